@@ -1,3 +1,8 @@
+#include <cstring>
+
+#include <pybind11/eval.h>
+#include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -7,6 +12,26 @@
 
 namespace py = pybind11;
 
+// Arrays of other dtypes or layouts are converted once by numpy into a
+// contiguous float32 array, otherwise the buffer is read directly
+typedef py::array_t<float, py::array::c_style | py::array::forcecast> np_float_array;
+
+static std::vector<float> vectorFromArray(const np_float_array& array) {
+    const float* data = array.data();
+    return std::vector<float>(data, data + array.size());
+}
+
+// The asyncio awaitable is defined as a python coroutine that polls the
+// sequence fence, so the event loop keeps running other tasks while waiting
+static const char* awaitSequenceSource = R"(
+import asyncio
+
+async def _await_sequence(sequence, poll_interval):
+    while not sequence.is_complete():
+        await asyncio.sleep(poll_interval)
+    return sequence.eval_await()
+)";
+
 PYBIND11_MODULE(kp, m) {
 
 #if KOMPUTE_ENABLE_SPDLOG
@@ -23,6 +48,11 @@ PYBIND11_MODULE(kp, m) {
 #endif
         });
 
+    py::dict awaitSequenceScope;
+    awaitSequenceScope["__builtins__"] = py::module::import("builtins");
+    py::exec(awaitSequenceSource, awaitSequenceScope);
+    m.attr("_await_sequence") = awaitSequenceScope["_await_sequence"];
+
     py::enum_<kp::Tensor::TensorTypes>(m, "TensorTypes", DOC(kp, Tensor, TensorTypes))
         .value("device", kp::Tensor::TensorTypes::eDevice, "Tensor holding data in GPU memory.")
         .value("staging", kp::Tensor::TensorTypes::eStaging, "Tensor used for transfer of data to device.")
@@ -30,21 +60,57 @@ PYBIND11_MODULE(kp, m) {
         .export_values();
 
     py::class_<kp::Tensor, std::shared_ptr<kp::Tensor>>(m, "Tensor", DOC(kp, Tensor))
+        // There are no std::vector<float> overloads as the list caster would
+        // match numpy arrays of other dtypes and convert them element by
+        // element, so lists are also converted through the buffer overloads
         .def(py::init(
-            [](const std::vector<float>& data) {
-                return std::unique_ptr<kp::Tensor>(new kp::Tensor(data));
-            }), DOC(kp, Tensor, Tensor, 2))
+            [](const np_float_array& data) {
+                return std::unique_ptr<kp::Tensor>(new kp::Tensor(vectorFromArray(data)));
+            }), "Initialiser with a list or any buffer protocol object such as a numpy array, copied with a single memcpy.")
         .def(py::init(
-            [](const std::vector<float>& data, kp::Tensor::TensorTypes tensorTypes) {
-                return std::unique_ptr<kp::Tensor>(new kp::Tensor(data, tensorTypes));
-            }), "Initialiser with list of data components and tensor GPU memory type.")
+            [](const np_float_array& data, kp::Tensor::TensorTypes tensorTypes) {
+                return std::unique_ptr<kp::Tensor>(new kp::Tensor(vectorFromArray(data), tensorTypes));
+            }), "Initialiser with a list or any buffer protocol object such as a numpy array and tensor GPU memory type.")
         .def("data", &kp::Tensor::data, DOC(kp, Tensor, data))
+        .def("numpy", [](std::shared_ptr<kp::Tensor> self) {
+                // The array is a view over the tensor local data which keeps
+                // the tensor alive, so no copy is performed, and for views it
+                // points into the local data of the parent tensor
+                return py::array_t<float>(
+                    { static_cast<py::ssize_t>(self->size()) },
+                    { static_cast<py::ssize_t>(sizeof(float)) },
+                    self->hostData(),
+                    py::cast(self));
+            }, "Returns a numpy array view over the tensor local data without copying it.")
         .def("size", &kp::Tensor::size, "Retrieves the size of the Tensor data as per the local Tensor memory.")
+        .def("shape", &kp::Tensor::shape, "Retrieves the size of each dimension of the Tensor, where zero means the dimension is not active.")
+        .def("reshape", &kp::Tensor::reshape, "Sets the shape of the Tensor without modifying its data, as used by the operations that broadcast their inputs.",
+                py::arg("shape"))
         .def("tensor_type", &kp::Tensor::tensorType, "Retreves the memory type of the tensor.")
         .def("is_init", &kp::Tensor::isInit, "Checks whether the tensor GPU memory has been initialised.")
-        .def("set_data", &kp::Tensor::setData, "Overrides the data in the local Tensor memory.")
-        .def("map_data_from_host", &kp::Tensor::mapDataFromHostMemory, "Maps data into GPU memory from tensor local data.")
-        .def("map_data_into_host", &kp::Tensor::mapDataIntoHostMemory, "Maps data from GPU memory into tensor local data.");
+        .def("view", &kp::Tensor::view, "Creates a view over a range of the tensor elements that shares its GPU memory.",
+                py::arg("offset"), py::arg("size"))
+        .def("is_view", &kp::Tensor::isView, "Checks whether the tensor is a view over the memory of another tensor.")
+        .def("set_data", [](kp::Tensor& self, const np_float_array& data) {
+                if (static_cast<size_t>(data.size()) != self.data().size()) {
+                    throw std::runtime_error("Kompute Tensor Cannot set data of different sizes");
+                }
+                memcpy(self.hostData(), data.data(), data.size() * sizeof(float));
+            }, "Overrides the data in the local Tensor memory with a single memcpy from a list or buffer protocol object.")
+        .def("mark_dirty", &kp::Tensor::markDirty, "Marks a range of the local Tensor memory as modified so only the modified ranges are synced to the device.",
+                py::arg("offset"), py::arg("size"))
+        .def("map_data_from_host", py::overload_cast<>(&kp::Tensor::mapDataFromHostMemory), "Maps data into GPU memory from tensor local data.")
+        .def("map_data_into_host", py::overload_cast<>(&kp::Tensor::mapDataIntoHostMemory), "Maps data from GPU memory into tensor local data.");
+
+    py::class_<kp::EvalFuture>(m, "EvalFuture", "Handle to an asynchronous evaluation which is awaited by the completion thread of the manager.")
+        .def("valid", &kp::EvalFuture::valid, "Checks whether the handle refers to an evaluation.")
+        .def("ready", &kp::EvalFuture::ready, "Checks without blocking whether the evaluation has finished.")
+        .def("wait", &kp::EvalFuture::wait, py::call_guard<py::gil_scoped_release>(),
+            py::arg("waitFor") = UINT64_MAX, "Waits until the evaluation finishes or the timeout in nanoseconds expires, returning whether it finished.")
+        .def("get", &kp::EvalFuture::get, py::call_guard<py::gil_scoped_release>(),
+            "Waits until the evaluation finishes and returns whether it was successful.")
+        .def("then", &kp::EvalFuture::then,
+            "Chains a function called with the finished future in the completion thread, returning a future for the function.");
 
     py::class_<kp::Sequence, std::shared_ptr<kp::Sequence>>(m, "Sequence")
         .def("init", &kp::Sequence::init, "Initialises Vulkan resources within sequence using provided device.")
@@ -52,10 +118,17 @@ PYBIND11_MODULE(kp, m) {
         .def("begin", &kp::Sequence::begin, "Clears previous commands and starts recording commands in sequence which can be run in batch.")
         .def("end", &kp::Sequence::end, "Stops listening and recording for new commands.")
         // eval
-        .def("eval", &kp::Sequence::eval, "Executes the currently recorded commands synchronously by waiting on Vulkan Fence.")
+        .def("eval", &kp::Sequence::eval, py::call_guard<py::gil_scoped_release>(),
+            "Executes the currently recorded commands synchronously by waiting on Vulkan Fence.")
         .def("eval_async", &kp::Sequence::evalAsync, "Executes the currently recorded commands asynchronously.")
-        .def("eval_await", &kp::Sequence::evalAwait, "Waits until the execution finishes using Vulkan Fence.")
+        .def("eval_await", &kp::Sequence::evalAwait, py::call_guard<py::gil_scoped_release>(),
+            py::arg("waitFor") = UINT64_MAX, "Waits until the execution finishes using Vulkan Fence.")
+        .def("eval_await_async", [](std::shared_ptr<kp::Sequence> self, double pollInterval) {
+                return py::module::import("kp").attr("_await_sequence")(self, pollInterval);
+            }, py::arg("poll_interval") = 0.001,
+            "Returns an asyncio awaitable which polls the Vulkan Fence every poll_interval seconds and runs the eval await once the execution finishes.")
         // status
+        .def("is_complete", &kp::Sequence::isComplete, "Checks without blocking whether the GPU has finished executing the last asynchronous submission.")
         .def("is_running", &kp::Sequence::isRunning, "Checks whether the Sequence operations are currently still executing.")
         .def("is_rec", &kp::Sequence::isRecording, "Checks whether the Sequence is currently in recording mode.")
         .def("is_init", &kp::Sequence::isInit, "Checks if the Sequence has been initialized")
@@ -87,8 +160,43 @@ PYBIND11_MODULE(kp, m) {
         .def("record_algo_lro", &kp::Sequence::record<kp::OpAlgoLhsRhsOut>,
             "Records operation to run left right out operation with custom shader");
 
+    py::class_<kp::DeviceInfo>(m, "DeviceInfo", "Capabilities of a physical device as reported by Manager.list_devices.")
+        .def_readonly("index", &kp::DeviceInfo::index)
+        .def_readonly("name", &kp::DeviceInfo::name)
+        .def_property_readonly("device_type", [](const kp::DeviceInfo& self) {
+                return vk::to_string(self.deviceType);
+            }, "Type of the device such as DiscreteGpu, IntegratedGpu or Cpu.")
+        .def_readonly("vendor_id", &kp::DeviceInfo::vendorID)
+        .def_readonly("device_id", &kp::DeviceInfo::deviceID)
+        .def_readonly("api_version", &kp::DeviceInfo::apiVersion)
+        .def_readonly("device_local_memory_size", &kp::DeviceInfo::deviceLocalMemorySize)
+        .def_readonly("has_unified_memory", &kp::DeviceInfo::hasUnifiedMemory)
+        .def_readonly("subgroup_size", &kp::DeviceInfo::subgroupSize)
+        .def_readonly("has_subgroup_arithmetic", &kp::DeviceInfo::hasSubgroupArithmetic)
+        .def_readonly("max_compute_work_group_invocations", &kp::DeviceInfo::maxComputeWorkGroupInvocations)
+        .def_readonly("max_compute_work_group_size", &kp::DeviceInfo::maxComputeWorkGroupSize)
+        .def_readonly("max_compute_shared_memory_size", &kp::DeviceInfo::maxComputeSharedMemorySize)
+        .def_readonly("compute_queue_family_indices", &kp::DeviceInfo::computeQueueFamilyIndices)
+        .def_readonly("extensions", &kp::DeviceInfo::extensions);
+
+    py::class_<kp::DevicePolicy>(m, "DevicePolicy", "Policy used by the Manager to choose the physical device to run on.")
+        .def(py::init())
+        .def_readwrite("prefer_discrete", &kp::DevicePolicy::preferDiscrete)
+        .def_readwrite("prefer_device_local_memory", &kp::DevicePolicy::preferDeviceLocalMemory)
+        .def_readwrite("prefer_dedicated_compute_queue", &kp::DevicePolicy::preferDedicatedComputeQueue)
+        .def_readwrite("required_extensions", &kp::DevicePolicy::requiredExtensions)
+        .def_readwrite("name_regex", &kp::DevicePolicy::nameRegex)
+        .def_readwrite("filter", &kp::DevicePolicy::filter)
+        .def("select", &kp::DevicePolicy::select, "Chooses the index of the best suitable device out of the devices provided.");
+
     py::class_<kp::Manager>(m, "Manager")
         .def(py::init(), "Default initializer uses device 0 and first compute compatible GPU queueFamily")
+        .def(py::init(
+            [](const kp::DevicePolicy& devicePolicy) {
+                return std::unique_ptr<kp::Manager>(new kp::Manager(devicePolicy));
+            }), "Manager initialiser which chooses the device with the policy provided")
+        .def_static("list_devices", &kp::Manager::listDevices, "Lists the physical devices available with their capabilities.")
+        .def("physical_device_index", &kp::Manager::physicalDeviceIndex, "Index of the physical device used by the manager.")
         .def(py::init(
             [](uint32_t physicalDeviceIndex) {
                 return std::unique_ptr<kp::Manager>(new kp::Manager(physicalDeviceIndex));
@@ -104,25 +212,25 @@ PYBIND11_MODULE(kp, m) {
                 py::arg("data"), py::arg("tensorType") = kp::Tensor::TensorTypes::eDevice,
                 "Build and initialise tensor")
         // Await functions
-        .def("eval_await", &kp::Manager::evalOpAwait,
+        .def("eval_await", &kp::Manager::evalOpAwait, py::call_guard<py::gil_scoped_release>(),
                 py::arg("sequenceName"), py::arg("waitFor") = UINT64_MAX,
                 "Awaits for asynchronous operation on a named Sequence")
-        .def("eval_await_def", &kp::Manager::evalOpAwaitDefault,
+        .def("eval_await_def", &kp::Manager::evalOpAwaitDefault, py::call_guard<py::gil_scoped_release>(),
                 py::arg("waitFor") = UINT64_MAX, "Awaits for asynchronous operation on the last anonymous Sequence created")
         // eval default
-        .def("eval_tensor_create_def", &kp::Manager::evalOpDefault<kp::OpTensorCreate>,
+        .def("eval_tensor_create_def", &kp::Manager::evalOpDefault<kp::OpTensorCreate>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates operation to create and initialise tensor GPU memory and buffer with new anonymous Sequence")
-        .def("eval_tensor_copy_def", &kp::Manager::evalOpDefault<kp::OpTensorCopy>,
+        .def("eval_tensor_copy_def", &kp::Manager::evalOpDefault<kp::OpTensorCopy>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates operation to copy one tensor to one or many tensors with new anonymous Sequence")
-        .def("eval_tensor_sync_device_def", &kp::Manager::evalOpDefault<kp::OpTensorSyncDevice>,
+        .def("eval_tensor_sync_device_def", &kp::Manager::evalOpDefault<kp::OpTensorSyncDevice>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates operation to sync tensor from local memory to GPU memory with new anonymous Sequence")
-        .def("eval_tensor_sync_local_def", &kp::Manager::evalOpDefault<kp::OpTensorSyncLocal>,
+        .def("eval_tensor_sync_local_def", &kp::Manager::evalOpDefault<kp::OpTensorSyncLocal>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates operation to sync tensor(s) from GPU memory to local memory using staging tensors with new anonymous Sequence")
-        .def("eval_algo_mult_def", &kp::Manager::evalOpDefault<kp::OpMult>,
+        .def("eval_algo_mult_def", &kp::Manager::evalOpDefault<kp::OpMult>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates operation to run multiplication compute shader to two input tensors and an output tensor with new anonymous Sequence")
-        .def("eval_algo_file_def", &kp::Manager::evalOpDefault<kp::OpAlgoBase, std::string>,
+        .def("eval_algo_file_def", &kp::Manager::evalOpDefault<kp::OpAlgoBase, std::string>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates an operation using a custom shader provided from a shader path with new anonymous Sequence")
-        .def("eval_algo_str_def", &kp::Manager::evalOpDefault<kp::OpAlgoBase, std::vector<char>>,
+        .def("eval_algo_str_def", &kp::Manager::evalOpDefault<kp::OpAlgoBase, std::vector<char>>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates an operation using a custom shader provided as string provided as list of characters with new anonymous Sequence")
         .def("eval_algo_data_def", [](kp::Manager &self,
                                     std::vector<std::shared_ptr<kp::Tensor>> tensors,
@@ -131,27 +239,29 @@ PYBIND11_MODULE(kp, m) {
                 py::buffer_info info(py::buffer(bytes).request());
                 const char *data = reinterpret_cast<const char *>(info.ptr);
                 size_t length = static_cast<size_t>(info.size);
+                std::vector<char> shaderData(data, data + length);
+                py::gil_scoped_release release;
                 self.evalOpDefault<kp::OpAlgoBase>(
                     tensors,
-                    std::vector<char>(data, data + length));
+                    shaderData);
             },
             "Evaluates an operation using a custom shader provided as spirv bytes with new anonymous Sequence")
-        .def("eval_algo_lro_def", &kp::Manager::evalOpDefault<kp::OpAlgoLhsRhsOut>,
+        .def("eval_algo_lro_def", &kp::Manager::evalOpDefault<kp::OpAlgoLhsRhsOut>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates operation to run left right out operation with custom shader with new anonymous Sequence")
         // eval
-        .def("eval_tensor_create", &kp::Manager::evalOp<kp::OpTensorCreate>,
+        .def("eval_tensor_create", &kp::Manager::evalOp<kp::OpTensorCreate>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates operation to create and initialise tensor GPU memory and buffer with explicitly named Sequence")
-        .def("eval_tensor_copy", &kp::Manager::evalOp<kp::OpTensorCopy>,
+        .def("eval_tensor_copy", &kp::Manager::evalOp<kp::OpTensorCopy>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates operation to copy one tensor to one or many tensors with explicitly named Sequence")
-        .def("eval_tensor_sync_device", &kp::Manager::evalOp<kp::OpTensorSyncDevice>,
+        .def("eval_tensor_sync_device", &kp::Manager::evalOp<kp::OpTensorSyncDevice>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates operation to sync tensor from local memory to GPU memory with explicitly named Sequence")
-        .def("eval_tensor_sync_local", &kp::Manager::evalOp<kp::OpTensorSyncLocal>,
+        .def("eval_tensor_sync_local", &kp::Manager::evalOp<kp::OpTensorSyncLocal>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates operation to sync tensor(s) from GPU memory to local memory using staging tensors with explicitly named Sequence")
-        .def("eval_algo_mult", &kp::Manager::evalOp<kp::OpMult>,
+        .def("eval_algo_mult", &kp::Manager::evalOp<kp::OpMult>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates operation to run multiplication compute shader to two input tensors and an output tensor with explicitly named Sequence")
-        .def("eval_algo_file", &kp::Manager::evalOp<kp::OpAlgoBase, std::string>,
+        .def("eval_algo_file", &kp::Manager::evalOp<kp::OpAlgoBase, std::string>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates an operation using a custom shader provided from a shader path with explicitly named Sequence")
-        .def("eval_algo_str", &kp::Manager::evalOp<kp::OpAlgoBase, std::vector<char>>,
+        .def("eval_algo_str", &kp::Manager::evalOp<kp::OpAlgoBase, std::vector<char>>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates an operation using a custom shader provided as string provided as list of characters with explicitly named Sequence")
         .def("eval_algo_data", [](kp::Manager &self,
                                     std::vector<std::shared_ptr<kp::Tensor>> tensors,
@@ -161,28 +271,30 @@ PYBIND11_MODULE(kp, m) {
                 py::buffer_info info(py::buffer(bytes).request());
                 const char *data = reinterpret_cast<const char *>(info.ptr);
                 size_t length = static_cast<size_t>(info.size);
+                std::vector<char> shaderData(data, data + length);
+                py::gil_scoped_release release;
                 self.evalOp<kp::OpAlgoBase>(
                     tensors,
                     sequenceName,
-                    std::vector<char>(data, data + length));
+                    shaderData);
             },
             "Evaluates an operation using a custom shader provided as spirv bytes with explicitly named Sequence")
-        .def("eval_algo_lro", &kp::Manager::evalOp<kp::OpAlgoLhsRhsOut>,
+        .def("eval_algo_lro", &kp::Manager::evalOp<kp::OpAlgoLhsRhsOut>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates operation to run left right out operation with custom shader with explicitly named Sequence")
         // eval async default
-        .def("eval_async_tensor_create_def", &kp::Manager::evalOpAsyncDefault<kp::OpTensorCreate>,
+        .def("eval_async_tensor_create_def", &kp::Manager::evalOpAsyncDefault<kp::OpTensorCreate>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates asynchronously operation to create and initialise tensor GPU memory and buffer with anonymous Sequence")
-        .def("eval_async_tensor_copy_def", &kp::Manager::evalOpAsyncDefault<kp::OpTensorCopy>,
+        .def("eval_async_tensor_copy_def", &kp::Manager::evalOpAsyncDefault<kp::OpTensorCopy>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates asynchronously operation to copy one tensor to one or many tensors with anonymous Sequence")
-        .def("eval_async_tensor_sync_device_def", &kp::Manager::evalOpAsyncDefault<kp::OpTensorSyncDevice>,
+        .def("eval_async_tensor_sync_device_def", &kp::Manager::evalOpAsyncDefault<kp::OpTensorSyncDevice>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates asynchronously operation to sync tensor from local memory to GPU memory with anonymous Sequence")
-        .def("eval_async_tensor_sync_local_def", &kp::Manager::evalOpAsyncDefault<kp::OpTensorSyncLocal>,
+        .def("eval_async_tensor_sync_local_def", &kp::Manager::evalOpAsyncDefault<kp::OpTensorSyncLocal>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates asynchronously operation to sync tensor(s) from GPU memory to local memory using staging tensors with anonymous Sequence")
-        .def("eval_async_algo_mult_def", &kp::Manager::evalOpAsyncDefault<kp::OpMult>,
+        .def("eval_async_algo_mult_def", &kp::Manager::evalOpAsyncDefault<kp::OpMult>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates asynchronously operation to run multiplication compute shader to two input tensors and an output tensor with anonymous Sequence")
-        .def("eval_async_algo_file_def", &kp::Manager::evalOpAsyncDefault<kp::OpAlgoBase, std::string>,
+        .def("eval_async_algo_file_def", &kp::Manager::evalOpAsyncDefault<kp::OpAlgoBase, std::string>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates asynchronously an operation using a custom shader provided from a shader path with anonymous Sequence")
-        .def("eval_async_algo_str_def", &kp::Manager::evalOpAsyncDefault<kp::OpAlgoBase, std::vector<char>>,
+        .def("eval_async_algo_str_def", &kp::Manager::evalOpAsyncDefault<kp::OpAlgoBase, std::vector<char>>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates Asynchronously an operation using a custom shader provided as string provided as list of characters with new anonymous Sequence")
         .def("eval_async_algo_data_def", [](kp::Manager &self,
                                     std::vector<std::shared_ptr<kp::Tensor>> tensors,
@@ -191,27 +303,29 @@ PYBIND11_MODULE(kp, m) {
                 py::buffer_info info(py::buffer(bytes).request());
                 const char *data = reinterpret_cast<const char *>(info.ptr);
                 size_t length = static_cast<size_t>(info.size);
-                self.evalOpAsyncDefault<kp::OpAlgoBase>(
+                std::vector<char> shaderData(data, data + length);
+                py::gil_scoped_release release;
+                return self.evalOpAsyncDefault<kp::OpAlgoBase>(
                     tensors,
-                    std::vector<char>(data, data + length));
+                    shaderData);
             },
             "Evaluates asynchronously an operation using a custom shader provided as raw string or spirv bytes with anonymous Sequence")
-        .def("eval_async_algo_lro_def", &kp::Manager::evalOpAsyncDefault<kp::OpAlgoLhsRhsOut>,
+        .def("eval_async_algo_lro_def", &kp::Manager::evalOpAsyncDefault<kp::OpAlgoLhsRhsOut>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates asynchronously operation to run left right out operation with custom shader with anonymous Sequence")
         // eval async
-        .def("eval_async_tensor_create", &kp::Manager::evalOpAsync<kp::OpTensorCreate>,
+        .def("eval_async_tensor_create", &kp::Manager::evalOpAsync<kp::OpTensorCreate>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates asynchronously operation to create and initialise tensor GPU memory and buffer with explicitly named Sequence")
-        .def("eval_async_tensor_copy", &kp::Manager::evalOpAsync<kp::OpTensorCopy>,
+        .def("eval_async_tensor_copy", &kp::Manager::evalOpAsync<kp::OpTensorCopy>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates asynchronously operation to copy one tensor to one or many tensors with explicitly named Sequence")
-        .def("eval_async_tensor_sync_device", &kp::Manager::evalOpAsync<kp::OpTensorSyncDevice>,
+        .def("eval_async_tensor_sync_device", &kp::Manager::evalOpAsync<kp::OpTensorSyncDevice>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates asynchronously operation to sync tensor from local memory to GPU memory with explicitly named Sequence")
-        .def("eval_async_tensor_sync_local", &kp::Manager::evalOpAsync<kp::OpTensorSyncLocal>,
+        .def("eval_async_tensor_sync_local", &kp::Manager::evalOpAsync<kp::OpTensorSyncLocal>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates asynchronously operation to sync tensor(s) from GPU memory to local memory using staging tensors with explicitly named Sequence")
-        .def("eval_async_algo_mult", &kp::Manager::evalOpAsync<kp::OpMult>,
+        .def("eval_async_algo_mult", &kp::Manager::evalOpAsync<kp::OpMult>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates asynchronously operation to run multiplication compute shader to two input tensors and an output tensor with explicitly named Sequence")
-        .def("eval_async_algo_file", &kp::Manager::evalOpAsync<kp::OpAlgoBase, std::string>,
+        .def("eval_async_algo_file", &kp::Manager::evalOpAsync<kp::OpAlgoBase, std::string>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates asynchronously an operation using a custom shader provided from a shader path with explicitly named Sequence")
-        .def("eval_async_algo_str", &kp::Manager::evalOpAsync<kp::OpAlgoBase, std::vector<char>>,
+        .def("eval_async_algo_str", &kp::Manager::evalOpAsync<kp::OpAlgoBase, std::vector<char>>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates Asynchronous an operation using a custom shader provided as string provided as list of characters with explicitly named Sequence")
         .def("eval_async_algo_data", [](kp::Manager &self,
                                     std::vector<std::shared_ptr<kp::Tensor>> tensors,
@@ -221,15 +335,48 @@ PYBIND11_MODULE(kp, m) {
                 py::buffer_info info(py::buffer(bytes).request());
                 const char *data = reinterpret_cast<const char *>(info.ptr);
                 size_t length = static_cast<size_t>(info.size);
-                self.evalOpAsync<kp::OpAlgoBase>(
+                std::vector<char> shaderData(data, data + length);
+                py::gil_scoped_release release;
+                return self.evalOpAsync<kp::OpAlgoBase>(
                     tensors,
                     sequenceName,
-                    std::vector<char>(data, data + length));
+                    shaderData);
             },
             "Evaluates asynchronously an operation using a custom shader provided as raw string or spirv bytes with explicitly named Sequence")
-        .def("eval_async_algo_lro", &kp::Manager::evalOpAsync<kp::OpAlgoLhsRhsOut>,
+        .def("eval_async_algo_lro", &kp::Manager::evalOpAsync<kp::OpAlgoLhsRhsOut>, py::call_guard<py::gil_scoped_release>(),
             "Evaluates asynchronously operation to run left right out operation with custom shader with explicitly named Sequence");
 
+    py::class_<kp::MultiDeviceManager> multiDeviceManager(m, "MultiDeviceManager",
+        "Coordinator which owns one Manager per device to run data parallel workloads on sharded tensors.");
+
+    py::enum_<kp::MultiDeviceManager::ReduceOps>(multiDeviceManager, "ReduceOps")
+        .value("sum", kp::MultiDeviceManager::ReduceOps::eSum, "Element wise sum of the tensors of each device.")
+        .value("mean", kp::MultiDeviceManager::ReduceOps::eMean, "Element wise mean of the tensors of each device.")
+        .export_values();
+
+    multiDeviceManager
+        .def(py::init<const std::vector<uint32_t>&>(), "Creates a Manager for each of the physical device indices, which can repeat.")
+        .def("size", &kp::MultiDeviceManager::size, "Number of devices coordinated.")
+        .def("shard", &kp::MultiDeviceManager::shard, py::call_guard<py::gil_scoped_release>(),
+            "Splits the data along its leading dimension into one tensor per device.",
+            py::arg("data"), py::arg("row_size") = 1, py::arg("tensor_type") = kp::Tensor::TensorTypes::eDevice)
+        .def("replicate", &kp::MultiDeviceManager::replicate, py::call_guard<py::gil_scoped_release>(),
+            "Creates a full copy of the data in the memory of each device.",
+            py::arg("data"), py::arg("tensor_type") = kp::Tensor::TensorTypes::eDevice)
+        .def("gather", &kp::MultiDeviceManager::gather, py::call_guard<py::gil_scoped_release>(),
+            "Syncs the shards of each device and concatenates them in device order.")
+        .def("all_reduce", &kp::MultiDeviceManager::allReduce, py::call_guard<py::gil_scoped_release>(),
+            "Reduces the tensors of each device on the host and syncs the result back into each device.",
+            py::arg("tensors"), py::arg("reduce_op") = kp::MultiDeviceManager::ReduceOps::eSum)
+        .def("eval_tensor_sync_device", &kp::MultiDeviceManager::evalOp<kp::OpTensorSyncDevice>, py::call_guard<py::gil_scoped_release>(),
+            "Evaluates in parallel the sync of the shards of each device from local memory to GPU memory")
+        .def("eval_tensor_sync_local", &kp::MultiDeviceManager::evalOp<kp::OpTensorSyncLocal>, py::call_guard<py::gil_scoped_release>(),
+            "Evaluates in parallel the sync of the shards of each device from GPU memory to local memory")
+        .def("eval_algo_mult", &kp::MultiDeviceManager::evalOp<kp::OpMult>, py::call_guard<py::gil_scoped_release>(),
+            "Evaluates in parallel the multiplication compute shader on the shards of each device")
+        .def("eval_algo_file", &kp::MultiDeviceManager::evalOp<kp::OpAlgoBase, std::string>, py::call_guard<py::gil_scoped_release>(),
+            "Evaluates in parallel an operation using a custom shader provided from a shader path on the shards of each device");
+
 #ifdef VERSION_INFO
     m.attr("__version__") = VERSION_INFO;
 #else
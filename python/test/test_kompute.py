@@ -1,8 +1,12 @@
 
+import asyncio
+
+import numpy as np
+
 from pyshader import python2shader, f32, ivec3, Array
 from pyshader.stdlib import exp, log
 
-from kp import Tensor, Manager, Sequence
+from kp import Tensor, Manager, Sequence, DevicePolicy, MultiDeviceManager
 
 def test_opmult():
     """
@@ -23,6 +27,92 @@ def test_opmult():
 
     assert tensor_out.data() == [2.0, 4.0, 6.0]
 
+def test_tensor_numpy():
+    """
+    Test tensors created from and viewed as numpy arrays without copies
+    """
+
+    tensor_in_a = Tensor(np.array([2, 2, 2], dtype=np.float32))
+    tensor_in_b = Tensor(np.array([1, 2, 3], dtype=np.float64))
+    tensor_out = Tensor(np.zeros(3, dtype=np.float32))
+
+    mgr = Manager()
+
+    mgr.eval_tensor_create_def([tensor_in_a, tensor_in_b, tensor_out])
+
+    mgr.eval_algo_mult_def([tensor_in_a, tensor_in_b, tensor_out])
+
+    mgr.eval_tensor_sync_local_def([tensor_out])
+
+    out_view = tensor_out.numpy()
+
+    assert out_view.dtype == np.float32
+    assert np.array_equal(out_view, np.array([2.0, 4.0, 6.0]))
+
+    # The array is a view over the tensor data so writes are shared
+    out_view[0] = 10.0
+    assert tensor_out.data()[0] == 10.0
+
+    tensor_in_a.set_data(np.array([3, 3, 3], dtype=np.float32))
+    assert np.array_equal(tensor_in_a.numpy(), np.array([3.0, 3.0, 3.0]))
+
+    # Arrays of other dtypes are cast as a whole instead of being read element
+    # by element, which the items of this array do not allow
+    class NoItemsArray(np.ndarray):
+        def __getitem__(self, key):
+            raise AssertionError("Array read element by element")
+
+    tensor_float64 = Tensor(np.array([4, 5, 6], dtype=np.float64).view(NoItemsArray))
+    assert np.array_equal(tensor_float64.numpy(), np.array([4.0, 5.0, 6.0]))
+
+    tensor_float64.set_data(np.array([7, 8, 9], dtype=np.float64).view(NoItemsArray))
+    assert np.array_equal(tensor_float64.numpy(), np.array([7.0, 8.0, 9.0]))
+
+    tensor_float64.set_data([1, 2, 3])
+    assert tensor_float64.data() == [1.0, 2.0, 3.0]
+
+def test_tensor_view():
+    """
+    Test views sharing the GPU memory of a tensor and syncing only their range
+    """
+
+    tensor = Tensor([0, 1, 2, 3, 4, 5])
+    view_a = tensor.view(0, 3)
+    view_b = tensor.view(3, 3)
+
+    assert view_b.is_view()
+    assert view_b.data() == [3.0, 4.0, 5.0]
+
+    mgr = Manager()
+
+    mgr.eval_tensor_create_def([tensor])
+
+    mgr.eval_tensor_copy_def([view_a, view_b])
+
+    tensor.set_data([0, 0, 0, 0, 0, 0])
+    mgr.eval_tensor_sync_local_def([view_b])
+
+    assert tensor.data() == [0.0, 0.0, 0.0, 0.0, 1.0, 2.0]
+
+def test_tensor_mark_dirty():
+    """
+    Test syncing only the ranges of a tensor marked as modified
+    """
+
+    tensor = Tensor([0, 0, 0, 0])
+
+    mgr = Manager()
+
+    mgr.eval_tensor_create_def([tensor])
+
+    tensor.set_data([1, 2, 3, 4])
+    tensor.mark_dirty(1, 2)
+
+    mgr.eval_tensor_sync_device_def([tensor])
+    mgr.eval_tensor_sync_local_def([tensor])
+
+    assert tensor.data() == [0.0, 2.0, 3.0, 0.0]
+
 def test_opalgobase_data():
     """
     Test basic OpAlgoBase operation
@@ -101,6 +191,73 @@ def test_sequence():
     seq.eval()
     assert tensor_out.data() == [2.0, 4.0, 6.0]
 
+def test_eval_async_future():
+    """
+    Test futures returned by asynchronous evaluations and their continuations
+    """
+
+    mgr = Manager()
+
+    tensor_in_a = Tensor([2, 2, 2])
+    tensor_in_b = Tensor([1, 2, 3])
+    tensor_out = Tensor([0, 0, 0])
+    mgr.eval_tensor_create_def([tensor_in_a, tensor_in_b, tensor_out])
+
+    continued = []
+
+    future = mgr.eval_async_algo_mult_def([tensor_in_a, tensor_in_b, tensor_out])
+    chained = future.then(lambda f: continued.append(f.ready()))
+
+    assert future.wait()
+    assert future.get()
+    assert chained.get()
+    assert continued == [True]
+
+    assert mgr.eval_async_tensor_sync_local_def([tensor_out]).get()
+    assert tensor_out.data() == [2.0, 4.0, 6.0]
+
+def test_sequence_eval_await_async():
+    """
+    Test awaiting a sequence from asyncio while other tasks keep running
+    """
+
+    mgr = Manager()
+
+    tensor_in_a = Tensor([2, 2, 2])
+    tensor_in_b = Tensor([1, 2, 3])
+    tensor_out = Tensor([0, 0, 0])
+    mgr.eval_tensor_create_def([tensor_in_a, tensor_in_b, tensor_out])
+
+    seq = mgr.create_sequence("asyncop")
+    seq.begin()
+    seq.record_algo_mult([tensor_in_a, tensor_in_b, tensor_out])
+    seq.record_tensor_sync_local([tensor_out])
+    seq.end()
+
+    async def run():
+        ticks = 0
+
+        async def tick():
+            nonlocal ticks
+            while True:
+                ticks += 1
+                await asyncio.sleep(0)
+
+        ticker = asyncio.ensure_future(tick())
+        assert seq.eval_async()
+        assert await seq.eval_await_async()
+        ticker.cancel()
+        return ticks
+
+    loop = asyncio.new_event_loop()
+    ticks = loop.run_until_complete(run())
+    loop.close()
+
+    assert ticks > 0
+    assert seq.is_complete()
+    assert not seq.is_running()
+    assert tensor_out.data() == [2.0, 4.0, 6.0]
+
 def test_pyshader_pyshader():
 
     @python2shader
@@ -223,3 +380,46 @@ def test_logistic_regression_pyshader():
     assert tensor_w_in.data()[1] > 1.5
     assert tensor_b_in.data()[0] < 0.7
 
+def test_device_policy():
+    """
+    Test listing the devices and choosing one with a policy
+    """
+
+    devices = Manager.list_devices()
+    assert len(devices) > 0
+    assert all(device.max_compute_work_group_invocations > 0 for device in devices)
+
+    policy = DevicePolicy()
+    policy.filter = lambda device: device.max_compute_shared_memory_size > 0
+    selected_index = policy.select(devices)
+
+    mgr = Manager(policy)
+    assert mgr.physical_device_index() == selected_index
+
+    tensor_in_a = Tensor([2, 2, 2])
+    tensor_in_b = Tensor([1, 2, 3])
+    tensor_out = Tensor([0, 0, 0])
+
+    mgr.eval_tensor_create_def([tensor_in_a, tensor_in_b, tensor_out])
+    mgr.eval_algo_mult_def([tensor_in_a, tensor_in_b, tensor_out])
+    mgr.eval_tensor_sync_local_def([tensor_out])
+
+    assert tensor_out.data() == [2.0, 4.0, 6.0]
+
+def test_multi_device_manager():
+    """
+    Test sharding an operation across the same device twice
+    """
+
+    multi_mgr = MultiDeviceManager([0, 0])
+
+    lhs_shards = multi_mgr.shard([0, 1, 2, 3, 4])
+    rhs_shards = multi_mgr.shard([2, 2, 2, 2, 2])
+    out_shards = multi_mgr.shard([0, 0, 0, 0, 0])
+
+    multi_mgr.eval_algo_mult([lhs_shards, rhs_shards, out_shards])
+
+    assert multi_mgr.gather(out_shards) == [0.0, 2.0, 4.0, 6.0, 8.0]
+
+    gradients = multi_mgr.replicate([1, 2])
+    assert multi_mgr.all_reduce(gradients, MultiDeviceManager.mean) == [1.0, 2.0]
@@ -52,6 +52,14 @@ SHADER_GENERATED_NOTICE = """/*
     required=True,
     help="The path for the directory to build and convert shaders",
 )
+@click.option(
+    "--target-env",
+    "-t",
+    envvar="KOMPUTE_SHADER_TARGET_ENV",
+    default=None,
+    required=False,
+    help="The Vulkan environment the shaders are compiled for, which otherwise is vulkan1.1 for the shaders using subgroup operations and the default of the shader binary for the rest",
+)
 @click.option(
     "--header-path",
     "-c",
@@ -71,6 +79,7 @@ SHADER_GENERATED_NOTICE = """/*
 def run_cli(
     shader_path: str = None,
     shader_binary: str = None,
+    target_env: str = None,
     header_path: bool = None,
     verbose: bool = None,
 ):
@@ -105,7 +114,15 @@ def run_cli(
     for file in shader_files:
         logger.debug(f"Converting to spirv: {file}")
         spirv_file = f"{file}.spv"
-        run_cmd(shader_binary, "-V", file, "-o", spirv_file)
+        file_target_env = target_env
+        if file_target_env is None:
+            with open(file) as shader_file:
+                if "GL_KHR_shader_subgroup" in shader_file.read():
+                    file_target_env = "vulkan1.1"
+        if file_target_env:
+            run_cmd(shader_binary, "-V", "--target-env", file_target_env, file, "-o", spirv_file)
+        else:
+            run_cmd(shader_binary, "-V", file, "-o", spirv_file)
         spirv_files.append(spirv_file)
 
     # Create cpp files if header_path provided
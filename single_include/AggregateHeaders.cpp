@@ -3,14 +3,43 @@
 #include "kompute/shaders/shaderopmult.hpp"
 #include "kompute/shaders/shaderlogisticregression.hpp"
 #include "kompute/Manager.hpp"
+#include "kompute/MultiDeviceManager.hpp"
+#include "kompute/ShaderCache.hpp"
+#include "kompute/ShaderCompiler.hpp"
+#include "kompute/DescriptorPoolArena.hpp"
+#include "kompute/DevicePolicy.hpp"
+#include "kompute/TransferEngine.hpp"
 #include "kompute/Sequence.hpp"
+#include "kompute/SequenceAwaitable.hpp"
+#include "kompute/EvalFuture.hpp"
+#include "kompute/CompletionThread.hpp"
 #include "kompute/operations/OpBase.hpp"
 #include "kompute/operations/OpAlgoBase.hpp"
 #include "kompute/operations/OpAlgoLhsRhsOut.hpp"
+#include "kompute/operations/OpAlgoDoubleBuffer.hpp"
 #include "kompute/operations/OpMult.hpp"
+#include "kompute/operations/OpElementwise.hpp"
+#include "kompute/operations/OpElementwiseOps.hpp"
+#include "kompute/operations/OpScan.hpp"
+#include "kompute/operations/OpCompact.hpp"
+#include "kompute/operations/OpSort.hpp"
+#include "kompute/operations/OpTopK.hpp"
+#include "kompute/operations/OpConv2D.hpp"
+#include "kompute/operations/OpConv1D.hpp"
+#include "kompute/operations/OpPool2D.hpp"
+#include "kompute/operations/OpPool1D.hpp"
+#include "kompute/operations/OpBatchNorm.hpp"
+#include "kompute/operations/OpSoftmax.hpp"
+#include "kompute/operations/OpLayerNorm.hpp"
+#include "kompute/operations/OpAttention.hpp"
+#include "kompute/operations/OpSpMV.hpp"
+#include "kompute/operations/OpSpMM.hpp"
+#include "kompute/operations/OpRandom.hpp"
 #include "kompute/operations/OpTensorCreate.hpp"
 #include "kompute/operations/OpTensorCopy.hpp"
 #include "kompute/operations/OpTensorSyncDevice.hpp"
 #include "kompute/operations/OpTensorSyncLocal.hpp"
 #include "kompute/Algorithm.hpp"
 #include "kompute/Tensor.hpp"
+#include "kompute/TensorDoubleBuffer.hpp"
+#include "kompute/SparseTensor.hpp"
@@ -679,9 +679,17 @@ static const unsigned int shaders_glsl_logisticregression_comp_spv_len = 4920;
 }
 #endif // define SHADEROP_SHADERLOGISTICREGRESSION_HPP
 
+#include <mutex>
 #include <unordered_map>
 
-#define KP_MAX_DIM_SIZE 1
+#include <mutex>
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+#define KP_MAX_DIM_SIZE 4
 
 namespace kp {
 
@@ -693,7 +701,7 @@ namespace kp {
  * would be used to store their respective data. The tensors can be used for GPU
  * data storage or transfer.
  */
-class Tensor
+class Tensor : public std::enable_shared_from_this<Tensor>
 {
   public:
     /**
@@ -709,6 +717,25 @@ class Tensor
         eStorage = 2, ///< Type is Device memory (only)
     };
 
+    /**
+     * Contiguous range of elements of a tensor, used to transfer only part of
+     * the data of the tensor between the host and the device.
+     */
+    struct Range
+    {
+        uint32_t offset; ///< Index of the first element in the range
+        uint32_t size;   ///< Number of elements in the range
+    };
+
+    /**
+     * Sorts the ranges provided and merges the ones that overlap or are
+     * adjacent, so they can be transferred with the least copy regions.
+     *
+     * @param ranges Ranges of elements to coalesce
+     * @return Sorted ranges without overlapping or adjacent ranges
+     */
+    static std::vector<Range> coalesceRanges(std::vector<Range> ranges);
+
     /**
      *  Base constructor, should not be used unless explicitly intended.
      */
@@ -716,14 +743,37 @@ class Tensor
 
     /**
      *  Default constructor with data provided which would be used to create the
-     * respective vulkan buffer and memory.
+     * respective vulkan buffer and memory. The data is moved into the tensor
+     * so temporary vectors are not copied.
      *
      *  @param data Vector of data that will be used by the tensor
      *  @param tensorType Type for the tensor which is of type TensorTypes
      */
-    Tensor(const std::vector<float>& data,
+    Tensor(std::vector<float> data,
            TensorTypes tensorType = TensorTypes::eDevice);
 
+    /**
+     * Constructor that wraps existing host memory instead of holding a data
+     * vector, which is imported as the memory of the vulkan buffer through
+     * VK_EXT_external_memory_host so the GPU reads and writes it directly
+     * without any memcpy. The pointer and the size in bytes must be aligned to
+     * the minImportedHostPointerAlignment of the device (usually the page
+     * size), and the memory must remain valid until the tensor is destroyed.
+     * When the extension is not among the enabled extensions passed to init, or
+     * the pointer or size are not aligned, the tensor falls back to host
+     * visible memory and the data is copied between the pointer and the memory
+     * when mapped.
+     *
+     * The host data of the tensor is the memory pointed to, so data() returns
+     * an empty vector and setData copies into the memory pointed to.
+     *
+     *  @param data Pointer to the host memory to wrap
+     *  @param size Number of elements in the host memory
+     *  @param tensorType Type for the tensor, which can only be
+     * TensorTypes::eStaging or TensorTypes::eStorage
+     */
+    Tensor(float* data, uint32_t size, TensorTypes tensorType);
+
     /**
      * Destructor which is in charge of freeing vulkan resources unless they
      * have been provided externally.
@@ -735,9 +785,16 @@ class Tensor
      * as well as creates the respective staging tensors. The staging tensors
      * would only be created for the tensors of type TensorType::eDevice as
      * otherwise there is no need to copy from host memory.
+     *
+     * @param physicalDevice Vulkan physical device of the buffer memory
+     * @param device Vulkan logical device to create the buffer with
+     * @param enabledExtensions (Optional) Extensions enabled in the device,
+     * where VK_EXT_external_memory_host allows importing the host memory of
+     * tensors wrapping a host pointer
      */
     void init(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
-              std::shared_ptr<vk::Device> device);
+              std::shared_ptr<vk::Device> device,
+              const std::vector<std::string>& enabledExtensions = {});
 
     /**
      * Destroys and frees the GPU resources which include the buffer and memory.
@@ -747,12 +804,23 @@ class Tensor
     /**
      * Returns the vector of data currently contained by the Tensor. It is
      * important to ensure that there is no out-of-sync data with the GPU
-     * memory.
+     * memory. Tensors wrapping host memory return an empty vector, and views
+     * return a copy of their range of the data of the parent tensor, which is
+     * refreshed on every call, so views are modified through setData,
+     * the subscript operator or hostData instead.
      *
      * @return Reference to vector of elements representing the data in the
      * tensor.
      */
     std::vector<float>& data();
+    /**
+     * Returns a pointer to the host data of the tensor, which for tensors
+     * wrapping host memory is the host pointer and for views points into the
+     * data of the parent tensor at the offset of the view.
+     *
+     * @return Pointer to the first element of the host data of the tensor
+     */
+    float* hostData();
     /**
      * Overrides the subscript operator to expose the underlying data's
      * subscript operator which in this case would be its underlying
@@ -769,6 +837,20 @@ class Tensor
      * @return Unsigned integer representing the total number of elements
      */
     uint32_t size();
+    /**
+     * Returns the size in bytes of the data of the Tensor, which is also the
+     * size of its buffer or of its range in the parent buffer for views.
+     *
+     * @return Unsigned integer representing the size in bytes
+     */
+    uint64_t memorySize();
+    /**
+     * Returns the offset in bytes where the data of the Tensor starts in its
+     * buffer, which is always zero unless the tensor is a view.
+     *
+     * @return Unsigned integer representing the offset in bytes
+     */
+    uint64_t memoryOffset();
     /**
      * Returns the shape of the tensor, which includes the number of dimensions
      * and the size per dimension.
@@ -777,6 +859,15 @@ class Tensor
      * respective dimension is not active.
      */
     std::array<uint32_t, KP_MAX_DIM_SIZE> shape();
+    /**
+     * Sets the shape of the tensor without modifying its data, which is used
+     * by the operations that broadcast their inputs. Tensors are created with
+     * a single dimension of the size of their data.
+     *
+     * @param shape The size of each dimension, outermost first, whose product
+     * must match the size of the tensor
+     */
+    void reshape(const std::vector<uint32_t>& shape);
     /**
      * Retrieve the tensor type of the Tensor
      *
@@ -789,17 +880,112 @@ class Tensor
      * provisioned.
      */
     bool isInit();
+    /**
+     * Creates a view over a contiguous range of the elements of the tensor,
+     * which shares the vulkan buffer and memory of the tensor instead of
+     * allocating its own. Views can be bound to shaders and used as the source
+     * or destination of copies and syncs, which only transfer the range of the
+     * view. Views of views are created over the original tensor with the
+     * offsets combined, and the tensor must be owned by a shared pointer.
+     *
+     * The view does not hold host data of its own, so it reads and writes the
+     * respective range of the host data of the tensor, and changes made to
+     * the tensor data after the view is created are seen by the view. The view
+     * is initialised once
+     * the tensor is initialised, so views can be created before or after the
+     * tensor is created with OpTensorCreate, but not created on their own.
+     *
+     * @param offset Number of elements from the start of the tensor where the
+     * view starts
+     * @param size Number of elements in the view
+     * @return Shared pointer to the view
+     */
+    std::shared_ptr<Tensor> view(uint32_t offset, uint32_t size);
+    /**
+     * Returns true if the tensor is a view over the memory of another tensor.
+     *
+     * @return Boolean stating whether the tensor is a view
+     */
+    bool isView();
+    /**
+     * Retrieves the tensor that owns the memory of a view.
+     *
+     * @return The parent tensor of the view, or nullptr if the tensor is not a
+     * view
+     */
+    std::shared_ptr<Tensor> parent();
+    /**
+     * Retrieves the host memory wrapped by the tensor.
+     *
+     * @return Pointer to the host memory, or nullptr if the tensor holds a
+     * data vector instead
+     */
+    float* hostPointer();
+    /**
+     * Returns true if the host memory wrapped by the tensor has been imported
+     * as the memory of its buffer, or false if the tensor does not wrap host
+     * memory or fell back to copying it into host visible memory.
+     *
+     * @return Boolean stating whether the host memory is used by the GPU
+     */
+    bool isHostMemoryImported();
+    /**
+     * Returns true if the tensor is of type TensorTypes::eDevice and was
+     * allocated in device local memory that is also host visible, as found in
+     * integrated GPUs, CPU implementations and devices with resizable BAR.
+     * These tensors are mapped directly by the sync operations instead of
+     * copied through staging tensors.
+     *
+     * @return Boolean stating whether the tensor memory is host visible
+     */
+    bool isUnifiedMemory();
 
     /**
      * Sets / resets the vector data of the tensor. This function does not
      * perform any copies into GPU memory and is only performed on the host.
+     * For views the respective range of the parent data is also updated.
      */
     void setData(const std::vector<float>& data);
+    /**
+     * Sets the vector data of the tensor only in the ranges provided, from
+     * the elements in the same positions of the data provided. This function
+     * is only performed on the host.
+     *
+     * @param data Vector of data with the same size as the tensor
+     * @param ranges Ranges of elements to set
+     */
+    void setData(const std::vector<float>& data,
+                 const std::vector<Range>& ranges);
+
+    /**
+     * Marks a range of the host data as modified, so that the following
+     * OpTensorSyncDevice only transfers the modified ranges of the tensor
+     * instead of all of its data. Ranges marked are coalesced with the ranges
+     * already marked. When no range has been marked the whole tensor is
+     * considered modified, as changes made through data() cannot be tracked.
+     *
+     * @param offset Index of the first element modified
+     * @param size Number of elements modified
+     */
+    void markDirty(uint32_t offset, uint32_t size);
+    /**
+     * Retrieves the coalesced ranges marked as modified in the host data.
+     *
+     * @return Ranges of elements modified since they were last cleared
+     */
+    std::vector<Range> dirtyRanges();
+    /**
+     * Clears the ranges marked as modified, which is done by
+     * OpTensorSyncDevice when it is evaluated.
+     */
+    void clearDirtyRanges();
 
     /**
      * Records a copy from the memory of the tensor provided to the current
      * thensor. This is intended to pass memory into a processing, to perform
-     * a staging buffer transfer, or to gather output (between others).
+     * a staging buffer transfer, or to gather output (between others). Only
+     * the range of the current tensor is copied, so either tensor can be a
+     * view, and the tensor copied from must be at least as large.
      *
      * @param commandBuffer Vulkan Command Buffer to record the commands into
      * @param copyFromTensor Tensor to copy the data from
@@ -810,6 +996,50 @@ class Tensor
                         std::shared_ptr<Tensor> copyFromTensor,
                         bool createBarrier);
 
+    /**
+     * Records a copy of the ranges provided from the memory of the tensor
+     * provided to the current tensor, with one copy region per range at the
+     * same element offsets in both tensors.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the commands into
+     * @param copyFromTensor Tensor to copy the data from
+     * @param ranges Ranges of elements to copy
+     * @param createBarrier Whether to create a barrier that ensures the data is
+     * copied before further operations.
+     */
+    void recordCopyFrom(std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                        std::shared_ptr<Tensor> copyFromTensor,
+                        const std::vector<Range>& ranges,
+                        bool createBarrier);
+
+    /**
+     * Records a copy of the regions provided from an external buffer into the
+     * memory of the current tensor, where the destination offsets of the
+     * regions are relative to the start of the tensor (or of the view range).
+     * This is used to
+     * transfer data in chunks from staging buffers not owned by a tensor.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the commands into
+     * @param buffer Vulkan buffer to copy the data from
+     * @param copyRegions Regions to copy with offsets in bytes
+     */
+    void recordCopyFromBuffer(std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                              const vk::Buffer& buffer,
+                              const std::vector<vk::BufferCopy>& copyRegions);
+
+    /**
+     * Records a copy of the regions provided from the memory of the current
+     * tensor into an external buffer, where the source offsets of the regions
+     * are relative to the start of the tensor (or of the view range).
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the commands into
+     * @param buffer Vulkan buffer to copy the data into
+     * @param copyRegions Regions to copy with offsets in bytes
+     */
+    void recordCopyToBuffer(std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                            const vk::Buffer& buffer,
+                            const std::vector<vk::BufferCopy>& copyRegions);
+
     /**
      * Records the buffer memory barrier into the command buffer which
      * ensures that relevant data transfers are carried out correctly.
@@ -830,21 +1060,39 @@ class Tensor
     /**
      * Constructs a vulkan descriptor buffer info which can be used to specify
      * and reference the underlying buffer component of the tensor without
-     * exposing it.
+     * exposing it. Views are bound with their offset and range in the buffer
+     * of the parent, which must be aligned to the minimum storage buffer
+     * offset alignment of the device.
      *
      * @return Descriptor buffer info with own buffer
      */
     vk::DescriptorBufferInfo constructDescriptorBufferInfo();
     /**
      * Maps data from the Host Visible GPU memory into the data vector. It
-     * requires the Tensor to be of staging type for it to work.
+     * requires the Tensor to be of staging type, or a device tensor in unified
+     * memory, for it to work.
      */
     void mapDataFromHostMemory();
+    /**
+     * Maps the ranges provided from the Host Visible GPU memory into the data
+     * vector. It requires the Tensor to be of staging type for it to work.
+     *
+     * @param ranges Ranges of elements to map
+     */
+    void mapDataFromHostMemory(const std::vector<Range>& ranges);
     /**
      * Maps data from the data vector into the Host Visible GPU memory. It
-     * requires the tensor to be of staging type for it to work.
+     * requires the tensor to be of staging type, or a device tensor in unified
+     * memory, for it to work.
      */
     void mapDataIntoHostMemory();
+    /**
+     * Maps the ranges provided from the data vector into the Host Visible GPU
+     * memory. It requires the tensor to be of staging type for it to work.
+     *
+     * @param ranges Ranges of elements to map
+     */
+    void mapDataIntoHostMemory(const std::vector<Range>& ranges);
 
   private:
     // -------------- NEVER OWNED RESOURCES
@@ -860,909 +1108,4774 @@ class Tensor
     // -------------- ALWAYS OWNED RESOURCES
     std::vector<float> mData;
 
+    std::shared_ptr<Tensor> mParent;
+    uint32_t mOffset = 0;
+    std::vector<Range> mDirtyRanges;
+    float* mHostPointer = nullptr;
+    bool mIsHostMemoryImported = false;
+    bool mIsExternalMemoryHostEnabled = false;
+    bool mIsUnifiedMemory = false;
+
     TensorTypes mTensorType = TensorTypes::eDevice;
 
-    std::array<uint32_t, KP_MAX_DIM_SIZE> mShape;
+    std::array<uint32_t, KP_MAX_DIM_SIZE> mShape = {};
     bool mIsInit = false;
 
     void createBuffer(); // Creates the vulkan buffer
+    bool createHostPointerBuffer(); // Imports the host memory as buffer memory
 
     // Private util functions
+    std::shared_ptr<vk::Buffer> getBuffer();
+    std::shared_ptr<vk::DeviceMemory> getMemory();
+    std::shared_ptr<vk::Device> getDevice();
+    void validateRanges(const std::vector<Range>& ranges);
+    uint32_t findUnifiedMemoryTypeIndex(
+      const vk::PhysicalDeviceMemoryProperties& memoryProperties,
+      uint32_t memoryTypeBits);
     vk::BufferUsageFlags getBufferUsageFlags();
     vk::MemoryPropertyFlags getMemoryPropertyFlags();
-    uint64_t memorySize();
 };
 
 } // End namespace kp
 
+#define KP_DEFAULT_DESCRIPTOR_SETS_PER_POOL 64
+#define KP_DEFAULT_DESCRIPTORS_PER_SET 4
+
 namespace kp {
 
 /**
- *  Base Operation which provides the high level interface that Kompute
- *  operations implement in order to perform a set of actions in the GPU.
+ * Growable arena of descriptor pools which is owned by the Manager and shared
+ * across all the algorithms created in its sequences. The arena also caches
+ * the descriptor set layouts by number of bindings and the descriptor sets
+ * already written for a given tuple of tensor bindings, so re-recording the
+ * same operation on the same tensors does not allocate or write descriptors.
+ * When the device supports VK_KHR_push_descriptor the arena can also provide
+ * push descriptor set layouts, in which case algorithms push their bindings
+ * into the command buffer and no descriptor sets are allocated at all.
  *
- *  Operations can perform actions on tensors, and optionally can also own an
- *  Algorithm with respective parameters. kp::Operations with kp::Algorithms
- *  would inherit from kp::OpBaseAlgo.
+ * Sets whose tensors have been destroyed are retired rather than freed, as
+ * command buffers already submitted may still reference them. The sequences
+ * register their submissions with beginSubmission and endSubmission, and a
+ * retired set is only freed once every submission that was in flight when it
+ * was retired has completed. The fences of the submissions are also polled
+ * when freeing, so submissions that are never awaited do not keep the sets
+ * from being freed.
  */
-class OpBase
+class DescriptorPoolArena
 {
   public:
     /**
      *  Base constructor, should not be used unless explicitly intended.
      */
-    OpBase() { SPDLOG_DEBUG("Compute OpBase base constructor"); }
+    DescriptorPoolArena();
 
     /**
-     * Default constructor with parameters that provides the bare minimum
-     * requirements for the operations to be able to create and manage their
-     * sub-components.
+     * Default constructor with the device that will be used to create the
+     * descriptor pools, layouts and sets.
      *
-     * @param physicalDevice Vulkan physical device used to find device queues
-     * @param device Vulkan logical device for passing to Algorithm
-     * @param commandBuffer Vulkan Command Buffer to record commands into
-     * @param tensors Tensors that are to be used in this operation
-     * @param freeTensors Whether operation manages the memory of the Tensors
+     * @param device Vulkan logical device to create the resources with
+     * @param setsPerPool Number of descriptor sets allocated per pool, which
+     * is the size by which the arena grows when a pool is exhausted
      */
-    OpBase(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
-           std::shared_ptr<vk::Device> device,
-           std::shared_ptr<vk::CommandBuffer> commandBuffer,
-           std::vector<std::shared_ptr<Tensor>>& tensors,
-           bool freeTensors)
-    {
-        SPDLOG_DEBUG("Compute OpBase constructor with params");
+    DescriptorPoolArena(
+      std::shared_ptr<vk::Device> device,
+      uint32_t setsPerPool = KP_DEFAULT_DESCRIPTOR_SETS_PER_POOL);
 
-        this->mPhysicalDevice = physicalDevice;
-        this->mDevice = device;
-        this->mCommandBuffer = commandBuffer;
-        this->mTensors = tensors;
-        this->mFreeTensors = freeTensors;
-    }
+    /**
+     * Destructor which destroys all the descriptor pools, and hence the
+     * descriptor sets allocated from them, as well as the set layouts.
+     */
+    ~DescriptorPoolArena();
 
     /**
-     * Default destructor for OpBase class. This OpBase destructor class should
-     * always be called to destroy and free owned resources unless it is
-     * intended to destroy the resources in the parent class. This can be done
-     * by passing the mFreeTensors=false.
+     * Retrieves the descriptor set layout with the number of storage buffer
+     * bindings provided, or creates it if it doesn't exist. Layouts with the
+     * same bindings are identically defined and hence compatible with all the
+     * pipelines created for the same number of tensors.
+     *
+     * @param numBindings The number of storage buffer bindings of the layout
+     * @return Shared pointer to the arena owned descriptor set layout
      */
-    virtual ~OpBase()
-    {
-        SPDLOG_DEBUG("Kompute OpBase destructor started");
+    std::shared_ptr<vk::DescriptorSetLayout> getOrCreateDescriptorSetLayout(
+      uint32_t numBindings);
 
-        if (!this->mDevice) {
-            SPDLOG_WARN("Kompute OpBase destructor called with empty device");
-            return;
-        }
+    /**
+     * Retrieves the descriptor set already written with the tensors provided
+     * as bindings in the same order, or allocates and writes a new descriptor
+     * set with a single batched update if none exists.
+     *
+     * @param tensors The tensors to bind in the order of their binding index
+     * @return Descriptor set owned by the arena with the tensors bound
+     */
+    vk::DescriptorSet getOrCreateDescriptorSet(
+      const std::vector<std::shared_ptr<Tensor>>& tensors);
 
-        if (this->mFreeTensors) {
-            SPDLOG_DEBUG("Kompute OpBase freeing tensors");
-            for (std::shared_ptr<Tensor> tensor : this->mTensors) {
-                if (tensor && tensor->isInit()) {
-                    tensor->freeMemoryDestroyGPUResources();
-                } else {
-                    SPDLOG_ERROR("Kompute OpBase expected to free "
-                                  "tensor but has already been freed.");
-                }
-            }
-        }
-    }
+    /**
+     * Enables the push descriptor fast path, which should only be called if
+     * the VK_KHR_push_descriptor extension has been enabled in the device.
+     *
+     * @param dispatcher Dynamic dispatcher initialised with the device to
+     * load the vkCmdPushDescriptorSetKHR function
+     */
+    void enablePushDescriptors(
+      std::shared_ptr<vk::DispatchLoaderDynamic> dispatcher);
 
     /**
-     * The init function is responsible for setting up all the resources and
-     * should be called after the Operation has been created.
+     * Whether algorithms should push their descriptors into the command
+     * buffer instead of binding descriptor sets allocated from the arena.
+     *
+     * @return Boolean stating whether push descriptors are enabled
      */
-    virtual void init() = 0;
+    bool isPushDescriptorsEnabled();
 
     /**
-     * The record function is intended to only send a record command or run
-     * commands that are expected to record operations that are to be submitted
-     * as a batch into the GPU.
+     * Returns the dispatcher used to record the push descriptor commands.
+     *
+     * @return Shared pointer to the dispatcher, or null if push descriptors
+     * are not enabled
      */
-    virtual void record() = 0;
+    std::shared_ptr<vk::DispatchLoaderDynamic> pushDescriptorDispatcher();
 
     /**
-     * Pre eval is called before the Sequence has called eval and submitted the commands to
-     * the GPU for processing, and can be used to perform any per-eval setup steps
-     * required as the computation iteration begins. It's worth noting that 
-     * there are situations where eval can be called multiple times, so the 
-     * resources that are created should be idempotent in case it's called multiple
-     * times in a row.
+     * Retrieves the push descriptor set layout with the number of storage
+     * buffer bindings provided, or creates it if it doesn't exist.
+     *
+     * @param numBindings The number of storage buffer bindings of the layout
+     * @return Shared pointer to the arena owned descriptor set layout
      */
-    virtual void preEval() = 0;
+    std::shared_ptr<vk::DescriptorSetLayout>
+    getOrCreatePushDescriptorSetLayout(uint32_t numBindings);
 
     /**
-     * Post eval is called after the Sequence has called eval and submitted the commands to
-     * the GPU for processing, and can be used to perform any tear-down steps
-     * required as the computation iteration finishes. It's worth noting that 
-     * there are situations where eval can be called multiple times, so the 
-     * resources that are destroyed should not require a re-init unless explicitly
-     * provided by the user.
+     * Registers a submission of a command buffer that may reference the
+     * descriptor sets of the arena, which has to be called before the
+     * command buffer is submitted.
+     *
+     * @param fence (Optional) Fence the submission signals, which is polled
+     * to find completed submissions until endSubmission is called, and has
+     * to stay valid until then. Submissions without a fence are in flight
+     * until endSubmission is called.
+     * @return Identifier of the submission to pass to endSubmission
      */
-    virtual void postEval() = 0;
+    uint64_t beginSubmission(vk::Fence fence = nullptr);
+
+    /**
+     * Marks the submission provided as completed once its fence has
+     * signalled, which has to be called before the fence is destroyed, and
+     * frees the retired descriptor sets that are no longer
+     * referenced by any submission in flight.
+     *
+     * @param submission Identifier returned by beginSubmission
+     */
+    void endSubmission(uint64_t submission);
+
+    /**
+     * Returns the number of descriptor pools currently allocated.
+     *
+     * @return Number of descriptor pools in the arena
+     */
+    size_t numDescriptorPools();
+
+    /**
+     * Returns the number of descriptor sets currently cached.
+     *
+     * @return Number of descriptor sets in the arena
+     */
+    size_t numDescriptorSets();
+
+    /**
+     * Returns the number of retired descriptor sets waiting for the
+     * submissions in flight to complete before they are freed.
+     *
+     * @return Number of retired descriptor sets in the arena
+     */
+    size_t numRetiredDescriptorSets();
+
+    /**
+     * Destroys the descriptor pools and descriptor set layouts owned by the
+     * arena.
+     */
+    void freeMemoryDestroyGPUResources();
+
+  private:
+    typedef std::vector<std::tuple<vk::Buffer, vk::DeviceSize, vk::DeviceSize>>
+      DescriptorSetKey;
+
+    struct DescriptorSetEntry
+    {
+        vk::DescriptorSet descriptorSet;
+        vk::DescriptorPool descriptorPool;
+        std::vector<std::weak_ptr<Tensor>> tensors;
+        uint64_t retiredAfterSubmission = 0; ///< Last submission begun when the set was retired
+    };
 
-  protected:
     // -------------- NEVER OWNED RESOURCES
-    std::shared_ptr<vk::PhysicalDevice>
-      mPhysicalDevice;                   ///< Vulkan Physical Device
-    std::shared_ptr<vk::Device> mDevice; ///< Vulkan Logical Device
-    std::shared_ptr<vk::CommandBuffer>
-      mCommandBuffer; ///< Vulkan Command Buffer
+    std::shared_ptr<vk::Device> mDevice;
 
     // -------------- OPTIONALLY OWNED RESOURCES
-    std::vector<std::shared_ptr<Tensor>>
-      mTensors; ///< Tensors referenced by operation that can be managed
-                ///< optionally by operation
-    bool mFreeTensors = false; ///< Explicit boolean that specifies whether the
-                               ///< tensors are freed (if they are managed)
+    std::shared_ptr<vk::DispatchLoaderDynamic> mPushDescriptorDispatcher;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    uint32_t mSetsPerPool = KP_DEFAULT_DESCRIPTOR_SETS_PER_POOL;
+    std::mutex mMutex;
+    std::vector<std::shared_ptr<vk::DescriptorPool>> mDescriptorPools;
+    std::unordered_map<uint32_t, std::shared_ptr<vk::DescriptorSetLayout>>
+      mDescriptorSetLayouts;
+    std::unordered_map<uint32_t, std::shared_ptr<vk::DescriptorSetLayout>>
+      mPushDescriptorSetLayouts;
+    std::map<DescriptorSetKey, DescriptorSetEntry> mDescriptorSets;
+    std::vector<DescriptorSetEntry> mRetiredDescriptorSets;
+    uint64_t mLastSubmission = 0;
+    std::map<uint64_t, vk::Fence> mSubmissionsInFlight;
+
+    // Create util functions
+    void createDescriptorPool(uint32_t numBindings);
+    vk::DescriptorSet allocateDescriptorSet(
+      std::shared_ptr<vk::DescriptorSetLayout> descriptorSetLayout,
+      uint32_t numBindings,
+      vk::DescriptorPool& descriptorPool);
+    std::shared_ptr<vk::DescriptorSetLayout> findOrCreateDescriptorSetLayout(
+      uint32_t numBindings,
+      bool isPushDescriptor = false);
+    void retireDescriptorSet(DescriptorSetEntry descriptorSetEntry);
+    void retireExpiredDescriptorSets();
+    void freeRetiredDescriptorSets();
 };
 
 } // End namespace kp
 
+#include <functional>
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+
 namespace kp {
 
 /**
- *  Container of operations that can be sent to GPU as batch
+ * State shared between the kp::EvalFuture handles of an asynchronous
+ * evaluation and the kp::CompletionThread that completes it, which holds the
+ * result of the evaluation and the continuations to run once it is ready.
  */
-class Sequence
+class EvalFutureState
 {
   public:
     /**
-     *  Base constructor for Sequence. Should not be used unless explicit
-     * intended.
-     */
-    Sequence();
-    /**
-     * Main constructor for sequence which requires core vulkan components to
-     * generate all dependent resources.
+     * Completes the state with the result of the evaluation, wakes up the
+     * waiting threads and runs the continuations in the calling thread.
      *
-     * @param physicalDevice Vulkan physical device
-     * @param device Vulkan logical device
-     * @param computeQueue Vulkan compute queue
-     * @param queueIndex Vulkan compute queue index in device
-     */
-    Sequence(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
-             std::shared_ptr<vk::Device> device,
-             std::shared_ptr<vk::Queue> computeQueue,
-             uint32_t queueIndex);
-    /**
-     * Destructor for sequence which is responsible for cleaning all subsequent
-     * owned operations.
+     * @param result Boolean stating whether the evaluation was successful
      */
-    ~Sequence();
+    void setResult(bool result);
 
     /**
-     * Initialises sequence including the creation of the command pool and the
-     * command buffer.
+     * Completes the state with an exception raised by the evaluation, which
+     * is rethrown by get, and runs the continuations in the calling thread.
+     *
+     * @param exception The exception raised by the evaluation
      */
-    void init();
+    void setException(std::exception_ptr exception);
 
     /**
-     * Begins recording commands for commands to be submitted into the command
-     * buffer.
+     * Adds a continuation to run once the state is completed, or runs it
+     * straight away in the calling thread if it already is.
      *
-     * @return Boolean stating whether execution was successful.
+     * @param continuation Function to run once the state is completed
      */
-    bool begin();
+    void addContinuation(std::function<void()> continuation);
 
     /**
-     * Ends the recording and stops recording commands when the record command
-     * is sent.
+     * Returns true if the state has been completed.
      *
-     * @return Boolean stating whether execution was successful.
+     * @return Boolean stating whether the state is completed
      */
-    bool end();
+    bool isReady();
 
     /**
-     * Eval sends all the recorded and stored operations in the vector of
-     * operations into the gpu as a submit job with a barrier.
+     * Waits until the state is completed or the timeout expires.
      *
-     * @return Boolean stating whether execution was successful.
+     * @param waitFor Number of nanoseconds to wait before timing out
+     * @return Boolean stating whether the state is completed
      */
-    bool eval();
+    bool wait(uint64_t waitFor);
 
     /**
-     * Eval Async sends all the recorded and stored operations in the vector of
-     * operations into the gpu as a submit job with a barrier. EvalAwait() must
-     * be called after to ensure the sequence is terminated correctly.
+     * Waits until the state is completed and returns its result.
      *
-     * @return Boolean stating whether execution was successful.
+     * @return Boolean stating whether the evaluation was successful
      */
-    bool evalAsync();
+    bool get();
+
+  private:
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mIsReady = false;
+    bool mResult = false;
+    std::exception_ptr mException;
+    std::vector<std::function<void()>> mContinuations;
+
+    void complete();
+};
 
+/**
+ * Lightweight handle to an asynchronous evaluation returned by the
+ * kp::Manager evalOpAsync functions. The evaluation is awaited by the
+ * completion thread of the manager, so the handle can be polled, waited with
+ * a timeout or chained with continuations without the caller having to await
+ * the sequence. Handles are cheap to copy and all copies refer to the same
+ * evaluation.
+ */
+class EvalFuture
+{
+  public:
     /**
-     * Eval Await waits for the fence to finish processing and then once it
-     * finishes, it runs the postEval of all operations.
-     *
-     * @param waitFor Number of milliseconds to wait before timing out.
-     * @return Boolean stating whether execution was successful.
+     * Base constructor which creates an invalid handle not referring to any
+     * evaluation.
      */
-    bool evalAwait(uint64_t waitFor = UINT64_MAX);
+    EvalFuture();
 
     /**
-     * Returns true if the sequence is currently in recording activated.
+     * Constructor with the shared state of the evaluation.
      *
-     * @return Boolean stating if recording ongoing.
+     * @param state The state completed by the completion thread
      */
-    bool isRecording();
+    EvalFuture(std::shared_ptr<EvalFutureState> state);
 
     /**
-     * Returns true if the sequence is currently running - mostly used for async
-     * workloads.
+     * Returns true if the handle refers to an evaluation.
      *
-     * @return Boolean stating if currently running.
+     * @return Boolean stating whether the handle is valid
      */
-    bool isRunning();
+    bool valid();
 
     /**
-     * Returns true if the sequence has been successfully initialised.
+     * Returns true without blocking if the evaluation has finished and the
+     * postEval of its operations has run.
      *
-     * @return Boolean stating if sequence has been initialised.
+     * @return Boolean stating whether the evaluation has finished
      */
-    bool isInit();
+    bool ready();
 
     /**
-     * Destroys and frees the GPU resources which include the buffer and memory
-     * and sets the sequence as init=False.
+     * Waits until the evaluation has finished or the timeout expires.
+     *
+     * @param waitFor Number of nanoseconds to wait before timing out
+     * @return Boolean stating whether the evaluation has finished
      */
-    void freeMemoryDestroyGPUResources();
+    bool wait(uint64_t waitFor = UINT64_MAX);
 
     /**
-     * Record function for operation to be added to the GPU queue in batch. This
-     * template requires classes to be derived from the OpBase class. This
-     * function also requires the Sequence to be recording, otherwise it will
-     * not be able to add the operation.
+     * Waits until the evaluation has finished and returns whether it was
+     * successful, rethrowing any exception raised by the evaluation.
      *
-     * @param tensors Vector of tensors to use for the operation
-     * @param TArgs Template parameters that are used to initialise operation
-     * which allows for extensible configurations on initialisation.
+     * @return Boolean stating whether the evaluation was successful
      */
-    template<typename T, typename... TArgs>
-    bool record(std::vector<std::shared_ptr<Tensor>> tensors, TArgs&&... params)
-    {
-        static_assert(std::is_base_of<OpBase, T>::value,
-                      "Kompute Sequence record(...) template only valid with "
-                      "OpBase derived classes");
-
-        SPDLOG_DEBUG("Kompute Sequence record function started");
+    bool get();
 
-        if (!this->isRecording()) {
-            SPDLOG_ERROR(
-              "Kompute sequence record attempted when not record BEGIN");
-            return false;
-        }
+    /**
+     * Chains a continuation that is called with this handle once the
+     * evaluation has finished. The continuation runs in the completion thread
+     * of the manager, or in the calling thread if the evaluation has already
+     * finished, so it should be short and must not wait on other futures.
+     *
+     * @param continuation Function called with the finished handle
+     * @return Handle that is ready once the continuation has run, which
+     * rethrows any exception raised by the continuation
+     */
+    EvalFuture then(std::function<void(EvalFuture)> continuation);
 
-        SPDLOG_DEBUG("Kompute Sequence creating OpBase derived class instance");
-        T* op = new T(this->mPhysicalDevice,
-                      this->mDevice,
-                      this->mCommandBuffer,
-                      tensors,
-                      std::forward<TArgs>(params)...);
+  private:
+    std::shared_ptr<EvalFutureState> mState;
+};
 
-        OpBase* baseOp = dynamic_cast<OpBase*>(op);
+} // End namespace kp
 
-        std::unique_ptr<OpBase> baseOpPtr{ baseOp };
+#if KOMPUTE_ENABLE_COROUTINES
 
-        SPDLOG_DEBUG(
-          "Kompute Sequence running init on OpBase derived class instance");
-        baseOpPtr->init();
+#include <coroutine>
 
-        SPDLOG_DEBUG(
-          "Kompute Sequence running record on OpBase derived class instance");
-        baseOpPtr->record();
+namespace kp {
 
-        mOperations.push_back(std::move(baseOpPtr));
+class Sequence;
+class CompletionThread;
 
-        return true;
-    }
+/**
+ * Executor used to resume the coroutines awaiting a sequence, which receives
+ * the function that resumes the coroutine and is expected to run it, for
+ * example by posting it into the event loop of the application.
+ */
+typedef std::function<void(std::function<void()>)> CoroExecutor;
 
-  private:
-    // -------------- NEVER OWNED RESOURCES
-    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice = nullptr;
-    std::shared_ptr<vk::Device> mDevice = nullptr;
-    std::shared_ptr<vk::Queue> mComputeQueue = nullptr;
-    uint32_t mQueueIndex = -1;
+/**
+ * C++20 awaitable returned by kp::Sequence::evalCoro, which submits the
+ * recorded sequence when awaited and suspends the awaiting coroutine until
+ * the completion thread of the manager has awaited the sequence. A single
+ * completion thread serves all the sequences of the manager, so any number of
+ * coroutines can be suspended on in flight GPU work without a thread each.
+ *
+ * This is only available when Kompute is built with
+ * KOMPUTE_OPT_ENABLE_COROUTINES, which compiles the library as C++20.
+ */
+class SequenceAwaitable
+{
+  public:
+    /**
+     * Constructor with the sequence to submit and the completion thread that
+     * will await it.
+     *
+     * @param sequence The recorded sequence to evaluate
+     * @param completionThread The completion thread that awaits the sequence
+     * @param executor (Optional) Executor to resume the coroutine with, which
+     * otherwise is resumed in the completion thread
+     */
+    SequenceAwaitable(std::shared_ptr<Sequence> sequence,
+                      std::shared_ptr<CompletionThread> completionThread,
+                      CoroExecutor executor = nullptr);
 
-    // -------------- OPTIONALLY OWNED RESOURCES
-    std::shared_ptr<vk::CommandPool> mCommandPool = nullptr;
-    bool mFreeCommandPool = false;
-    std::shared_ptr<vk::CommandBuffer> mCommandBuffer = nullptr;
-    bool mFreeCommandBuffer = false;
+    /**
+     * The sequence is always submitted when awaited, so the coroutine is
+     * never resumed straight away.
+     *
+     * @return Always false
+     */
+    bool await_ready() noexcept;
 
-    // -------------- ALWAYS OWNED RESOURCES
-    vk::Fence mFence;
-    std::vector<std::unique_ptr<OpBase>> mOperations;
+    /**
+     * Submits the sequence and schedules the resumption of the coroutine once
+     * the completion thread has awaited it.
+     *
+     * @param handle Handle of the awaiting coroutine
+     * @return False if the sequence could not be submitted, in which case the
+     * coroutine continues without suspending
+     */
+    bool await_suspend(std::coroutine_handle<> handle);
 
-    // State
-    bool mIsInit = false;
-    bool mRecording = false;
-    bool mIsRunning = false;
+    /**
+     * Returns the result of the evaluation once the coroutine is resumed,
+     * rethrowing any exception raised by the postEval of the operations.
+     *
+     * @return Boolean stating whether the evaluation was successful
+     */
+    bool await_resume();
 
-    // Create functions
-    void createCommandPool();
-    void createCommandBuffer();
+  private:
+    std::shared_ptr<Sequence> mSequence;
+    std::shared_ptr<CompletionThread> mCompletionThread;
+    CoroExecutor mExecutor;
+    EvalFuture mFuture;
 };
 
 } // End namespace kp
 
+#endif // KOMPUTE_ENABLE_COROUTINES
+
+#include <mutex>
+#include <unordered_map>
+
 namespace kp {
 
 /**
-    Operation that creates tensor and manages the memory of the components
-   created
-*/
-class OpTensorCreate : public OpBase
+ * Cache of Vulkan shader modules which is owned by the Manager and shared
+ * across all the operations that are recorded in its sequences. Shaders
+ * loaded from files are memory mapped and created only once per path, and are
+ * replaced when the file is modified, and shaders provided as data are
+ * created only once per unique content, identified by a hash of the content,
+ * which avoids reading and compiling the same shader every time an operation
+ * is recorded.
+ */
+class ShaderCache
 {
   public:
-    OpTensorCreate();
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    ShaderCache();
 
     /**
-     * Default constructor with parameters that provides the bare minimum
-     * requirements for the operations to be able to create and manage their
-     * sub-components.
+     * Default constructor with the device that will be used to create the
+     * shader modules.
      *
-     * @param physicalDevice Vulkan physical device used to find device queues
-     * @param device Vulkan logical device for passing to Algorithm
-     * @param commandBuffer Vulkan Command Buffer to record commands into
-     * @param tensors Tensors that will be used to create in operation.
-     * @param freeTensors Whether operation manages the memory of the Tensors
+     * @param device Vulkan logical device to create the shader modules with
      */
-    OpTensorCreate(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
-                   std::shared_ptr<vk::Device> device,
-                   std::shared_ptr<vk::CommandBuffer> commandBuffer,
-                   std::vector<std::shared_ptr<Tensor>> tensors);
+    ShaderCache(std::shared_ptr<vk::Device> device);
 
     /**
-     * Default destructor which in this case expects the parent class to free
-     * the tensors
+     * Destructor which destroys all the shader modules owned by the cache.
      */
-    ~OpTensorCreate() override;
+    ~ShaderCache();
 
     /**
-     * In charge of initialising the primary Tensor as well as the staging
-     * tensor as required. It will only initialise a staging tensor if the
-     * Primary tensor is of type Device. For staging tensors it performs a 
-     * mapDataIntoHostMemory which would perform immediately as opposed to 
-     * on sequence eval/submission.
+     * Retrieves the shader module for the file provided, or creates it by
+     * memory mapping the file if it has not been loaded before or if the file
+     * has been modified since it was last loaded, in which case the shader
+     * module of the previous version is destroyed.
+     *
+     * @param shaderFilePath Path to the shader in either spirv or raw format
+     * @return Shared pointer to the cache owned shader module
      */
-    void init() override;
+    std::shared_ptr<vk::ShaderModule> getOrCreateFromFile(
+      const std::string& shaderFilePath);
 
     /**
-     * Record runs the core actions to create the tensors. For device tensors
-     * it records a copyCommand to move the data from the staging tensor to the 
-     * device tensor. The mapping for staging tensors happens in the init function
-     * not in the record function.
+     * Retrieves the shader module for the shader data provided, or creates it
+     * if no shader module with the same content has been created before.
+     *
+     * @param shaderFileData The bytes of the shader in spirv or raw format
+     * @return Shared pointer to the cache owned shader module
      */
-    void record() override;
+    std::shared_ptr<vk::ShaderModule> getOrCreateFromData(
+      const std::vector<char>& shaderFileData);
 
     /**
-     * Does not perform any preEval commands.
+     * Returns the number of shader modules currently owned by the cache.
+     *
+     * @return Number of shader modules in the cache
      */
-    virtual void preEval() override;
+    size_t size();
 
     /**
-     * Performs a copy back into the main tensor to ensure that the data
-     * contained is the one that is now being stored in the GPU.
+     * Destroys all the shader modules owned by the cache. Shader modules are
+     * only required during pipeline creation so existing algorithms are not
+     * affected.
      */
-    virtual void postEval() override;
+    void freeMemoryDestroyGPUResources();
 
   private:
-    // Never owned resources
-    std::vector<std::shared_ptr<Tensor>> mStagingTensors;
+    struct FileShaderEntry
+    {
+        std::shared_ptr<vk::ShaderModule> shaderModule;
+        time_t modificationTime = 0;
+        size_t size = 0;
+    };
+
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::Device> mDevice;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::mutex mMutex;
+    std::unordered_map<std::string, FileShaderEntry> mFileShaderModules;
+    std::unordered_map<uint64_t, std::shared_ptr<vk::ShaderModule>>
+      mDataShaderModules;
+
+    // Create util functions
+    std::shared_ptr<vk::ShaderModule> createShaderModule(const char* data,
+                                                         size_t size);
+    static uint64_t hashShaderData(const std::vector<char>& shaderFileData);
 };
 
 } // End namespace kp
 
-#define KP_DEFAULT_SESSION "DEFAULT"
+#include <fstream>
 
 namespace kp {
 
 /**
-    Base orchestrator which creates and manages device and child components
+    Abstraction for compute shaders that are run on top of tensors grouped via
+   ParameterGroups (which group descriptorsets)
 */
-class Manager
+class Algorithm
 {
   public:
     /**
-        Base constructor and default used which creates the base resources
-       including choosing the device 0 by default.
+        Base constructor for Algorithm. Should not be used unless explicit
+       intended.
     */
-    Manager();
+    Algorithm();
 
     /**
-     * Similar to base constructor but allows the user to provide the device
-     * they would like to create the resources on.
+     *  Default constructor for Algorithm
      *
-     * @param physicalDeviceIndex The index of the physical device to use
-     * @param familyQueueIndices (Optional) List of queue indices to add for
-     * explicit allocation
-     * @param totalQueues The total number of compute queues to create.
+     *  @param device The Vulkan device to use for creating resources
+     *  @param commandBuffer The vulkan command buffer to bind the pipeline and
+     * shaders
      */
-    Manager(uint32_t physicalDeviceIndex,
-            const std::vector<uint32_t>& familyQueueIndices = {});
+    Algorithm(std::shared_ptr<vk::Device> device,
+              std::shared_ptr<vk::CommandBuffer> commandBuffer);
 
     /**
-     * Manager constructor which allows your own vulkan application to integrate
-     * with the vulkan kompute use.
+     * Sets the descriptor pool arena that will be used to retrieve the
+     * descriptor set layout and the descriptor set for the tensor parameters
+     * instead of creating a descriptor pool for this algorithm only. It must
+     * be set before the init function is called.
      *
-     * @param instance Vulkan compute instance to base this application
-     * @param physicalDevice Vulkan physical device to use for application
-     * @param device Vulkan logical device to use for all base resources
-     * @param physicalDeviceIndex Index for vulkan physical device used
+     * @param descriptorPoolArena The arena to allocate descriptor sets from
      */
-    Manager(std::shared_ptr<vk::Instance> instance,
-            std::shared_ptr<vk::PhysicalDevice> physicalDevice,
-            std::shared_ptr<vk::Device> device,
-            uint32_t physicalDeviceIndex);
+    void setDescriptorPoolArena(
+      std::shared_ptr<DescriptorPoolArena> descriptorPoolArena);
 
     /**
-     * Manager destructor which would ensure all owned resources are destroyed
-     * unless explicitly stated that resources should not be destroyed or freed.
+     * Initialiser for the shader data provided to the algorithm as well as
+     * tensor parameters that will be used in shader.
+     *
+     * @param shaderFileData The bytes in spir-v format of the shader
+     * @tensorParams The Tensors to be used in the Algorithm / shader for
+     * processing
+     * @param specializationConstants Additional specialization constants
+     * whose constant ids follow the ones of the sizes of the tensors
      */
-    ~Manager();
+    void init(const std::vector<char>& shaderFileData,
+              std::vector<std::shared_ptr<Tensor>> tensorParams,
+              const std::vector<uint32_t>& specializationConstants = {});
 
     /**
-     * Get or create a managed Sequence that will be contained by this manager.
-     * If the named sequence does not currently exist, it would be created and
-     * initialised.
+     * Initialiser for an existing shader module, such as the ones provided by
+     * the kp::ShaderCache, as well as tensor parameters that will be used in
+     * shader. The shader module is not owned by the Algorithm and hence it
+     * won't be destroyed together with the Algorithm.
      *
-     * @param sequenceName The name for the named sequence to be retrieved or
-     * created
-     * @return Shared pointer to the manager owned sequence resource
+     * @param shaderModule The shader module to create the pipeline with
+     * @tensorParams The Tensors to be used in the Algorithm / shader for
+     * processing
+     * @param specializationConstants Additional specialization constants
+     * whose constant ids follow the ones of the sizes of the tensors
      */
-    std::shared_ptr<Sequence> getOrCreateManagedSequence(
-      std::string sequenceName);
+    void init(std::shared_ptr<vk::ShaderModule> shaderModule,
+              std::vector<std::shared_ptr<Tensor>> tensorParams,
+              const std::vector<uint32_t>& specializationConstants = {});
 
     /**
-     * Create a new managed Kompute sequence so it's available within the
-     * manager.
+     * Destructor for Algorithm which is responsible for freeing and desroying
+     * respective pipelines and owned parameter groups.
+     */
+    ~Algorithm();
+
+    /**
+     * Records the dispatch function with the provided template parameters or
+     * alternatively using the size of the tensor by default. If the
+     * descriptor pool arena has push descriptors enabled the tensor bindings
+     * are pushed into the command buffer, otherwise the descriptor set
+     * written during init is bound.
      *
-     * @param sequenceName The name for the named sequence to be created, if
-     * empty then default indexed value is used
-     * @param queueIndex The queue to use from the available queues
-     * @return Weak pointer to the manager owned sequence resource
+     * @param x Layout X dispatch value
+     * @param y Layout Y dispatch value
+     * @param z Layout Z dispatch value
      */
-    std::shared_ptr<Sequence> createManagedSequence(
-      std::string sequenceName = "",
-      uint32_t queueIndex = 0);
+    void recordDispatch(uint32_t x = 1, uint32_t y = 1, uint32_t z = 1);
 
     /**
-     * Function that evaluates operation against named sequence.
+     * Records the dispatch function with a different set of tensors bound
+     * than the ones provided on init, which is used to alternate bindings
+     * such as in double buffered iterations without re-creating the pipeline.
+     * The tensors must match the number and sizes of the init tensors, and
+     * require push descriptors or a descriptor pool arena to be available.
      *
-     * @param tensors The tensors to be used in the operation recorded
-     * @param sequenceName The name of the sequence to be retrieved or created
-     * @param TArgs Template parameters that will be used to initialise
-     * Operation to allow for extensible configurations on initialisation
+     * @param tensors The tensors to bind in the order of their binding index
+     * @param x Layout X dispatch value
+     * @param y Layout Y dispatch value
+     * @param z Layout Z dispatch value
      */
-    template<typename T, typename... TArgs>
-    void evalOp(std::vector<std::shared_ptr<Tensor>> tensors,
-                std::string sequenceName,
-                TArgs&&... params)
-    {
-        SPDLOG_DEBUG("Kompute Manager evalOp triggered");
-        std::shared_ptr<kp::Sequence> sq =
-          this->getOrCreateManagedSequence(sequenceName);
+    void recordDispatch(const std::vector<std::shared_ptr<Tensor>>& tensors,
+                        uint32_t x = 1,
+                        uint32_t y = 1,
+                        uint32_t z = 1);
 
-        SPDLOG_DEBUG("Kompute Manager evalOp running sequence BEGIN");
-        sq->begin();
+  private:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::Device> mDevice;
+    std::shared_ptr<vk::CommandBuffer> mCommandBuffer;
+    std::shared_ptr<DescriptorPoolArena> mDescriptorPoolArena;
+    std::shared_ptr<vk::DispatchLoaderDynamic> mPushDescriptorDispatcher;
+    std::vector<std::shared_ptr<Tensor>> mTensorParams;
 
-        SPDLOG_DEBUG("Kompute Manager evalOp running sequence RECORD");
-        sq->record<T>(tensors, std::forward<TArgs>(params)...);
+    // -------------- OPTIONALLY OWNED RESOURCES
+    std::shared_ptr<vk::DescriptorSetLayout> mDescriptorSetLayout;
+    bool mFreeDescriptorSetLayout = false;
+    std::shared_ptr<vk::DescriptorPool> mDescriptorPool;
+    bool mFreeDescriptorPool = false;
+    std::shared_ptr<vk::DescriptorSet> mDescriptorSet;
+    bool mFreeDescriptorSet = false;
+    std::shared_ptr<vk::ShaderModule> mShaderModule;
+    bool mFreeShaderModule = false;
+    std::shared_ptr<vk::PipelineLayout> mPipelineLayout;
+    bool mFreePipelineLayout = false;
+    std::shared_ptr<vk::PipelineCache> mPipelineCache;
+    bool mFreePipelineCache = false;
+    std::shared_ptr<vk::Pipeline> mPipeline;
+    bool mFreePipeline = false;
 
-        SPDLOG_DEBUG("Kompute Manager evalOp running sequence END");
-        sq->end();
+    // Create util functions
+    void createShaderModule(const std::vector<char>& shaderFileData);
+    void createPipeline(std::vector<uint32_t> specializationData = {});
 
-        SPDLOG_DEBUG("Kompute Manager evalOp running sequence EVAL");
-        sq->eval();
+    // Parameters
+    void createParameters(std::vector<std::shared_ptr<Tensor>>& tensorParams);
+    void recordPushDescriptors(
+      const std::vector<std::shared_ptr<Tensor>>& tensors);
+};
 
-        SPDLOG_DEBUG("Kompute Manager evalOp running sequence SUCCESS");
-    }
+} // End namespace kp
+
+namespace kp {
+
+/**
+ *  Base Operation which provides the high level interface that Kompute
+ *  operations implement in order to perform a set of actions in the GPU.
+ *
+ *  Operations can perform actions on tensors, and optionally can also own an
+ *  Algorithm with respective parameters. kp::Operations with kp::Algorithms
+ *  would inherit from kp::OpBaseAlgo.
+ */
+class OpBase
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpBase() { SPDLOG_DEBUG("Compute OpBase base constructor"); }
 
     /**
-     * Function that evaluates operation against a newly created sequence.
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
      *
-     * @param tensors The tensors to be used in the operation recorded
-     * @param TArgs Template parameters that will be used to initialise
-     * Operation to allow for extensible configurations on initialisation
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation
+     * @param freeTensors Whether operation manages the memory of the Tensors
      */
-    template<typename T, typename... TArgs>
-    void evalOpDefault(std::vector<std::shared_ptr<Tensor>> tensors,
-                       TArgs&&... params)
+    OpBase(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           bool freeTensors)
     {
-        SPDLOG_DEBUG("Kompute Manager evalOp Default triggered");
-        this->mCurrentSequenceIndex++;
-        this->evalOp<T>(tensors,
-                        KP_DEFAULT_SESSION +
-                          std::to_string(this->mCurrentSequenceIndex),
-                        std::forward<TArgs>(params)...);
+        SPDLOG_DEBUG("Compute OpBase constructor with params");
+
+        this->mPhysicalDevice = physicalDevice;
+        this->mDevice = device;
+        this->mCommandBuffer = commandBuffer;
+        this->mTensors = tensors;
+        this->mFreeTensors = freeTensors;
     }
 
     /**
-     * Function that evaluates operation against named sequence asynchronously.
-     *
-     * @param tensors The tensors to be used in the operation recorded
-     * @param sequenceName The name of the sequence to be retrieved or created
-     * @param params Template parameters that will be used to initialise
-     * Operation to allow for extensible configurations on initialisation
+     * Default destructor for OpBase class. This OpBase destructor class should
+     * always be called to destroy and free owned resources unless it is
+     * intended to destroy the resources in the parent class. This can be done
+     * by passing the mFreeTensors=false.
      */
-    template<typename T, typename... TArgs>
-    void evalOpAsync(std::vector<std::shared_ptr<Tensor>> tensors,
-                     std::string sequenceName,
-                     TArgs&&... params)
+    virtual ~OpBase()
     {
-        SPDLOG_DEBUG("Kompute Manager evalOpAsync triggered");
+        SPDLOG_DEBUG("Kompute OpBase destructor started");
 
-        std::shared_ptr<kp::Sequence> sq =
-          this->getOrCreateManagedSequence(sequenceName);
+        if (!this->mDevice) {
+            SPDLOG_WARN("Kompute OpBase destructor called with empty device");
+            return;
+        }
 
-        SPDLOG_DEBUG("Kompute Manager evalOpAsync running sequence BEGIN");
-        sq->begin();
+        if (this->mFreeTensors) {
+            SPDLOG_DEBUG("Kompute OpBase freeing tensors");
+            for (std::shared_ptr<Tensor> tensor : this->mTensors) {
+                if (tensor && tensor->isInit()) {
+                    tensor->freeMemoryDestroyGPUResources();
+                } else {
+                    SPDLOG_ERROR("Kompute OpBase expected to free "
+                                  "tensor but has already been freed.");
+                }
+            }
+        }
+    }
 
-        SPDLOG_DEBUG("Kompute Manager evalOpAsync running sequence RECORD");
-        sq->record<T>(tensors, std::forward<TArgs>(params)...);
+    /**
+     * The init function is responsible for setting up all the resources and
+     * should be called after the Operation has been created.
+     */
+    virtual void init() = 0;
+
+    /**
+     * The record function is intended to only send a record command or run
+     * commands that are expected to record operations that are to be submitted
+     * as a batch into the GPU.
+     */
+    virtual void record() = 0;
+
+    /**
+     * Pre eval is called before the Sequence has called eval and submitted the commands to
+     * the GPU for processing, and can be used to perform any per-eval setup steps
+     * required as the computation iteration begins. It's worth noting that 
+     * there are situations where eval can be called multiple times, so the 
+     * resources that are created should be idempotent in case it's called multiple
+     * times in a row.
+     */
+    virtual void preEval() = 0;
+
+    /**
+     * Post eval is called after the Sequence has called eval and submitted the commands to
+     * the GPU for processing, and can be used to perform any tear-down steps
+     * required as the computation iteration finishes. It's worth noting that 
+     * there are situations where eval can be called multiple times, so the 
+     * resources that are destroyed should not require a re-init unless explicitly
+     * provided by the user.
+     */
+    virtual void postEval() = 0;
+
+  protected:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::PhysicalDevice>
+      mPhysicalDevice;                   ///< Vulkan Physical Device
+    std::shared_ptr<vk::Device> mDevice; ///< Vulkan Logical Device
+    std::shared_ptr<vk::CommandBuffer>
+      mCommandBuffer; ///< Vulkan Command Buffer
+
+    // -------------- OPTIONALLY OWNED RESOURCES
+    std::vector<std::shared_ptr<Tensor>>
+      mTensors; ///< Tensors referenced by operation that can be managed
+                ///< optionally by operation
+    bool mFreeTensors = false; ///< Explicit boolean that specifies whether the
+                               ///< tensors are freed (if they are managed)
+};
+
+} // End namespace kp
+
+/**
+ * Shader data of the compute shader shaders/glsl/<name>.comp for operations
+ * that create several algorithms. Release builds use the SPIR-V embedded in
+ * kompute/shaders/shader<name>.hpp, which has to be included, and other
+ * builds read the shader file as done for the shader of the operation.
+ */
+#if RELEASE
+#define KP_OPERATION_SHADER_DATA(name)                                         \
+    std::vector<char>(kp::shader_data::shaders_glsl_##name##_comp_spv,         \
+                      kp::shader_data::shaders_glsl_##name##_comp_spv +        \
+                        kp::shader_data::shaders_glsl_##name##_comp_spv_len)
+#else
+#define KP_OPERATION_SHADER_DATA(name)                                         \
+    kp::OpAlgoBase::readShaderFile("shaders/glsl/" #name ".comp")
+#endif
+
+namespace kp {
+
+/**
+ * Operation that provides a general abstraction that simplifies the use of 
+ * algorithm and parameter components which can be used with shaders.
+ * By default it enables the user to provide a dynamic number of tensors
+ * which are then passed as inputs.
+ */
+class OpAlgoBase : public OpBase
+{
+  public:
+    struct KomputeWorkgroup {
+        uint32_t x;
+        uint32_t y;
+        uint32_t z;
+    };
+
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpAlgoBase();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation
+     * @param shaderFilePath Optional parameter to specify the shader to load (either in spirv or raw format)
+     * @param komputeWorkgroup Optional parameter to specify the layout for processing
+     */
+    OpAlgoBase(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           KomputeWorkgroup komputeWorkgroup = KomputeWorkgroup());
+
+    /**
+     * Constructor that enables a file to be passed to the operation with
+     * the contents of the shader. This can be either in raw format or in
+     * compiled SPIR-V binary format.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation
+     * @param shaderFilePath Parameter to specify the shader to load (either in spirv or raw format)
+     * @param komputeWorkgroup Optional parameter to specify the layout for processing
+     */
+    OpAlgoBase(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           std::string shaderFilePath,
+           KomputeWorkgroup komputeWorkgroup = KomputeWorkgroup());
+
+    /**
+     * Constructor that enables raw shader data to be passed to the main operation
+     * which can be either in raw shader glsl code or in compiled SPIR-V binary.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation
+     * @param shaderDataRaw Optional parameter to specify the shader data either in binary or raw form
+     * @param komputeWorkgroup Optional parameter to specify the layout for processing
+     */
+    OpAlgoBase(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           const std::vector<char>& shaderDataRaw,
+           KomputeWorkgroup komputeWorkgroup = KomputeWorkgroup());
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpAlgoBase() override;
+
+    /**
+     * The init function is responsible for the initialisation of the algorithm
+     * component based on the parameters specified, and allows for extensibility
+     * on the options provided. Further dependent classes can perform more 
+     * specific checks such as ensuring tensors provided are initialised, etc.
+     */
+    virtual void init() override;
+
+    /**
+     * This records the commands that are to be sent to the GPU. This includes
+     * the barriers that ensure the memory has been copied before going in and
+     * out of the shader, as well as the dispatch operation that sends the
+     * shader processing to the gpu. This function also records the GPU memory
+     * copy of the output data for the staging buffer so it can be read by the
+     * host.
+     */
+    virtual void record() override;
+
+    /**
+     * Does not perform any preEval commands.
+     */
+    virtual void preEval() override;
+
+    /**
+     * Executes after the recorded commands are submitted, and performs a copy
+     * of the GPU Device memory into the staging buffer so the output data can
+     * be retrieved.
+     */
+    virtual void postEval() override;
+
+    /**
+     * Sets the shader cache that will be used to retrieve the shader module
+     * instead of loading and creating it on every init. This is set by the
+     * kp::Sequence with the cache owned by the kp::Manager before the init
+     * function is called.
+     *
+     * @param shaderCache The shader cache to retrieve shader modules from
+     */
+    void setShaderCache(std::shared_ptr<ShaderCache> shaderCache);
+
+    /**
+     * Sets the descriptor pool arena that the algorithm will use to retrieve
+     * its descriptor set layout and descriptor set instead of creating its own
+     * descriptor pool. This is set by the kp::Sequence with the arena owned by
+     * the kp::Manager before the init function is called.
+     *
+     * @param descriptorPoolArena The arena to allocate descriptor sets from
+     */
+    void setDescriptorPoolArena(
+      std::shared_ptr<DescriptorPoolArena> descriptorPoolArena);
+
+  protected:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<ShaderCache> mShaderCache; ///< Optional shader cache shared across operations
+    std::shared_ptr<DescriptorPoolArena> mDescriptorPoolArena; ///< Optional descriptor pool arena shared across operations
+
+    // -------------- OPTIONALLY OWNED RESOURCES
+    std::shared_ptr<Algorithm> mAlgorithm;
+    bool mFreeAlgorithm = false;
+
+    // -------------- ALWAYS OWNED RESOURCES
+
+    KomputeWorkgroup mKomputeWorkgroup;
+
+    std::string mShaderFilePath; ///< Optional member variable which can be provided for the OpAlgoBase to find the data automatically and load for processing
+    std::vector<char> mShaderDataRaw; ///< Optional member variable which can be provided to contain either the raw shader content or the spirv binary content
+    std::vector<uint32_t> mSpecializationConstants; ///< Optional specialization constants passed to the algorithm after the sizes of the tensors, which allows precompiled shaders to be specialised for each operation
+
+    virtual std::vector<char> fetchSpirvBinaryData();
+
+    /**
+     * Reads the data of a shader file, which is either the raw shader content
+     * or the spirv binary content.
+     *
+     * @param shaderFilePath The path of the shader file
+     * @return The bytes of the shader file
+     */
+    static std::vector<char> readShaderFile(const std::string& shaderFilePath);
+
+    /**
+     * Initialises the algorithm with the tensors of the operation, using the
+     * shader cache when available so the shader module is only created once
+     * per shader file or unique shader data.
+     */
+    void initAlgorithm();
+
+    /**
+     * Creates an additional algorithm which shares the shader cache and the
+     * descriptor pool arena of the operation, for operations that record
+     * several dispatches with different shaders or tensors.
+     *
+     * @param shaderData The raw shader content or the spirv binary content
+     * @param tensors The tensors bound to the algorithm in binding order
+     * @param specializationConstants Additional specialization constants whose constant ids follow the ones of the sizes of the tensors
+     * @return Shared pointer to the initialised algorithm
+     */
+    std::shared_ptr<Algorithm> createAlgorithm(
+      const std::vector<char>& shaderData,
+      const std::vector<std::shared_ptr<Tensor>>& tensors,
+      const std::vector<uint32_t>& specializationConstants = {});
+
+    /**
+     * Creates a device tensor owned by the operation, such as the block sums
+     * or the intermediate results of operations with several dispatches.
+     *
+     * @param size The number of 32 bit elements of the tensor
+     * @return The initialised tensor
+     */
+    std::shared_ptr<Tensor> createInternalTensor(uint32_t size);
+
+    /**
+     * Returns the largest power of two workgroup size supported by the device
+     * that does not exceed a maximum, for shaders that reduce values within
+     * a workgroup.
+     *
+     * @param maxSize The maximum workgroup size
+     * @return The workgroup size, which is at least one
+     */
+    uint32_t powerOfTwoWorkgroupSize(uint32_t maxSize);
+
+    /**
+     * Returns the active dimensions of the shape of a tensor, outermost first.
+     *
+     * @param tensor The tensor to return the shape of
+     * @return The size of each active dimension
+     */
+    static std::vector<uint32_t> tensorShape(
+      const std::shared_ptr<Tensor>& tensor);
+
+    /**
+     * Formats a shape for the error messages of the operations.
+     *
+     * @param shape The size of each dimension
+     * @return The shape as a string such as (2, 3)
+     */
+    static std::string shapeToString(const std::vector<uint32_t>& shape);
+};
+
+} // End namespace kp
+
+namespace kp {
+
+/**
+    Operation that creates tensor and manages the memory of the components
+   created
+*/
+class OpTensorCreate : public OpBase
+{
+  public:
+    OpTensorCreate();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that will be used to create in operation.
+     * @param freeTensors Whether operation manages the memory of the Tensors
+     */
+    OpTensorCreate(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                   std::shared_ptr<vk::Device> device,
+                   std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                   std::vector<std::shared_ptr<Tensor>> tensors);
+
+    /**
+     * Default destructor which in this case expects the parent class to free
+     * the tensors
+     */
+    ~OpTensorCreate() override;
+
+    /**
+     * In charge of initialising the primary Tensor as well as the staging
+     * tensor as required. It will only initialise a staging tensor if the
+     * Primary tensor is of type Device. For staging tensors it performs a 
+     * mapDataIntoHostMemory which would perform immediately as opposed to 
+     * on sequence eval/submission.
+     */
+    void init() override;
+
+    /**
+     * Record runs the core actions to create the tensors. For device tensors
+     * it records a copyCommand to move the data from the staging tensor to the 
+     * device tensor. The mapping for staging tensors happens in the init function
+     * not in the record function.
+     */
+    void record() override;
+
+    /**
+     * Does not perform any preEval commands.
+     */
+    virtual void preEval() override;
+
+    /**
+     * Performs a copy back into the main tensor to ensure that the data
+     * contained is the one that is now being stored in the GPU.
+     */
+    virtual void postEval() override;
+
+    /**
+     * Sets the extensions enabled in the device, which are passed to the
+     * tensors when they are initialised so they only use the features of the
+     * extensions available. This is set by the kp::Sequence with the
+     * extensions enabled by the kp::Manager before the init function is
+     * called.
+     *
+     * @param enabledExtensions The names of the extensions enabled
+     */
+    void setEnabledExtensions(
+      const std::vector<std::string>& enabledExtensions);
+
+  private:
+    // Never owned resources
+    std::vector<std::shared_ptr<Tensor>> mStagingTensors;
+    std::vector<std::string> mEnabledExtensions;
+};
+
+} // End namespace kp
+
+namespace kp {
+
+class CompletionThread;
+
+/**
+ *  Container of operations that can be sent to GPU as batch
+ */
+class Sequence : public std::enable_shared_from_this<Sequence>
+{
+  public:
+    /**
+     *  Base constructor for Sequence. Should not be used unless explicit
+     * intended.
+     */
+    Sequence();
+    /**
+     * Main constructor for sequence which requires core vulkan components to
+     * generate all dependent resources.
+     *
+     * @param physicalDevice Vulkan physical device
+     * @param device Vulkan logical device
+     * @param computeQueue Vulkan compute queue
+     * @param queueIndex Vulkan compute queue index in device
+     * @param shaderCache (Optional) Shader cache to share across the
+     * algorithm operations recorded in this sequence
+     * @param descriptorPoolArena (Optional) Descriptor pool arena to allocate
+     * the descriptor sets of the algorithm operations recorded in this sequence
+     * @param queueMutex (Optional) Mutex held while submitting into the compute
+     * queue, which has to be provided if the queue is shared with other
+     * sequences that may be evaluated from other threads
+     * @param enabledExtensions (Optional) Extensions enabled in the device,
+     * which are passed to the tensors created by the operations recorded in
+     * this sequence
+     */
+    Sequence(
+      std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+      std::shared_ptr<vk::Device> device,
+      std::shared_ptr<vk::Queue> computeQueue,
+      uint32_t queueIndex,
+      std::shared_ptr<ShaderCache> shaderCache = nullptr,
+      std::shared_ptr<DescriptorPoolArena> descriptorPoolArena = nullptr,
+      std::shared_ptr<std::mutex> queueMutex = nullptr,
+      const std::vector<std::string>& enabledExtensions = {});
+    /**
+     * Destructor for sequence which is responsible for cleaning all subsequent
+     * owned operations.
+     */
+    ~Sequence();
+
+    /**
+     * Initialises sequence including the creation of the command pool and the
+     * command buffer.
+     */
+    void init();
+
+    /**
+     * Begins recording commands for commands to be submitted into the command
+     * buffer.
+     *
+     * @return Boolean stating whether execution was successful.
+     */
+    bool begin();
+
+    /**
+     * Ends the recording and stops recording commands when the record command
+     * is sent.
+     *
+     * @return Boolean stating whether execution was successful.
+     */
+    bool end();
+
+    /**
+     * Eval sends all the recorded and stored operations in the vector of
+     * operations into the gpu as a submit job with a barrier.
+     *
+     * @return Boolean stating whether execution was successful.
+     */
+    bool eval();
+
+    /**
+     * Eval Async sends all the recorded and stored operations in the vector of
+     * operations into the gpu as a submit job with a barrier. EvalAwait() must
+     * be called after to ensure the sequence is terminated correctly.
+     *
+     * @return Boolean stating whether execution was successful.
+     */
+    bool evalAsync();
+
+    /**
+     * Eval Await waits for the fence to finish processing and then once it
+     * finishes, it runs the postEval of all operations.
+     *
+     * @param waitFor Number of nanoseconds to wait before timing out. If the
+     * wait times out the sequence remains running and evalAwait can be called
+     * again.
+     * @return Boolean stating whether execution was successful.
+     */
+    bool evalAwait(uint64_t waitFor = UINT64_MAX);
+
+    /**
+     * Returns true if the GPU has finished executing the submission of the
+     * last evalAsync without blocking, which allows polling a running
+     * sequence. Once it returns true evalAwait can be called to run the
+     * postEval of the operations without waiting.
+     *
+     * @return Boolean stating whether the submitted work has completed, which
+     * is also true if the sequence is not running.
+     */
+    bool isComplete();
+
+    /**
+     * Sets the completion thread that awaits the sequence when it is
+     * evaluated through evalCoro, which the manager sets on the sequences it
+     * creates when built with coroutines enabled.
+     *
+     * @param completionThread The completion thread of the manager
+     */
+    void setCompletionThread(
+      std::shared_ptr<CompletionThread> completionThread);
+
+#if KOMPUTE_ENABLE_COROUTINES
+    /**
+     * Returns a C++20 awaitable which submits the recorded operations when
+     * awaited with co_await, and resumes the coroutine once the completion
+     * thread has awaited the sequence and run the postEval of the operations.
+     * The sequence must be owned by a shared pointer and have a completion
+     * thread set, as is the case for the sequences created by the manager.
+     *
+     * @param executor (Optional) Executor to resume the coroutine with, which
+     * otherwise is resumed in the completion thread
+     * @return Awaitable which evaluates to whether execution was successful
+     */
+    SequenceAwaitable evalCoro(CoroExecutor executor = nullptr);
+#endif
+
+    /**
+     * Returns true if the sequence is currently in recording activated.
+     *
+     * @return Boolean stating if recording ongoing.
+     */
+    bool isRecording();
+
+    /**
+     * Returns true if the sequence is currently running - mostly used for async
+     * workloads.
+     *
+     * @return Boolean stating if currently running.
+     */
+    bool isRunning();
+
+    /**
+     * Returns true if the sequence has been successfully initialised.
+     *
+     * @return Boolean stating if sequence has been initialised.
+     */
+    bool isInit();
+
+    /**
+     * Returns the mutex that guards the command pool and command buffer owned
+     * by the sequence. Vulkan command pools are externally synchronized, so
+     * this mutex has to be held by any thread that records or evaluates the
+     * sequence while other threads may use it, which is how the manager
+     * serialises concurrent evaluations of the same named sequence.
+     *
+     * @return Reference to the mutex of the sequence
+     */
+    std::mutex& mutex();
+
+    /**
+     * Destroys and frees the GPU resources which include the buffer and memory
+     * and sets the sequence as init=False.
+     */
+    void freeMemoryDestroyGPUResources();
+
+    /**
+     * Record function for operation to be added to the GPU queue in batch. This
+     * template requires classes to be derived from the OpBase class. This
+     * function also requires the Sequence to be recording, otherwise it will
+     * not be able to add the operation.
+     *
+     * @param tensors Vector of tensors to use for the operation
+     * @param TArgs Template parameters that are used to initialise operation
+     * which allows for extensible configurations on initialisation.
+     */
+    template<typename T, typename... TArgs>
+    bool record(std::vector<std::shared_ptr<Tensor>> tensors, TArgs&&... params)
+    {
+        static_assert(std::is_base_of<OpBase, T>::value,
+                      "Kompute Sequence record(...) template only valid with "
+                      "OpBase derived classes");
+
+        SPDLOG_DEBUG("Kompute Sequence record function started");
+
+        if (!this->isRecording()) {
+            SPDLOG_ERROR(
+              "Kompute sequence record attempted when not record BEGIN");
+            return false;
+        }
+
+        SPDLOG_DEBUG("Kompute Sequence creating OpBase derived class instance");
+        T* op = new T(this->mPhysicalDevice,
+                      this->mDevice,
+                      this->mCommandBuffer,
+                      tensors,
+                      std::forward<TArgs>(params)...);
+
+        OpBase* baseOp = dynamic_cast<OpBase*>(op);
+
+        std::unique_ptr<OpBase> baseOpPtr{ baseOp };
+
+        if (OpAlgoBase* algoOp = dynamic_cast<OpAlgoBase*>(baseOp)) {
+            if (this->mShaderCache) {
+                SPDLOG_DEBUG("Kompute Sequence setting shader cache");
+                algoOp->setShaderCache(this->mShaderCache);
+            }
+            if (this->mDescriptorPoolArena) {
+                SPDLOG_DEBUG("Kompute Sequence setting descriptor pool arena");
+                algoOp->setDescriptorPoolArena(this->mDescriptorPoolArena);
+            }
+        }
+        if (OpTensorCreate* createOp = dynamic_cast<OpTensorCreate*>(baseOp)) {
+            SPDLOG_DEBUG("Kompute Sequence setting enabled extensions");
+            createOp->setEnabledExtensions(this->mEnabledExtensions);
+        }
+
+        SPDLOG_DEBUG(
+          "Kompute Sequence running init on OpBase derived class instance");
+        baseOpPtr->init();
+
+        SPDLOG_DEBUG(
+          "Kompute Sequence running record on OpBase derived class instance");
+        baseOpPtr->record();
+
+        mOperations.push_back(std::move(baseOpPtr));
+
+        return true;
+    }
+
+  private:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice = nullptr;
+    std::shared_ptr<vk::Device> mDevice = nullptr;
+    std::shared_ptr<vk::Queue> mComputeQueue = nullptr;
+    uint32_t mQueueIndex = -1;
+    std::shared_ptr<ShaderCache> mShaderCache = nullptr;
+    std::shared_ptr<DescriptorPoolArena> mDescriptorPoolArena = nullptr;
+    std::shared_ptr<std::mutex> mQueueMutex = nullptr;
+    std::vector<std::string> mEnabledExtensions;
+    // Declared regardless of KOMPUTE_ENABLE_COROUTINES so the layout of the
+    // class does not depend on whether coroutines are enabled
+    std::shared_ptr<CompletionThread> mCompletionThread = nullptr;
+
+    // -------------- OPTIONALLY OWNED RESOURCES
+    std::shared_ptr<vk::CommandPool> mCommandPool = nullptr;
+    bool mFreeCommandPool = false;
+    std::shared_ptr<vk::CommandBuffer> mCommandBuffer = nullptr;
+    bool mFreeCommandBuffer = false;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    vk::Fence mFence;
+    uint64_t mSubmission = 0;
+    std::vector<std::unique_ptr<OpBase>> mOperations;
+    std::mutex mMutex;
+
+    // State
+    bool mIsInit = false;
+    bool mRecording = false;
+    bool mIsRunning = false;
+
+    // Create functions
+    void createCommandPool();
+    void createCommandBuffer();
+};
+
+} // End namespace kp
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#define KP_DEFAULT_COMPLETION_WAIT_TIMEOUT 1000000
+
+namespace kp {
+
+/**
+ * Background thread owned by the kp::Manager which awaits the sequences
+ * evaluated asynchronously and completes their kp::EvalFuture handles. The
+ * thread blocks on the fence of the oldest pending sequence with a short
+ * timeout and polls the rest, running the postEval of each sequence as soon as
+ * it finishes, so callers never block on a fence themselves.
+ *
+ * Sequences tracked by the completion thread must not be awaited directly, as
+ * their fences are destroyed once awaited, and should instead be waited
+ * through their future.
+ */
+class CompletionThread
+{
+  public:
+    /**
+     * Default constructor which does not start the thread until init is
+     * called.
+     *
+     * @param waitTimeout Number of nanoseconds the thread blocks on the fence
+     * of the oldest pending sequence before polling the others
+     */
+    CompletionThread(
+      uint64_t waitTimeout = KP_DEFAULT_COMPLETION_WAIT_TIMEOUT);
+
+    /**
+     * Destructor which waits for the pending sequences and stops the thread.
+     */
+    ~CompletionThread();
+
+    /**
+     * Starts the completion thread.
+     */
+    void init();
+
+    /**
+     * Tracks a sequence that has been evaluated asynchronously, so its
+     * future is completed once the sequence finishes.
+     *
+     * @param sequence The sequence evaluated asynchronously
+     * @param isSubmitted Whether the evalAsync of the sequence succeeded,
+     * otherwise the sequence is not tracked and the returned future is
+     * already completed as failed
+     * @return Future completed once the sequence has been awaited
+     */
+    EvalFuture track(std::shared_ptr<Sequence> sequence,
+                     bool isSubmitted = true);
+
+    /**
+     * Retrieves the future of a sequence that is currently being tracked.
+     *
+     * @param sequence The sequence to find the future for
+     * @return The future of the sequence, or an invalid future if the
+     * sequence is not being tracked
+     */
+    EvalFuture find(std::shared_ptr<Sequence> sequence);
+
+    /**
+     * Returns true if the completion thread has been started.
+     *
+     * @return Boolean stating whether the thread is running
+     */
+    bool isInit();
+
+    /**
+     * Waits for the pending sequences to finish and stops the thread.
+     */
+    void stop();
+
+  private:
+    struct PendingEval
+    {
+        std::shared_ptr<Sequence> sequence;
+        std::shared_ptr<EvalFutureState> state;
+    };
+
+    // -------------- ALWAYS OWNED RESOURCES
+    uint64_t mWaitTimeout = KP_DEFAULT_COMPLETION_WAIT_TIMEOUT;
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<PendingEval> mPendingEvals;
+    bool mIsStopping = false;
+    bool mIsInit = false;
+
+    // Worker util functions
+    void run();
+    void complete(const PendingEval& pendingEval,
+                  bool result,
+                  std::exception_ptr exception);
+};
+
+} // End namespace kp
+
+#include <functional>
+#include <string>
+
+namespace kp {
+
+/**
+ * Capabilities of a physical device as reported by kp::Manager::listDevices,
+ * which are also used by kp::DevicePolicy to choose the device of a manager.
+ */
+struct DeviceInfo
+{
+    uint32_t index = 0;
+    std::string name;
+    vk::PhysicalDeviceType deviceType = vk::PhysicalDeviceType::eOther;
+    uint32_t vendorID = 0;
+    uint32_t deviceID = 0;
+    uint32_t apiVersion = 0;
+    // Total size of the device local heaps in bytes
+    uint64_t deviceLocalMemorySize = 0;
+    // Whether a memory type is both device local and host visible
+    bool hasUnifiedMemory = false;
+    // Zero when the device does not support Vulkan 1.1
+    uint32_t subgroupSize = 0;
+    // Whether subgroup arithmetic operations are supported in compute shaders
+    bool hasSubgroupArithmetic = false;
+    uint32_t maxComputeWorkGroupInvocations = 0;
+    std::array<uint32_t, 3> maxComputeWorkGroupSize = { 0, 0, 0 };
+    uint32_t maxComputeSharedMemorySize = 0;
+    std::vector<uint32_t> computeQueueFamilyIndices;
+    // Compute queue family without graphics support, or -1 if there is none
+    uint32_t dedicatedComputeQueueFamilyIndex = -1;
+    std::vector<std::string> extensions;
+    vk::PhysicalDeviceFeatures features;
+
+    /**
+     * Queries the capabilities of a physical device.
+     *
+     * @param physicalDevice The physical device to query
+     * @param index The index of the physical device in the instance
+     * @return The capabilities of the physical device
+     */
+    static DeviceInfo fromPhysicalDevice(
+      const vk::PhysicalDevice& physicalDevice,
+      uint32_t index);
+
+    /**
+     * Returns true if the device supports the extension provided.
+     *
+     * @param extensionName The name of the extension
+     * @return Boolean stating whether the extension is supported
+     */
+    bool hasExtension(const std::string& extensionName) const;
+};
+
+/**
+ * Policy used by kp::Manager to choose the physical device to create its
+ * resources on. Devices that do not have a compute queue, the required
+ * extensions, a name matching the regex or that are rejected by the filter
+ * are discarded, and the remaining ones are ranked by device type and then by
+ * device local memory, falling back to the lowest index.
+ */
+struct DevicePolicy
+{
+    // Ranks discrete, then integrated, virtual and CPU devices
+    bool preferDiscrete = true;
+    // Ranks devices with more device local memory first
+    bool preferDeviceLocalMemory = true;
+    // Uses a compute queue family without graphics support when available
+    bool preferDedicatedComputeQueue = false;
+    // Extensions that the device must support, which are also enabled
+    std::vector<std::string> requiredExtensions;
+    // ECMAScript regex searched in the device name, ignored when empty
+    std::string nameRegex;
+    // Custom requirement such as features or limits, ignored when empty
+    std::function<bool(const DeviceInfo&)> filter;
+
+    /**
+     * Returns true if the device fulfils the requirements of the policy.
+     *
+     * @param deviceInfo The capabilities of the device
+     * @return Boolean stating whether the device can be selected
+     */
+    bool isSuitable(const DeviceInfo& deviceInfo) const;
+
+    /**
+     * Chooses the best suitable device, throwing if none is suitable.
+     *
+     * @param deviceInfos The capabilities of the available devices
+     * @return The index of the chosen device in the instance
+     */
+    uint32_t select(const std::vector<DeviceInfo>& deviceInfos) const;
+};
+
+} // End namespace kp
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#define KP_DEFAULT_TRANSFER_CHUNK_SIZE (16 * 1024 * 1024)
+#define KP_DEFAULT_TRANSFER_NUM_CHUNKS 2
+
+namespace kp {
+
+/**
+ * Streaming transfer engine that moves tensor data between the host and the
+ * device in chunks through a ring of persistently mapped staging buffers.
+ * Transfers are executed by a CPU worker thread, which fills the staging
+ * chunk k+1 while the GPU copies chunk k, and are submitted to the queue of
+ * the engine so they can overlap with compute submitted in other queues.
+ *
+ * The queue should preferably not be used by other sequences so transfers
+ * don't serialise with compute, and if it is shared the queue mutex has to be
+ * provided as Vulkan queue submissions are externally synchronized. It should
+ * belong to the same queue family as the queues that use the tensors, as the
+ * tensor buffers are created with exclusive sharing mode.
+ */
+class TransferEngine
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    TransferEngine();
+
+    /**
+     * Default constructor with the core vulkan components and the size of the
+     * staging ring used for the transfers.
+     *
+     * @param physicalDevice Vulkan physical device to find the memory types
+     * @param device Vulkan logical device to create the resources with
+     * @param queue Vulkan queue the transfers are submitted to
+     * @param queueIndex Vulkan queue family index of the queue
+     * @param chunkSize Size in bytes of each staging chunk
+     * @param numChunks Number of staging chunks in the ring, which is the
+     * number of chunk copies that can be in flight at the same time
+     * @param queueMutex (Optional) Mutex held while submitting into the queue,
+     * which has to be provided if the queue is shared with sequences
+     */
+    TransferEngine(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                   std::shared_ptr<vk::Device> device,
+                   std::shared_ptr<vk::Queue> queue,
+                   uint32_t queueIndex,
+                   uint64_t chunkSize = KP_DEFAULT_TRANSFER_CHUNK_SIZE,
+                   uint32_t numChunks = KP_DEFAULT_TRANSFER_NUM_CHUNKS,
+                   std::shared_ptr<std::mutex> queueMutex = nullptr);
+
+    /**
+     * Destructor which waits for the pending transfers and destroys the GPU
+     * resources owned by the engine.
+     */
+    ~TransferEngine();
+
+    /**
+     * Creates the command pool, the staging chunks and their command buffers
+     * and fences, and starts the worker thread.
+     */
+    void init();
+
+    /**
+     * Queues the upload of the host data of the tensors provided into their
+     * device memory and returns without waiting for it. The host data of the
+     * tensors must not be modified until the transfer finishes.
+     *
+     * @param tensors Tensors of type eDevice or eStaging to upload
+     * @return Future that becomes ready once the data is in device memory,
+     * which rethrows any error raised by the transfer
+     */
+    std::future<void> uploadAsync(std::vector<std::shared_ptr<Tensor>> tensors);
+
+    /**
+     * Queues the download of the device memory of the tensors provided into
+     * their host data and returns without waiting for it.
+     *
+     * @param tensors Tensors of type eDevice or eStaging to download
+     * @return Future that becomes ready once the host data has been updated,
+     * which rethrows any error raised by the transfer
+     */
+    std::future<void> downloadAsync(
+      std::vector<std::shared_ptr<Tensor>> tensors);
+
+    /**
+     * Uploads the host data of the tensors and waits until it is completed.
+     *
+     * @param tensors Tensors of type eDevice or eStaging to upload
+     */
+    void upload(std::vector<std::shared_ptr<Tensor>> tensors);
+
+    /**
+     * Downloads the device memory of the tensors and waits until it is
+     * completed.
+     *
+     * @param tensors Tensors of type eDevice or eStaging to download
+     */
+    void download(std::vector<std::shared_ptr<Tensor>> tensors);
+
+    /**
+     * Queues the copy of a tensor into a tensor of another manager, whose
+     * transfer engine is provided, and returns without waiting for it. When
+     * both engines share the logical device the buffers are copied directly,
+     * otherwise the data is bounced through the host in chunks, with the
+     * engine downloading chunk k+1 from its device while the destination
+     * engine uploads chunk k to the other device. The host data of the
+     * destination tensor is also updated, as with kp::OpTensorCopy.
+     *
+     * @param srcTensor Tensor of type eDevice or eStaging of this engine
+     * @param dstEngine Transfer engine of the device of the destination
+     * @param dstTensor Tensor of type eDevice or eStaging of the same size
+     * @return Future that becomes ready once the data is in the memory of the
+     * destination tensor, which rethrows any error raised by the transfer
+     */
+    std::future<void> copyToAsync(std::shared_ptr<Tensor> srcTensor,
+                                  std::shared_ptr<TransferEngine> dstEngine,
+                                  std::shared_ptr<Tensor> dstTensor);
+
+    /**
+     * Copies a tensor into a tensor of another manager and waits until it is
+     * completed.
+     *
+     * @param srcTensor Tensor of type eDevice or eStaging of this engine
+     * @param dstEngine Transfer engine of the device of the destination
+     * @param dstTensor Tensor of type eDevice or eStaging of the same size
+     */
+    void copyTo(std::shared_ptr<Tensor> srcTensor,
+                std::shared_ptr<TransferEngine> dstEngine,
+                std::shared_ptr<Tensor> dstTensor);
+
+    /**
+     * Returns the size in bytes of the staging chunks.
+     *
+     * @return Chunk size in bytes
+     */
+    uint64_t chunkSize();
+
+    /**
+     * Returns the number of staging chunks in the ring.
+     *
+     * @return Number of staging chunks
+     */
+    uint32_t numChunks();
+
+    /**
+     * Returns true if the init function has been carried out successfully.
+     *
+     * @return Boolean representing whether the engine is initialised
+     */
+    bool isInit();
+
+    /**
+     * Stops the worker thread after the queued transfers complete and
+     * destroys the GPU resources owned by the engine.
+     */
+    void freeMemoryDestroyGPUResources();
+
+  private:
+    struct StagingChunk
+    {
+        vk::Buffer buffer;
+        vk::DeviceMemory memory;
+        void* mapped = nullptr;
+        std::shared_ptr<vk::CommandBuffer> commandBuffer;
+        vk::Fence fence;
+        bool isInFlight = false;
+        std::function<void(const char*)> downloadCallback; ///< Receives the mapped chunk once the fence is signalled
+    };
+
+    struct PendingUploads
+    {
+        std::mutex mutex; ///< Guards the futures as the callbacks queue them
+        std::vector<std::future<void>> futures; ///< Uploads in the order the chunks were downloaded
+    };
+
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice;
+    std::shared_ptr<vk::Device> mDevice;
+    std::shared_ptr<vk::Queue> mQueue;
+    uint32_t mQueueIndex = -1;
+    std::shared_ptr<std::mutex> mQueueMutex;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    uint64_t mChunkSize = KP_DEFAULT_TRANSFER_CHUNK_SIZE;
+    uint32_t mNumChunks = KP_DEFAULT_TRANSFER_NUM_CHUNKS;
+    std::shared_ptr<vk::CommandPool> mCommandPool;
+    std::vector<StagingChunk> mStagingChunks;
+    uint64_t mNextChunk = 0;
+    bool mIsInit = false;
+
+    std::thread mWorker;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<std::function<void()>> mTasks;
+    bool mIsStopping = false;
+
+    // Create util functions
+    void createCommandPool();
+    void createStagingChunk(StagingChunk& stagingChunk);
+
+    // Worker util functions
+    std::future<void> enqueue(std::function<void()> transfer);
+    void runWorker();
+    void uploadTensor(std::shared_ptr<Tensor> tensor);
+    void downloadTensor(std::shared_ptr<Tensor> tensor);
+    void uploadChunk(std::shared_ptr<Tensor> tensor,
+                     uint64_t offset,
+                     const char* data,
+                     uint64_t size);
+    void downloadChunk(std::shared_ptr<Tensor> tensor,
+                       uint64_t offset,
+                       uint64_t size,
+                       std::function<void(const char*)> downloadCallback);
+    void copyTensor(std::shared_ptr<Tensor> srcTensor,
+                    std::shared_ptr<TransferEngine> dstEngine,
+                    std::shared_ptr<Tensor> dstTensor,
+                    std::shared_ptr<PendingUploads> uploads);
+    void validateTransferTensor(std::shared_ptr<Tensor> tensor);
+    StagingChunk& acquireStagingChunk();
+    void submitStagingChunk(StagingChunk& stagingChunk);
+    void waitStagingChunk(StagingChunk& stagingChunk);
+    void waitAllStagingChunks();
+};
+
+} // End namespace kp
+
+#define KP_DEFAULT_SESSION "DEFAULT"
+
+namespace kp {
+
+/**
+    Base orchestrator which creates and manages device and child components.
+
+    The manager is thread safe: the registry of managed sequences is guarded by
+   a mutex, submissions into each queue are serialised by a per queue mutex,
+   and the eval functions hold the mutex of the sequence they record into, as
+   each sequence owns the command pool it records with and command pools
+   cannot be used from several threads at once. Threads evaluating in parallel
+   should hence use the default anonymous sequences or different named
+   sequences, as evaluations of the same named sequence are serialised.
+*/
+class Manager
+{
+  public:
+    /**
+        Base constructor and default used which creates the base resources
+       including choosing the device 0 by default.
+    */
+    Manager();
+
+    /**
+     * Similar to base constructor but allows the user to provide the device
+     * they would like to create the resources on.
+     *
+     * @param physicalDeviceIndex The index of the physical device to use
+     * @param familyQueueIndices (Optional) List of queue indices to add for
+     * explicit allocation
+     * @param totalQueues The total number of compute queues to create.
+     */
+    Manager(uint32_t physicalDeviceIndex,
+            const std::vector<uint32_t>& familyQueueIndices = {});
+
+    /**
+     * Similar to base constructor but chooses the device to create the
+     * resources on with the policy provided, enabling the extensions it
+     * requires.
+     *
+     * @param devicePolicy The policy used to choose the physical device
+     * @param familyQueueIndices (Optional) List of queue indices to add for
+     * explicit allocation, otherwise a compute queue is chosen by the policy
+     */
+    Manager(const DevicePolicy& devicePolicy,
+            const std::vector<uint32_t>& familyQueueIndices = {});
+
+    /**
+     * Manager constructor which allows your own vulkan application to integrate
+     * with the vulkan kompute use.
+     *
+     * @param instance Vulkan compute instance to base this application
+     * @param physicalDevice Vulkan physical device to use for application
+     * @param device Vulkan logical device to use for all base resources
+     * @param physicalDeviceIndex Index for vulkan physical device used
+     * @param familyQueueIndices (Optional) Family index of each of the queues
+     * the device was created with to use for the sequences, where repeated
+     * families take the next queue of the family, otherwise the first queue
+     * of the first compute family, which the device must have been created
+     * with
+     */
+    Manager(std::shared_ptr<vk::Instance> instance,
+            std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+            std::shared_ptr<vk::Device> device,
+            uint32_t physicalDeviceIndex,
+            const std::vector<uint32_t>& familyQueueIndices = {});
+
+    /**
+     * Manager destructor which would ensure all owned resources are destroyed
+     * unless explicitly stated that resources should not be destroyed or freed.
+     */
+    ~Manager();
+
+    /**
+     * Lists the physical devices available with their capabilities, which
+     * creates a temporary instance so it can be called before creating a
+     * manager.
+     *
+     * @return The capabilities of each physical device in index order
+     */
+    static std::vector<DeviceInfo> listDevices();
+
+    /**
+     * Returns the index of the physical device used by the manager.
+     *
+     * @return The index of the physical device in the instance
+     */
+    uint32_t physicalDeviceIndex();
+
+    /**
+     * Get or create a managed Sequence that will be contained by this manager.
+     * If the named sequence does not currently exist, it would be created and
+     * initialised.
+     *
+     * @param sequenceName The name for the named sequence to be retrieved or
+     * created
+     * @return Shared pointer to the manager owned sequence resource
+     */
+    std::shared_ptr<Sequence> getOrCreateManagedSequence(
+      std::string sequenceName);
+
+    /**
+     * Create a new managed Kompute sequence so it's available within the
+     * manager.
+     *
+     * @param sequenceName The name for the named sequence to be created, if
+     * empty then default indexed value is used
+     * @param queueIndex The queue to use from the available queues
+     * @return Weak pointer to the manager owned sequence resource
+     */
+    std::shared_ptr<Sequence> createManagedSequence(
+      std::string sequenceName = "",
+      uint32_t queueIndex = 0);
+
+    /**
+     * Function that evaluates operation against named sequence.
+     *
+     * @param tensors The tensors to be used in the operation recorded
+     * @param sequenceName The name of the sequence to be retrieved or created
+     * @param TArgs Template parameters that will be used to initialise
+     * Operation to allow for extensible configurations on initialisation
+     */
+    template<typename T, typename... TArgs>
+    void evalOp(std::vector<std::shared_ptr<Tensor>> tensors,
+                std::string sequenceName,
+                TArgs&&... params)
+    {
+        SPDLOG_DEBUG("Kompute Manager evalOp triggered");
+        std::shared_ptr<kp::Sequence> sq =
+          this->getOrCreateManagedSequence(sequenceName);
+
+        std::lock_guard<std::mutex> lock(sq->mutex());
+
+        SPDLOG_DEBUG("Kompute Manager evalOp running sequence BEGIN");
+        sq->begin();
+
+        SPDLOG_DEBUG("Kompute Manager evalOp running sequence RECORD");
+        sq->record<T>(tensors, std::forward<TArgs>(params)...);
+
+        SPDLOG_DEBUG("Kompute Manager evalOp running sequence END");
+        sq->end();
+
+        SPDLOG_DEBUG("Kompute Manager evalOp running sequence EVAL");
+        sq->eval();
+
+        SPDLOG_DEBUG("Kompute Manager evalOp running sequence SUCCESS");
+    }
+
+    /**
+     * Function that evaluates operation against a newly created sequence.
+     *
+     * @param tensors The tensors to be used in the operation recorded
+     * @param TArgs Template parameters that will be used to initialise
+     * Operation to allow for extensible configurations on initialisation
+     */
+    template<typename T, typename... TArgs>
+    void evalOpDefault(std::vector<std::shared_ptr<Tensor>> tensors,
+                       TArgs&&... params)
+    {
+        SPDLOG_DEBUG("Kompute Manager evalOp Default triggered");
+        this->evalOp<T>(tensors,
+                        this->nextDefaultSequenceName(),
+                        std::forward<TArgs>(params)...);
+    }
+
+    /**
+     * Function that evaluates operation against named sequence asynchronously.
+     * The sequence is awaited by the completion thread of the manager, so the
+     * returned future can be used instead of calling evalOpAwait.
+     *
+     * @param tensors The tensors to be used in the operation recorded
+     * @param sequenceName The name of the sequence to be retrieved or created
+     * @param params Template parameters that will be used to initialise
+     * Operation to allow for extensible configurations on initialisation
+     * @return Future that is ready once the sequence finishes and the postEval
+     * of the operation has run
+     */
+    template<typename T, typename... TArgs>
+    EvalFuture evalOpAsync(std::vector<std::shared_ptr<Tensor>> tensors,
+                           std::string sequenceName,
+                           TArgs&&... params)
+    {
+        SPDLOG_DEBUG("Kompute Manager evalOpAsync triggered");
+
+        std::shared_ptr<kp::Sequence> sq =
+          this->getOrCreateManagedSequence(sequenceName);
+
+        std::shared_ptr<CompletionThread> completionThread =
+          this->getOrCreateCompletionThread();
+
+        std::lock_guard<std::mutex> lock(sq->mutex());
+
+        SPDLOG_DEBUG("Kompute Manager evalOpAsync running sequence BEGIN");
+        sq->begin();
+
+        SPDLOG_DEBUG("Kompute Manager evalOpAsync running sequence RECORD");
+        sq->record<T>(tensors, std::forward<TArgs>(params)...);
+
+        SPDLOG_DEBUG("Kompute Manager evalOpAsync running sequence END");
+        sq->end();
+
+        SPDLOG_DEBUG("Kompute Manager evalOpAsync running sequence EVAL");
+        bool isSubmitted = sq->evalAsync();
+
+        SPDLOG_DEBUG("Kompute Manager evalOpAsync running sequence SUCCESS");
+        return completionThread->track(sq, isSubmitted);
+    }
+
+    /**
+     * Operation that evaluates operation against default sequence
+     * asynchronously.
+     *
+     * @param tensors The tensors to be used in the operation recorded
+     * @param params Template parameters that will be used to initialise
+     * Operation to allow for extensible configurations on initialisation
+     * @return Future that is ready once the sequence finishes and the postEval
+     * of the operation has run
+     */
+    template<typename T, typename... TArgs>
+    EvalFuture evalOpAsyncDefault(std::vector<std::shared_ptr<Tensor>> tensors,
+                                  TArgs&&... params)
+    {
+        SPDLOG_DEBUG("Kompute Manager evalOpAsyncDefault triggered");
+        return this->evalOpAsync<T>(tensors,
+                             this->nextDefaultSequenceName(),
+                             std::forward<TArgs>(params)...);
+    }
+
+    /**
+     * Operation that awaits for named sequence to finish. If the sequence was
+     * evaluated through evalOpAsync this waits on its future, as the sequence
+     * is awaited by the completion thread.
+     *
+     * @param sequenceName The name of the sequence to wait for termination
+     * @param waitFor The amount of time to wait before timing out
+     */
+    void evalOpAwait(std::string sequenceName, uint64_t waitFor = UINT64_MAX)
+    {
+        SPDLOG_DEBUG("Kompute Manager evalOpAwait triggered with sequence {}",
+                     sequenceName);
+        std::shared_ptr<kp::Sequence> sq =
+          this->findManagedSequence(sequenceName);
+
+        EvalFuture future;
+        if (sq) {
+            future = this->findEvalFuture(sq);
+        }
+
+        if (future.valid()) {
+            SPDLOG_DEBUG("Kompute Manager evalOpAwait waiting on future");
+            if (future.wait(waitFor)) {
+                future.get();
+            }
+        } else if (sq) {
+            std::lock_guard<std::mutex> lock(sq->mutex());
+
+            SPDLOG_DEBUG("Kompute Manager evalOpAwait running sequence "
+                         "Sequence EVAL AWAIT");
+            if (sq->isRunning()) {
+                sq->evalAwait(waitFor);
+            }
+            SPDLOG_DEBUG(
+              "Kompute Manager evalOpAwait running sequence SUCCESS");
+        } else {
+            SPDLOG_ERROR("Kompute Manager evalOpAwait Sequence not found");
+        }
+    }
+
+    /**
+     * Operation that awaits for the last default sequence created to finish.
+     * When several threads evaluate default sequences asynchronously the last
+     * one created may belong to another thread, so named sequences should be
+     * awaited instead.
+     *
+     * @param tensors The tensors to be used in the operation recorded
+     * @param params Template parameters that will be used to initialise
+     * Operation to allow for extensible configurations on initialisation
+     */
+    void evalOpAwaitDefault(uint64_t waitFor = UINT64_MAX)
+    {
+        SPDLOG_DEBUG("Kompute Manager evalOpAwaitDefault triggered");
+        this->evalOpAwait(this->currentDefaultSequenceName(), waitFor);
+    }
+
+    /**
+     * Function that simplifies the common workflow of tensor creation and
+     * initialization. It will take the constructor parameters for a Tensor
+     * and will will us it to create a new Tensor and then create it using
+     * the OpCreateTensor command.
+     *
+     * @param data The data to initialize the tensor with
+     * @param tensorType The type of tensor to initialize
+     * @returns Initialized Tensor with memory Syncd to GPU device
+     */
+    std::shared_ptr<Tensor> buildTensor(
+      const std::vector<float>& data,
+      Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice)
+    {
+        SPDLOG_DEBUG("Kompute Manager createInitTensor triggered");
+
+        SPDLOG_DEBUG("Kompute Manager creating new tensor shared ptr");
+        std::shared_ptr<Tensor> tensor =
+          std::make_shared<Tensor>(kp::Tensor(data, tensorType));
+
+        this->evalOpDefault<OpTensorCreate>({ tensor });
+
+        return tensor;
+    }
+
+    /**
+     * Returns the shader cache owned by the manager, which is shared across
+     * all the algorithm operations recorded in the managed sequences.
+     *
+     * @return Shared pointer to the manager owned shader cache
+     */
+    std::shared_ptr<ShaderCache> shaderCache();
+
+    /**
+     * Returns the descriptor pool arena owned by the manager, which is shared
+     * across all the algorithm operations recorded in the managed sequences.
+     *
+     * @return Shared pointer to the manager owned descriptor pool arena
+     */
+    std::shared_ptr<DescriptorPoolArena> descriptorPoolArena();
+
+    /**
+     * Create a streaming transfer engine owned by the manager, which uploads
+     * and downloads tensor data in chunks from a worker thread on the queue
+     * provided. A queue not used by the sequences should be provided, which
+     * can be requested by passing the compute queue family index more than
+     * once in the family queue indices of the manager constructor.
+     *
+     * @param queueIndex The queue to use from the available queues
+     * @param chunkSize Size in bytes of each staging chunk
+     * @param numChunks Number of staging chunks that can be in flight
+     * @return Shared pointer to the manager owned transfer engine
+     */
+    std::shared_ptr<TransferEngine> createTransferEngine(
+      uint32_t queueIndex = 0,
+      uint64_t chunkSize = KP_DEFAULT_TRANSFER_CHUNK_SIZE,
+      uint32_t numChunks = KP_DEFAULT_TRANSFER_NUM_CHUNKS);
+
+  private:
+    // -------------- OPTIONALLY OWNED RESOURCES
+    std::shared_ptr<vk::Instance> mInstance = nullptr;
+    bool mFreeInstance = false;
+    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice = nullptr;
+    uint32_t mPhysicalDeviceIndex = -1;
+    std::shared_ptr<vk::Device> mDevice = nullptr;
+    bool mFreeDevice = false;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::unordered_map<std::string, std::shared_ptr<Sequence>>
+      mManagedSequences;
+    std::mutex mManagedSequencesMutex;
+    std::vector<std::shared_ptr<TransferEngine>> mTransferEngines;
+
+    std::vector<uint32_t> mComputeQueueFamilyIndices;
+    std::vector<std::shared_ptr<vk::Queue>> mComputeQueues;
+    std::vector<std::shared_ptr<std::mutex>> mComputeQueueMutexes;
+    std::vector<std::string> mEnabledExtensions;
+
+    std::shared_ptr<ShaderCache> mShaderCache = nullptr;
+    std::shared_ptr<DescriptorPoolArena> mDescriptorPoolArena = nullptr;
+    std::shared_ptr<CompletionThread> mCompletionThread = nullptr;
+    std::mutex mCompletionThreadMutex;
+
+    uint32_t mCurrentSequenceIndex = -1;
+
+#if DEBUG
+#ifndef KOMPUTE_DISABLE_VK_DEBUG_LAYERS
+    vk::DebugReportCallbackEXT mDebugReportCallback;
+    vk::DispatchLoaderDynamic mDebugDispatcher;
+#endif
+#endif
+
+    // Create functions
+    void createInstance();
+    void createDevice(const std::vector<uint32_t>& familyQueueIndices = {},
+                      const std::vector<std::string>& requiredExtensions = {});
+    void createComputeQueues();
+    static std::vector<DeviceInfo> enumerateDevices(
+      const vk::Instance& instance);
+    static uint32_t findComputeQueueFamilyIndex(
+      const vk::PhysicalDevice& physicalDevice);
+    std::shared_ptr<Sequence> createSequence(uint32_t queueIndex);
+    std::shared_ptr<CompletionThread> getOrCreateCompletionThread();
+    EvalFuture findEvalFuture(std::shared_ptr<Sequence> sequence);
+
+    // Sequence registry functions
+    std::shared_ptr<Sequence> findManagedSequence(
+      const std::string& sequenceName);
+    std::string nextDefaultSequenceName();
+    std::string currentDefaultSequenceName();
+};
+
+} // End namespace kp
+
+#include <exception>
+
+namespace kp {
+
+/**
+    Operation that syncs tensor's device by mapping local data into the device memory. For TensorTypes::eDevice it will use a staging tensor to perform the copy, unless the tensor is in unified memory in which case it is mapped directly. For TensorTypes::eStaging it will only copy the data and perform a map, which will be executed during the record (as opposed to during the sequence eval/submit). This function cannot be carried out for TensorTypes::eStaging.
+*/
+class OpTensorSyncDevice : public OpBase
+{
+  public:
+    OpTensorSyncDevice();
+
+    /**
+     * Default constructor with parameters that provides the core vulkan resources and the tensors that will be used in the operation. The tensos provided cannot be of type TensorTypes::eStorage.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that will be used to create in operation.
+     * @param ranges (Optional) Ranges of elements to sync for all the tensors, which otherwise syncs the ranges marked as dirty in each tensor or the whole tensor if none are marked.
+     */
+    OpTensorSyncDevice(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                   std::shared_ptr<vk::Device> device,
+                   std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                   std::vector<std::shared_ptr<Tensor>> tensors,
+                   std::vector<Tensor::Range> ranges = {});
+
+    /**
+     * Default destructor. This class does not manage memory so it won't be expecting the parent to perform a release.
+     */
+    ~OpTensorSyncDevice() override;
+
+    /**
+     * Performs basic checks such as ensuring that there is at least one tensor provided, that they are initialized and that they are not of type TensorTpes::eStaging. For staging tensors in host memory, the map is performed during the init function.
+     */
+    void init() override;
+
+    /**
+     * For device tensors, it records the copy command to the device tensor from the temporary staging tensor, with one copy region per coalesced range. The copy regions are resolved from the dirty ranges when recorded, but the dirty ranges are only cleared when the operation is evaluated.
+     */
+    void record() override;
+
+    /**
+     * Maps the ranges of the local data into the staging tensors, or into the tensors themselves if they are of type TensorTypes::eStaging or in unified memory, and clears the dirty ranges of the tensors. The ranges of tensors mapped directly are resolved from the dirty ranges on every evaluation. Tensors transferred through a staging tensor always transfer the ranges recorded, and ranges marked dirty after recording that are not within them throw an exception as the operation has to be recorded again.
+     */
+    virtual void preEval() override;
+
+    /**
+     * Does not perform any postEval commands.
+     */
+    virtual void postEval() override;
+
+  private:
+    // Never owned resources
+    std::vector<std::shared_ptr<Tensor>> mStagingTensors;
+
+    // Always owned resources
+    std::vector<Tensor::Range> mRanges;
+    std::vector<std::vector<Tensor::Range>> mRecordedRanges;
+
+    // Resolves the explicit ranges, the dirty ranges or the whole tensor
+    std::vector<Tensor::Range> resolveRanges(std::shared_ptr<Tensor> tensor);
+};
+
+} // End namespace kp
+
+namespace kp {
+
+/**
+    Operation that syncs tensor's local data by mapping the data from device memory into the local vector. For TensorTypes::eDevice it will use a staging tensor to perform the copy, unless the tensor is in unified memory in which case it is mapped directly. For TensorTypes::eStaging it will only copy the data and perform a map, which will be executed during the postSubmit (there will be no copy during the sequence eval/submit). This function cannot be carried out for TensorTypes::eStaging.
+*/
+class OpTensorSyncLocal : public OpBase
+{
+  public:
+    OpTensorSyncLocal();
+
+    /**
+     * Default constructor with parameters that provides the core vulkan resources and the tensors that will be used in the operation. The tensors provided cannot be of type TensorTypes::eStorage.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that will be used to create in operation.
+     * @param ranges (Optional) Ranges of elements to sync for all the tensors, which otherwise syncs the whole tensors.
+     */
+    OpTensorSyncLocal(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                   std::shared_ptr<vk::Device> device,
+                   std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                   std::vector<std::shared_ptr<Tensor>> tensors,
+                   std::vector<Tensor::Range> ranges = {});
+
+    /**
+     * Default destructor. This class manages the memory of the staging tensors it owns but these are released in the postSubmit, before it arrives to the destructor.
+     */
+    ~OpTensorSyncLocal() override;
+
+    /**
+     * Performs basic checks such as ensuring that there is at least one tensor provided, that they are initialized and that they are not of type TensorTpes::eStaging.
+     */
+    void init() override;
+
+    /**
+     * For device tensors, it records the copy command into the staging tensor from the device tensor, with one copy region per coalesced range.
+     */
+    void record() override;
+
+    /**
+     * Does not perform any preEval commands.
+     */
+    virtual void preEval() override;
+
+    /**
+     * For host tensors it performs the map command from the host memory into local memory.
+     */
+    virtual void postEval() override;
+
+  private:
+    // Never owned resources
+    std::vector<std::shared_ptr<Tensor>> mStagingTensors;
+
+    // Always owned resources
+    std::vector<Tensor::Range> mRanges;
+    std::vector<std::vector<Tensor::Range>> mTensorRanges;
+};
+
+} // End namespace kp
+
+namespace kp {
+
+/**
+    Coordinator which owns one kp::Manager per device to run data parallel
+   workloads. Tensors are sharded along their leading dimension with one shard
+   per device, the same operation is evaluated on the shards of every device
+   in parallel, and the shards are gathered or all-reduced back on the host.
+
+    The same physical device index can be provided several times, in which
+   case each manager creates its own logical device on it, which allows
+   running the multi device paths with a single GPU or CPU implementation.
+*/
+class MultiDeviceManager
+{
+  public:
+    /**
+     * Reductions supported by allReduce.
+     */
+    enum class ReduceOps
+    {
+        eSum = 0,
+        eMean = 1,
+    };
+
+    /**
+     * Constructor which creates a manager for each of the physical devices
+     * provided.
+     *
+     * @param physicalDeviceIndices The indices of the physical devices to use
+     */
+    MultiDeviceManager(const std::vector<uint32_t>& physicalDeviceIndices);
+
+    /**
+     * Constructor which coordinates managers created by the application, for
+     * example with a kp::DevicePolicy each.
+     *
+     * @param managers The managers of each device
+     */
+    MultiDeviceManager(const std::vector<std::shared_ptr<Manager>>& managers);
+
+    /**
+     * Destructor which releases the managers, destroying their resources
+     * unless also referenced by the application.
+     */
+    ~MultiDeviceManager();
+
+    /**
+     * Returns the number of devices coordinated.
+     *
+     * @return The number of managers
+     */
+    uint32_t size();
+
+    /**
+     * Returns the manager of a device.
+     *
+     * @param deviceIndex The position of the device in the coordinator
+     * @return Shared pointer to the manager of the device
+     */
+    std::shared_ptr<Manager> manager(uint32_t deviceIndex);
+
+    /**
+     * Splits the data along its leading dimension into one tensor per device,
+     * each created in the memory of its device. The rows are distributed as
+     * evenly as possible, with the first devices receiving one more row when
+     * they cannot be split equally.
+     *
+     * @param data The data to shard
+     * @param rowSize Number of elements in each row of the leading dimension
+     * @param tensorType The type of the tensors created on each device
+     * @return The shard of each device in device order
+     */
+    std::vector<std::shared_ptr<Tensor>> shard(
+      const std::vector<float>& data,
+      uint32_t rowSize = 1,
+      Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice);
+
+    /**
+     * Creates a full copy of the data in the memory of each device, as used
+     * for weights shared by all the shards.
+     *
+     * @param data The data to replicate
+     * @param tensorType The type of the tensors created on each device
+     * @return The copy of each device in device order
+     */
+    std::vector<std::shared_ptr<Tensor>> replicate(
+      const std::vector<float>& data,
+      Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice);
+
+    /**
+     * Syncs the shards of each device into local memory in parallel and
+     * concatenates them in device order.
+     *
+     * @param shards The shard of each device in device order
+     * @return The gathered data
+     */
+    std::vector<float> gather(
+      const std::vector<std::shared_ptr<Tensor>>& shards);
+
+    /**
+     * Reduces tensors of the same size across the devices on the host, such
+     * as the gradients computed from each shard, and syncs the result back
+     * into the tensor of each device.
+     *
+     * @param tensors The tensor of each device in device order
+     * @param reduceOp The reduction to apply element wise
+     * @return The reduced data
+     */
+    std::vector<float> allReduce(
+      const std::vector<std::shared_ptr<Tensor>>& tensors,
+      ReduceOps reduceOp = ReduceOps::eSum);
+
+    /**
+     * Evaluates the same operation on every device in parallel, which
+     * receives the shard of each of the sharded tensors provided for its
+     * device, and waits for all of them to finish, throwing if the
+     * evaluation of any device failed.
+     *
+     * @param shardedTensors The shards of each tensor of the operation, as
+     * returned by shard or replicate
+     * @param params Template parameters that will be used to initialise
+     * Operation to allow for extensible configurations on initialisation
+     */
+    template<typename T, typename... TArgs>
+    void evalOp(
+      const std::vector<std::vector<std::shared_ptr<Tensor>>>& shardedTensors,
+      const TArgs&... params)
+    {
+        SPDLOG_DEBUG("Kompute MultiDeviceManager evalOp triggered");
+
+        std::vector<EvalFuture> futures;
+        try {
+            for (uint32_t i = 0; i < this->mManagers.size(); i++) {
+                futures.push_back(this->mManagers[i]->evalOpAsyncDefault<T>(
+                  this->deviceTensors(shardedTensors, i), params...));
+            }
+        } catch (...) {
+            this->awaitAll(futures, std::current_exception());
+        }
+        this->awaitAll(futures);
+    }
+
+  private:
+    // -------------- ALWAYS OWNED RESOURCES
+    std::vector<std::shared_ptr<Manager>> mManagers;
+
+    std::vector<std::shared_ptr<Tensor>> deviceTensors(
+      const std::vector<std::vector<std::shared_ptr<Tensor>>>& shardedTensors,
+      uint32_t deviceIndex);
+    void awaitAll(std::vector<EvalFuture>& futures,
+                  std::exception_ptr exception = nullptr);
+    void validateTensors(const std::vector<std::shared_ptr<Tensor>>& tensors);
+};
+
+} // End namespace kp
+
+namespace kp {
+
+/**
+ * Converts the shaders provided to algorithms into the SPIR-V binary format
+ * that is required by vkCreateShaderModule. SPIR-V binaries are returned
+ * unchanged, and GLSL compute shader source, such as the shaders generated
+ * by the operations at runtime, is compiled with glslang when Kompute is
+ * built with KOMPUTE_OPT_ENABLE_SHADER_COMPILATION. Without it GLSL source is
+ * passed to the driver as it is, which is only accepted by devices with the
+ * VK_NV_glsl_shader extension.
+ */
+class ShaderCompiler
+{
+  public:
+    /**
+     * Returns true if the data provided starts with the SPIR-V magic number.
+     *
+     * @param data The bytes of the shader
+     * @param size The number of bytes of the shader
+     * @return Boolean stating whether the shader is a SPIR-V binary
+     */
+    static bool isSpirv(const char* data, size_t size);
+
+    /**
+     * Returns true if Kompute was built with the runtime shader compiler.
+     *
+     * @return Boolean stating whether GLSL source can be compiled
+     */
+    static bool isCompilationEnabled();
+
+    /**
+     * Compiles GLSL compute shader source into SPIR-V targeting Vulkan 1.1,
+     * throwing with the log of the compiler if it fails or if Kompute was
+     * built without the runtime shader compiler.
+     *
+     * @param source The GLSL source of the compute shader
+     * @return The bytes of the SPIR-V binary
+     */
+    static std::vector<char> compileSource(const std::string& source);
+
+    /**
+     * Returns the SPIR-V binary of the shader provided, compiling it if it is
+     * GLSL source and the runtime shader compiler is enabled.
+     *
+     * @param data The bytes of the shader in spirv or raw format
+     * @param size The number of bytes of the shader
+     * @return The bytes of the shader to create the shader module with
+     */
+    static std::vector<char> toSpirv(const char* data, size_t size);
+};
+
+} // End namespace kp
+
+#include <fstream>
+
+namespace kp {
+
+/**
+ * Operation base class to simplify the creation of operations that require
+ * right hand and left hand side datapoints together with a single output.
+ * The expected data passed is two input tensors and one output tensor.
+ */
+class OpAlgoLhsRhsOut : public OpAlgoBase
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpAlgoLhsRhsOut();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation
+     * @param freeTensors Whether operation manages the memory of the Tensors
+     * @param komputeWorkgroup Optional parameter to specify the layout for processing
+     */
+    OpAlgoLhsRhsOut(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>> tensors,
+           KomputeWorkgroup komputeWorkgroup = KomputeWorkgroup());
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpAlgoLhsRhsOut() override;
+
+    /**
+     * The init function is responsible for ensuring that all of the tensors
+     * provided are aligned with requirements such as LHS, RHS and Output
+     * tensors, and  creates the algorithm component which processes the
+     * computation.
+     */
+    virtual void init() override;
+
+    /**
+     * This records the commands that are to be sent to the GPU. This includes
+     * the barriers that ensure the memory has been copied before going in and
+     * out of the shader, as well as the dispatch operation that sends the
+     * shader processing to the gpu. This function also records the GPU memory
+     * copy of the output data for the staging buffer so it can be read by the
+     * host.
+     */
+    virtual void record() override;
+
+    /**
+     * Executes after the recorded commands are submitted, and performs a copy
+     * of the GPU Device memory into the staging buffer so the output data can
+     * be retrieved.
+     */
+    virtual void postEval() override;
+
+  protected:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<Tensor> mTensorLHS; ///< Reference to the parameter used in the left hand side equation of the shader
+    std::shared_ptr<Tensor> mTensorRHS; ///< Reference to the parameter used in the right hand side equation of the shader
+    std::shared_ptr<Tensor> mTensorOutput; ///< Reference to the parameter used in the output of the shader and will be copied with a staging vector
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::shared_ptr<Tensor> mTensorOutputStaging; ///< Staging temporary tensor user do to copy the output of the tensor
+};
+
+} // End namespace kp
+
+namespace kp {
+
+/**
+ * Pair of tensors of the same size and type used by iterative kernels, where
+ * one tensor is read and the other is written on each iteration and the roles
+ * are swapped afterwards. This avoids copying the output back into the input
+ * between iterations, as only the descriptor bindings are alternated.
+ */
+class TensorDoubleBuffer
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    TensorDoubleBuffer();
+
+    /**
+     * Default constructor with the data that will be used to create both of
+     * the tensors, which initially contain the same data.
+     *
+     * @param data Vector of data that will be used by both tensors
+     * @param tensorType Type for both tensors which is of type TensorTypes
+     */
+    TensorDoubleBuffer(
+      const std::vector<float>& data,
+      Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice);
+
+    /**
+     * Constructor with two existing tensors, where the first tensor is the
+     * one initially read from and the second the one initially written to.
+     *
+     * @param front Tensor that is initially read from
+     * @param back Tensor that is initially written to
+     */
+    TensorDoubleBuffer(std::shared_ptr<Tensor> front,
+                       std::shared_ptr<Tensor> back);
+
+    /**
+     * Returns the tensor that holds the latest data and is read from in the
+     * next iteration.
+     *
+     * @return Shared pointer to the tensor currently read from
+     */
+    std::shared_ptr<Tensor> read();
+
+    /**
+     * Returns the tensor that is written to in the next iteration.
+     *
+     * @return Shared pointer to the tensor currently written to
+     */
+    std::shared_ptr<Tensor> write();
+
+    /**
+     * Returns the tensor with the index provided, where the tensor with index
+     * 0 is the first tensor provided or created regardless of the roles.
+     *
+     * @param index The index of the tensor which is either 0 or 1
+     * @return Shared pointer to the tensor at the index provided
+     */
+    std::shared_ptr<Tensor> tensor(uint32_t index);
+
+    /**
+     * Returns both of the tensors in their creation order, which can be used
+     * to create or synchronise them together.
+     *
+     * @return Vector containing both tensors
+     */
+    std::vector<std::shared_ptr<Tensor>> tensors();
+
+    /**
+     * Returns the index of the tensor that is currently read from.
+     *
+     * @return Index of the read tensor which is either 0 or 1
+     */
+    uint32_t readIndex();
+
+    /**
+     * Swaps the read and write roles of the tensors.
+     */
+    void swap();
+
+  private:
+    // -------------- ALWAYS OWNED RESOURCES
+    std::shared_ptr<Tensor> mTensors[2];
+    uint32_t mReadIndex = 0;
+};
+
+} // End namespace kp
+
+namespace kp {
+
+/**
+ * Operation that runs a shader for a number of iterations over a
+ * kp::TensorDoubleBuffer, where the shader reads from binding 0 and writes to
+ * binding 1. The bindings of the two tensors are swapped between iterations
+ * so the output of one iteration is the input of the next without any copies.
+ * The tensors provided must start with the read and write tensors of the
+ * double buffer, followed by any other tensors which keep their bindings.
+ */
+class OpAlgoDoubleBuffer : public OpAlgoBase
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpAlgoDoubleBuffer();
+
+    /**
+     * Constructor that enables a file to be passed to the operation with
+     * the contents of the shader. This can be either in raw format or in
+     * compiled SPIR-V binary format.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, starting with the read and write tensors of the double buffer
+     * @param doubleBuffer Double buffer whose tensor roles are alternated
+     * @param iterations Number of times the shader is dispatched per evaluation
+     * @param shaderFilePath Parameter to specify the shader to load (either in spirv or raw format)
+     * @param komputeWorkgroup Optional parameter to specify the layout for processing
+     */
+    OpAlgoDoubleBuffer(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           std::shared_ptr<TensorDoubleBuffer> doubleBuffer,
+           uint32_t iterations,
+           std::string shaderFilePath,
+           KomputeWorkgroup komputeWorkgroup = KomputeWorkgroup());
+
+    /**
+     * Constructor that enables raw shader data to be passed to the main operation
+     * which can be either in raw shader glsl code or in compiled SPIR-V binary.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, starting with the read and write tensors of the double buffer
+     * @param doubleBuffer Double buffer whose tensor roles are alternated
+     * @param iterations Number of times the shader is dispatched per evaluation
+     * @param shaderDataRaw Parameter to specify the shader data either in binary or raw form
+     * @param komputeWorkgroup Optional parameter to specify the layout for processing
+     */
+    OpAlgoDoubleBuffer(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           std::shared_ptr<TensorDoubleBuffer> doubleBuffer,
+           uint32_t iterations,
+           const std::vector<char>& shaderDataRaw,
+           KomputeWorkgroup komputeWorkgroup = KomputeWorkgroup());
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpAlgoDoubleBuffer() override;
+
+    /**
+     * Validates that the first two tensors are the read and write tensors of
+     * the double buffer and initialises the algorithm with them.
+     */
+    virtual void init() override;
+
+    /**
+     * Records all the iterations, with a barrier between iterations on the
+     * tensor written so the next iteration reads the latest data, and with the
+     * bindings of the double buffer tensors swapped on each iteration.
+     */
+    virtual void record() override;
+
+    /**
+     * Validates that the double buffer roles are the same as when the
+     * operation was recorded, as the recorded bindings cannot be changed.
+     */
+    virtual void preEval() override;
+
+    /**
+     * Swaps the double buffer roles if an odd number of iterations was run,
+     * so the read tensor of the double buffer contains the latest output.
+     */
+    virtual void postEval() override;
+
+  protected:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<TensorDoubleBuffer> mDoubleBuffer; ///< Double buffer with the tensors that alternate read and write roles
+
+    // -------------- ALWAYS OWNED RESOURCES
+    uint32_t mIterations = 1;
+    uint32_t mRecordedReadIndex = 0;
+};
+
+} // End namespace kp
+
+#include <fstream>
+
+#if RELEASE
+
+#endif
+
+namespace kp {
+
+/**
+ * Operation that performs multiplication on two tensors and outpus on third
+ * tensor.
+ */
+class OpMult : public OpAlgoBase
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpMult() {
+
+    }
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation
+     * @param komputeWorkgroup Optional parameter to specify the layout for processing
+     */
+    OpMult(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>> tensors,
+           KomputeWorkgroup komputeWorkgroup = KomputeWorkgroup())
+      : OpAlgoBase(physicalDevice, device, commandBuffer, tensors, "", komputeWorkgroup)
+    {
+        SPDLOG_DEBUG("Kompute OpMult constructor with params");
+
+#ifndef RELEASE
+        this->mShaderFilePath = "shaders/glsl/opmult.comp";
+#endif
+    }
+
+#if RELEASE
+    /**
+     * If RELEASE=1 it will be using the static version of the shader which is 
+     * loaded using this file directly. Otherwise it should not override the function.
+     */
+    std::vector<char> fetchSpirvBinaryData() override
+    {
+        SPDLOG_WARN(
+          "Kompute OpMult Running shaders directly from header");
+
+        return std::vector<char>(
+          shader_data::shaders_glsl_opmult_comp_spv,
+          shader_data::shaders_glsl_opmult_comp_spv +
+            kp::shader_data::shaders_glsl_opmult_comp_spv_len);
+
+    }
+#endif
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    ~OpMult() override {
+        SPDLOG_DEBUG("Kompute OpMult destructor started");
+    }
+
+};
+
+} // End namespace kp
+
+#define KP_DEFAULT_ELEMENTWISE_WORKGROUP_SIZE 256
+
+namespace kp {
+
+/**
+ * Expression evaluated element wise by kp::OpElementwise, composed of the
+ * input tensors of the operation, scalar constants, arithmetic operators and
+ * math functions. The whole expression is generated into a single shader, so
+ * chains such as relu(a * b + c) are fused without writing the intermediate
+ * results into device memory.
+ */
+class ElementwiseExpr
+{
+  public:
+    /**
+     * Expression reading the element of an input tensor of the operation.
+     *
+     * @param index The position of the tensor in the operation tensors
+     * @return The expression of the input
+     */
+    static ElementwiseExpr input(uint32_t index);
+
+    /**
+     * Expression of a scalar constant broadcast to every element, which is
+     * generated into the shader code.
+     *
+     * @param value The value of the constant
+     * @return The expression of the constant
+     */
+    static ElementwiseExpr constant(float value);
+
+    static ElementwiseExpr relu(const ElementwiseExpr& x);
+    static ElementwiseExpr sigmoid(const ElementwiseExpr& x);
+    static ElementwiseExpr exp(const ElementwiseExpr& x);
+    static ElementwiseExpr log(const ElementwiseExpr& x);
+    static ElementwiseExpr tanh(const ElementwiseExpr& x);
+    static ElementwiseExpr abs(const ElementwiseExpr& x);
+    static ElementwiseExpr sqrt(const ElementwiseExpr& x);
+    static ElementwiseExpr max(const ElementwiseExpr& lhs,
+                               const ElementwiseExpr& rhs);
+    static ElementwiseExpr min(const ElementwiseExpr& lhs,
+                               const ElementwiseExpr& rhs);
+
+    /**
+     * Comparisons of two expressions, which evaluate to one where the
+     * comparison holds and to zero otherwise, as used for masks and for the
+     * predicates of kp::OpCompact.
+     */
+    static ElementwiseExpr greater(const ElementwiseExpr& lhs,
+                                   const ElementwiseExpr& rhs);
+    static ElementwiseExpr less(const ElementwiseExpr& lhs,
+                                const ElementwiseExpr& rhs);
+    static ElementwiseExpr equal(const ElementwiseExpr& lhs,
+                                 const ElementwiseExpr& rhs);
+
+    ElementwiseExpr operator-() const;
+    ElementwiseExpr operator+(const ElementwiseExpr& rhs) const;
+    ElementwiseExpr operator-(const ElementwiseExpr& rhs) const;
+    ElementwiseExpr operator*(const ElementwiseExpr& rhs) const;
+    ElementwiseExpr operator/(const ElementwiseExpr& rhs) const;
+    ElementwiseExpr operator+(float rhs) const;
+    ElementwiseExpr operator-(float rhs) const;
+    ElementwiseExpr operator*(float rhs) const;
+    ElementwiseExpr operator/(float rhs) const;
+
+    /**
+     * Generates the GLSL code of the expression.
+     *
+     * @param inputs The GLSL code reading the element of each input tensor
+     * @param type The GLSL type the expression is evaluated as, either float
+     * or vec4
+     * @return The GLSL code of the expression
+     */
+    std::string generate(const std::vector<std::string>& inputs,
+                         const std::string& type) const;
+
+    /**
+     * Returns the number of input tensors read by the expression.
+     *
+     * @return One more than the highest input index used
+     */
+    uint32_t numInputs() const;
+
+  private:
+    enum class NodeTypes
+    {
+        eInput,
+        eConstant,
+        eUnary,
+        eBinary,
+        eComparison,
+        eFunction,
+    };
+
+    struct Node
+    {
+        NodeTypes nodeType;
+        std::string op;
+        uint32_t inputIndex = 0;
+        float value = 0;
+        std::vector<std::shared_ptr<const Node>> args;
+    };
+
+    std::shared_ptr<const Node> mNode;
+
+    static ElementwiseExpr make(NodeTypes nodeType,
+                                const std::string& op,
+                                std::vector<ElementwiseExpr> args);
+    static std::string generateNode(const std::shared_ptr<const Node>& node,
+                                    const std::vector<std::string>& inputs,
+                                    const std::string& type);
+    static uint32_t numInputsNode(const std::shared_ptr<const Node>& node);
+};
+
+ElementwiseExpr
+operator+(float lhs, const ElementwiseExpr& rhs);
+ElementwiseExpr
+operator-(float lhs, const ElementwiseExpr& rhs);
+ElementwiseExpr
+operator*(float lhs, const ElementwiseExpr& rhs);
+ElementwiseExpr
+operator/(float lhs, const ElementwiseExpr& rhs);
+
+/**
+ * Operation that evaluates an element wise expression over input tensors and
+ * writes it into the last tensor provided. The shader is generated from the
+ * expression, processes four elements per invocation with vec4 loads and
+ * stores, and uses a workgroup size within the limits of the device, striding
+ * over the tensors when they exceed the dispatch limits.
+ *
+ * The inputs are broadcast following the NumPy rules based on the shape of
+ * each tensor, so for example a bias of shape (N) can be added to each row of
+ * a tensor of shape (M, N). The strides of each broadcast input are generated
+ * into the shader, so the index computation is specialised for the shapes
+ * when the pipeline is created.
+ *
+ * As the shader is GLSL source it is compiled to SPIR-V by kp::ShaderCompiler,
+ * which requires Kompute to be built with KOMPUTE_OPT_ENABLE_SHADER_COMPILATION.
+ * The operations with a fixed unary, binary or scalar expression, such as
+ * kp::OpAdd or kp::OpRelu, instead use precompiled shaders which receive the
+ * operation and the broadcast strides as specialization constants, so only
+ * fused expressions require the shader compiler.
+ */
+class OpElementwise : public OpAlgoBase
+{
+  public:
+    /**
+     * Types of the operations with a fixed expression, which are evaluated
+     * with the precompiled shaders, or eExpression for fused expressions
+     * which are generated into a shader.
+     */
+    enum class OperationTypes
+    {
+        eExpression,
+        eAdd,
+        eSub,
+        eDiv,
+        eRelu,
+        eSigmoid,
+        eExp,
+        eTanh,
+        eScale,
+        eAddScalar,
+    };
+
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpElementwise();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input tensors followed by the output tensor
+     * @param expression Expression evaluated for each element of the output
+     */
+    OpElementwise(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                  std::shared_ptr<vk::Device> device,
+                  std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                  std::vector<std::shared_ptr<Tensor>>& tensors,
+                  const ElementwiseExpr& expression);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpElementwise() override;
+
+    /**
+     * Validates that the inputs can be broadcast to the shape of the output,
+     * generates the shader of the expression, or selects the precompiled
+     * shader of the operation type, and creates the algorithm that evaluates
+     * it.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatch of the shader, together with the barriers that make
+     * the writes of previous operations visible to the shader and the output
+     * visible to subsequent operations, so element wise operations can be
+     * chained within a sequence.
+     */
+    virtual void record() override;
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    ElementwiseExpr mExpression;
+    OperationTypes mOperationType = OperationTypes::eExpression;
+    float mScalar = 0;
+    uint32_t mWorkgroupSize = KP_DEFAULT_ELEMENTWISE_WORKGROUP_SIZE;
+    std::vector<uint32_t> mShape;
+
+    /**
+     * Generates the GLSL code of the shader, which is overridden by the
+     * operations that change how the inputs are indexed.
+     *
+     * @return The GLSL code of the shader
+     */
+    virtual std::string generateShader();
+
+    /**
+     * Returns the GLSL code reading the element of each input tensor for the
+     * given vec4 index and component, where the component is empty for the
+     * vec4 load.
+     *
+     * @param vecIndex The GLSL variable holding the vec4 index
+     * @param component The GLSL code of the component, or empty for vec4
+     * @return The GLSL code reading each input
+     */
+    virtual std::vector<std::string> generateInputs(
+      const std::string& vecIndex,
+      const std::string& component);
+
+    /**
+     * Returns whether an input is broadcast, in which case the index of its
+     * elements is computed from the index of the output element.
+     *
+     * @param tensorIndex The position of the input in the operation tensors
+     * @return Whether the input is smaller than the output
+     */
+    bool isBroadcast(uint32_t tensorIndex);
+
+    /**
+     * Returns whether the vec4 of output elements of a broadcast input can be
+     * read with a single vec4 load instead of four scalar loads.
+     *
+     * @param tensorIndex The position of the input in the operation tensors
+     * @return Whether the input is read with vec4 loads
+     */
+    bool isBroadcastVectorizable(uint32_t tensorIndex);
+
+    /**
+     * Generates the GLSL code computing the index of the element of a
+     * broadcast input from the index e of the output element.
+     *
+     * @param tensorIndex The position of the input in the operation tensors
+     * @return The GLSL code of the index
+     */
+    std::string generateBroadcastIndex(uint32_t tensorIndex);
+
+  private:
+    std::vector<uint32_t> broadcastShape(uint32_t tensorIndex);
+    void setOperationShader();
+};
+
+} // End namespace kp
+
+namespace kp {
+
+/**
+ * Operation that adds two tensors element wise and outputs on a third tensor,
+ * broadcasting the shapes of the inputs.
+ */
+class OpAdd : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpAdd() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the lhs, rhs and output tensors
+     */
+    OpAdd(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+          std::shared_ptr<vk::Device> device,
+          std::shared_ptr<vk::CommandBuffer> commandBuffer,
+          std::vector<std::shared_ptr<Tensor>> tensors)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::input(0) + ElementwiseExpr::input(1))
+    {
+        SPDLOG_DEBUG("Kompute OpAdd constructor with params");
+
+        this->mOperationType = OperationTypes::eAdd;
+    }
+};
+
+/**
+ * Operation that subtracts the second tensor from the first one element wise
+ * and outputs on a third tensor, broadcasting the shapes of the inputs.
+ */
+class OpSub : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpSub() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the lhs, rhs and output tensors
+     */
+    OpSub(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+          std::shared_ptr<vk::Device> device,
+          std::shared_ptr<vk::CommandBuffer> commandBuffer,
+          std::vector<std::shared_ptr<Tensor>> tensors)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::input(0) - ElementwiseExpr::input(1))
+    {
+        SPDLOG_DEBUG("Kompute OpSub constructor with params");
+
+        this->mOperationType = OperationTypes::eSub;
+    }
+};
+
+/**
+ * Operation that divides the first tensor by the second one element wise and
+ * outputs on a third tensor, broadcasting the shapes of the inputs.
+ */
+class OpDiv : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpDiv() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the lhs, rhs and output tensors
+     */
+    OpDiv(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+          std::shared_ptr<vk::Device> device,
+          std::shared_ptr<vk::CommandBuffer> commandBuffer,
+          std::vector<std::shared_ptr<Tensor>> tensors)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::input(0) / ElementwiseExpr::input(1))
+    {
+        SPDLOG_DEBUG("Kompute OpDiv constructor with params");
+
+        this->mOperationType = OperationTypes::eDiv;
+    }
+};
+
+/**
+ * Operation that applies the rectified linear unit max(x, 0) element wise to
+ * a tensor and outputs on a second tensor.
+ */
+class OpRelu : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpRelu() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     */
+    OpRelu(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>> tensors)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::relu(ElementwiseExpr::input(0)))
+    {
+        SPDLOG_DEBUG("Kompute OpRelu constructor with params");
+
+        this->mOperationType = OperationTypes::eRelu;
+    }
+};
+
+/**
+ * Operation that applies the logistic function 1 / (1 + exp(-x)) element wise
+ * to a tensor and outputs on a second tensor.
+ */
+class OpSigmoid : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpSigmoid() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     */
+    OpSigmoid(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+              std::shared_ptr<vk::Device> device,
+              std::shared_ptr<vk::CommandBuffer> commandBuffer,
+              std::vector<std::shared_ptr<Tensor>> tensors)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::sigmoid(ElementwiseExpr::input(0)))
+    {
+        SPDLOG_DEBUG("Kompute OpSigmoid constructor with params");
+
+        this->mOperationType = OperationTypes::eSigmoid;
+    }
+};
+
+/**
+ * Operation that applies the exponential function element wise to a tensor
+ * and outputs on a second tensor.
+ */
+class OpExp : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpExp() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     */
+    OpExp(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+          std::shared_ptr<vk::Device> device,
+          std::shared_ptr<vk::CommandBuffer> commandBuffer,
+          std::vector<std::shared_ptr<Tensor>> tensors)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::exp(ElementwiseExpr::input(0)))
+    {
+        SPDLOG_DEBUG("Kompute OpExp constructor with params");
+
+        this->mOperationType = OperationTypes::eExp;
+    }
+};
+
+/**
+ * Operation that applies the hyperbolic tangent element wise to a tensor and
+ * outputs on a second tensor.
+ */
+class OpTanh : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpTanh() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     */
+    OpTanh(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>> tensors)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::tanh(ElementwiseExpr::input(0)))
+    {
+        SPDLOG_DEBUG("Kompute OpTanh constructor with params");
+
+        this->mOperationType = OperationTypes::eTanh;
+    }
+};
+
+/**
+ * Operation that multiplies a tensor by a scalar element wise and outputs on
+ * a second tensor. The scalar is passed to the shader as a specialization
+ * constant.
+ */
+class OpScale : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpScale() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     * @param scale The scalar each element is multiplied by
+     */
+    OpScale(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+            std::shared_ptr<vk::Device> device,
+            std::shared_ptr<vk::CommandBuffer> commandBuffer,
+            std::vector<std::shared_ptr<Tensor>> tensors,
+            float scale)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::input(0) * scale)
+    {
+        SPDLOG_DEBUG("Kompute OpScale constructor with params");
+
+        this->mOperationType = OperationTypes::eScale;
+        this->mScalar = scale;
+    }
+};
+
+/**
+ * Operation that adds a scalar to a tensor element wise and outputs on a
+ * second tensor. The scalar is passed to the shader as a specialization
+ * constant.
+ */
+class OpAddScalar : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpAddScalar() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     * @param scalar The scalar added to each element
+     */
+    OpAddScalar(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                std::shared_ptr<vk::Device> device,
+                std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                std::vector<std::shared_ptr<Tensor>> tensors,
+                float scalar)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::input(0) + scalar)
+    {
+        SPDLOG_DEBUG("Kompute OpAddScalar constructor with params");
+
+        this->mOperationType = OperationTypes::eAddScalar;
+        this->mScalar = scalar;
+    }
+};
+
+} // End namespace kp
+
+#define KP_DEFAULT_SCAN_WORKGROUP_SIZE 256
+#define KP_SCAN_ITEMS_PER_INVOCATION 4
+
+namespace kp {
+
+/**
+ * Operation that computes the prefix sum of the first tensor into the second
+ * tensor, which can be the same tensor to scan in place.
+ *
+ * The scan is a multi-level block scan: each workgroup scans a block of the
+ * tensor and writes the total of the block into a tensor of block sums, which
+ * is scanned recursively until it fits in a single block, and the scanned
+ * block sums are then added back into the blocks of the level below. The
+ * workgroup scan uses subgroup arithmetic when the device supports it in
+ * compute shaders, and shared memory otherwise.
+ */
+class OpScan : public OpAlgoBase
+{
+  public:
+    /**
+     * Types of scan, where the inclusive scan sums each element with the ones
+     * before it and the exclusive scan only sums the ones before it.
+     */
+    enum class ScanTypes
+    {
+        eInclusive = 0,
+        eExclusive = 1,
+    };
+
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpScan();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     * @param scanType Whether the scan is inclusive or exclusive
+     */
+    OpScan(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           ScanTypes scanType = ScanTypes::eInclusive);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithms
+     * and the block sums tensors but does not destroy the underlying tensors
+     */
+    virtual ~OpScan() override;
+
+    /**
+     * Validates the sizes of the tensors, creates the block sums tensors of
+     * each level and the algorithms that scan and propagate them.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatches of each level of the scan with the barriers
+     * between them.
+     */
+    virtual void record() override;
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    ScanTypes mScanType = ScanTypes::eInclusive;
+    uint32_t mWorkgroupSize = KP_DEFAULT_SCAN_WORKGROUP_SIZE;
+    uint32_t mMaxWorkgroupCount = 0;
+    bool mUseSubgroups = false;
+    std::vector<std::shared_ptr<Tensor>> mScanInputs;
+    std::vector<std::shared_ptr<Tensor>> mScanOutputs;
+    std::vector<std::shared_ptr<Tensor>> mScanSums;
+    std::vector<std::shared_ptr<Algorithm>> mScanAlgorithms;
+    std::vector<std::shared_ptr<Algorithm>> mAddAlgorithms;
+
+    /**
+     * Creates the levels of the scan of a tensor into another tensor.
+     *
+     * @param input The tensor to scan
+     * @param output The tensor the scan is written into
+     * @param scanType Whether the scan is inclusive or exclusive
+     * @param isFloat Whether the elements are float, otherwise they are uint
+     */
+    void initScan(std::shared_ptr<Tensor> input,
+                  std::shared_ptr<Tensor> output,
+                  ScanTypes scanType,
+                  bool isFloat);
+
+    /**
+     * Records the dispatches of the scan created by initScan.
+     */
+    void recordScan();
+
+    /**
+     * Returns the number of workgroups to dispatch for a number of blocks or
+     * elements, bound by the dispatch limits of the device as the shaders
+     * stride over the remaining ones.
+     *
+     * @param count The number of blocks or elements
+     * @param perWorkgroup The number processed by each workgroup
+     * @return The number of workgroups
+     */
+    uint32_t dispatchSize(uint32_t count, uint32_t perWorkgroup);
+
+    /**
+     * Queries the workgroup size, the dispatch limits and the subgroup
+     * support of the device, which is also done by initScan.
+     */
+    void initDeviceLimits();
+};
+
+} // End namespace kp
+
+namespace kp {
+
+/**
+ * Operation that keeps the elements of the first tensor for which a predicate
+ * is non-zero, writing them contiguously and in their original order into the
+ * output tensor, and the number of elements kept into a count tensor of a
+ * single element.
+ *
+ * The predicate is a kp::ElementwiseExpr over the input tensors, where input
+ * 0 is the tensor compacted and further inputs such as a tensor of flags can
+ * also be referenced, so the tensors are the inputs followed by the output and
+ * the count. The predicate is evaluated into flags, which are scanned with the
+ * block scan of kp::OpScan to find the position of each element kept. The
+ * flags are evaluated by a shader generated from the predicate as done by
+ * kp::OpElementwise, which requires Kompute to be built with
+ * KOMPUTE_OPT_ENABLE_SHADER_COMPILATION, while the scan and the scatter use
+ * the precompiled shaders of the operations.
+ */
+class OpCompact : public OpScan
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpCompact();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input tensors followed by the output and count tensors
+     * @param predicate Expression evaluated for each element, which is kept when the expression is non-zero
+     */
+    OpCompact(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+              std::shared_ptr<vk::Device> device,
+              std::shared_ptr<vk::CommandBuffer> commandBuffer,
+              std::vector<std::shared_ptr<Tensor>>& tensors,
+              const ElementwiseExpr& predicate);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithms
+     * and the intermediate tensors but does not destroy the underlying tensors
+     */
+    virtual ~OpCompact() override;
+
+    /**
+     * Validates the sizes of the tensors, creates the flags and offsets
+     * tensors and the algorithms that evaluate the predicate, scan the flags
+     * and scatter the elements kept.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatches that evaluate the predicate, scan the flags and
+     * scatter the elements kept, with the barriers between them.
+     */
+    virtual void record() override;
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    ElementwiseExpr mPredicate;
+    std::shared_ptr<Tensor> mFlags;
+    std::shared_ptr<Tensor> mOffsets;
+    std::shared_ptr<Algorithm> mFlagsAlgorithm;
+    std::shared_ptr<Algorithm> mScatterAlgorithm;
+
+  private:
+    std::string generateFlagsShader();
+};
+
+} // End namespace kp
+
+#define KP_SORT_RADIX_BITS 4
+
+namespace kp {
+
+/**
+ * Operation that sorts the keys of the first tensor in place with a stable
+ * least significant digit radix sort, and optionally reorders a second tensor
+ * of values of the same size together with the keys.
+ *
+ * Each pass of the sort computes a histogram of the digits of each block of
+ * keys, scans it with the block scan of kp::OpScan into the position of each
+ * digit of each block, and scatters the keys of each block into their
+ * positions. The keys are mapped to unsigned integers that preserve their
+ * order, so float keys are sorted numerically including negative values.
+ */
+class OpSort : public OpScan
+{
+  public:
+    /**
+     * Interpretation of the 32 bit elements of the keys tensor, where eUint
+     * keys hold the bits of unsigned integers in the tensor memory.
+     */
+    enum class KeyTypes
+    {
+        eFloat = 0,
+        eUint = 1,
+    };
+
+    /**
+     * Order of the sorted keys.
+     */
+    enum class SortOrders
+    {
+        eAscending = 0,
+        eDescending = 1,
+    };
+
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpSort();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the keys tensor optionally followed by a values tensor
+     * @param keyType Whether the keys are floats or unsigned integers
+     * @param sortOrder Whether the keys are sorted in ascending or descending order
+     */
+    OpSort(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           KeyTypes keyType = KeyTypes::eFloat,
+           SortOrders sortOrder = SortOrders::eAscending);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithms
+     * and the intermediate tensors but does not destroy the underlying tensors
+     */
+    virtual ~OpSort() override;
+
+    /**
+     * Validates the sizes of the tensors, creates the intermediate tensors
+     * and the algorithms of each pass of the sort.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatches of each pass of the sort with the barriers
+     * between them.
+     */
+    virtual void record() override;
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    KeyTypes mKeyType = KeyTypes::eFloat;
+    SortOrders mSortOrder = SortOrders::eAscending;
+    std::vector<std::shared_ptr<Tensor>> mSortInputs;
+    std::vector<std::shared_ptr<Tensor>> mSortOutputs;
+    std::vector<std::shared_ptr<Tensor>> mSortKeys;
+    std::vector<std::shared_ptr<Tensor>> mSortValues;
+    std::shared_ptr<Tensor> mHistogram;
+    std::shared_ptr<Tensor> mSortPlaceholder;
+    std::shared_ptr<Algorithm> mLoadAlgorithm;
+    std::shared_ptr<Algorithm> mStoreAlgorithm;
+    std::vector<std::shared_ptr<Algorithm>> mHistogramAlgorithms;
+    std::vector<std::shared_ptr<Algorithm>> mScatterAlgorithms;
+
+    /**
+     * Creates the passes that sort keys and values into output tensors,
+     * where only the first elements that fit in the outputs are stored.
+     *
+     * @param keys The keys to sort
+     * @param values The values reordered with the keys, or nullptr to use the index of each key as its value
+     * @param outputKeys The tensor the first sorted keys are written into
+     * @param outputValues The tensor the values of the first sorted keys are written into, or nullptr to only sort the keys
+     */
+    void initSort(std::shared_ptr<Tensor> keys,
+                  std::shared_ptr<Tensor> values,
+                  std::shared_ptr<Tensor> outputKeys,
+                  std::shared_ptr<Tensor> outputValues);
+
+    /**
+     * Records the dispatches of the sort created by initSort.
+     */
+    void recordSort();
+
+  private:
+    void recordShaderBarrier(std::shared_ptr<Tensor> tensor);
+};
+
+} // End namespace kp
+
+namespace kp {
+
+/**
+ * Operation that finds the k largest elements of the first tensor, writing
+ * them in descending order into the second tensor and their indices in the
+ * first tensor into the third tensor, where k is the size of the second and
+ * third tensors.
+ *
+ * The elements are sorted together with their indices by kp::OpSort, and only
+ * the first k sorted elements are stored into the outputs. Ties are returned
+ * in the order of their indices as the sort is stable.
+ */
+class OpTopK : public OpSort
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpTopK();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input tensor followed by the values and indices output tensors
+     * @param sortOrder Whether the largest elements are returned in descending order, or the smallest in ascending order
+     */
+    OpTopK(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           SortOrders sortOrder = SortOrders::eDescending);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithms
+     * and the intermediate tensors but does not destroy the underlying tensors
+     */
+    virtual ~OpTopK() override;
+
+    /**
+     * Validates the sizes of the tensors and creates the passes of the sort
+     * of the input tensor with its indices.
+     */
+    virtual void init() override;
+};
+
+} // End namespace kp
+
+#define KP_DEFAULT_CONV_TILE_SIZE 16
+#define KP_CONV_DIRECT_MAX_KERNEL_SIZE 16
+
+namespace kp {
+
+/**
+ * Operation that computes the 2-D convolution of an input tensor with the
+ * filters of a weights tensor, adding an optional bias per filter.
+ *
+ * The tensors are the input of shape (N, C, H, W) or (C, H, W), the weights
+ * of shape (K, C, KH, KW), optionally the bias of size K, and the output of
+ * shape (N, K, OH, OW) or (K, OH, OW), where the output can also be a tensor
+ * of a single dimension of the same size. The shapes are set with
+ * kp::Tensor::reshape.
+ *
+ * Small kernels are computed directly, where each workgroup loads the input
+ * patch of a tile of the output into shared memory for each channel. Large
+ * kernels are unfolded into a matrix of input patches which is multiplied by
+ * the weights with a tiled matrix multiplication. The tiles are sized from
+ * the workgroup and shared memory limits of the device. The shaders are
+ * precompiled and specialised for the dimensions of the convolution when the
+ * pipelines are created.
+ */
+class OpConv2D : public OpAlgoBase
+{
+  public:
+    /**
+     * Algorithms used to compute the convolution, where eAuto uses the
+     * direct convolution for small kernels that fit in shared memory.
+     */
+    enum class ConvAlgorithms
+    {
+        eAuto = 0,
+        eDirect = 1,
+        eIm2col = 2,
+    };
+
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpConv2D();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input, weights, optional bias and output tensors
+     * @param stride The step between the input positions of consecutive outputs in each spatial dimension
+     * @param padding The number of zeros added on each side of each spatial dimension of the input
+     * @param convAlgorithm The algorithm used to compute the convolution
+     */
+    OpConv2D(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+             std::shared_ptr<vk::Device> device,
+             std::shared_ptr<vk::CommandBuffer> commandBuffer,
+             std::vector<std::shared_ptr<Tensor>>& tensors,
+             uint32_t stride = 1,
+             uint32_t padding = 0,
+             ConvAlgorithms convAlgorithm = ConvAlgorithms::eAuto);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithms
+     * and the intermediate tensors but does not destroy the underlying tensors
+     */
+    virtual ~OpConv2D() override;
+
+    /**
+     * Validates the shapes of the tensors and creates the algorithms of the
+     * convolution.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatches of the convolution with the barriers between
+     * them.
+     */
+    virtual void record() override;
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    ConvAlgorithms mConvAlgorithm = ConvAlgorithms::eAuto;
+    uint32_t mBatches = 1;
+    uint32_t mChannels = 0;
+    uint32_t mHeight = 0;
+    uint32_t mWidth = 0;
+    uint32_t mFilters = 0;
+    uint32_t mKernelHeight = 0;
+    uint32_t mKernelWidth = 0;
+    uint32_t mStrideY = 1;
+    uint32_t mStrideX = 1;
+    uint32_t mPaddingY = 0;
+    uint32_t mPaddingX = 0;
+    uint32_t mOutputHeight = 0;
+    uint32_t mOutputWidth = 0;
+    uint32_t mTileSize = KP_DEFAULT_CONV_TILE_SIZE;
+    uint32_t mTileX = KP_DEFAULT_CONV_TILE_SIZE;
+    uint32_t mTileY = KP_DEFAULT_CONV_TILE_SIZE;
+    std::shared_ptr<Tensor> mColumns;
+    std::vector<std::shared_ptr<Algorithm>> mAlgorithms;
+    std::vector<KomputeWorkgroup> mWorkgroups;
+
+    /**
+     * Computes the spatial size of the output from the dimensions set by
+     * init, throwing if the kernel is larger than the padded input.
+     */
+    void initOutputSize();
+
+    /**
+     * Validates the output tensor and creates the algorithms of the
+     * convolution from the dimensions set by init, which allows the 1-D
+     * convolution to reuse the 2-D one.
+     *
+     * @param outputShape The expected shape of the output tensor
+     */
+    void initConvolution(const std::vector<uint32_t>& outputShape);
+
+  private:
+    void initTileSize();
+    KomputeWorkgroup tiledWorkgroup(uint32_t tilesX,
+                                    uint32_t tilesY,
+                                    uint32_t tilesZ);
+    std::vector<uint32_t> dimensionConstants();
+};
+
+} // End namespace kp
+
+namespace kp {
+
+/**
+ * Operation that computes the 1-D convolution of an input tensor with the
+ * filters of a weights tensor, adding an optional bias per filter.
+ *
+ * The tensors are the input of shape (N, C, L) or (C, L), the weights of
+ * shape (K, C, KL), optionally the bias of size K, and the output of shape
+ * (N, K, OL) or (K, OL), where the output can also be a tensor of a single
+ * dimension of the same size. The convolution is computed by kp::OpConv2D
+ * with a height of one, which uses wide tiles for outputs of a single row.
+ */
+class OpConv1D : public OpConv2D
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpConv1D();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input, weights, optional bias and output tensors
+     * @param stride The step between the input positions of consecutive outputs
+     * @param padding The number of zeros added on each side of the input
+     * @param convAlgorithm The algorithm used to compute the convolution
+     */
+    OpConv1D(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+             std::shared_ptr<vk::Device> device,
+             std::shared_ptr<vk::CommandBuffer> commandBuffer,
+             std::vector<std::shared_ptr<Tensor>>& tensors,
+             uint32_t stride = 1,
+             uint32_t padding = 0,
+             ConvAlgorithms convAlgorithm = ConvAlgorithms::eAuto);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithms
+     * and the intermediate tensors but does not destroy the underlying tensors
+     */
+    virtual ~OpConv1D() override;
+
+    /**
+     * Validates the shapes of the tensors and creates the algorithms of the
+     * convolution.
+     */
+    virtual void init() override;
+};
+
+} // End namespace kp
+
+#define KP_DEFAULT_POOL_WORKGROUP_SIZE 256
+
+namespace kp {
+
+/**
+ * Operation that computes the maximum or the average of each window of the
+ * spatial dimensions of an input tensor.
+ *
+ * The tensors are the input of shape (N, C, H, W) or (C, H, W) and the output
+ * of shape (N, C, OH, OW) or (C, OH, OW), where the output can also be a
+ * tensor of a single dimension of the same size. The windows are square and
+ * do not overlap unless the stride is smaller than the kernel size.
+ */
+class OpPool2D : public OpAlgoBase
+{
+  public:
+    /**
+     * Reduction computed over each window.
+     */
+    enum class PoolTypes
+    {
+        eMax = 0,
+        eAverage = 1,
+    };
+
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpPool2D();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     * @param poolType Whether the maximum or the average of each window is computed
+     * @param kernelSize The size of the windows in each spatial dimension
+     * @param stride The step between consecutive windows, which defaults to the kernel size when zero
+     */
+    OpPool2D(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+             std::shared_ptr<vk::Device> device,
+             std::shared_ptr<vk::CommandBuffer> commandBuffer,
+             std::vector<std::shared_ptr<Tensor>>& tensors,
+             PoolTypes poolType,
+             uint32_t kernelSize,
+             uint32_t stride = 0);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpPool2D() override;
+
+    /**
+     * Validates the shapes of the tensors and creates the algorithm of the
+     * pooling.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatch of the pooling with the barriers of the input and
+     * output tensors.
+     */
+    virtual void record() override;
+
+#if RELEASE
+    /**
+     * If RELEASE=1 it will be using the static version of the shader which is
+     * loaded using this file directly. Otherwise it should not override the function.
+     */
+    std::vector<char> fetchSpirvBinaryData() override;
+#endif
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    PoolTypes mPoolType = PoolTypes::eMax;
+    uint32_t mPlanes = 0; ///< Number of windows of each position, which is the batches times the channels
+    uint32_t mHeight = 0;
+    uint32_t mWidth = 0;
+    uint32_t mKernelHeight = 0;
+    uint32_t mKernelWidth = 0;
+    uint32_t mStrideY = 1;
+    uint32_t mStrideX = 1;
+    uint32_t mOutputHeight = 0;
+    uint32_t mOutputWidth = 0;
+    uint32_t mWorkgroupSize = KP_DEFAULT_POOL_WORKGROUP_SIZE;
+
+    /**
+     * Validates the output tensor and creates the algorithm of the pooling
+     * from the dimensions set by init, which allows the 1-D pooling to reuse
+     * the 2-D one.
+     *
+     * @param outputShape The expected shape of the output tensor without the output spatial dimensions, which are appended
+     * @param spatialDimensions The number of spatial dimensions of the output, either one or two
+     */
+    void initPooling(std::vector<uint32_t> outputShape,
+                     uint32_t spatialDimensions);
+};
+
+} // End namespace kp
+
+namespace kp {
+
+/**
+ * Operation that computes the maximum or the average of each window of the
+ * last dimension of an input tensor.
+ *
+ * The tensors are the input of shape (N, C, L) or (C, L) and the output of
+ * shape (N, C, OL) or (C, OL), where the output can also be a tensor of a
+ * single dimension of the same size. The pooling is computed by kp::OpPool2D
+ * with windows of a height of one.
+ */
+class OpPool1D : public OpPool2D
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpPool1D();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     * @param poolType Whether the maximum or the average of each window is computed
+     * @param kernelSize The size of the windows
+     * @param stride The step between consecutive windows, which defaults to the kernel size when zero
+     */
+    OpPool1D(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+             std::shared_ptr<vk::Device> device,
+             std::shared_ptr<vk::CommandBuffer> commandBuffer,
+             std::vector<std::shared_ptr<Tensor>>& tensors,
+             PoolTypes poolType,
+             uint32_t kernelSize,
+             uint32_t stride = 0);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpPool1D() override;
+
+    /**
+     * Validates the shapes of the tensors and creates the algorithm of the
+     * pooling.
+     */
+    virtual void init() override;
+};
+
+} // End namespace kp
+
+#define KP_DEFAULT_BATCH_NORM_WORKGROUP_SIZE 256
+
+namespace kp {
+
+/**
+ * Operation that applies the batch normalisation of inference, which
+ * normalises each channel of the input with its running mean and variance
+ * and then scales and shifts it.
+ *
+ * The tensors are the input of shape (N, C, ...), the scale, shift, mean and
+ * variance tensors of size C, and the output which has the same size as the
+ * input and can be the input itself. Inputs without a batch dimension can be
+ * reshaped with a leading dimension of one.
+ */
+class OpBatchNorm : public OpAlgoBase
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpBatchNorm();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input, scale, shift, mean, variance and output tensors
+     * @param epsilon Value added to the variance to avoid divisions by zero
+     */
+    OpBatchNorm(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                std::shared_ptr<vk::Device> device,
+                std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                std::vector<std::shared_ptr<Tensor>>& tensors,
+                float epsilon = 1e-5f);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpBatchNorm() override;
+
+    /**
+     * Validates the shapes of the tensors and creates the algorithm of the
+     * normalisation.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatch of the normalisation with the barriers of the
+     * input and output tensors.
+     */
+    virtual void record() override;
+
+#if RELEASE
+    /**
+     * If RELEASE=1 it will be using the static version of the shader which is
+     * loaded using this file directly. Otherwise it should not override the function.
+     */
+    std::vector<char> fetchSpirvBinaryData() override;
+#endif
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    float mEpsilon = 1e-5f;
+    uint32_t mChannels = 0;
+    uint32_t mChannelSize = 0; ///< Number of consecutive elements of each channel, which is the product of the dimensions after the channels
+    uint32_t mWorkgroupSize = KP_DEFAULT_BATCH_NORM_WORKGROUP_SIZE;
+};
+
+} // End namespace kp
+
+#define KP_DEFAULT_SOFTMAX_WORKGROUP_SIZE 256
+
+namespace kp {
+
+/**
+ * Operation that computes the softmax of each row of the last dimension of
+ * the first tensor into the second tensor, which can be the same tensor.
+ *
+ * Each workgroup reduces a row into its maximum and the sum of the
+ * exponentials relative to the maximum in a single pass, rescaling the
+ * partial sums when the maximum increases, so large inputs do not overflow.
+ * The shader is compiled ahead of time and specialised with the row size and
+ * the workgroup size of the device.
+ */
+class OpSoftmax : public OpAlgoBase
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpSoftmax();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     */
+    OpSoftmax(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+              std::shared_ptr<vk::Device> device,
+              std::shared_ptr<vk::CommandBuffer> commandBuffer,
+              std::vector<std::shared_ptr<Tensor>>& tensors);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpSoftmax() override;
+
+    /**
+     * Validates the shapes of the tensors and creates the algorithm
+     * specialised for the row size.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatch of the softmax with the barriers of the input and
+     * output tensors.
+     */
+    virtual void record() override;
+
+#if RELEASE
+    /**
+     * If RELEASE=1 it will be using the static version of the shader which is
+     * loaded using this file directly. Otherwise it should not override the function.
+     */
+    std::vector<char> fetchSpirvBinaryData() override;
+#endif
+};
 
-        SPDLOG_DEBUG("Kompute Manager evalOpAsync running sequence END");
-        sq->end();
+} // End namespace kp
 
-        SPDLOG_DEBUG("Kompute Manager evalOpAsync running sequence EVAL");
-        sq->evalAsync();
+#define KP_DEFAULT_LAYER_NORM_WORKGROUP_SIZE 256
 
-        SPDLOG_DEBUG("Kompute Manager evalOpAsync running sequence SUCCESS");
-    }
+namespace kp {
 
+/**
+ * Operation that normalises each row of the last dimension of the input
+ * tensor, and then scales and optionally shifts it per column.
+ *
+ * The tensors are the input, the scale of the size of the rows, optionally
+ * the shift of the same size, and the output which has the same size as the
+ * input and can be the input itself. Layer normalisation subtracts the mean
+ * of each row and divides by its standard deviation, while RMS normalisation
+ * only divides by the root mean square of each row. Each workgroup reduces a
+ * row with Welford's algorithm, so the variance is computed in a single
+ * numerically stable pass.
+ */
+class OpLayerNorm : public OpAlgoBase
+{
+  public:
     /**
-     * Operation that evaluates operation against default sequence
-     * asynchronously.
-     *
-     * @param tensors The tensors to be used in the operation recorded
-     * @param params Template parameters that will be used to initialise
-     * Operation to allow for extensible configurations on initialisation
+     * Types of normalisation of the rows.
      */
-    template<typename T, typename... TArgs>
-    void evalOpAsyncDefault(std::vector<std::shared_ptr<Tensor>> tensors,
-                            TArgs&&... params)
+    enum class NormTypes
     {
-        SPDLOG_DEBUG("Kompute Manager evalOpAsyncDefault triggered");
-        this->mCurrentSequenceIndex++;
-        this->evalOpAsync<T>(tensors,
-                             KP_DEFAULT_SESSION +
-                               std::to_string(this->mCurrentSequenceIndex),
-                             std::forward<TArgs>(params)...);
-    }
+        eLayerNorm = 0,
+        eRmsNorm = 1,
+    };
 
     /**
-     * Operation that awaits for named sequence to finish.
-     *
-     * @param sequenceName The name of the sequence to wait for termination
-     * @param waitFor The amount of time to wait before timing out
+     *  Base constructor, should not be used unless explicitly intended.
      */
-    void evalOpAwait(std::string sequenceName, uint64_t waitFor = UINT64_MAX)
-    {
-        SPDLOG_DEBUG("Kompute Manager evalOpAwait triggered with sequence {}",
-                     sequenceName);
-        std::unordered_map<std::string, std::shared_ptr<Sequence>>::iterator
-          found = this->mManagedSequences.find(sequenceName);
-
-        if (found != this->mManagedSequences.end()) {
-            if (std::shared_ptr<kp::Sequence> sq = found->second) {
-                SPDLOG_DEBUG("Kompute Manager evalOpAwait running sequence "
-                             "Sequence EVAL AWAIT");
-                if (sq->isRunning()) {
-                    sq->evalAwait(waitFor);
-                }
-            }
-            SPDLOG_DEBUG(
-              "Kompute Manager evalOpAwait running sequence SUCCESS");
-        } else {
-            SPDLOG_ERROR("Kompute Manager evalOpAwait Sequence not found");
-        }
-    }
+    OpLayerNorm();
 
     /**
-     * Operation that awaits for default sequence to finish.
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
      *
-     * @param tensors The tensors to be used in the operation recorded
-     * @param params Template parameters that will be used to initialise
-     * Operation to allow for extensible configurations on initialisation
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input, scale, optional shift and output tensors
+     * @param normType Whether the rows are normalised by their standard deviation or their root mean square
+     * @param epsilon Value added to the variance or mean square to avoid divisions by zero
      */
-    void evalOpAwaitDefault(uint64_t waitFor = UINT64_MAX)
-    {
-        SPDLOG_DEBUG("Kompute Manager evalOpAwaitDefault triggered");
-        this->evalOpAwait(KP_DEFAULT_SESSION +
-                            std::to_string(this->mCurrentSequenceIndex),
-                          waitFor);
-    }
+    OpLayerNorm(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                std::shared_ptr<vk::Device> device,
+                std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                std::vector<std::shared_ptr<Tensor>>& tensors,
+                NormTypes normType = NormTypes::eLayerNorm,
+                float epsilon = 1e-5f);
 
     /**
-     * Function that simplifies the common workflow of tensor creation and
-     * initialization. It will take the constructor parameters for a Tensor
-     * and will will us it to create a new Tensor and then create it using
-     * the OpCreateTensor command.
-     *
-     * @param data The data to initialize the tensor with
-     * @param tensorType The type of tensor to initialize
-     * @returns Initialized Tensor with memory Syncd to GPU device
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
      */
-    std::shared_ptr<Tensor> buildTensor(
-      const std::vector<float>& data,
-      Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice)
-    {
-        SPDLOG_DEBUG("Kompute Manager createInitTensor triggered");
-
-        SPDLOG_DEBUG("Kompute Manager creating new tensor shared ptr");
-        std::shared_ptr<Tensor> tensor =
-          std::make_shared<Tensor>(kp::Tensor(data, tensorType));
-
-        this->evalOpDefault<OpTensorCreate>({ tensor });
-
-        return tensor;
-    }
-
-  private:
-    // -------------- OPTIONALLY OWNED RESOURCES
-    std::shared_ptr<vk::Instance> mInstance = nullptr;
-    bool mFreeInstance = false;
-    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice = nullptr;
-    uint32_t mPhysicalDeviceIndex = -1;
-    std::shared_ptr<vk::Device> mDevice = nullptr;
-    bool mFreeDevice = false;
+    virtual ~OpLayerNorm() override;
 
-    // -------------- ALWAYS OWNED RESOURCES
-    std::unordered_map<std::string, std::shared_ptr<Sequence>>
-      mManagedSequences;
-
-    std::vector<uint32_t> mComputeQueueFamilyIndices;
-    std::vector<std::shared_ptr<vk::Queue>> mComputeQueues;
+    /**
+     * Validates the shapes of the tensors and creates the algorithm
+     * specialised for the row size and the type of normalisation.
+     */
+    virtual void init() override;
 
-    uint32_t mCurrentSequenceIndex = -1;
+    /**
+     * Records the dispatch of the normalisation with the barriers of the
+     * input and output tensors.
+     */
+    virtual void record() override;
 
-#if DEBUG
-#ifndef KOMPUTE_DISABLE_VK_DEBUG_LAYERS
-    vk::DebugReportCallbackEXT mDebugReportCallback;
-    vk::DispatchLoaderDynamic mDebugDispatcher;
-#endif
+#if RELEASE
+    /**
+     * If RELEASE=1 it will be using the static version of the shader which is
+     * loaded using this file directly. Otherwise it should not override the function.
+     */
+    std::vector<char> fetchSpirvBinaryData() override;
 #endif
 
-    // Create functions
-    void createInstance();
-    void createDevice(const std::vector<uint32_t>& familyQueueIndices = {});
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    NormTypes mNormType = NormTypes::eLayerNorm;
+    float mEpsilon = 1e-5f;
 };
 
 } // End namespace kp
 
-#include <fstream>
+#define KP_DEFAULT_ATTENTION_TILE_SIZE 64
 
 namespace kp {
 
 /**
-    Abstraction for compute shaders that are run on top of tensors grouped via
-   ParameterGroups (which group descriptorsets)
-*/
-class Algorithm
+ * Operation that computes the scaled dot product attention of queries, keys
+ * and values, which is the softmax of the scaled products of each query with
+ * the keys used to weight the values.
+ *
+ * The tensors are the queries of shape (..., LQ, D), the keys of shape
+ * (..., LK, D), the values of shape (..., LK, DV) and the output of shape
+ * (..., LQ, DV), where the leading dimensions such as the batches and the
+ * heads have the same total size in all tensors, and the output can also be a
+ * tensor of a single dimension of the same size.
+ *
+ * The attention is tiled in the style of FlashAttention: each workgroup
+ * computes a tile of query rows and loads tiles of the keys and values into
+ * shared memory, computing the softmax online so the matrix of scores is
+ * never written to memory. The tiles are sized from the shared memory limits
+ * of the device and the shader is compiled ahead of time and specialised with
+ * the dimensions of the tensors.
+ */
+class OpAttention : public OpAlgoBase
 {
   public:
     /**
-        Base constructor for Algorithm. Should not be used unless explicit
-       intended.
-    */
-    Algorithm();
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpAttention();
 
     /**
-     *  Default constructor for Algorithm
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
      *
-     *  @param device The Vulkan device to use for creating resources
-     *  @param commandBuffer The vulkan command buffer to bind the pipeline and
-     * shaders
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the queries, keys, values and output tensors
+     * @param causal Whether each query only attends to the keys up to its position, where the queries are aligned with the last keys
+     * @param scale The scale of the products of the queries and the keys, which defaults to the inverse square root of their dimension when zero
      */
-    Algorithm(std::shared_ptr<vk::Device> device,
-              std::shared_ptr<vk::CommandBuffer> commandBuffer);
+    OpAttention(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                std::shared_ptr<vk::Device> device,
+                std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                std::vector<std::shared_ptr<Tensor>>& tensors,
+                bool causal = false,
+                float scale = 0.0f);
 
     /**
-     * Initialiser for the shader data provided to the algorithm as well as
-     * tensor parameters that will be used in shader.
-     *
-     * @param shaderFileData The bytes in spir-v format of the shader
-     * @tensorParams The Tensors to be used in the Algorithm / shader for
-     * processing
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
      */
-    void init(const std::vector<char>& shaderFileData,
-              std::vector<std::shared_ptr<Tensor>> tensorParams);
+    virtual ~OpAttention() override;
 
     /**
-     * Destructor for Algorithm which is responsible for freeing and desroying
-     * respective pipelines and owned parameter groups.
+     * Validates the shapes of the tensors, sizes the tiles and creates the
+     * algorithm specialised for the dimensions of the tensors.
      */
-    ~Algorithm();
+    virtual void init() override;
 
     /**
-     * Records the dispatch function with the provided template parameters or
-     * alternatively using the size of the tensor by default.
-     *
-     * @param x Layout X dispatch value
-     * @param y Layout Y dispatch value
-     * @param z Layout Z dispatch value
+     * Records the dispatch of the attention with the barriers of the input
+     * and output tensors.
      */
-    void recordDispatch(uint32_t x = 1, uint32_t y = 1, uint32_t z = 1);
-
-  private:
-    // -------------- NEVER OWNED RESOURCES
-    std::shared_ptr<vk::Device> mDevice;
-    std::shared_ptr<vk::CommandBuffer> mCommandBuffer;
-
-    // -------------- OPTIONALLY OWNED RESOURCES
-    std::shared_ptr<vk::DescriptorSetLayout> mDescriptorSetLayout;
-    bool mFreeDescriptorSetLayout = false;
-    std::shared_ptr<vk::DescriptorPool> mDescriptorPool;
-    bool mFreeDescriptorPool = false;
-    std::shared_ptr<vk::DescriptorSet> mDescriptorSet;
-    bool mFreeDescriptorSet = false;
-    std::shared_ptr<vk::ShaderModule> mShaderModule;
-    bool mFreeShaderModule = false;
-    std::shared_ptr<vk::PipelineLayout> mPipelineLayout;
-    bool mFreePipelineLayout = false;
-    std::shared_ptr<vk::PipelineCache> mPipelineCache;
-    bool mFreePipelineCache = false;
-    std::shared_ptr<vk::Pipeline> mPipeline;
-    bool mFreePipeline = false;
+    virtual void record() override;
 
-    // Create util functions
-    void createShaderModule(const std::vector<char>& shaderFileData);
-    void createPipeline(std::vector<uint32_t> specializationData = {});
+#if RELEASE
+    /**
+     * If RELEASE=1 it will be using the static version of the shader which is
+     * loaded using this file directly. Otherwise it should not override the function.
+     */
+    std::vector<char> fetchSpirvBinaryData() override;
+#endif
 
-    // Parameters
-    void createParameters(std::vector<std::shared_ptr<Tensor>>& tensorParams);
-    void createDescriptorPool();
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    bool mCausal = false;
+    float mScale = 0.0f;
 };
 
 } // End namespace kp
 
+#define KP_SPARSE_ELL_VECTOR_SIZE 4
+
 namespace kp {
 
 /**
- * Operation that provides a general abstraction that simplifies the use of 
- * algorithm and parameter components which can be used with shaders.
- * By default it enables the user to provide a dynamic number of tensors
- * which are then passed as inputs.
+ * Sparse matrix that bundles the kp::Tensor of its indices and non zero
+ * values, which are used by kp::OpSpMV and kp::OpSpMM. The indices are stored
+ * as the bits of 32 bit unsigned integers in the float tensors.
+ *
+ * In the CSR format the matrix holds the offsets of the rows into the column
+ * indices and values of the non zero elements. In the ELL format every row is
+ * padded with zeros to the number of non zero elements of the longest row,
+ * rounded up to a multiple of KP_SPARSE_ELL_VECTOR_SIZE. The padded rows are
+ * stored in slices of KP_SPARSE_ELL_VECTOR_SIZE columns, where the slices of
+ * consecutive rows are contiguous, so each invocation loads a vector of
+ * elements of its row and consecutive invocations load consecutive vectors.
+ * ELL is faster when the rows have a similar number of non zero elements,
+ * while CSR does not waste memory on padding when they do not.
  */
-class OpAlgoBase : public OpBase
+class SparseTensor
 {
   public:
-    struct KomputeWorkgroup {
-        uint32_t x;
-        uint32_t y;
-        uint32_t z;
-    };
-
     /**
-     *  Base constructor, should not be used unless explicitly intended.
+     * Storage formats of the sparse matrix.
      */
-    OpAlgoBase();
+    enum class SparseFormats
+    {
+        eCSR = 0,
+        eELL = 1,
+    };
 
     /**
-     * Default constructor with parameters that provides the bare minimum
-     * requirements for the operations to be able to create and manage their
-     * sub-components.
-     *
-     * @param physicalDevice Vulkan physical device used to find device queues
-     * @param device Vulkan logical device for passing to Algorithm
-     * @param commandBuffer Vulkan Command Buffer to record commands into
-     * @param tensors Tensors that are to be used in this operation
-     * @param shaderFilePath Optional parameter to specify the shader to load (either in spirv or raw format)
-     * @param komputeWorkgroup Optional parameter to specify the layout for processing
+     *  Base constructor, should not be used unless explicitly intended.
      */
-    OpAlgoBase(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
-           std::shared_ptr<vk::Device> device,
-           std::shared_ptr<vk::CommandBuffer> commandBuffer,
-           std::vector<std::shared_ptr<Tensor>>& tensors,
-           KomputeWorkgroup komputeWorkgroup = KomputeWorkgroup());
+    SparseTensor();
 
     /**
-     * Constructor that enables a file to be passed to the operation with
-     * the contents of the shader. This can be either in raw format or in
-     * compiled SPIR-V binary format.
+     * Constructor with the matrix in CSR format, which is converted when the
+     * format requested is ELL.
      *
-     * @param physicalDevice Vulkan physical device used to find device queues
-     * @param device Vulkan logical device for passing to Algorithm
-     * @param commandBuffer Vulkan Command Buffer to record commands into
-     * @param tensors Tensors that are to be used in this operation
-     * @param shaderFilePath Parameter to specify the shader to load (either in spirv or raw format)
-     * @param komputeWorkgroup Optional parameter to specify the layout for processing
+     * @param rows Number of rows of the matrix
+     * @param columns Number of columns of the matrix
+     * @param rowOffsets Offsets of each row into the column indices and values, followed by the number of non zero elements
+     * @param columnIndices Column of each non zero element
+     * @param values Value of each non zero element
+     * @param format Format of the tensors of the matrix
+     * @param tensorType Type for the tensors which is of type TensorTypes
      */
-    OpAlgoBase(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
-           std::shared_ptr<vk::Device> device,
-           std::shared_ptr<vk::CommandBuffer> commandBuffer,
-           std::vector<std::shared_ptr<Tensor>>& tensors,
-           std::string shaderFilePath,
-           KomputeWorkgroup komputeWorkgroup = KomputeWorkgroup());
+    SparseTensor(uint32_t rows,
+                 uint32_t columns,
+                 const std::vector<uint32_t>& rowOffsets,
+                 const std::vector<uint32_t>& columnIndices,
+                 const std::vector<float>& values,
+                 SparseFormats format = SparseFormats::eCSR,
+                 Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice);
 
     /**
-     * Constructor that enables raw shader data to be passed to the main operation
-     * which can be either in raw shader glsl code or in compiled SPIR-V binary.
+     * Constructor with a dense matrix in row major order, from which the non
+     * zero elements are kept.
      *
-     * @param physicalDevice Vulkan physical device used to find device queues
-     * @param device Vulkan logical device for passing to Algorithm
-     * @param commandBuffer Vulkan Command Buffer to record commands into
-     * @param tensors Tensors that are to be used in this operation
-     * @param shaderDataRaw Optional parameter to specify the shader data either in binary or raw form
-     * @param komputeWorkgroup Optional parameter to specify the layout for processing
-     */
-    OpAlgoBase(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
-           std::shared_ptr<vk::Device> device,
-           std::shared_ptr<vk::CommandBuffer> commandBuffer,
-           std::vector<std::shared_ptr<Tensor>>& tensors,
-           const std::vector<char>& shaderDataRaw,
-           KomputeWorkgroup komputeWorkgroup = KomputeWorkgroup());
+     * @param dense Values of the dense matrix in row major order
+     * @param rows Number of rows of the matrix
+     * @param columns Number of columns of the matrix
+     * @param format Format of the tensors of the matrix
+     * @param tensorType Type for the tensors which is of type TensorTypes
+     */
+    SparseTensor(const std::vector<float>& dense,
+                 uint32_t rows,
+                 uint32_t columns,
+                 SparseFormats format = SparseFormats::eCSR,
+                 Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice);
 
     /**
-     * Default destructor, which is in charge of destroying the algorithm
-     * components but does not destroy the underlying tensors
+     * Returns the format of the tensors of the matrix.
+     *
+     * @return The format of the matrix
      */
-    virtual ~OpAlgoBase() override;
+    SparseFormats format();
 
     /**
-     * The init function is responsible for the initialisation of the algorithm
-     * component based on the parameters specified, and allows for extensibility
-     * on the options provided. Further dependent classes can perform more 
-     * specific checks such as ensuring tensors provided are initialised, etc.
+     * Returns the number of rows of the matrix.
+     *
+     * @return The number of rows
      */
-    virtual void init() override;
+    uint32_t rows();
 
     /**
-     * This records the commands that are to be sent to the GPU. This includes
-     * the barriers that ensure the memory has been copied before going in and
-     * out of the shader, as well as the dispatch operation that sends the
-     * shader processing to the gpu. This function also records the GPU memory
-     * copy of the output data for the staging buffer so it can be read by the
-     * host.
+     * Returns the number of columns of the matrix.
+     *
+     * @return The number of columns
      */
-    virtual void record() override;
+    uint32_t columns();
 
     /**
-     * Does not perform any preEval commands.
+     * Returns the number of non zero elements of the matrix, without the
+     * padding of the ELL format.
+     *
+     * @return The number of non zero elements
      */
-    virtual void preEval() override;
+    uint32_t nonZeros();
 
     /**
-     * Executes after the recorded commands are submitted, and performs a copy
-     * of the GPU Device memory into the staging buffer so the output data can
-     * be retrieved.
+     * Returns the number of elements stored for each row in the ELL format,
+     * including the padding, or zero in the CSR format.
+     *
+     * @return The padded width of the rows
      */
-    virtual void postEval() override;
+    uint32_t ellWidth();
 
-  protected:
-    // -------------- NEVER OWNED RESOURCES
+    /**
+     * Returns the tensor with the offsets of the rows in the CSR format, or
+     * nullptr in the ELL format.
+     *
+     * @return Shared pointer to the tensor of row offsets
+     */
+    std::shared_ptr<Tensor> rowOffsets();
 
-    // -------------- OPTIONALLY OWNED RESOURCES
-    std::shared_ptr<Algorithm> mAlgorithm;
-    bool mFreeAlgorithm = false;
+    /**
+     * Returns the tensor with the column of each stored element.
+     *
+     * @return Shared pointer to the tensor of column indices
+     */
+    std::shared_ptr<Tensor> columnIndices();
 
-    // -------------- ALWAYS OWNED RESOURCES
+    /**
+     * Returns the tensor with the value of each stored element.
+     *
+     * @return Shared pointer to the tensor of values
+     */
+    std::shared_ptr<Tensor> values();
 
-    KomputeWorkgroup mKomputeWorkgroup;
+    /**
+     * Returns all the tensors of the matrix, which can be used to create or
+     * synchronise them together.
+     *
+     * @return Vector containing the tensors of the matrix
+     */
+    std::vector<std::shared_ptr<Tensor>> tensors();
 
-    std::string mShaderFilePath; ///< Optional member variable which can be provided for the OpAlgoBase to find the data automatically and load for processing
-    std::vector<char> mShaderDataRaw; ///< Optional member variable which can be provided to contain either the raw shader content or the spirv binary content
+    /**
+     * Expands the host data of the tensors into a dense matrix, which
+     * reflects the device data after the tensors are synchronised.
+     *
+     * @return Values of the dense matrix in row major order
+     */
+    std::vector<float> dense();
 
-    virtual std::vector<char> fetchSpirvBinaryData();
+  private:
+    // -------------- ALWAYS OWNED RESOURCES
+    SparseFormats mFormat = SparseFormats::eCSR;
+    uint32_t mRows = 0;
+    uint32_t mColumns = 0;
+    uint32_t mNonZeros = 0;
+    uint32_t mEllWidth = 0;
+    std::shared_ptr<Tensor> mRowOffsets;
+    std::shared_ptr<Tensor> mColumnIndices;
+    std::shared_ptr<Tensor> mValues;
+
+    void initTensors(const std::vector<uint32_t>& rowOffsets,
+                     const std::vector<uint32_t>& columnIndices,
+                     const std::vector<float>& values,
+                     Tensor::TensorTypes tensorType);
 };
 
 } // End namespace kp
 
-#include <fstream>
+#define KP_DEFAULT_SPARSE_WORKGROUP_SIZE 256
+#define KP_SPARSE_CSR_MAX_LANES 32
 
 namespace kp {
 
 /**
- * Operation base class to simplify the creation of operations that require
- * right hand and left hand side datapoints together with a single output.
- * The expected data passed is two input tensors and one output tensor.
+ * Operation that multiplies a kp::SparseTensor by the dense vector of the
+ * first tensor, writing the result into the second tensor. The size of the
+ * first tensor is the number of columns of the matrix and the size of the
+ * second tensor is the number of rows.
+ *
+ * Matrices in the CSR format are multiplied with a subgroup per row, where
+ * the invocations of the subgroup stride over the non zero elements of the
+ * row and their products are summed with subgroup arithmetic. Devices without
+ * subgroup arithmetic use groups of invocations sized from the average number
+ * of non zero elements of the rows, which are summed in shared memory.
+ * Matrices in the ELL format are multiplied with an invocation per row, which
+ * loads the padded row in vectors of KP_SPARSE_ELL_VECTOR_SIZE elements.
  */
-class OpAlgoLhsRhsOut : public OpAlgoBase
+class OpSpMV : public OpAlgoBase
 {
   public:
     /**
      *  Base constructor, should not be used unless explicitly intended.
      */
-    OpAlgoLhsRhsOut();
+    OpSpMV();
 
     /**
      * Default constructor with parameters that provides the bare minimum
@@ -1772,80 +5885,75 @@ class OpAlgoLhsRhsOut : public OpAlgoBase
      * @param physicalDevice Vulkan physical device used to find device queues
      * @param device Vulkan logical device for passing to Algorithm
      * @param commandBuffer Vulkan Command Buffer to record commands into
-     * @param tensors Tensors that are to be used in this operation
-     * @param freeTensors Whether operation manages the memory of the Tensors
-     * @param komputeWorkgroup Optional parameter to specify the layout for processing
+     * @param tensors Tensors that are to be used in this operation, with the dense input and output tensors
+     * @param matrix Sparse matrix whose tensors must be initialised
      */
-    OpAlgoLhsRhsOut(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+    OpSpMV(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
            std::shared_ptr<vk::Device> device,
            std::shared_ptr<vk::CommandBuffer> commandBuffer,
-           std::vector<std::shared_ptr<Tensor>> tensors,
-           KomputeWorkgroup komputeWorkgroup = KomputeWorkgroup());
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           std::shared_ptr<SparseTensor> matrix);
 
     /**
      * Default destructor, which is in charge of destroying the algorithm
      * components but does not destroy the underlying tensors
      */
-    virtual ~OpAlgoLhsRhsOut() override;
+    virtual ~OpSpMV() override;
 
     /**
-     * The init function is responsible for ensuring that all of the tensors
-     * provided are aligned with requirements such as LHS, RHS and Output
-     * tensors, and  creates the algorithm component which processes the
-     * computation.
+     * Validates the sizes of the tensors against the matrix and creates the
+     * algorithm of the multiplication.
      */
     virtual void init() override;
 
     /**
-     * This records the commands that are to be sent to the GPU. This includes
-     * the barriers that ensure the memory has been copied before going in and
-     * out of the shader, as well as the dispatch operation that sends the
-     * shader processing to the gpu. This function also records the GPU memory
-     * copy of the output data for the staging buffer so it can be read by the
-     * host.
+     * Records the dispatch of the multiplication with the barriers on the
+     * tensors of the matrix, the input and the output.
      */
     virtual void record() override;
 
-    /**
-     * Executes after the recorded commands are submitted, and performs a copy
-     * of the GPU Device memory into the staging buffer so the output data can
-     * be retrieved.
-     */
-    virtual void postEval() override;
-
   protected:
     // -------------- NEVER OWNED RESOURCES
-    std::shared_ptr<Tensor> mTensorLHS; ///< Reference to the parameter used in the left hand side equation of the shader
-    std::shared_ptr<Tensor> mTensorRHS; ///< Reference to the parameter used in the right hand side equation of the shader
-    std::shared_ptr<Tensor> mTensorOutput; ///< Reference to the parameter used in the output of the shader and will be copied with a staging vector
+    std::shared_ptr<SparseTensor> mMatrix; ///< Sparse matrix multiplied by the first tensor
 
     // -------------- ALWAYS OWNED RESOURCES
-    std::shared_ptr<Tensor> mTensorOutputStaging; ///< Staging temporary tensor user do to copy the output of the tensor
-};
-
-} // End namespace kp
+    uint32_t mWorkgroupSize = KP_DEFAULT_SPARSE_WORKGROUP_SIZE;
 
-#include <fstream>
+    /**
+     * Validates the tensors of the matrix and creates the algorithm that
+     * multiplies it by a dense matrix of the number of columns provided, in
+     * row major order, which is a vector when there is a single column.
+     *
+     * @param denseColumns The number of columns of the dense input and output
+     */
+    void initMultiplication(uint32_t denseColumns);
 
-#if RELEASE
+  private:
+    uint32_t dispatchSize(uint32_t count);
+};
 
-#endif
+} // End namespace kp
 
 namespace kp {
 
 /**
- * Operation that performs multiplication on two tensors and outpus on third
- * tensor.
+ * Operation that multiplies a kp::SparseTensor by the dense matrix of the
+ * first tensor, writing the result into the second tensor. The dense matrices
+ * are in row major order, where the first tensor has as many rows as the
+ * columns of the sparse matrix, and the second tensor as many rows as the
+ * rows of the sparse matrix, with the same number of columns.
+ *
+ * Each invocation computes an element of the output, and consecutive
+ * invocations compute consecutive columns of a row so they share the non zero
+ * elements of the row and read consecutive elements of the dense matrix.
  */
-class OpMult : public OpAlgoBase
+class OpSpMM : public OpSpMV
 {
   public:
     /**
      *  Base constructor, should not be used unless explicitly intended.
      */
-    OpMult() {
-
-    }
+    OpSpMM();
 
     /**
      * Default constructor with parameters that provides the bare minimum
@@ -1855,157 +5963,124 @@ class OpMult : public OpAlgoBase
      * @param physicalDevice Vulkan physical device used to find device queues
      * @param device Vulkan logical device for passing to Algorithm
      * @param commandBuffer Vulkan Command Buffer to record commands into
-     * @param tensors Tensors that are to be used in this operation
-     * @param komputeWorkgroup Optional parameter to specify the layout for processing
+     * @param tensors Tensors that are to be used in this operation, with the dense input and output tensors
+     * @param matrix Sparse matrix whose tensors must be initialised
      */
-    OpMult(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+    OpSpMM(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
            std::shared_ptr<vk::Device> device,
            std::shared_ptr<vk::CommandBuffer> commandBuffer,
-           std::vector<std::shared_ptr<Tensor>> tensors,
-           KomputeWorkgroup komputeWorkgroup = KomputeWorkgroup())
-      : OpAlgoBase(physicalDevice, device, commandBuffer, tensors, "", komputeWorkgroup)
-    {
-        SPDLOG_DEBUG("Kompute OpMult constructor with params");
-
-#ifndef RELEASE
-        this->mShaderFilePath = "shaders/glsl/opmult.comp";
-#endif
-    }
-
-#if RELEASE
-    /**
-     * If RELEASE=1 it will be using the static version of the shader which is 
-     * loaded using this file directly. Otherwise it should not override the function.
-     */
-    std::vector<char> fetchSpirvBinaryData() override
-    {
-        SPDLOG_WARN(
-          "Kompute OpMult Running shaders directly from header");
-
-        return std::vector<char>(
-          shader_data::shaders_glsl_opmult_comp_spv,
-          shader_data::shaders_glsl_opmult_comp_spv +
-            kp::shader_data::shaders_glsl_opmult_comp_spv_len);
-
-    }
-#endif
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           std::shared_ptr<SparseTensor> matrix);
 
     /**
      * Default destructor, which is in charge of destroying the algorithm
      * components but does not destroy the underlying tensors
      */
-    ~OpMult() override {
-        SPDLOG_DEBUG("Kompute OpMult destructor started");
-    }
+    virtual ~OpSpMM() override;
 
+    /**
+     * Computes the number of columns of the dense matrices from the shape of
+     * the input, validates the sizes of the tensors and creates the algorithm
+     * of the multiplication.
+     */
+    virtual void init() override;
 };
 
 } // End namespace kp
 
+#define KP_DEFAULT_RANDOM_WORKGROUP_SIZE 256
+#define KP_RANDOM_VALUES_PER_COUNTER 4
+
 namespace kp {
 
 /**
-    Operation that copies the data from the first tensor to the rest of the tensors provided, using a record command for all the vectors. This operation does not own/manage the memory of the tensors passed to it. The operation must only receive tensors of type 
-*/
-class OpTensorCopy : public OpBase
+ * Operation that fills the tensors provided with random numbers generated on
+ * the device, overwriting their contents without any upload of data.
+ *
+ * The numbers are generated with the counter based Philox4x32-10 generator,
+ * keyed by the seed, where each counter generates KP_RANDOM_VALUES_PER_COUNTER
+ * numbers. The element at index i of the tensors takes the number at position
+ * offset + i of the stream of the seed, and the tensors after the first one
+ * continue the stream from the end of the tensor before them. The results
+ * only depend on the seed and the positions, so generating a tensor in parts
+ * with the corresponding offsets gives the same numbers as generating it at
+ * once.
+ */
+class OpRandom : public OpAlgoBase
 {
   public:
-    OpTensorCopy();
-
-    /**
-     * Default constructor with parameters that provides the core vulkan resources and the tensors that will be used in the operation.
-     *
-     * @param physicalDevice Vulkan physical device used to find device queues
-     * @param device Vulkan logical device for passing to Algorithm
-     * @param commandBuffer Vulkan Command Buffer to record commands into
-     * @param tensors Tensors that will be used to create in operation.
-     */
-    OpTensorCopy(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
-                   std::shared_ptr<vk::Device> device,
-                   std::shared_ptr<vk::CommandBuffer> commandBuffer,
-                   std::vector<std::shared_ptr<Tensor>> tensors);
-
-    /**
-     * Default destructor. This class does not manage memory so it won't be expecting the parent to perform a release.
-     */
-    ~OpTensorCopy() override;
-
-    /**
-     * Performs basic checks such as ensuring there are at least two tensors provided, that they are initialised and that they are not of type TensorTypes::eStorage.
-     */
-    void init() override;
-
-    /**
-     * Records the copy commands from the first tensor into all the other tensors provided. Also optionally records a barrier.
-     */
-    void record() override;
-
     /**
-     * Does not perform any preEval commands.
+     * Distributions of the random numbers. The uniform distribution is in
+     * the range [first, second), the normal distribution has a mean of first
+     * and a standard deviation of second, computed with the Box-Muller
+     * transform, and the Bernoulli distribution is one with a probability of
+     * first and zero otherwise.
      */
-    virtual void preEval() override;
+    enum class RandomDistributions
+    {
+        eUniform = 0,
+        eNormal = 1,
+        eBernoulli = 2,
+    };
 
     /**
-     * Copies the local vectors for all the tensors to sync the data with the gpu.
+     *  Base constructor, should not be used unless explicitly intended.
      */
-    virtual void postEval() override;
-
-  private:
-};
-
-} // End namespace kp
-
-namespace kp {
-
-/**
-    Operation that syncs tensor's device by mapping local data into the device memory. For TensorTypes::eDevice it will use a staging tensor to perform the copy. For TensorTypes::eStaging it will only copy the data and perform a map, which will be executed during the record (as opposed to during the sequence eval/submit). This function cannot be carried out for TensorTypes::eStaging.
-*/
-class OpTensorSyncDevice : public OpBase
-{
-  public:
-    OpTensorSyncDevice();
+    OpRandom();
 
     /**
-     * Default constructor with parameters that provides the core vulkan resources and the tensors that will be used in the operation. The tensos provided cannot be of type TensorTypes::eStorage.
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
      *
      * @param physicalDevice Vulkan physical device used to find device queues
      * @param device Vulkan logical device for passing to Algorithm
      * @param commandBuffer Vulkan Command Buffer to record commands into
-     * @param tensors Tensors that will be used to create in operation.
-     */
-    OpTensorSyncDevice(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
-                   std::shared_ptr<vk::Device> device,
-                   std::shared_ptr<vk::CommandBuffer> commandBuffer,
-                   std::vector<std::shared_ptr<Tensor>> tensors);
-
-    /**
-     * Default destructor. This class does not manage memory so it won't be expecting the parent to perform a release.
-     */
-    ~OpTensorSyncDevice() override;
-
-    /**
-     * Performs basic checks such as ensuring that there is at least one tensor provided, that they are initialized and that they are not of type TensorTpes::eStaging. For staging tensors in host memory, the map is performed during the init function.
+     * @param tensors Tensors that are to be used in this operation, which are filled with random numbers
+     * @param distribution The distribution of the random numbers
+     * @param seed The key of the generator, where each seed generates a different stream of numbers
+     * @param offset The position in the stream of the first element of the first tensor
+     * @param first The lower bound of the uniform distribution, the mean of the normal distribution or the probability of the Bernoulli distribution
+     * @param second The upper bound of the uniform distribution or the standard deviation of the normal distribution
      */
-    void init() override;
+    OpRandom(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+             std::shared_ptr<vk::Device> device,
+             std::shared_ptr<vk::CommandBuffer> commandBuffer,
+             std::vector<std::shared_ptr<Tensor>>& tensors,
+             RandomDistributions distribution = RandomDistributions::eUniform,
+             uint64_t seed = 0,
+             uint64_t offset = 0,
+             float first = 0.0f,
+             float second = 1.0f);
 
     /**
-     * For device tensors, it records the copy command to the device tensor from the temporary staging tensor.
+     * Default destructor, which is in charge of destroying the algorithms
+     * but does not destroy the underlying tensors
      */
-    void record() override;
+    virtual ~OpRandom() override;
 
     /**
-     * Does not perform any preEval commands.
+     * Validates the parameters of the distribution and creates the algorithm
+     * that fills each tensor at its position in the stream.
      */
-    virtual void preEval() override;
+    virtual void init() override;
 
     /**
-     * Does not perform any postEval commands.
+     * Records the dispatches that fill each tensor with the barriers on the
+     * tensors.
      */
-    virtual void postEval() override;
+    virtual void record() override;
 
-  private:
-    // Never owned resources
-    std::vector<std::shared_ptr<Tensor>> mStagingTensors;
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    RandomDistributions mDistribution = RandomDistributions::eUniform;
+    uint64_t mSeed = 0;
+    uint64_t mOffset = 0;
+    float mFirst = 0.0f;
+    float mSecond = 1.0f;
+    uint32_t mWorkgroupSize = KP_DEFAULT_RANDOM_WORKGROUP_SIZE;
+    std::vector<std::shared_ptr<Algorithm>> mAlgorithms;
+    std::vector<uint32_t> mNumWorkgroups;
 };
 
 } // End namespace kp
@@ -2013,38 +6088,38 @@ class OpTensorSyncDevice : public OpBase
 namespace kp {
 
 /**
-    Operation that syncs tensor's local data by mapping the data from device memory into the local vector. For TensorTypes::eDevice it will use a staging tensor to perform the copy. For TensorTypes::eStaging it will only copy the data and perform a map, which will be executed during the postSubmit (there will be no copy during the sequence eval/submit). This function cannot be carried out for TensorTypes::eStaging.
+    Operation that copies the data from the first tensor to the rest of the tensors provided, using a record command for all the vectors. This operation does not own/manage the memory of the tensors passed to it. The operation must only receive tensors of type 
 */
-class OpTensorSyncLocal : public OpBase
+class OpTensorCopy : public OpBase
 {
   public:
-    OpTensorSyncLocal();
+    OpTensorCopy();
 
     /**
-     * Default constructor with parameters that provides the core vulkan resources and the tensors that will be used in the operation. The tensors provided cannot be of type TensorTypes::eStorage.
+     * Default constructor with parameters that provides the core vulkan resources and the tensors that will be used in the operation.
      *
      * @param physicalDevice Vulkan physical device used to find device queues
      * @param device Vulkan logical device for passing to Algorithm
      * @param commandBuffer Vulkan Command Buffer to record commands into
      * @param tensors Tensors that will be used to create in operation.
      */
-    OpTensorSyncLocal(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+    OpTensorCopy(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
                    std::shared_ptr<vk::Device> device,
                    std::shared_ptr<vk::CommandBuffer> commandBuffer,
                    std::vector<std::shared_ptr<Tensor>> tensors);
 
     /**
-     * Default destructor. This class manages the memory of the staging tensors it owns but these are released in the postSubmit, before it arrives to the destructor.
+     * Default destructor. This class does not manage memory so it won't be expecting the parent to perform a release.
      */
-    ~OpTensorSyncLocal() override;
+    ~OpTensorCopy() override;
 
     /**
-     * Performs basic checks such as ensuring that there is at least one tensor provided, that they are initialized and that they are not of type TensorTpes::eStaging.
+     * Performs basic checks such as ensuring there are at least two tensors provided, that they are initialised and that they are not of type TensorTypes::eStorage.
      */
     void init() override;
 
     /**
-     * For device tensors, it records the copy command into the staging tensor from the device tensor.
+     * Records the copy commands from the first tensor into all the other tensors provided. Also optionally records a barrier.
      */
     void record() override;
 
@@ -2054,13 +6129,11 @@ class OpTensorSyncLocal : public OpBase
     virtual void preEval() override;
 
     /**
-     * For host tensors it performs the map command from the host memory into local memory.
+     * Copies the local vectors for all the tensors to sync the data with the gpu.
      */
     virtual void postEval() override;
 
   private:
-    // Never owned resources
-    std::vector<std::shared_ptr<Tensor>> mStagingTensors;
 };
 
 } // End namespace kp
@@ -1,6 +1,7 @@
 #include <fstream>
 
 #include "kompute/Algorithm.hpp"
+#include "kompute/ShaderCompiler.hpp"
 
 namespace kp {
 
@@ -18,6 +19,13 @@ Algorithm::Algorithm(std::shared_ptr<vk::Device> device,
     this->mCommandBuffer = commandBuffer;
 }
 
+void
+Algorithm::setDescriptorPoolArena(
+  std::shared_ptr<DescriptorPoolArena> descriptorPoolArena)
+{
+    this->mDescriptorPoolArena = descriptorPoolArena;
+}
+
 Algorithm::~Algorithm()
 {
     SPDLOG_DEBUG("Kompute Algorithm Destructor started");
@@ -107,7 +115,8 @@ Algorithm::~Algorithm()
 
 void
 Algorithm::init(const std::vector<char>& shaderFileData,
-                std::vector<std::shared_ptr<Tensor>> tensorParams)
+                std::vector<std::shared_ptr<Tensor>> tensorParams,
+                const std::vector<uint32_t>& specializationConstants)
 {
     SPDLOG_DEBUG("Kompute Algorithm init started");
 
@@ -118,18 +127,77 @@ Algorithm::init(const std::vector<char>& shaderFileData,
     for (std::shared_ptr<Tensor> tensor : tensorParams) {
         sizes.push_back(tensor->size());
     }
+    sizes.insert(sizes.end(),
+                 specializationConstants.begin(),
+                 specializationConstants.end());
     this->createPipeline(sizes);
 }
 
 void
-Algorithm::createDescriptorPool()
-{}
+Algorithm::init(std::shared_ptr<vk::ShaderModule> shaderModule,
+                std::vector<std::shared_ptr<Tensor>> tensorParams,
+                const std::vector<uint32_t>& specializationConstants)
+{
+    SPDLOG_DEBUG("Kompute Algorithm init with shader module started");
+
+    if (!shaderModule) {
+        throw std::runtime_error("Kompute Algorithm shader module is null");
+    }
+
+    this->createParameters(tensorParams);
+
+    // The shader module is externally managed so it is not destroyed here
+    this->mShaderModule = shaderModule;
+    this->mFreeShaderModule = false;
+
+    std::vector<uint32_t> sizes;
+    for (std::shared_ptr<Tensor> tensor : tensorParams) {
+        sizes.push_back(tensor->size());
+    }
+    sizes.insert(sizes.end(),
+                 specializationConstants.begin(),
+                 specializationConstants.end());
+    this->createPipeline(sizes);
+}
 
 void
 Algorithm::createParameters(std::vector<std::shared_ptr<Tensor>>& tensorParams)
 {
     SPDLOG_DEBUG("Kompute Algorithm createParameters started");
 
+    this->mTensorParams = tensorParams;
+
+    if (this->mDescriptorPoolArena &&
+        this->mDescriptorPoolArena->isPushDescriptorsEnabled()) {
+        SPDLOG_DEBUG("Kompute Algorithm using push descriptors");
+
+        // Bindings are pushed when the dispatch is recorded so no descriptor
+        // set is allocated or written for this algorithm
+        this->mDescriptorSetLayout =
+          this->mDescriptorPoolArena->getOrCreatePushDescriptorSetLayout(
+            static_cast<uint32_t>(tensorParams.size()));
+        this->mPushDescriptorDispatcher =
+          this->mDescriptorPoolArena->pushDescriptorDispatcher();
+
+        SPDLOG_DEBUG("Kompue Algorithm successfully run init");
+        return;
+    }
+
+    if (this->mDescriptorPoolArena) {
+        SPDLOG_DEBUG("Kompute Algorithm retrieving descriptors from arena");
+
+        // The layout and the set are owned by the arena and shared with all
+        // the algorithms that bind the same tensors
+        this->mDescriptorSetLayout =
+          this->mDescriptorPoolArena->getOrCreateDescriptorSetLayout(
+            static_cast<uint32_t>(tensorParams.size()));
+        this->mDescriptorSet = std::make_shared<vk::DescriptorSet>(
+          this->mDescriptorPoolArena->getOrCreateDescriptorSet(tensorParams));
+
+        SPDLOG_DEBUG("Kompue Algorithm successfully run init");
+        return;
+    }
+
     std::vector<vk::DescriptorPoolSize> descriptorPoolSizes = {
         vk::DescriptorPoolSize(
           vk::DescriptorType::eStorageBuffer,
@@ -147,6 +215,7 @@ Algorithm::createParameters(std::vector<std::shared_ptr<Tensor>>& tensorParams)
     this->mDescriptorPool = std::make_shared<vk::DescriptorPool>();
     this->mDevice->createDescriptorPool(
       &descriptorPoolInfo, nullptr, this->mDescriptorPool.get());
+    this->mFreeDescriptorPool = true;
 
     std::vector<vk::DescriptorSetLayoutBinding> descriptorSetBindings;
     for (size_t i = 0; i < tensorParams.size(); i++) {
@@ -178,15 +247,19 @@ Algorithm::createParameters(std::vector<std::shared_ptr<Tensor>>& tensorParams)
     this->mDescriptorSet = std::make_shared<vk::DescriptorSet>();
     this->mDevice->allocateDescriptorSets(&descriptorSetAllocateInfo,
                                           this->mDescriptorSet.get());
-    this->mFreeDescriptorSet = true;
+    // The descriptor set is freed when the descriptor pool is destroyed, as
+    // the pool is not created with the free descriptor set flag
+    this->mFreeDescriptorSet = false;
 
     SPDLOG_DEBUG("Kompute Algorithm updating descriptor sets");
+    std::vector<vk::DescriptorBufferInfo> descriptorBufferInfos;
     for (size_t i = 0; i < tensorParams.size(); i++) {
-        std::vector<vk::WriteDescriptorSet> computeWriteDescriptorSets;
-
-        vk::DescriptorBufferInfo descriptorBufferInfo =
-          tensorParams[i]->constructDescriptorBufferInfo();
+        descriptorBufferInfos.push_back(
+          tensorParams[i]->constructDescriptorBufferInfo());
+    }
 
+    std::vector<vk::WriteDescriptorSet> computeWriteDescriptorSets;
+    for (size_t i = 0; i < tensorParams.size(); i++) {
         computeWriteDescriptorSets.push_back(
           vk::WriteDescriptorSet(*this->mDescriptorSet,
                                  i, // Destination binding
@@ -194,12 +267,11 @@ Algorithm::createParameters(std::vector<std::shared_ptr<Tensor>>& tensorParams)
                                  1, // Descriptor count
                                  vk::DescriptorType::eStorageBuffer,
                                  nullptr, // Descriptor image info
-                                 &descriptorBufferInfo));
-
-        this->mDevice->updateDescriptorSets(computeWriteDescriptorSets,
-                                            nullptr);
+                                 &descriptorBufferInfos[i]));
     }
 
+    this->mDevice->updateDescriptorSets(computeWriteDescriptorSets, nullptr);
+
     SPDLOG_DEBUG("Kompue Algorithm successfully run init");
 }
 
@@ -208,13 +280,15 @@ Algorithm::createShaderModule(const std::vector<char>& shaderFileData)
 {
     SPDLOG_DEBUG("Kompute Algorithm createShaderModule started");
 
-    vk::ShaderModuleCreateInfo shaderModuleInfo(
-      vk::ShaderModuleCreateFlags(),
-      shaderFileData.size(),
-      (uint32_t*)shaderFileData.data());
+    std::vector<char> spirvData =
+      ShaderCompiler::toSpirv(shaderFileData.data(), shaderFileData.size());
+
+    vk::ShaderModuleCreateInfo shaderModuleInfo(vk::ShaderModuleCreateFlags(),
+                                                spirvData.size(),
+                                                (uint32_t*)spirvData.data());
 
     SPDLOG_DEBUG("Kompute Algorithm Creating shader module. ShaderFileSize: {}",
-                 shaderFileData.size());
+                 spirvData.size());
     this->mFreeShaderModule = true;
     this->mShaderModule = std::make_shared<vk::ShaderModule>();
     this->mDevice->createShaderModule(
@@ -302,14 +376,104 @@ Algorithm::recordDispatch(uint32_t x, uint32_t y, uint32_t z)
     this->mCommandBuffer->bindPipeline(vk::PipelineBindPoint::eCompute,
                                        *this->mPipeline);
 
-    this->mCommandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eCompute,
-                                             *this->mPipelineLayout,
-                                             0, // First set
-                                             *this->mDescriptorSet,
-                                             nullptr // Dispatcher
-    );
+    if (this->mPushDescriptorDispatcher) {
+        this->recordPushDescriptors(this->mTensorParams);
+    } else {
+        this->mCommandBuffer->bindDescriptorSets(
+          vk::PipelineBindPoint::eCompute,
+          *this->mPipelineLayout,
+          0, // First set
+          *this->mDescriptorSet,
+          nullptr // Dispatcher
+        );
+    }
+
+    this->mCommandBuffer->dispatch(x, y, z);
+}
+
+void
+Algorithm::recordDispatch(const std::vector<std::shared_ptr<Tensor>>& tensors,
+                          uint32_t x,
+                          uint32_t y,
+                          uint32_t z)
+{
+    SPDLOG_DEBUG("Kompute Algorithm calling record dispatch with {} tensors",
+                 tensors.size());
+
+    if (tensors.size() != this->mTensorParams.size()) {
+        throw std::runtime_error(
+          "Kompute Algorithm record dispatch expected " +
+          std::to_string(this->mTensorParams.size()) + " tensors but got " +
+          std::to_string(tensors.size()));
+    }
+
+    // The sizes are baked into the pipeline as specialization constants
+    for (size_t i = 0; i < tensors.size(); i++) {
+        if (tensors[i]->size() != this->mTensorParams[i]->size()) {
+            throw std::runtime_error(
+              "Kompute Algorithm record dispatch tensor " + std::to_string(i) +
+              " size does not match the size provided on init");
+        }
+    }
+
+    if (!this->mPushDescriptorDispatcher && !this->mDescriptorPoolArena) {
+        throw std::runtime_error(
+          "Kompute Algorithm record dispatch with different tensors requires "
+          "a descriptor pool arena");
+    }
+
+    this->mCommandBuffer->bindPipeline(vk::PipelineBindPoint::eCompute,
+                                       *this->mPipeline);
+
+    if (this->mPushDescriptorDispatcher) {
+        this->recordPushDescriptors(tensors);
+    } else {
+        // The arena returns the set already written for these tensors if the
+        // same bindings have been used before
+        vk::DescriptorSet descriptorSet =
+          this->mDescriptorPoolArena->getOrCreateDescriptorSet(tensors);
+
+        this->mCommandBuffer->bindDescriptorSets(
+          vk::PipelineBindPoint::eCompute,
+          *this->mPipelineLayout,
+          0, // First set
+          descriptorSet,
+          nullptr // Dispatcher
+        );
+    }
 
     this->mCommandBuffer->dispatch(x, y, z);
 }
 
+void
+Algorithm::recordPushDescriptors(
+  const std::vector<std::shared_ptr<Tensor>>& tensors)
+{
+    std::vector<vk::DescriptorBufferInfo> descriptorBufferInfos;
+    for (size_t i = 0; i < tensors.size(); i++) {
+        descriptorBufferInfos.push_back(
+          tensors[i]->constructDescriptorBufferInfo());
+    }
+
+    // The destination set is ignored for push descriptors
+    std::vector<vk::WriteDescriptorSet> computeWriteDescriptorSets;
+    for (size_t i = 0; i < tensors.size(); i++) {
+        computeWriteDescriptorSets.push_back(
+          vk::WriteDescriptorSet(vk::DescriptorSet(),
+                                 i, // Destination binding
+                                 0, // Destination array element
+                                 1, // Descriptor count
+                                 vk::DescriptorType::eStorageBuffer,
+                                 nullptr, // Descriptor image info
+                                 &descriptorBufferInfos[i]));
+    }
+
+    this->mCommandBuffer->pushDescriptorSetKHR(
+      vk::PipelineBindPoint::eCompute,
+      *this->mPipelineLayout,
+      0, // Set
+      computeWriteDescriptorSets,
+      *this->mPushDescriptorDispatcher);
+}
+
 }
@@ -0,0 +1,188 @@
+
+#include "kompute/CompletionThread.hpp"
+
+namespace kp {
+
+CompletionThread::CompletionThread(uint64_t waitTimeout)
+{
+    SPDLOG_DEBUG("Kompute CompletionThread constructor with wait timeout: {}",
+                 waitTimeout);
+
+    this->mWaitTimeout = waitTimeout;
+}
+
+CompletionThread::~CompletionThread()
+{
+    SPDLOG_DEBUG("Kompute CompletionThread destructor started");
+
+    if (this->mIsInit) {
+        this->stop();
+    }
+}
+
+void
+CompletionThread::init()
+{
+    SPDLOG_DEBUG("Kompute CompletionThread init called");
+
+    if (this->mIsInit) {
+        SPDLOG_WARN("Kompute CompletionThread init called when already init");
+        return;
+    }
+
+    this->mIsStopping = false;
+    this->mThread = std::thread(&CompletionThread::run, this);
+    this->mIsInit = true;
+}
+
+EvalFuture
+CompletionThread::track(std::shared_ptr<Sequence> sequence, bool isSubmitted)
+{
+    std::shared_ptr<EvalFutureState> state =
+      std::make_shared<EvalFutureState>();
+
+    if (!isSubmitted || !sequence->isRunning()) {
+        SPDLOG_WARN("Kompute CompletionThread track called with sequence "
+                    "that was not submitted");
+        state->setResult(false);
+        return EvalFuture(state);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        if (!this->mIsInit || this->mIsStopping) {
+            throw std::runtime_error(
+              "Kompute CompletionThread track called when not running");
+        }
+        this->mPendingEvals.push_back({ sequence, state });
+    }
+    this->mCondition.notify_one();
+
+    return EvalFuture(state);
+}
+
+EvalFuture
+CompletionThread::find(std::shared_ptr<Sequence> sequence)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    for (const PendingEval& pendingEval : this->mPendingEvals) {
+        if (pendingEval.sequence == sequence) {
+            return EvalFuture(pendingEval.state);
+        }
+    }
+    return EvalFuture();
+}
+
+bool
+CompletionThread::isInit()
+{
+    return this->mIsInit;
+}
+
+void
+CompletionThread::stop()
+{
+    SPDLOG_DEBUG("Kompute CompletionThread stop called");
+
+    if (!this->mIsInit) {
+        SPDLOG_WARN("Kompute CompletionThread stop called when not init");
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mIsStopping = true;
+    }
+    this->mCondition.notify_one();
+
+    if (this->mThread.joinable()) {
+        this->mThread.join();
+    }
+
+    this->mIsInit = false;
+}
+
+void
+CompletionThread::run()
+{
+    SPDLOG_DEBUG("Kompute CompletionThread thread started");
+
+    while (true) {
+        std::vector<PendingEval> pendingEvals;
+        {
+            std::unique_lock<std::mutex> lock(this->mMutex);
+            this->mCondition.wait(lock, [this]() {
+                return this->mIsStopping || !this->mPendingEvals.empty();
+            });
+            // Stopping only exits once all the pending sequences complete
+            if (this->mPendingEvals.empty()) {
+                break;
+            }
+            pendingEvals.assign(this->mPendingEvals.begin(),
+                                this->mPendingEvals.end());
+        }
+
+        for (size_t i = 0; i < pendingEvals.size(); i++) {
+            std::shared_ptr<Sequence> sequence = pendingEvals[i].sequence;
+
+            bool isComplete = false;
+            bool result = false;
+            std::exception_ptr exception;
+            try {
+                std::lock_guard<std::mutex> lock(sequence->mutex());
+
+                if (!sequence->isRunning()) {
+                    isComplete = true;
+                    result = true;
+                } else if (i == 0) {
+                    // Blocks on the oldest submission, which in a single
+                    // queue is also the first one to complete
+                    isComplete = sequence->evalAwait(this->mWaitTimeout);
+                    result = isComplete;
+                } else if (sequence->isComplete()) {
+                    isComplete = sequence->evalAwait(0);
+                    result = isComplete;
+                }
+            } catch (...) {
+                isComplete = true;
+                exception = std::current_exception();
+            }
+
+            if (isComplete) {
+                this->complete(pendingEvals[i], result, exception);
+            }
+        }
+    }
+
+    SPDLOG_DEBUG("Kompute CompletionThread thread stopped");
+}
+
+void
+CompletionThread::complete(const PendingEval& pendingEval,
+                           bool result,
+                           std::exception_ptr exception)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        for (std::deque<PendingEval>::iterator it =
+               this->mPendingEvals.begin();
+             it != this->mPendingEvals.end();
+             it++) {
+            if (it->state == pendingEval.state) {
+                this->mPendingEvals.erase(it);
+                break;
+            }
+        }
+    }
+
+    // The future is completed without holding the lock, as continuations
+    // may track new evaluations
+    if (exception) {
+        pendingEval.state->setException(exception);
+    } else {
+        pendingEval.state->setResult(result);
+    }
+}
+
+} // End namespace kp
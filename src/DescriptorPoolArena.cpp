@@ -0,0 +1,463 @@
+#include <algorithm>
+
+#include "kompute/DescriptorPoolArena.hpp"
+
+namespace kp {
+
+DescriptorPoolArena::DescriptorPoolArena()
+{
+    SPDLOG_DEBUG("Kompute DescriptorPoolArena base constructor");
+}
+
+DescriptorPoolArena::DescriptorPoolArena(std::shared_ptr<vk::Device> device,
+                                         uint32_t setsPerPool)
+{
+    SPDLOG_DEBUG("Kompute DescriptorPoolArena constructor with sets per pool: "
+                 "{}",
+                 setsPerPool);
+
+    this->mDevice = device;
+    this->mSetsPerPool = setsPerPool > 0 ? setsPerPool : 1;
+}
+
+DescriptorPoolArena::~DescriptorPoolArena()
+{
+    SPDLOG_DEBUG("Kompute DescriptorPoolArena destructor started");
+
+    this->freeMemoryDestroyGPUResources();
+}
+
+std::shared_ptr<vk::DescriptorSetLayout>
+DescriptorPoolArena::getOrCreateDescriptorSetLayout(uint32_t numBindings)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    return this->findOrCreateDescriptorSetLayout(numBindings);
+}
+
+vk::DescriptorSet
+DescriptorPoolArena::getOrCreateDescriptorSet(
+  const std::vector<std::shared_ptr<Tensor>>& tensors)
+{
+    SPDLOG_DEBUG("Kompute DescriptorPoolArena getOrCreateDescriptorSet with "
+                 "{} tensors",
+                 tensors.size());
+
+    std::vector<vk::DescriptorBufferInfo> descriptorBufferInfos;
+    DescriptorSetKey descriptorSetKey;
+    for (const std::shared_ptr<Tensor>& tensor : tensors) {
+        vk::DescriptorBufferInfo descriptorBufferInfo =
+          tensor->constructDescriptorBufferInfo();
+        descriptorBufferInfos.push_back(descriptorBufferInfo);
+        descriptorSetKey.push_back(
+          std::make_tuple(descriptorBufferInfo.buffer,
+                          descriptorBufferInfo.offset,
+                          descriptorBufferInfo.range));
+    }
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    std::map<DescriptorSetKey, DescriptorSetEntry>::iterator found =
+      this->mDescriptorSets.find(descriptorSetKey);
+
+    if (found != this->mDescriptorSets.end()) {
+        bool isValid = true;
+        for (size_t i = 0; i < tensors.size(); i++) {
+            if (found->second.tensors[i].lock() != tensors[i]) {
+                isValid = false;
+                break;
+            }
+        }
+        if (isValid) {
+            SPDLOG_DEBUG("Kompute DescriptorPoolArena found cached set");
+            return found->second.descriptorSet;
+        }
+        // The buffer handles were reused by different tensors after the
+        // original ones were destroyed, so the cached set is stale
+        this->retireDescriptorSet(found->second);
+        this->mDescriptorSets.erase(found);
+    }
+
+    this->retireExpiredDescriptorSets();
+    this->freeRetiredDescriptorSets();
+
+    uint32_t numBindings = static_cast<uint32_t>(tensors.size());
+
+    std::shared_ptr<vk::DescriptorSetLayout> descriptorSetLayout =
+      this->findOrCreateDescriptorSetLayout(numBindings);
+
+    DescriptorSetEntry descriptorSetEntry;
+    descriptorSetEntry.descriptorSet = this->allocateDescriptorSet(
+      descriptorSetLayout, numBindings, descriptorSetEntry.descriptorPool);
+    for (const std::shared_ptr<Tensor>& tensor : tensors) {
+        descriptorSetEntry.tensors.push_back(tensor);
+    }
+
+    SPDLOG_DEBUG("Kompute DescriptorPoolArena updating descriptor set");
+    std::vector<vk::WriteDescriptorSet> computeWriteDescriptorSets;
+    for (size_t i = 0; i < descriptorBufferInfos.size(); i++) {
+        computeWriteDescriptorSets.push_back(
+          vk::WriteDescriptorSet(descriptorSetEntry.descriptorSet,
+                                 i, // Destination binding
+                                 0, // Destination array element
+                                 1, // Descriptor count
+                                 vk::DescriptorType::eStorageBuffer,
+                                 nullptr, // Descriptor image info
+                                 &descriptorBufferInfos[i]));
+    }
+    this->mDevice->updateDescriptorSets(computeWriteDescriptorSets, nullptr);
+
+    this->mDescriptorSets.insert({ descriptorSetKey, descriptorSetEntry });
+
+    return descriptorSetEntry.descriptorSet;
+}
+
+void
+DescriptorPoolArena::enablePushDescriptors(
+  std::shared_ptr<vk::DispatchLoaderDynamic> dispatcher)
+{
+    SPDLOG_DEBUG("Kompute DescriptorPoolArena enabling push descriptors");
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    this->mPushDescriptorDispatcher = dispatcher;
+}
+
+bool
+DescriptorPoolArena::isPushDescriptorsEnabled()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    return this->mPushDescriptorDispatcher != nullptr;
+}
+
+std::shared_ptr<vk::DispatchLoaderDynamic>
+DescriptorPoolArena::pushDescriptorDispatcher()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    return this->mPushDescriptorDispatcher;
+}
+
+std::shared_ptr<vk::DescriptorSetLayout>
+DescriptorPoolArena::getOrCreatePushDescriptorSetLayout(uint32_t numBindings)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mPushDescriptorDispatcher) {
+        throw std::runtime_error(
+          "Kompute DescriptorPoolArena push descriptors are not enabled");
+    }
+
+    return this->findOrCreateDescriptorSetLayout(numBindings, true);
+}
+
+uint64_t
+DescriptorPoolArena::beginSubmission(vk::Fence fence)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    this->mLastSubmission++;
+    this->mSubmissionsInFlight.insert({ this->mLastSubmission, fence });
+
+    return this->mLastSubmission;
+}
+
+void
+DescriptorPoolArena::endSubmission(uint64_t submission)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    this->mSubmissionsInFlight.erase(submission);
+
+    this->freeRetiredDescriptorSets();
+}
+
+size_t
+DescriptorPoolArena::numDescriptorPools()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    return this->mDescriptorPools.size();
+}
+
+size_t
+DescriptorPoolArena::numDescriptorSets()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    return this->mDescriptorSets.size();
+}
+
+size_t
+DescriptorPoolArena::numRetiredDescriptorSets()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    return this->mRetiredDescriptorSets.size();
+}
+
+void
+DescriptorPoolArena::freeMemoryDestroyGPUResources()
+{
+    SPDLOG_DEBUG("Kompute DescriptorPoolArena freeMemoryDestroyGPUResources "
+                 "called");
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        if (this->mDescriptorPools.size()) {
+            SPDLOG_ERROR("Kompute DescriptorPoolArena "
+                         "freeMemoryDestroyGPUResources called with null "
+                         "Device pointer");
+        }
+        return;
+    }
+
+    // Destroying the pools implicitly frees all the sets allocated from them
+    this->mDescriptorSets.clear();
+    this->mRetiredDescriptorSets.clear();
+
+    for (const std::shared_ptr<vk::DescriptorPool>& descriptorPool :
+         this->mDescriptorPools) {
+        this->mDevice->destroy(
+          *descriptorPool,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    this->mDescriptorPools.clear();
+
+    for (const std::pair<const uint32_t,
+                         std::shared_ptr<vk::DescriptorSetLayout>>&
+           layoutPair : this->mDescriptorSetLayouts) {
+        this->mDevice->destroy(
+          *layoutPair.second,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    this->mDescriptorSetLayouts.clear();
+
+    for (const std::pair<const uint32_t,
+                         std::shared_ptr<vk::DescriptorSetLayout>>&
+           layoutPair : this->mPushDescriptorSetLayouts) {
+        this->mDevice->destroy(
+          *layoutPair.second,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    this->mPushDescriptorSetLayouts.clear();
+
+    SPDLOG_DEBUG("Kompute DescriptorPoolArena destroyed descriptor pools");
+}
+
+void
+DescriptorPoolArena::createDescriptorPool(uint32_t numBindings)
+{
+    SPDLOG_DEBUG("Kompute DescriptorPoolArena creating descriptor pool");
+
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute DescriptorPoolArena device is null");
+    }
+
+    // Sized so a pool can always hold at least the set being allocated
+    uint32_t descriptorsPerSet =
+      std::max<uint32_t>(numBindings, KP_DEFAULT_DESCRIPTORS_PER_SET);
+
+    std::vector<vk::DescriptorPoolSize> descriptorPoolSizes = {
+        vk::DescriptorPoolSize(vk::DescriptorType::eStorageBuffer,
+                               this->mSetsPerPool *
+                                 descriptorsPerSet // Descriptor count
+                               )
+    };
+
+    vk::DescriptorPoolCreateInfo descriptorPoolInfo(
+      vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
+      this->mSetsPerPool, // Max sets
+      static_cast<uint32_t>(descriptorPoolSizes.size()),
+      descriptorPoolSizes.data());
+
+    std::shared_ptr<vk::DescriptorPool> descriptorPool =
+      std::make_shared<vk::DescriptorPool>();
+    this->mDevice->createDescriptorPool(
+      &descriptorPoolInfo, nullptr, descriptorPool.get());
+
+    this->mDescriptorPools.push_back(descriptorPool);
+
+    SPDLOG_DEBUG("Kompute DescriptorPoolArena total descriptor pools: {}",
+                 this->mDescriptorPools.size());
+}
+
+vk::DescriptorSet
+DescriptorPoolArena::allocateDescriptorSet(
+  std::shared_ptr<vk::DescriptorSetLayout> descriptorSetLayout,
+  uint32_t numBindings,
+  vk::DescriptorPool& descriptorPool)
+{
+    SPDLOG_DEBUG("Kompute DescriptorPoolArena allocating descriptor set");
+
+    if (!this->mDescriptorPools.size()) {
+        this->createDescriptorPool(numBindings);
+    }
+
+    vk::DescriptorSet descriptorSet;
+
+    vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo(
+      *this->mDescriptorPools.back(),
+      1, // Descriptor set layout count
+      descriptorSetLayout.get());
+
+    vk::Result result = this->mDevice->allocateDescriptorSets(
+      &descriptorSetAllocateInfo, &descriptorSet);
+
+    if (result == vk::Result::eErrorOutOfPoolMemory ||
+        result == vk::Result::eErrorFragmentedPool) {
+        SPDLOG_DEBUG("Kompute DescriptorPoolArena pool exhausted, growing");
+
+        this->createDescriptorPool(numBindings);
+
+        descriptorSetAllocateInfo.descriptorPool =
+          *this->mDescriptorPools.back();
+
+        result = this->mDevice->allocateDescriptorSets(
+          &descriptorSetAllocateInfo, &descriptorSet);
+    }
+
+    if (result != vk::Result::eSuccess) {
+        throw std::runtime_error(
+          "Kompute DescriptorPoolArena failed to allocate descriptor set: " +
+          vk::to_string(result));
+    }
+
+    descriptorPool = *this->mDescriptorPools.back();
+
+    return descriptorSet;
+}
+
+std::shared_ptr<vk::DescriptorSetLayout>
+DescriptorPoolArena::findOrCreateDescriptorSetLayout(uint32_t numBindings,
+                                                     bool isPushDescriptor)
+{
+    std::unordered_map<uint32_t, std::shared_ptr<vk::DescriptorSetLayout>>&
+      descriptorSetLayouts = isPushDescriptor
+                               ? this->mPushDescriptorSetLayouts
+                               : this->mDescriptorSetLayouts;
+
+    std::unordered_map<uint32_t,
+                       std::shared_ptr<vk::DescriptorSetLayout>>::iterator
+      found = descriptorSetLayouts.find(numBindings);
+
+    if (found != descriptorSetLayouts.end()) {
+        return found->second;
+    }
+
+    SPDLOG_DEBUG("Kompute DescriptorPoolArena creating descriptor set layout "
+                 "with {} bindings, push descriptor: {}",
+                 numBindings,
+                 isPushDescriptor);
+
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute DescriptorPoolArena device is null");
+    }
+
+    std::vector<vk::DescriptorSetLayoutBinding> descriptorSetBindings;
+    for (uint32_t i = 0; i < numBindings; i++) {
+        descriptorSetBindings.push_back(
+          vk::DescriptorSetLayoutBinding(i, // Binding index
+                                         vk::DescriptorType::eStorageBuffer,
+                                         1, // Descriptor count
+                                         vk::ShaderStageFlagBits::eCompute));
+    }
+
+    vk::DescriptorSetLayoutCreateFlags descriptorSetLayoutFlags =
+      isPushDescriptor
+        ? vk::DescriptorSetLayoutCreateFlags(
+            vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR)
+        : vk::DescriptorSetLayoutCreateFlags();
+
+    vk::DescriptorSetLayoutCreateInfo descriptorSetLayoutInfo(
+      descriptorSetLayoutFlags,
+      static_cast<uint32_t>(descriptorSetBindings.size()),
+      descriptorSetBindings.data());
+
+    std::shared_ptr<vk::DescriptorSetLayout> descriptorSetLayout =
+      std::make_shared<vk::DescriptorSetLayout>();
+    this->mDevice->createDescriptorSetLayout(
+      &descriptorSetLayoutInfo, nullptr, descriptorSetLayout.get());
+
+    descriptorSetLayouts.insert({ numBindings, descriptorSetLayout });
+
+    return descriptorSetLayout;
+}
+
+void
+DescriptorPoolArena::retireDescriptorSet(DescriptorSetEntry descriptorSetEntry)
+{
+    descriptorSetEntry.retiredAfterSubmission = this->mLastSubmission;
+    this->mRetiredDescriptorSets.push_back(descriptorSetEntry);
+}
+
+void
+DescriptorPoolArena::retireExpiredDescriptorSets()
+{
+    std::map<DescriptorSetKey, DescriptorSetEntry>::iterator it =
+      this->mDescriptorSets.begin();
+
+    while (it != this->mDescriptorSets.end()) {
+        bool isExpired = false;
+        for (const std::weak_ptr<Tensor>& tensor : it->second.tensors) {
+            if (tensor.expired()) {
+                isExpired = true;
+                break;
+            }
+        }
+        if (isExpired) {
+            SPDLOG_DEBUG("Kompute DescriptorPoolArena retiring expired set");
+            this->retireDescriptorSet(it->second);
+            it = this->mDescriptorSets.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+void
+DescriptorPoolArena::freeRetiredDescriptorSets()
+{
+    if (this->mRetiredDescriptorSets.empty()) {
+        return;
+    }
+
+    // Submissions whose fence has signalled are completed even if they have
+    // not been awaited yet
+    std::map<uint64_t, vk::Fence>::iterator submission =
+      this->mSubmissionsInFlight.begin();
+    while (submission != this->mSubmissionsInFlight.end()) {
+        if (submission->second &&
+            this->mDevice->getFenceStatus(submission->second) ==
+              vk::Result::eSuccess) {
+            submission = this->mSubmissionsInFlight.erase(submission);
+        } else {
+            submission++;
+        }
+    }
+
+    // Submissions begun after a set was retired cannot reference it, so it
+    // is only waiting on the submissions up to the last one begun before
+    uint64_t oldestSubmissionInFlight =
+      this->mSubmissionsInFlight.empty()
+        ? this->mLastSubmission + 1
+        : this->mSubmissionsInFlight.begin()->first;
+
+    std::vector<DescriptorSetEntry>::iterator it =
+      this->mRetiredDescriptorSets.begin();
+
+    while (it != this->mRetiredDescriptorSets.end()) {
+        if (it->retiredAfterSubmission < oldestSubmissionInFlight) {
+            SPDLOG_DEBUG("Kompute DescriptorPoolArena freeing retired set");
+            this->mDevice->freeDescriptorSets(
+              it->descriptorPool, 1, &it->descriptorSet);
+            it = this->mRetiredDescriptorSets.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+}
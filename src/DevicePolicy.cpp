@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <regex>
+
+#include "kompute/DevicePolicy.hpp"
+
+namespace kp {
+
+static uint32_t
+deviceTypeRank(vk::PhysicalDeviceType deviceType)
+{
+    switch (deviceType) {
+        case vk::PhysicalDeviceType::eDiscreteGpu:
+            return 4;
+        case vk::PhysicalDeviceType::eIntegratedGpu:
+            return 3;
+        case vk::PhysicalDeviceType::eVirtualGpu:
+            return 2;
+        case vk::PhysicalDeviceType::eCpu:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+DeviceInfo
+DeviceInfo::fromPhysicalDevice(const vk::PhysicalDevice& physicalDevice,
+                               uint32_t index)
+{
+    DeviceInfo deviceInfo;
+
+    vk::PhysicalDeviceProperties properties = physicalDevice.getProperties();
+
+    deviceInfo.index = index;
+    deviceInfo.name = std::string(properties.deviceName.data());
+    deviceInfo.deviceType = properties.deviceType;
+    deviceInfo.vendorID = properties.vendorID;
+    deviceInfo.deviceID = properties.deviceID;
+    deviceInfo.apiVersion = properties.apiVersion;
+    deviceInfo.maxComputeWorkGroupInvocations =
+      properties.limits.maxComputeWorkGroupInvocations;
+    for (uint32_t i = 0; i < 3; i++) {
+        deviceInfo.maxComputeWorkGroupSize[i] =
+          properties.limits.maxComputeWorkGroupSize[i];
+    }
+    deviceInfo.maxComputeSharedMemorySize =
+      properties.limits.maxComputeSharedMemorySize;
+
+    // The subgroup properties are core since Vulkan 1.1
+    if (properties.apiVersion >= VK_MAKE_VERSION(1, 1, 0)) {
+        vk::StructureChain<vk::PhysicalDeviceProperties2,
+                           vk::PhysicalDeviceSubgroupProperties>
+          propertiesChain =
+            physicalDevice.getProperties2<vk::PhysicalDeviceProperties2,
+                                          vk::PhysicalDeviceSubgroupProperties>();
+        vk::PhysicalDeviceSubgroupProperties subgroupProperties =
+          propertiesChain.get<vk::PhysicalDeviceSubgroupProperties>();
+        deviceInfo.subgroupSize = subgroupProperties.subgroupSize;
+        deviceInfo.hasSubgroupArithmetic =
+          (subgroupProperties.supportedStages &
+           vk::ShaderStageFlagBits::eCompute) &&
+          (subgroupProperties.supportedOperations &
+           vk::SubgroupFeatureFlagBits::eArithmetic);
+    }
+
+    vk::PhysicalDeviceMemoryProperties memoryProperties =
+      physicalDevice.getMemoryProperties();
+    for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+        if (memoryProperties.memoryHeaps[i].flags &
+            vk::MemoryHeapFlagBits::eDeviceLocal) {
+            deviceInfo.deviceLocalMemorySize +=
+              memoryProperties.memoryHeaps[i].size;
+        }
+    }
+    vk::MemoryPropertyFlags unifiedMemoryPropertyFlags =
+      vk::MemoryPropertyFlagBits::eDeviceLocal |
+      vk::MemoryPropertyFlagBits::eHostVisible;
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        if ((memoryProperties.memoryTypes[i].propertyFlags &
+             unifiedMemoryPropertyFlags) == unifiedMemoryPropertyFlags) {
+            deviceInfo.hasUnifiedMemory = true;
+        }
+    }
+
+    std::vector<vk::QueueFamilyProperties> allQueueFamilyProperties =
+      physicalDevice.getQueueFamilyProperties();
+    for (uint32_t i = 0; i < allQueueFamilyProperties.size(); i++) {
+        vk::QueueFlags queueFlags = allQueueFamilyProperties[i].queueFlags;
+        if (!(queueFlags & vk::QueueFlagBits::eCompute)) {
+            continue;
+        }
+        deviceInfo.computeQueueFamilyIndices.push_back(i);
+        if (!(queueFlags & vk::QueueFlagBits::eGraphics) &&
+            deviceInfo.dedicatedComputeQueueFamilyIndex == (uint32_t)-1) {
+            deviceInfo.dedicatedComputeQueueFamilyIndex = i;
+        }
+    }
+
+    std::vector<vk::ExtensionProperties> availableExtensionProperties =
+      physicalDevice.enumerateDeviceExtensionProperties();
+    for (vk::ExtensionProperties extensionProperties :
+         availableExtensionProperties) {
+        deviceInfo.extensions.push_back(
+          std::string(extensionProperties.extensionName.data()));
+    }
+
+    deviceInfo.features = physicalDevice.getFeatures();
+
+    return deviceInfo;
+}
+
+bool
+DeviceInfo::hasExtension(const std::string& extensionName) const
+{
+    return std::find(this->extensions.begin(),
+                     this->extensions.end(),
+                     extensionName) != this->extensions.end();
+}
+
+bool
+DevicePolicy::isSuitable(const DeviceInfo& deviceInfo) const
+{
+    if (deviceInfo.computeQueueFamilyIndices.empty()) {
+        return false;
+    }
+    for (const std::string& extensionName : this->requiredExtensions) {
+        if (!deviceInfo.hasExtension(extensionName)) {
+            return false;
+        }
+    }
+    if (!this->nameRegex.empty() &&
+        !std::regex_search(deviceInfo.name, std::regex(this->nameRegex))) {
+        return false;
+    }
+    if (this->filter && !this->filter(deviceInfo)) {
+        return false;
+    }
+    return true;
+}
+
+uint32_t
+DevicePolicy::select(const std::vector<DeviceInfo>& deviceInfos) const
+{
+    const DeviceInfo* selectedDeviceInfo = nullptr;
+
+    for (const DeviceInfo& deviceInfo : deviceInfos) {
+        if (!this->isSuitable(deviceInfo)) {
+            SPDLOG_DEBUG("Kompute DevicePolicy discarding device {} {}",
+                         deviceInfo.index,
+                         deviceInfo.name);
+            continue;
+        }
+        if (!selectedDeviceInfo) {
+            selectedDeviceInfo = &deviceInfo;
+            continue;
+        }
+
+        // Devices are only replaced when strictly better, so ties keep the
+        // lowest index
+        if (this->preferDiscrete) {
+            uint32_t rank = deviceTypeRank(deviceInfo.deviceType);
+            uint32_t selectedRank =
+              deviceTypeRank(selectedDeviceInfo->deviceType);
+            if (rank != selectedRank) {
+                if (rank > selectedRank) {
+                    selectedDeviceInfo = &deviceInfo;
+                }
+                continue;
+            }
+        }
+        if (this->preferDeviceLocalMemory &&
+            deviceInfo.deviceLocalMemorySize >
+              selectedDeviceInfo->deviceLocalMemorySize) {
+            selectedDeviceInfo = &deviceInfo;
+        }
+    }
+
+    if (!selectedDeviceInfo) {
+        throw std::runtime_error("Kompute DevicePolicy found no suitable "
+                                 "device out of " +
+                                 std::to_string(deviceInfos.size()) +
+                                 " physical devices");
+    }
+
+    SPDLOG_DEBUG("Kompute DevicePolicy selected device {} {}",
+                 selectedDeviceInfo->index,
+                 selectedDeviceInfo->name);
+
+    return selectedDeviceInfo->index;
+}
+
+} // End namespace kp
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <chrono>
+
+#include "kompute/EvalFuture.hpp"
+
+namespace kp {
+
+void
+EvalFutureState::setResult(bool result)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mResult = result;
+    }
+    this->complete();
+}
+
+void
+EvalFutureState::setException(std::exception_ptr exception)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mException = exception;
+    }
+    this->complete();
+}
+
+void
+EvalFutureState::addContinuation(std::function<void()> continuation)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        if (!this->mIsReady) {
+            this->mContinuations.push_back(continuation);
+            return;
+        }
+    }
+    continuation();
+}
+
+bool
+EvalFutureState::isReady()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mIsReady;
+}
+
+bool
+EvalFutureState::wait(uint64_t waitFor)
+{
+    std::unique_lock<std::mutex> lock(this->mMutex);
+
+    if (waitFor == UINT64_MAX) {
+        this->mCondition.wait(lock, [this]() { return this->mIsReady; });
+        return true;
+    }
+
+    // Timeouts beyond the range of the clock are clamped, which is still
+    // centuries long
+    uint64_t maxWaitFor = static_cast<uint64_t>(
+      std::chrono::nanoseconds::max().count() / 2);
+    return this->mCondition.wait_for(
+      lock,
+      std::chrono::nanoseconds(std::min(waitFor, maxWaitFor)),
+      [this]() { return this->mIsReady; });
+}
+
+bool
+EvalFutureState::get()
+{
+    std::unique_lock<std::mutex> lock(this->mMutex);
+    this->mCondition.wait(lock, [this]() { return this->mIsReady; });
+
+    if (this->mException) {
+        std::rethrow_exception(this->mException);
+    }
+    return this->mResult;
+}
+
+void
+EvalFutureState::complete()
+{
+    std::vector<std::function<void()>> continuations;
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mIsReady = true;
+        continuations.swap(this->mContinuations);
+    }
+    this->mCondition.notify_all();
+
+    // Continuations run without the lock so they can query the future
+    for (const std::function<void()>& continuation : continuations) {
+        continuation();
+    }
+}
+
+EvalFuture::EvalFuture() {}
+
+EvalFuture::EvalFuture(std::shared_ptr<EvalFutureState> state)
+{
+    this->mState = state;
+}
+
+bool
+EvalFuture::valid()
+{
+    return this->mState != nullptr;
+}
+
+bool
+EvalFuture::ready()
+{
+    if (!this->mState) {
+        return false;
+    }
+    return this->mState->isReady();
+}
+
+bool
+EvalFuture::wait(uint64_t waitFor)
+{
+    if (!this->mState) {
+        throw std::runtime_error("Kompute EvalFuture wait called on invalid "
+                                 "future");
+    }
+    return this->mState->wait(waitFor);
+}
+
+bool
+EvalFuture::get()
+{
+    if (!this->mState) {
+        throw std::runtime_error("Kompute EvalFuture get called on invalid "
+                                 "future");
+    }
+    return this->mState->get();
+}
+
+EvalFuture
+EvalFuture::then(std::function<void(EvalFuture)> continuation)
+{
+    if (!this->mState) {
+        throw std::runtime_error("Kompute EvalFuture then called on invalid "
+                                 "future");
+    }
+
+    std::shared_ptr<EvalFutureState> chainedState =
+      std::make_shared<EvalFutureState>();
+
+    EvalFuture self = *this;
+    this->mState->addContinuation([self, chainedState, continuation]() {
+        try {
+            continuation(self);
+            chainedState->setResult(true);
+        } catch (...) {
+            chainedState->setException(std::current_exception());
+        }
+    });
+
+    return EvalFuture(chainedState);
+}
+
+} // End namespace kp
@@ -37,15 +37,50 @@ Manager::Manager(uint32_t physicalDeviceIndex,
     this->createDevice(familyQueueIndices);
 }
 
+Manager::Manager(const DevicePolicy& devicePolicy,
+                 const std::vector<uint32_t>& familyQueueIndices)
+{
+    this->createInstance();
+
+    std::vector<DeviceInfo> deviceInfos =
+      Manager::enumerateDevices(*this->mInstance);
+    this->mPhysicalDeviceIndex = devicePolicy.select(deviceInfos);
+
+    std::vector<uint32_t> selectedFamilyQueueIndices = familyQueueIndices;
+    const DeviceInfo& deviceInfo = deviceInfos[this->mPhysicalDeviceIndex];
+    if (selectedFamilyQueueIndices.empty() &&
+        devicePolicy.preferDedicatedComputeQueue &&
+        deviceInfo.dedicatedComputeQueueFamilyIndex != (uint32_t)-1) {
+        selectedFamilyQueueIndices.push_back(
+          deviceInfo.dedicatedComputeQueueFamilyIndex);
+    }
+
+    this->createDevice(selectedFamilyQueueIndices,
+                       devicePolicy.requiredExtensions);
+}
+
 Manager::Manager(std::shared_ptr<vk::Instance> instance,
                  std::shared_ptr<vk::PhysicalDevice> physicalDevice,
                  std::shared_ptr<vk::Device> device,
-                 uint32_t physicalDeviceIndex)
+                 uint32_t physicalDeviceIndex,
+                 const std::vector<uint32_t>& familyQueueIndices)
 {
     this->mInstance = instance;
     this->mPhysicalDevice = physicalDevice;
     this->mDevice = device;
     this->mPhysicalDeviceIndex = physicalDeviceIndex;
+
+    if (familyQueueIndices.empty()) {
+        this->mComputeQueueFamilyIndices.push_back(
+          Manager::findComputeQueueFamilyIndex(*this->mPhysicalDevice));
+    } else {
+        this->mComputeQueueFamilyIndices = familyQueueIndices;
+    }
+    this->createComputeQueues();
+
+    this->mShaderCache = std::make_shared<ShaderCache>(this->mDevice);
+    this->mDescriptorPoolArena =
+      std::make_shared<DescriptorPoolArena>(this->mDevice);
 }
 
 Manager::~Manager()
@@ -58,6 +93,23 @@ Manager::~Manager()
         return;
     }
 
+    if (this->mCompletionThread) {
+        SPDLOG_DEBUG("Kompute Manager stopping completion thread");
+        this->mCompletionThread->stop();
+        this->mCompletionThread = nullptr;
+    }
+
+    if (this->mTransferEngines.size()) {
+        SPDLOG_DEBUG("Kompute Manager explicitly freeing transfer engines");
+        for (const std::shared_ptr<TransferEngine>& transferEngine :
+             this->mTransferEngines) {
+            if (transferEngine->isInit()) {
+                transferEngine->freeMemoryDestroyGPUResources();
+            }
+        }
+        this->mTransferEngines.clear();
+    }
+
     if (this->mManagedSequences.size()) {
         SPDLOG_DEBUG("Kompute Manager explicitly running destructor for "
                      "managed sequences");
@@ -68,6 +120,18 @@ Manager::~Manager()
         this->mManagedSequences.clear();
     }
 
+    if (this->mShaderCache) {
+        SPDLOG_DEBUG("Kompute Manager destroying shader cache");
+        this->mShaderCache->freeMemoryDestroyGPUResources();
+        this->mShaderCache = nullptr;
+    }
+
+    if (this->mDescriptorPoolArena) {
+        SPDLOG_DEBUG("Kompute Manager destroying descriptor pool arena");
+        this->mDescriptorPoolArena->freeMemoryDestroyGPUResources();
+        this->mDescriptorPoolArena = nullptr;
+    }
+
     if (this->mFreeDevice) {
         SPDLOG_INFO("Destroying device");
         this->mDevice->destroy(
@@ -103,11 +167,17 @@ Manager::getOrCreateManagedSequence(std::string sequenceName)
 {
     SPDLOG_DEBUG("Kompute Manager creating Sequence object");
 
+    // The lookup and the creation happen under the same lock so concurrent
+    // callers with the same name always receive the same sequence
+    std::lock_guard<std::mutex> lock(this->mManagedSequencesMutex);
+
     std::unordered_map<std::string, std::shared_ptr<Sequence>>::iterator found =
       this->mManagedSequences.find(sequenceName);
 
     if (found == this->mManagedSequences.end()) {
-        return this->createManagedSequence(sequenceName);
+        std::shared_ptr<Sequence> sq = this->createSequence(0);
+        this->mManagedSequences.insert({ sequenceName, sq });
+        return sq;
     } else {
         return found->second;
     }
@@ -122,12 +192,9 @@ Manager::createManagedSequence(std::string sequenceName, uint32_t queueIndex)
                  sequenceName,
                  queueIndex);
 
-    std::shared_ptr<Sequence> sq =
-      std::make_shared<Sequence>(this->mPhysicalDevice,
-                                 this->mDevice,
-                                 this->mComputeQueues[queueIndex],
-                                 this->mComputeQueueFamilyIndices[queueIndex]);
-    sq->init();
+    std::shared_ptr<Sequence> sq = this->createSequence(queueIndex);
+
+    std::lock_guard<std::mutex> lock(this->mManagedSequencesMutex);
 
     if (sequenceName.empty()) {
         this->mCurrentSequenceIndex++;
@@ -141,6 +208,212 @@ Manager::createManagedSequence(std::string sequenceName, uint32_t queueIndex)
     return sq;
 }
 
+std::shared_ptr<Sequence>
+Manager::createSequence(uint32_t queueIndex)
+{
+    if (queueIndex >= this->mComputeQueues.size()) {
+        throw std::runtime_error(
+          "Kompute Manager createSequence queue index out of range: " +
+          std::to_string(queueIndex));
+    }
+
+    std::shared_ptr<Sequence> sq =
+      std::make_shared<Sequence>(this->mPhysicalDevice,
+                                 this->mDevice,
+                                 this->mComputeQueues[queueIndex],
+                                 this->mComputeQueueFamilyIndices[queueIndex],
+                                 this->mShaderCache,
+                                 this->mDescriptorPoolArena,
+                                 this->mComputeQueueMutexes[queueIndex],
+                                 this->mEnabledExtensions);
+    sq->init();
+
+#if KOMPUTE_ENABLE_COROUTINES
+    // Sequences can be awaited from coroutines through the completion thread
+    sq->setCompletionThread(this->getOrCreateCompletionThread());
+#endif
+
+    return sq;
+}
+
+std::shared_ptr<CompletionThread>
+Manager::getOrCreateCompletionThread()
+{
+    std::lock_guard<std::mutex> lock(this->mCompletionThreadMutex);
+
+    // The thread is only started once the first asynchronous evaluation is
+    // submitted, so synchronous workloads don't spawn it
+    if (!this->mCompletionThread) {
+        SPDLOG_DEBUG("Kompute Manager creating completion thread");
+        this->mCompletionThread = std::make_shared<CompletionThread>();
+        this->mCompletionThread->init();
+    }
+    return this->mCompletionThread;
+}
+
+EvalFuture
+Manager::findEvalFuture(std::shared_ptr<Sequence> sequence)
+{
+    std::shared_ptr<CompletionThread> completionThread;
+    {
+        std::lock_guard<std::mutex> lock(this->mCompletionThreadMutex);
+        completionThread = this->mCompletionThread;
+    }
+
+    if (!completionThread) {
+        return EvalFuture();
+    }
+    return completionThread->find(sequence);
+}
+
+std::shared_ptr<Sequence>
+Manager::findManagedSequence(const std::string& sequenceName)
+{
+    std::lock_guard<std::mutex> lock(this->mManagedSequencesMutex);
+
+    std::unordered_map<std::string, std::shared_ptr<Sequence>>::iterator found =
+      this->mManagedSequences.find(sequenceName);
+
+    if (found == this->mManagedSequences.end()) {
+        return nullptr;
+    }
+    return found->second;
+}
+
+std::string
+Manager::nextDefaultSequenceName()
+{
+    std::lock_guard<std::mutex> lock(this->mManagedSequencesMutex);
+
+    this->mCurrentSequenceIndex++;
+    return KP_DEFAULT_SESSION + std::to_string(this->mCurrentSequenceIndex);
+}
+
+std::string
+Manager::currentDefaultSequenceName()
+{
+    std::lock_guard<std::mutex> lock(this->mManagedSequencesMutex);
+
+    return KP_DEFAULT_SESSION + std::to_string(this->mCurrentSequenceIndex);
+}
+
+std::shared_ptr<ShaderCache>
+Manager::shaderCache()
+{
+    return this->mShaderCache;
+}
+
+std::shared_ptr<DescriptorPoolArena>
+Manager::descriptorPoolArena()
+{
+    return this->mDescriptorPoolArena;
+}
+
+std::vector<DeviceInfo>
+Manager::listDevices()
+{
+    SPDLOG_DEBUG("Kompute Manager listing devices");
+
+    vk::ApplicationInfo applicationInfo;
+    applicationInfo.pApplicationName = "Vulkan Kompute";
+    applicationInfo.pEngineName = "VulkanKompute";
+    applicationInfo.apiVersion = KOMPUTE_VK_API_VERSION;
+    applicationInfo.engineVersion = KOMPUTE_VK_API_VERSION;
+    applicationInfo.applicationVersion = KOMPUTE_VK_API_VERSION;
+
+    vk::InstanceCreateInfo instanceCreateInfo;
+    instanceCreateInfo.pApplicationInfo = &applicationInfo;
+
+    vk::Instance instance;
+    vk::createInstance(&instanceCreateInfo, nullptr, &instance);
+
+    std::vector<DeviceInfo> deviceInfos;
+    try {
+        deviceInfos = Manager::enumerateDevices(instance);
+    } catch (...) {
+        instance.destroy();
+        throw;
+    }
+    instance.destroy();
+
+    return deviceInfos;
+}
+
+std::vector<DeviceInfo>
+Manager::enumerateDevices(const vk::Instance& instance)
+{
+    std::vector<vk::PhysicalDevice> physicalDevices =
+      instance.enumeratePhysicalDevices();
+
+    std::vector<DeviceInfo> deviceInfos;
+    for (uint32_t i = 0; i < physicalDevices.size(); i++) {
+        deviceInfos.push_back(
+          DeviceInfo::fromPhysicalDevice(physicalDevices[i], i));
+    }
+    return deviceInfos;
+}
+
+uint32_t
+Manager::findComputeQueueFamilyIndex(const vk::PhysicalDevice& physicalDevice)
+{
+    std::vector<vk::QueueFamilyProperties> allQueueFamilyProperties =
+      physicalDevice.getQueueFamilyProperties();
+
+    for (uint32_t i = 0; i < allQueueFamilyProperties.size(); i++) {
+        if (allQueueFamilyProperties[i].queueFlags &
+            vk::QueueFlagBits::eCompute) {
+            return i;
+        }
+    }
+
+    throw std::runtime_error("Compute queue is not supported");
+}
+
+uint32_t
+Manager::physicalDeviceIndex()
+{
+    return this->mPhysicalDeviceIndex;
+}
+
+std::shared_ptr<TransferEngine>
+Manager::createTransferEngine(uint32_t queueIndex,
+                              uint64_t chunkSize,
+                              uint32_t numChunks)
+{
+    SPDLOG_DEBUG("Kompute Manager createTransferEngine with queueIndex: {}",
+                 queueIndex);
+
+    if (queueIndex >= this->mComputeQueues.size()) {
+        throw std::runtime_error(
+          "Kompute Manager createTransferEngine queue index out of range: " +
+          std::to_string(queueIndex));
+    }
+
+    if (this->mComputeQueues.size() == 1) {
+        SPDLOG_WARN("Kompute Manager transfer engine shares the only queue "
+                    "with the sequences, so transfers will be serialised "
+                    "with the sequence submissions");
+    }
+
+    std::shared_ptr<TransferEngine> transferEngine =
+      std::make_shared<TransferEngine>(
+        this->mPhysicalDevice,
+        this->mDevice,
+        this->mComputeQueues[queueIndex],
+        this->mComputeQueueFamilyIndices[queueIndex],
+        chunkSize,
+        numChunks,
+        this->mComputeQueueMutexes[queueIndex]);
+    transferEngine->init();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mManagedSequencesMutex);
+        this->mTransferEngines.push_back(transferEngine);
+    }
+
+    return transferEngine;
+}
+
 void
 Manager::createInstance()
 {
@@ -227,7 +500,8 @@ Manager::createInstance()
 }
 
 void
-Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices)
+Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices,
+                      const std::vector<std::string>& requiredExtensions)
 {
 
     SPDLOG_DEBUG("Kompute Manager creating Device");
@@ -245,6 +519,12 @@ Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices)
     std::vector<vk::PhysicalDevice> physicalDevices =
       this->mInstance->enumeratePhysicalDevices();
 
+    if (this->mPhysicalDeviceIndex >= physicalDevices.size()) {
+        throw std::runtime_error(
+          "Kompute Manager physical device index out of range: " +
+          std::to_string(this->mPhysicalDeviceIndex));
+    }
+
     vk::PhysicalDevice physicalDevice =
       physicalDevices[this->mPhysicalDeviceIndex];
 
@@ -259,27 +539,8 @@ Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices)
                 physicalDeviceProperties.deviceName);
 
     if (!familyQueueIndices.size()) {
-        // Find compute queue
-        std::vector<vk::QueueFamilyProperties> allQueueFamilyProperties =
-          physicalDevice.getQueueFamilyProperties();
-
-        uint32_t computeQueueFamilyIndex = -1;
-        for (uint32_t i = 0; i < allQueueFamilyProperties.size(); i++) {
-            vk::QueueFamilyProperties queueFamilyProperties =
-              allQueueFamilyProperties[i];
-
-            if (queueFamilyProperties.queueFlags &
-                vk::QueueFlagBits::eCompute) {
-                computeQueueFamilyIndex = i;
-                break;
-            }
-        }
-
-        if (computeQueueFamilyIndex < 0) {
-            throw std::runtime_error("Compute queue is not supported");
-        }
-
-        this->mComputeQueueFamilyIndices.push_back(computeQueueFamilyIndex);
+        this->mComputeQueueFamilyIndices.push_back(
+          Manager::findComputeQueueFamilyIndex(physicalDevice));
     } else {
         this->mComputeQueueFamilyIndices = familyQueueIndices;
     }
@@ -291,12 +552,8 @@ Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices)
         familyQueuePriorities[value].push_back(1.0f);
     }
 
-    std::unordered_map<uint32_t, uint32_t> familyQueueIndexCount;
     std::vector<vk::DeviceQueueCreateInfo> deviceQueueCreateInfos;
     for (const auto& familyQueueInfo : familyQueueCounts) {
-        // Setting the device count to 0
-        familyQueueIndexCount[familyQueueInfo.first] = 0;
-
         // Creating the respective device queue
         vk::DeviceQueueCreateInfo deviceQueueCreateInfo(
           vk::DeviceQueueCreateFlags(),
@@ -306,15 +563,85 @@ Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices)
         deviceQueueCreateInfos.push_back(deviceQueueCreateInfo);
     }
 
+    std::vector<const char*> deviceExtensions;
+    for (const std::string& extensionName : requiredExtensions) {
+        deviceExtensions.push_back(extensionName.c_str());
+    }
+
+    bool isPushDescriptorSupported = false;
+    bool isExternalMemoryHostSupported = false;
+    {
+        std::vector<vk::ExtensionProperties> availableExtensionProperties =
+          physicalDevice.enumerateDeviceExtensionProperties();
+        for (vk::ExtensionProperties extensionProperties :
+             availableExtensionProperties) {
+            std::string extensionName(extensionProperties.extensionName.data());
+#ifndef KOMPUTE_DISABLE_PUSH_DESCRIPTORS
+            if (extensionName == VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME) {
+                isPushDescriptorSupported = true;
+            }
+#endif
+            // Allows tensors wrapping host memory to import it without copies
+            if (extensionName == VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME) {
+                isExternalMemoryHostSupported = true;
+            }
+        }
+    }
+
+    // Extensions are only added once even if also required by the policy
+    std::set<std::string> enabledExtensionNames(requiredExtensions.begin(),
+                                                requiredExtensions.end());
+    if (isPushDescriptorSupported &&
+        !enabledExtensionNames.count(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME)) {
+        deviceExtensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+    }
+    if (isExternalMemoryHostSupported &&
+        !enabledExtensionNames.count(
+          VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME)) {
+        deviceExtensions.push_back(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+    }
+
     vk::DeviceCreateInfo deviceCreateInfo(vk::DeviceCreateFlags(),
                                           deviceQueueCreateInfos.size(),
                                           deviceQueueCreateInfos.data());
+    if (!deviceExtensions.empty()) {
+        deviceCreateInfo.enabledExtensionCount =
+          (uint32_t)deviceExtensions.size();
+        deviceCreateInfo.ppEnabledExtensionNames = deviceExtensions.data();
+    }
+    this->mEnabledExtensions.assign(deviceExtensions.begin(),
+                                    deviceExtensions.end());
 
     this->mDevice = std::make_shared<vk::Device>();
     physicalDevice.createDevice(
       &deviceCreateInfo, nullptr, this->mDevice.get());
     SPDLOG_DEBUG("Kompute Manager device created");
 
+    this->createComputeQueues();
+
+    this->mShaderCache = std::make_shared<ShaderCache>(this->mDevice);
+    this->mDescriptorPoolArena =
+      std::make_shared<DescriptorPoolArena>(this->mDevice);
+
+    if (isPushDescriptorSupported) {
+        SPDLOG_DEBUG("Kompute Manager enabling push descriptors");
+
+        std::shared_ptr<vk::DispatchLoaderDynamic> pushDescriptorDispatcher =
+          std::make_shared<vk::DispatchLoaderDynamic>();
+        pushDescriptorDispatcher->init(*this->mInstance,
+                                       &vkGetInstanceProcAddr,
+                                       *this->mDevice,
+                                       &vkGetDeviceProcAddr);
+        this->mDescriptorPoolArena->enablePushDescriptors(
+          pushDescriptorDispatcher);
+    }
+}
+
+void
+Manager::createComputeQueues()
+{
+    // Repeated families take the next queue of the family in the device
+    std::unordered_map<uint32_t, uint32_t> familyQueueIndexCount;
     for (const uint32_t& familyQueueIndex : this->mComputeQueueFamilyIndices) {
         std::shared_ptr<vk::Queue> currQueue = std::make_shared<vk::Queue>();
 
@@ -325,6 +652,7 @@ Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices)
         familyQueueIndexCount[familyQueueIndex]++;
 
         this->mComputeQueues.push_back(currQueue);
+        this->mComputeQueueMutexes.push_back(std::make_shared<std::mutex>());
     }
 
     SPDLOG_DEBUG("Kompute Manager compute queue obtained");
@@ -0,0 +1,249 @@
+#include <algorithm>
+
+#include "kompute/MultiDeviceManager.hpp"
+
+namespace kp {
+
+MultiDeviceManager::MultiDeviceManager(
+  const std::vector<uint32_t>& physicalDeviceIndices)
+{
+    SPDLOG_DEBUG("Kompute MultiDeviceManager constructor with {} devices",
+                 physicalDeviceIndices.size());
+
+    if (physicalDeviceIndices.empty()) {
+        throw std::runtime_error(
+          "Kompute MultiDeviceManager called with no physical devices");
+    }
+
+    for (uint32_t physicalDeviceIndex : physicalDeviceIndices) {
+        this->mManagers.push_back(
+          std::make_shared<Manager>(physicalDeviceIndex));
+    }
+}
+
+MultiDeviceManager::MultiDeviceManager(
+  const std::vector<std::shared_ptr<Manager>>& managers)
+{
+    SPDLOG_DEBUG("Kompute MultiDeviceManager constructor with {} managers",
+                 managers.size());
+
+    if (managers.empty()) {
+        throw std::runtime_error(
+          "Kompute MultiDeviceManager called with no managers");
+    }
+
+    this->mManagers = managers;
+}
+
+MultiDeviceManager::~MultiDeviceManager()
+{
+    SPDLOG_DEBUG("Kompute MultiDeviceManager destructor started");
+}
+
+uint32_t
+MultiDeviceManager::size()
+{
+    return this->mManagers.size();
+}
+
+std::shared_ptr<Manager>
+MultiDeviceManager::manager(uint32_t deviceIndex)
+{
+    if (deviceIndex >= this->mManagers.size()) {
+        throw std::runtime_error(
+          "Kompute MultiDeviceManager device index out of range: " +
+          std::to_string(deviceIndex));
+    }
+    return this->mManagers[deviceIndex];
+}
+
+std::vector<std::shared_ptr<Tensor>>
+MultiDeviceManager::shard(const std::vector<float>& data,
+                          uint32_t rowSize,
+                          Tensor::TensorTypes tensorType)
+{
+    uint32_t numDevices = this->mManagers.size();
+
+    if (rowSize == 0 || data.size() % rowSize != 0) {
+        throw std::runtime_error(
+          "Kompute MultiDeviceManager data size " +
+          std::to_string(data.size()) +
+          " is not a multiple of the row size " + std::to_string(rowSize));
+    }
+    uint32_t numRows = data.size() / rowSize;
+    if (numRows < numDevices) {
+        throw std::runtime_error("Kompute MultiDeviceManager cannot shard " +
+                                 std::to_string(numRows) + " rows across " +
+                                 std::to_string(numDevices) + " devices");
+    }
+
+    SPDLOG_DEBUG("Kompute MultiDeviceManager sharding {} rows of size {}",
+                 numRows,
+                 rowSize);
+
+    std::vector<std::shared_ptr<Tensor>> shards;
+    std::vector<EvalFuture> futures;
+    uint32_t rowOffset = 0;
+    try {
+        for (uint32_t i = 0; i < numDevices; i++) {
+            uint32_t shardRows =
+              numRows / numDevices + (i < numRows % numDevices ? 1 : 0);
+
+            std::shared_ptr<Tensor> tensor = std::make_shared<Tensor>(
+              std::vector<float>(data.begin() + rowOffset * rowSize,
+                                 data.begin() +
+                                   (rowOffset + shardRows) * rowSize),
+              tensorType);
+            futures.push_back(
+              this->mManagers[i]->evalOpAsyncDefault<OpTensorCreate>(
+                { tensor }));
+
+            shards.push_back(tensor);
+            rowOffset += shardRows;
+        }
+    } catch (...) {
+        this->awaitAll(futures, std::current_exception());
+    }
+    this->awaitAll(futures);
+
+    return shards;
+}
+
+std::vector<std::shared_ptr<Tensor>>
+MultiDeviceManager::replicate(const std::vector<float>& data,
+                              Tensor::TensorTypes tensorType)
+{
+    SPDLOG_DEBUG("Kompute MultiDeviceManager replicating {} elements",
+                 data.size());
+
+    std::vector<std::shared_ptr<Tensor>> replicas;
+    std::vector<EvalFuture> futures;
+    try {
+        for (const std::shared_ptr<Manager>& manager : this->mManagers) {
+            std::shared_ptr<Tensor> tensor =
+              std::make_shared<Tensor>(data, tensorType);
+            futures.push_back(
+              manager->evalOpAsyncDefault<OpTensorCreate>({ tensor }));
+            replicas.push_back(tensor);
+        }
+    } catch (...) {
+        this->awaitAll(futures, std::current_exception());
+    }
+    this->awaitAll(futures);
+
+    return replicas;
+}
+
+std::vector<float>
+MultiDeviceManager::gather(const std::vector<std::shared_ptr<Tensor>>& shards)
+{
+    SPDLOG_DEBUG("Kompute MultiDeviceManager gathering shards");
+
+    this->validateTensors(shards);
+
+    this->evalOp<OpTensorSyncLocal>({ shards });
+
+    std::vector<float> data;
+    for (const std::shared_ptr<Tensor>& shard : shards) {
+        data.insert(data.end(), shard->data().begin(), shard->data().end());
+    }
+    return data;
+}
+
+std::vector<float>
+MultiDeviceManager::allReduce(
+  const std::vector<std::shared_ptr<Tensor>>& tensors,
+  ReduceOps reduceOp)
+{
+    SPDLOG_DEBUG("Kompute MultiDeviceManager all-reduce of {} tensors",
+                 tensors.size());
+
+    this->validateTensors(tensors);
+    for (const std::shared_ptr<Tensor>& tensor : tensors) {
+        if (tensor->size() != tensors[0]->size()) {
+            throw std::runtime_error(
+              "Kompute MultiDeviceManager all-reduce tensors have different "
+              "sizes");
+        }
+    }
+
+    this->evalOp<OpTensorSyncLocal>({ tensors });
+
+    std::vector<float> reduced = tensors[0]->data();
+    for (size_t i = 1; i < tensors.size(); i++) {
+        const std::vector<float>& data = tensors[i]->data();
+        for (size_t j = 0; j < reduced.size(); j++) {
+            reduced[j] += data[j];
+        }
+    }
+    if (reduceOp == ReduceOps::eMean) {
+        for (float& value : reduced) {
+            value /= tensors.size();
+        }
+    }
+
+    for (const std::shared_ptr<Tensor>& tensor : tensors) {
+        tensor->setData(reduced);
+    }
+    this->evalOp<OpTensorSyncDevice>({ tensors });
+
+    return reduced;
+}
+
+std::vector<std::shared_ptr<Tensor>>
+MultiDeviceManager::deviceTensors(
+  const std::vector<std::vector<std::shared_ptr<Tensor>>>& shardedTensors,
+  uint32_t deviceIndex)
+{
+    std::vector<std::shared_ptr<Tensor>> tensors;
+    for (const std::vector<std::shared_ptr<Tensor>>& shards : shardedTensors) {
+        if (shards.size() != this->mManagers.size()) {
+            throw std::runtime_error(
+              "Kompute MultiDeviceManager expected one shard per device but "
+              "got " +
+              std::to_string(shards.size()));
+        }
+        tensors.push_back(shards[deviceIndex]);
+    }
+    return tensors;
+}
+
+void
+MultiDeviceManager::awaitAll(std::vector<EvalFuture>& futures,
+                             std::exception_ptr exception)
+{
+    // All the futures are awaited before rethrowing so no evaluation is left
+    // in flight with tensors that may be released by the caller, which is
+    // also done when submitting the evaluations failed part way with the
+    // exception provided
+    for (EvalFuture& future : futures) {
+        try {
+            // Submissions can also fail without an exception, in which case
+            // the tensors of the device were not evaluated
+            if (!future.get()) {
+                throw std::runtime_error(
+                  "Kompute MultiDeviceManager evaluation failed on a device");
+            }
+        } catch (...) {
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void
+MultiDeviceManager::validateTensors(
+  const std::vector<std::shared_ptr<Tensor>>& tensors)
+{
+    if (tensors.size() != this->mManagers.size()) {
+        throw std::runtime_error(
+          "Kompute MultiDeviceManager expected one tensor per device but got " +
+          std::to_string(tensors.size()));
+    }
+}
+
+} // End namespace kp
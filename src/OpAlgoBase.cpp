@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+
 #include "kompute/operations/OpAlgoBase.hpp"
 
 namespace kp {
@@ -93,13 +95,128 @@ OpAlgoBase::init()
         }
     }
 
-    SPDLOG_DEBUG("Kompute OpAlgoBase fetching spirv data");
+    this->initAlgorithm();
+}
+
+void
+OpAlgoBase::setShaderCache(std::shared_ptr<ShaderCache> shaderCache)
+{
+    this->mShaderCache = shaderCache;
+}
 
-    std::vector<char> shaderFileData = this->fetchSpirvBinaryData();
+void
+OpAlgoBase::setDescriptorPoolArena(
+  std::shared_ptr<DescriptorPoolArena> descriptorPoolArena)
+{
+    this->mDescriptorPoolArena = descriptorPoolArena;
+}
 
+void
+OpAlgoBase::initAlgorithm()
+{
     SPDLOG_DEBUG("Kompute OpAlgoBase Initialising algorithm component");
 
-    this->mAlgorithm->init(shaderFileData, this->mTensors);
+    if (this->mDescriptorPoolArena) {
+        this->mAlgorithm->setDescriptorPoolArena(this->mDescriptorPoolArena);
+    }
+
+    if (!this->mShaderCache) {
+        SPDLOG_DEBUG("Kompute OpAlgoBase fetching spirv data");
+
+        std::vector<char> shaderFileData = this->fetchSpirvBinaryData();
+
+        this->mAlgorithm->init(
+          shaderFileData, this->mTensors, this->mSpecializationConstants);
+    } else if (this->mShaderFilePath.size()) {
+        SPDLOG_DEBUG("Kompute OpAlgoBase fetching cached shader from file");
+
+        this->mAlgorithm->init(
+          this->mShaderCache->getOrCreateFromFile(this->mShaderFilePath),
+          this->mTensors,
+          this->mSpecializationConstants);
+    } else {
+        SPDLOG_DEBUG("Kompute OpAlgoBase fetching cached shader from data");
+
+        this->mAlgorithm->init(
+          this->mShaderCache->getOrCreateFromData(this->fetchSpirvBinaryData()),
+          this->mTensors,
+          this->mSpecializationConstants);
+    }
+}
+
+std::shared_ptr<Algorithm>
+OpAlgoBase::createAlgorithm(
+  const std::vector<char>& shaderData,
+  const std::vector<std::shared_ptr<Tensor>>& tensors,
+  const std::vector<uint32_t>& specializationConstants)
+{
+    SPDLOG_DEBUG("Kompute OpAlgoBase creating algorithm with {} tensors",
+                 tensors.size());
+
+    std::shared_ptr<Algorithm> algorithm =
+      std::make_shared<Algorithm>(this->mDevice, this->mCommandBuffer);
+
+    if (this->mDescriptorPoolArena) {
+        algorithm->setDescriptorPoolArena(this->mDescriptorPoolArena);
+    }
+
+    if (this->mShaderCache) {
+        algorithm->init(this->mShaderCache->getOrCreateFromData(shaderData),
+                        tensors,
+                        specializationConstants);
+    } else {
+        algorithm->init(shaderData, tensors, specializationConstants);
+    }
+
+    return algorithm;
+}
+
+std::shared_ptr<Tensor>
+OpAlgoBase::createInternalTensor(uint32_t size)
+{
+    std::shared_ptr<Tensor> tensor = std::make_shared<Tensor>(
+      std::vector<float>(size, 0), Tensor::TensorTypes::eDevice);
+    tensor->init(this->mPhysicalDevice, this->mDevice);
+    return tensor;
+}
+
+uint32_t
+OpAlgoBase::powerOfTwoWorkgroupSize(uint32_t maxSize)
+{
+    vk::PhysicalDeviceLimits limits =
+      this->mPhysicalDevice->getProperties().limits;
+    maxSize = std::min({ maxSize,
+                         limits.maxComputeWorkGroupInvocations,
+                         limits.maxComputeWorkGroupSize[0] });
+
+    uint32_t workgroupSize = 1;
+    while (workgroupSize * 2 <= maxSize) {
+        workgroupSize *= 2;
+    }
+    return workgroupSize;
+}
+
+std::vector<uint32_t>
+OpAlgoBase::tensorShape(const std::shared_ptr<Tensor>& tensor)
+{
+    std::vector<uint32_t> shape;
+    for (uint32_t dimension : tensor->shape()) {
+        if (!dimension) {
+            break;
+        }
+        shape.push_back(dimension);
+    }
+    return shape;
+}
+
+std::string
+OpAlgoBase::shapeToString(const std::vector<uint32_t>& shape)
+{
+    std::string shapeString = "(";
+    for (size_t i = 0; i < shape.size(); i++) {
+        shapeString += (i ? ", " : "") + std::to_string(shape[i]);
+    }
+    return shapeString + ")";
 }
 
 void
@@ -140,24 +257,7 @@ OpAlgoBase::fetchSpirvBinaryData()
     SPDLOG_WARN("Kompute OpAlgoBase Running shaders directly from spirv file");
 
     if (this->mShaderFilePath.size()) {
-        std::ifstream fileStream(this->mShaderFilePath,
-                                 std::ios::binary | std::ios::in |
-                                   std::ios::ate);
-
-        if (!fileStream.good()) {
-            throw std::runtime_error("Error reading file: " +
-                                     this->mShaderFilePath);
-        }
-
-        size_t shaderFileSize = fileStream.tellg();
-        fileStream.seekg(0, std::ios::beg);
-        char* shaderDataRaw = new char[shaderFileSize];
-        fileStream.read(shaderDataRaw, shaderFileSize);
-        fileStream.close();
-
-        SPDLOG_WARN("Kompute OpAlgoBase fetched {} bytes", shaderFileSize);
-
-        return std::vector<char>(shaderDataRaw, shaderDataRaw + shaderFileSize);
+        return readShaderFile(this->mShaderFilePath);
     } else if (this->mShaderDataRaw.size()) {
         return this->mShaderDataRaw;
     } else {
@@ -167,4 +267,25 @@ OpAlgoBase::fetchSpirvBinaryData()
     }
 }
 
+std::vector<char>
+OpAlgoBase::readShaderFile(const std::string& shaderFilePath)
+{
+    std::ifstream fileStream(
+      shaderFilePath, std::ios::binary | std::ios::in | std::ios::ate);
+
+    if (!fileStream.good()) {
+        throw std::runtime_error("Error reading file: " + shaderFilePath);
+    }
+
+    size_t shaderFileSize = fileStream.tellg();
+    fileStream.seekg(0, std::ios::beg);
+    std::vector<char> shaderDataRaw(shaderFileSize);
+    fileStream.read(shaderDataRaw.data(), shaderFileSize);
+    fileStream.close();
+
+    SPDLOG_WARN("Kompute OpAlgoBase fetched {} bytes", shaderFileSize);
+
+    return shaderDataRaw;
+}
+
 }
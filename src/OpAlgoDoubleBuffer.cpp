@@ -0,0 +1,169 @@
+
+#include "kompute/operations/OpAlgoDoubleBuffer.hpp"
+
+namespace kp {
+
+OpAlgoDoubleBuffer::OpAlgoDoubleBuffer()
+{
+    SPDLOG_DEBUG("Kompute OpAlgoDoubleBuffer constructor base");
+}
+
+OpAlgoDoubleBuffer::OpAlgoDoubleBuffer(
+  std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+  std::shared_ptr<vk::Device> device,
+  std::shared_ptr<vk::CommandBuffer> commandBuffer,
+  std::vector<std::shared_ptr<Tensor>>& tensors,
+  std::shared_ptr<TensorDoubleBuffer> doubleBuffer,
+  uint32_t iterations,
+  std::string shaderFilePath,
+  KomputeWorkgroup komputeWorkgroup)
+  : OpAlgoBase(physicalDevice,
+               device,
+               commandBuffer,
+               tensors,
+               shaderFilePath,
+               komputeWorkgroup)
+{
+    SPDLOG_DEBUG("Kompute OpAlgoDoubleBuffer constructor with iterations: {}",
+                 iterations);
+
+    this->mDoubleBuffer = doubleBuffer;
+    this->mIterations = iterations;
+}
+
+OpAlgoDoubleBuffer::OpAlgoDoubleBuffer(
+  std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+  std::shared_ptr<vk::Device> device,
+  std::shared_ptr<vk::CommandBuffer> commandBuffer,
+  std::vector<std::shared_ptr<Tensor>>& tensors,
+  std::shared_ptr<TensorDoubleBuffer> doubleBuffer,
+  uint32_t iterations,
+  const std::vector<char>& shaderDataRaw,
+  KomputeWorkgroup komputeWorkgroup)
+  : OpAlgoBase(physicalDevice,
+               device,
+               commandBuffer,
+               tensors,
+               shaderDataRaw,
+               komputeWorkgroup)
+{
+    SPDLOG_DEBUG("Kompute OpAlgoDoubleBuffer constructor with iterations: {}",
+                 iterations);
+
+    this->mDoubleBuffer = doubleBuffer;
+    this->mIterations = iterations;
+}
+
+OpAlgoDoubleBuffer::~OpAlgoDoubleBuffer()
+{
+    SPDLOG_DEBUG("Kompute OpAlgoDoubleBuffer destructor started");
+}
+
+void
+OpAlgoDoubleBuffer::init()
+{
+    SPDLOG_DEBUG("Kompute OpAlgoDoubleBuffer init called");
+
+    if (!this->mDoubleBuffer) {
+        throw std::runtime_error(
+          "Kompute OpAlgoDoubleBuffer called with null double buffer");
+    }
+
+    if (this->mTensors.size() < 2 ||
+        this->mTensors[0] != this->mDoubleBuffer->read() ||
+        this->mTensors[1] != this->mDoubleBuffer->write()) {
+        throw std::runtime_error(
+          "Kompute OpAlgoDoubleBuffer tensors must start with the read and "
+          "write tensors of the double buffer");
+    }
+
+    if (this->mIterations < 1) {
+        throw std::runtime_error(
+          "Kompute OpAlgoDoubleBuffer requires at least one iteration");
+    }
+
+    // Swapped bindings are retrieved from the arena or pushed directly
+    if (this->mIterations > 1 && !this->mDescriptorPoolArena) {
+        throw std::runtime_error(
+          "Kompute OpAlgoDoubleBuffer requires a descriptor pool arena to "
+          "swap bindings, record it in a sequence created by a kp::Manager");
+    }
+
+    this->mRecordedReadIndex = this->mDoubleBuffer->readIndex();
+
+    OpAlgoBase::init();
+}
+
+void
+OpAlgoDoubleBuffer::record()
+{
+    SPDLOG_DEBUG("Kompute OpAlgoDoubleBuffer record called with {} iterations",
+                 this->mIterations);
+
+    // Barrier to ensure the data is finished writing to buffer memory
+    for (std::shared_ptr<Tensor> tensor : this->mTensors) {
+        tensor->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eHostWrite,
+          vk::AccessFlagBits::eShaderRead,
+          vk::PipelineStageFlagBits::eHost,
+          vk::PipelineStageFlagBits::eComputeShader);
+    }
+
+    std::vector<std::shared_ptr<Tensor>> swappedTensors = this->mTensors;
+    std::swap(swappedTensors[0], swappedTensors[1]);
+
+    for (uint32_t i = 0; i < this->mIterations; i++) {
+        bool isSwapped = i % 2 == 1;
+
+        if (i > 0) {
+            // The tensor written in the previous iteration is read in this
+            // one, and the compute to compute dependency also ensures the
+            // previous reads of the tensor now written have finished
+            std::shared_ptr<Tensor> previousOutput =
+              isSwapped ? this->mTensors[1] : this->mTensors[0];
+            previousOutput->recordBufferMemoryBarrier(
+              this->mCommandBuffer,
+              vk::AccessFlagBits::eShaderWrite,
+              vk::AccessFlagBits::eShaderRead,
+              vk::PipelineStageFlagBits::eComputeShader,
+              vk::PipelineStageFlagBits::eComputeShader);
+        }
+
+        if (isSwapped) {
+            this->mAlgorithm->recordDispatch(swappedTensors,
+                                             this->mKomputeWorkgroup.x,
+                                             this->mKomputeWorkgroup.y,
+                                             this->mKomputeWorkgroup.z);
+        } else {
+            this->mAlgorithm->recordDispatch(this->mKomputeWorkgroup.x,
+                                             this->mKomputeWorkgroup.y,
+                                             this->mKomputeWorkgroup.z);
+        }
+    }
+}
+
+void
+OpAlgoDoubleBuffer::preEval()
+{
+    SPDLOG_DEBUG("Kompute OpAlgoDoubleBuffer preEval called");
+
+    if (this->mDoubleBuffer->readIndex() != this->mRecordedReadIndex) {
+        throw std::runtime_error(
+          "Kompute OpAlgoDoubleBuffer double buffer roles changed since the "
+          "operation was recorded, use an even number of iterations to "
+          "evaluate the same recording multiple times or record it again");
+    }
+}
+
+void
+OpAlgoDoubleBuffer::postEval()
+{
+    SPDLOG_DEBUG("Kompute OpAlgoDoubleBuffer postEval called");
+
+    if (this->mIterations % 2 == 1) {
+        this->mDoubleBuffer->swap();
+    }
+}
+
+}
@@ -66,17 +66,14 @@ OpAlgoLhsRhsOut::init()
     }
 
     this->mTensorOutputStaging = std::make_shared<Tensor>(
-      this->mTensorOutput->data(), Tensor::TensorTypes::eStaging);
+      std::vector<float>(this->mTensorOutput->size(), 0),
+      Tensor::TensorTypes::eStaging);
 
     this->mTensorOutputStaging->init(this->mPhysicalDevice, this->mDevice);
 
-    SPDLOG_DEBUG("Kompute OpAlgoLhsRhsOut fetching spirv data");
-
-    std::vector<char> shaderFileData = this->fetchSpirvBinaryData();
-
     SPDLOG_DEBUG("Kompute OpAlgoLhsRhsOut Initialising algorithm component");
 
-    this->mAlgorithm->init(shaderFileData, this->mTensors);
+    this->initAlgorithm();
 }
 
 void
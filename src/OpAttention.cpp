@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if RELEASE
+#include "kompute/shaders/shaderopattention.hpp"
+#endif
+
+#include "kompute/operations/OpAttention.hpp"
+
+namespace kp {
+
+OpAttention::OpAttention()
+{
+    SPDLOG_DEBUG("Kompute OpAttention constructor base");
+}
+
+OpAttention::OpAttention(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                         std::shared_ptr<vk::Device> device,
+                         std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                         std::vector<std::shared_ptr<Tensor>>& tensors,
+                         bool causal,
+                         float scale)
+  : OpAlgoBase(physicalDevice, device, commandBuffer, tensors, "")
+{
+    SPDLOG_DEBUG("Kompute OpAttention constructor with params");
+
+    this->mCausal = causal;
+    this->mScale = scale;
+
+#ifndef RELEASE
+    this->mShaderFilePath = "shaders/glsl/opattention.comp";
+#endif
+}
+
+OpAttention::~OpAttention()
+{
+    SPDLOG_DEBUG("Kompute OpAttention destructor started");
+}
+
+void
+OpAttention::init()
+{
+    SPDLOG_DEBUG("Kompute OpAttention init called");
+
+    if (this->mTensors.size() != 4) {
+        throw std::runtime_error(
+          "Kompute OpAttention called with " +
+          std::to_string(this->mTensors.size()) +
+          " tensors but expected the queries, keys, values and output tensors");
+    }
+
+    std::vector<uint32_t> queriesShape = tensorShape(this->mTensors[0]);
+    std::vector<uint32_t> keysShape = tensorShape(this->mTensors[1]);
+    std::vector<uint32_t> valuesShape = tensorShape(this->mTensors[2]);
+    if (queriesShape.size() < 2 || keysShape.size() < 2 ||
+        valuesShape.size() < 2) {
+        throw std::runtime_error(
+          "Kompute OpAttention queries, keys and values need at least two "
+          "dimensions but have shapes " +
+          shapeToString(queriesShape) + ", " + shapeToString(keysShape) +
+          " and " + shapeToString(valuesShape));
+    }
+
+    uint32_t queryRows = queriesShape[queriesShape.size() - 2];
+    uint32_t keyRows = keysShape[keysShape.size() - 2];
+    uint32_t headDim = queriesShape.back();
+    uint32_t valueDim = valuesShape.back();
+    uint32_t numBatches = this->mTensors[0]->size() / (queryRows * headDim);
+
+    std::vector<uint32_t> outputShape(queriesShape.begin(),
+                                      queriesShape.end() - 1);
+    outputShape.push_back(valueDim);
+    std::vector<uint32_t> tensorOutputShape = tensorShape(this->mTensors[3]);
+
+    if (keysShape.back() != headDim ||
+        valuesShape[valuesShape.size() - 2] != keyRows ||
+        this->mTensors[1]->size() != numBatches * keyRows * headDim ||
+        this->mTensors[2]->size() != numBatches * keyRows * valueDim) {
+        throw std::runtime_error(
+          "Kompute OpAttention shapes of the queries " +
+          shapeToString(queriesShape) + ", keys " + shapeToString(keysShape) +
+          " and values " + shapeToString(valuesShape) + " do not match");
+    }
+    // Outputs with a single dimension only need to match the output size
+    if (this->mTensors[3]->size() != numBatches * queryRows * valueDim ||
+        (tensorOutputShape.size() > 1 && tensorOutputShape != outputShape)) {
+        throw std::runtime_error(
+          "Kompute OpAttention output of shape " +
+          shapeToString(tensorOutputShape) +
+          " does not match the shape of the attention " +
+          shapeToString(outputShape));
+    }
+    if (this->mCausal && keyRows < queryRows) {
+        throw std::runtime_error(
+          "Kompute OpAttention causal attention needs at least as many keys "
+          "as queries");
+    }
+
+    // Each invocation computes a query row, and the tile of keys and values
+    // is the largest that fits in the shared memory of the device
+    uint32_t queryTile = this->powerOfTwoWorkgroupSize(std::min<uint32_t>(
+      KP_DEFAULT_ATTENTION_TILE_SIZE, queryRows * 2 - 1));
+    uint32_t sharedMemorySize =
+      this->mPhysicalDevice->getProperties().limits.maxComputeSharedMemorySize;
+    uint32_t keyTile = KP_DEFAULT_ATTENTION_TILE_SIZE;
+    while (keyTile > 1 &&
+           keyTile * (headDim + valueDim) * sizeof(float) > sharedMemorySize) {
+        keyTile /= 2;
+    }
+    if ((headDim + valueDim) * sizeof(float) > sharedMemorySize) {
+        throw std::runtime_error(
+          "Kompute OpAttention a row of keys and values of " +
+          std::to_string(headDim + valueDim) +
+          " floats does not fit in the shared memory of the device");
+    }
+
+    float scale =
+      this->mScale != 0.0f ? this->mScale : 1.0f / std::sqrt(float(headDim));
+    uint32_t scaleBits;
+    std::memcpy(&scaleBits, &scale, sizeof(float));
+    this->mSpecializationConstants = { queryRows,
+                                       keyRows,
+                                       headDim,
+                                       valueDim,
+                                       keyTile,
+                                       this->mCausal ? 1u : 0u,
+                                       scaleBits,
+                                       queryTile };
+
+    uint32_t numBlocks =
+      numBatches * ((queryRows + queryTile - 1) / queryTile);
+    uint32_t maxWorkgroupCount =
+      this->mPhysicalDevice->getProperties().limits.maxComputeWorkGroupCount[0];
+    this->mKomputeWorkgroup = { std::min(numBlocks, maxWorkgroupCount), 1, 1 };
+
+    SPDLOG_DEBUG("Kompute OpAttention using tiles of {} queries and {} keys",
+                 queryTile,
+                 keyTile);
+
+    OpAlgoBase::init();
+}
+
+void
+OpAttention::record()
+{
+    SPDLOG_DEBUG("Kompute OpAttention record called");
+
+    std::shared_ptr<Tensor> tensorOutput = this->mTensors.back();
+
+    for (size_t i = 0; i + 1 < this->mTensors.size(); i++) {
+        this->mTensors[i]->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eMemoryWrite,
+          vk::AccessFlagBits::eShaderRead,
+          vk::PipelineStageFlagBits::eAllCommands,
+          vk::PipelineStageFlagBits::eComputeShader);
+    }
+    tensorOutput->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eMemoryWrite,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::PipelineStageFlagBits::eAllCommands,
+      vk::PipelineStageFlagBits::eComputeShader);
+
+    this->mAlgorithm->recordDispatch(this->mKomputeWorkgroup.x,
+                                     this->mKomputeWorkgroup.y,
+                                     this->mKomputeWorkgroup.z);
+
+    tensorOutput->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::AccessFlagBits::eMemoryRead,
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eAllCommands);
+}
+
+#if RELEASE
+std::vector<char>
+OpAttention::fetchSpirvBinaryData()
+{
+    SPDLOG_WARN("Kompute OpAttention Running shaders directly from header");
+
+    return std::vector<char>(
+      shader_data::shaders_glsl_opattention_comp_spv,
+      shader_data::shaders_glsl_opattention_comp_spv +
+        kp::shader_data::shaders_glsl_opattention_comp_spv_len);
+}
+#endif
+
+} // End namespace kp
@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cstring>
+
+#if RELEASE
+#include "kompute/shaders/shaderopbatchnorm.hpp"
+#endif
+
+#include "kompute/operations/OpBatchNorm.hpp"
+
+namespace kp {
+
+OpBatchNorm::OpBatchNorm()
+{
+    SPDLOG_DEBUG("Kompute OpBatchNorm constructor base");
+}
+
+OpBatchNorm::OpBatchNorm(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                         std::shared_ptr<vk::Device> device,
+                         std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                         std::vector<std::shared_ptr<Tensor>>& tensors,
+                         float epsilon)
+  : OpAlgoBase(physicalDevice, device, commandBuffer, tensors)
+{
+    SPDLOG_DEBUG("Kompute OpBatchNorm constructor with params");
+
+    this->mEpsilon = epsilon;
+
+#ifndef RELEASE
+    this->mShaderFilePath = "shaders/glsl/opbatchnorm.comp";
+#endif
+}
+
+OpBatchNorm::~OpBatchNorm()
+{
+    SPDLOG_DEBUG("Kompute OpBatchNorm destructor started");
+}
+
+void
+OpBatchNorm::init()
+{
+    SPDLOG_DEBUG("Kompute OpBatchNorm init called");
+
+    if (this->mTensors.size() != 6) {
+        throw std::runtime_error(
+          "Kompute OpBatchNorm called with " +
+          std::to_string(this->mTensors.size()) +
+          " tensors but expected the input, scale, shift, mean, variance and "
+          "output tensors");
+    }
+
+    std::vector<uint32_t> inputShape = tensorShape(this->mTensors[0]);
+    if (inputShape.size() < 2) {
+        throw std::runtime_error(
+          "Kompute OpBatchNorm expected an input of shape (N, C, ...) but got " +
+          shapeToString(inputShape));
+    }
+
+    this->mChannels = inputShape[1];
+    this->mChannelSize = 1;
+    for (size_t i = 2; i < inputShape.size(); i++) {
+        this->mChannelSize *= inputShape[i];
+    }
+
+    for (size_t i = 1; i < 5; i++) {
+        if (this->mTensors[i]->size() != this->mChannels) {
+            throw std::runtime_error(
+              "Kompute OpBatchNorm tensor " + std::to_string(i) +
+              " of size " + std::to_string(this->mTensors[i]->size()) +
+              " does not match the number of channels " +
+              std::to_string(this->mChannels));
+        }
+    }
+    if (this->mTensors[5]->size() != this->mTensors[0]->size()) {
+        throw std::runtime_error(
+          "Kompute OpBatchNorm output of size " +
+          std::to_string(this->mTensors[5]->size()) +
+          " does not match the input size " +
+          std::to_string(this->mTensors[0]->size()));
+    }
+
+    vk::PhysicalDeviceLimits limits =
+      this->mPhysicalDevice->getProperties().limits;
+    this->mWorkgroupSize =
+      std::min({ (uint32_t)KP_DEFAULT_BATCH_NORM_WORKGROUP_SIZE,
+                 limits.maxComputeWorkGroupInvocations,
+                 limits.maxComputeWorkGroupSize[0] });
+    this->mWorkgroupSize = std::max<uint32_t>(this->mWorkgroupSize, 1);
+
+    uint32_t numWorkgroups =
+      (this->mTensors[0]->size() + this->mWorkgroupSize - 1) /
+      this->mWorkgroupSize;
+    if (limits.maxComputeWorkGroupCount[0] > 0) {
+        numWorkgroups =
+          std::min(numWorkgroups, limits.maxComputeWorkGroupCount[0]);
+    }
+    this->mKomputeWorkgroup = { std::max<uint32_t>(numWorkgroups, 1), 1, 1 };
+
+    // The bits of the epsilon are passed so the shader reads the same float
+    uint32_t epsilonBits;
+    std::memcpy(&epsilonBits, &this->mEpsilon, sizeof(float));
+    this->mSpecializationConstants = {
+        this->mChannels, this->mChannelSize, epsilonBits, this->mWorkgroupSize
+    };
+
+    OpAlgoBase::init();
+}
+
+void
+OpBatchNorm::record()
+{
+    SPDLOG_DEBUG("Kompute OpBatchNorm record called");
+
+    std::shared_ptr<Tensor> tensorOutput = this->mTensors.back();
+
+    for (size_t i = 0; i + 1 < this->mTensors.size(); i++) {
+        this->mTensors[i]->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eMemoryWrite,
+          vk::AccessFlagBits::eShaderRead,
+          vk::PipelineStageFlagBits::eAllCommands,
+          vk::PipelineStageFlagBits::eComputeShader);
+    }
+    tensorOutput->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eMemoryWrite,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::PipelineStageFlagBits::eAllCommands,
+      vk::PipelineStageFlagBits::eComputeShader);
+
+    this->mAlgorithm->recordDispatch(this->mKomputeWorkgroup.x,
+                                     this->mKomputeWorkgroup.y,
+                                     this->mKomputeWorkgroup.z);
+
+    tensorOutput->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::AccessFlagBits::eMemoryRead,
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eAllCommands);
+}
+
+#if RELEASE
+std::vector<char>
+OpBatchNorm::fetchSpirvBinaryData()
+{
+    SPDLOG_WARN("Kompute OpBatchNorm Running shaders directly from header");
+
+    return std::vector<char>(
+      shader_data::shaders_glsl_opbatchnorm_comp_spv,
+      shader_data::shaders_glsl_opbatchnorm_comp_spv +
+        kp::shader_data::shaders_glsl_opbatchnorm_comp_spv_len);
+}
+#endif
+
+} // End namespace kp
@@ -0,0 +1,178 @@
+#include <sstream>
+
+#if RELEASE
+#include "kompute/shaders/shaderopcompactscatter.hpp"
+#endif
+
+#include "kompute/operations/OpCompact.hpp"
+
+namespace kp {
+
+OpCompact::OpCompact()
+{
+    SPDLOG_DEBUG("Kompute OpCompact constructor base");
+}
+
+OpCompact::OpCompact(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                     std::shared_ptr<vk::Device> device,
+                     std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                     std::vector<std::shared_ptr<Tensor>>& tensors,
+                     const ElementwiseExpr& predicate)
+  : OpScan(physicalDevice,
+           device,
+           commandBuffer,
+           tensors,
+           ScanTypes::eExclusive)
+{
+    SPDLOG_DEBUG("Kompute OpCompact constructor with params");
+
+    this->mPredicate = predicate;
+}
+
+OpCompact::~OpCompact()
+{
+    SPDLOG_DEBUG("Kompute OpCompact destructor started");
+}
+
+void
+OpCompact::init()
+{
+    SPDLOG_DEBUG("Kompute OpCompact init called");
+
+    if (this->mTensors.size() < 3) {
+        throw std::runtime_error(
+          "Kompute OpCompact called with " +
+          std::to_string(this->mTensors.size()) +
+          " tensors but expected the inputs, output and count tensors");
+    }
+    uint32_t numInputs = this->mTensors.size() - 2;
+    if (this->mPredicate.numInputs() > numInputs) {
+        throw std::runtime_error(
+          "Kompute OpCompact predicate reads " +
+          std::to_string(this->mPredicate.numInputs()) +
+          " inputs but was called with " + std::to_string(numInputs));
+    }
+
+    for (std::shared_ptr<Tensor> tensor : this->mTensors) {
+        if (!tensor->isInit()) {
+            throw std::runtime_error(
+              "Kompute OpCompact all tensor parameters must be initialised");
+        }
+    }
+
+    uint32_t size = this->mTensors[0]->size();
+    for (uint32_t i = 0; i <= numInputs; i++) {
+        if (this->mTensors[i]->size() != size || size == 0) {
+            throw std::runtime_error(
+              "Kompute OpCompact inputs and output must have the same size but "
+              "tensor " +
+              std::to_string(i) + " has size " +
+              std::to_string(this->mTensors[i]->size()));
+        }
+    }
+    if (this->mTensors.back()->size() != 1) {
+        throw std::runtime_error(
+          "Kompute OpCompact count tensor must have a single element");
+    }
+
+    // The flags and offsets are uint so the positions are exact for any size
+    this->mFlags = this->createInternalTensor(size);
+    this->mOffsets = this->createInternalTensor(size);
+
+    this->initScan(
+      this->mFlags, this->mOffsets, ScanTypes::eExclusive, false);
+
+    std::vector<std::shared_ptr<Tensor>> flagsTensors(
+      this->mTensors.begin(), this->mTensors.begin() + numInputs);
+    flagsTensors.push_back(this->mFlags);
+    std::string flagsShader = this->generateFlagsShader();
+    this->mFlagsAlgorithm = this->createAlgorithm(
+      std::vector<char>(flagsShader.begin(), flagsShader.end()), flagsTensors);
+
+    this->mScatterAlgorithm =
+      this->createAlgorithm(KP_OPERATION_SHADER_DATA(opcompactscatter),
+                            { this->mTensors[0],
+                              this->mFlags,
+                              this->mOffsets,
+                              this->mTensors[numInputs],
+                              this->mTensors[numInputs + 1] },
+                            { this->mWorkgroupSize });
+}
+
+void
+OpCompact::record()
+{
+    SPDLOG_DEBUG("Kompute OpCompact record called");
+
+    uint32_t numInputs = this->mTensors.size() - 2;
+    uint32_t size = this->mTensors[0]->size();
+
+    for (uint32_t i = 0; i < numInputs; i++) {
+        this->mTensors[i]->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eMemoryWrite,
+          vk::AccessFlagBits::eShaderRead,
+          vk::PipelineStageFlagBits::eAllCommands,
+          vk::PipelineStageFlagBits::eComputeShader);
+    }
+
+    this->mFlagsAlgorithm->recordDispatch(
+      this->dispatchSize(size, this->mWorkgroupSize), 1, 1);
+
+    this->recordScan();
+
+    for (uint32_t i = numInputs; i < this->mTensors.size(); i++) {
+        this->mTensors[i]->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eMemoryWrite,
+          vk::AccessFlagBits::eShaderWrite,
+          vk::PipelineStageFlagBits::eAllCommands,
+          vk::PipelineStageFlagBits::eComputeShader);
+    }
+
+    this->mScatterAlgorithm->recordDispatch(
+      this->dispatchSize(size, this->mWorkgroupSize), 1, 1);
+
+    for (uint32_t i = numInputs; i < this->mTensors.size(); i++) {
+        this->mTensors[i]->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eShaderWrite,
+          vk::AccessFlagBits::eMemoryRead,
+          vk::PipelineStageFlagBits::eComputeShader,
+          vk::PipelineStageFlagBits::eAllCommands);
+    }
+}
+
+std::string
+OpCompact::generateFlagsShader()
+{
+    uint32_t numInputs = this->mTensors.size() - 2;
+
+    std::vector<std::string> inputs;
+    std::stringstream shader;
+    shader << "#version 450\n\n";
+    shader << "layout(local_size_x = " << this->mWorkgroupSize << ") in;\n\n";
+    for (uint32_t i = 0; i < numInputs; i++) {
+        shader << "layout(set = 0, binding = " << i << ") buffer tensor" << i
+               << " { float values" << i << "[]; };\n";
+        inputs.push_back("values" + std::to_string(i) + "[i]");
+    }
+    shader << "layout(set = 0, binding = " << numInputs
+           << ") buffer tensorFlags { uint flags[]; };\n\n";
+    shader << "layout(constant_id = " << numInputs
+           << ") const uint LEN_FLAGS = 0;\n\n";
+    shader << R"(void main()
+{
+    uint stride = gl_NumWorkGroups.x * gl_WorkGroupSize.x;
+    for (uint i = gl_GlobalInvocationID.x; i < LEN_FLAGS; i += stride) {
+)";
+    shader << "        flags[i] = " << this->mPredicate.generate(inputs, "float")
+           << " != 0.0 ? 1u : 0u;\n";
+    shader << R"(    }
+}
+)";
+
+    return shader.str();
+}
+
+} // End namespace kp
@@ -0,0 +1,85 @@
+#include "kompute/operations/OpConv1D.hpp"
+
+namespace kp {
+
+OpConv1D::OpConv1D()
+{
+    SPDLOG_DEBUG("Kompute OpConv1D constructor base");
+}
+
+OpConv1D::OpConv1D(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                   std::shared_ptr<vk::Device> device,
+                   std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                   std::vector<std::shared_ptr<Tensor>>& tensors,
+                   uint32_t stride,
+                   uint32_t padding,
+                   ConvAlgorithms convAlgorithm)
+  : OpConv2D(physicalDevice,
+             device,
+             commandBuffer,
+             tensors,
+             stride,
+             padding,
+             convAlgorithm)
+{
+    SPDLOG_DEBUG("Kompute OpConv1D constructor with params");
+
+    this->mStrideY = 1;
+    this->mPaddingY = 0;
+}
+
+OpConv1D::~OpConv1D()
+{
+    SPDLOG_DEBUG("Kompute OpConv1D destructor started");
+}
+
+void
+OpConv1D::init()
+{
+    SPDLOG_DEBUG("Kompute OpConv1D init called");
+
+    if (this->mTensors.size() < 3 || this->mTensors.size() > 4) {
+        throw std::runtime_error(
+          "Kompute OpConv1D called with " +
+          std::to_string(this->mTensors.size()) +
+          " tensors but expected the input, weights, optional bias and "
+          "output tensors");
+    }
+
+    for (std::shared_ptr<Tensor> tensor : this->mTensors) {
+        if (!tensor->isInit()) {
+            throw std::runtime_error(
+              "Kompute OpConv1D all tensor parameters must be initialised");
+        }
+    }
+
+    std::vector<uint32_t> inputShape = tensorShape(this->mTensors[0]);
+    std::vector<uint32_t> weightsShape = tensorShape(this->mTensors[1]);
+    if (inputShape.size() < 2 || inputShape.size() > 3 ||
+        weightsShape.size() != 3 ||
+        inputShape[inputShape.size() - 2] != weightsShape[1]) {
+        throw std::runtime_error(
+          "Kompute OpConv1D expected an input of shape (N, C, L) or (C, L) "
+          "and weights of shape (K, C, KL) but got " +
+          shapeToString(inputShape) + " and " + shapeToString(weightsShape));
+    }
+
+    bool batched = inputShape.size() == 3;
+    this->mBatches = batched ? inputShape[0] : 1;
+    this->mChannels = weightsShape[1];
+    this->mHeight = 1;
+    this->mWidth = inputShape.back();
+    this->mFilters = weightsShape[0];
+    this->mKernelHeight = 1;
+    this->mKernelWidth = weightsShape[2];
+
+    this->initOutputSize();
+
+    std::vector<uint32_t> outputShape = { this->mFilters, this->mOutputWidth };
+    if (batched) {
+        outputShape.insert(outputShape.begin(), this->mBatches);
+    }
+    this->initConvolution(outputShape);
+}
+
+} // End namespace kp
@@ -0,0 +1,333 @@
+#include <algorithm>
+
+#if RELEASE
+#include "kompute/shaders/shaderopconv2ddirect.hpp"
+#include "kompute/shaders/shaderopconv2dgemm.hpp"
+#include "kompute/shaders/shaderopconv2dim2col.hpp"
+#endif
+
+#include "kompute/operations/OpConv2D.hpp"
+
+namespace kp {
+
+OpConv2D::OpConv2D()
+{
+    SPDLOG_DEBUG("Kompute OpConv2D constructor base");
+}
+
+OpConv2D::OpConv2D(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                   std::shared_ptr<vk::Device> device,
+                   std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                   std::vector<std::shared_ptr<Tensor>>& tensors,
+                   uint32_t stride,
+                   uint32_t padding,
+                   ConvAlgorithms convAlgorithm)
+  : OpAlgoBase(physicalDevice, device, commandBuffer, tensors)
+{
+    SPDLOG_DEBUG("Kompute OpConv2D constructor with params");
+
+    this->mStrideY = stride;
+    this->mStrideX = stride;
+    this->mPaddingY = padding;
+    this->mPaddingX = padding;
+    this->mConvAlgorithm = convAlgorithm;
+}
+
+OpConv2D::~OpConv2D()
+{
+    SPDLOG_DEBUG("Kompute OpConv2D destructor started");
+}
+
+void
+OpConv2D::init()
+{
+    SPDLOG_DEBUG("Kompute OpConv2D init called");
+
+    if (this->mTensors.size() < 3 || this->mTensors.size() > 4) {
+        throw std::runtime_error(
+          "Kompute OpConv2D called with " +
+          std::to_string(this->mTensors.size()) +
+          " tensors but expected the input, weights, optional bias and "
+          "output tensors");
+    }
+
+    for (std::shared_ptr<Tensor> tensor : this->mTensors) {
+        if (!tensor->isInit()) {
+            throw std::runtime_error(
+              "Kompute OpConv2D all tensor parameters must be initialised");
+        }
+    }
+
+    std::vector<uint32_t> inputShape = tensorShape(this->mTensors[0]);
+    std::vector<uint32_t> weightsShape = tensorShape(this->mTensors[1]);
+    if (inputShape.size() < 3 || weightsShape.size() != 4 ||
+        inputShape[inputShape.size() - 3] != weightsShape[1]) {
+        throw std::runtime_error(
+          "Kompute OpConv2D expected an input of shape (N, C, H, W) or (C, H, "
+          "W) and weights of shape (K, C, KH, KW) but got " +
+          shapeToString(inputShape) + " and " + shapeToString(weightsShape));
+    }
+
+    bool batched = inputShape.size() == 4;
+    this->mBatches = batched ? inputShape[0] : 1;
+    this->mChannels = weightsShape[1];
+    this->mHeight = inputShape[inputShape.size() - 2];
+    this->mWidth = inputShape[inputShape.size() - 1];
+    this->mFilters = weightsShape[0];
+    this->mKernelHeight = weightsShape[2];
+    this->mKernelWidth = weightsShape[3];
+
+    this->initOutputSize();
+
+    std::vector<uint32_t> outputShape = {
+        this->mFilters, this->mOutputHeight, this->mOutputWidth
+    };
+    if (batched) {
+        outputShape.insert(outputShape.begin(), this->mBatches);
+    }
+    this->initConvolution(outputShape);
+}
+
+void
+OpConv2D::record()
+{
+    SPDLOG_DEBUG("Kompute OpConv2D record called");
+
+    std::shared_ptr<Tensor> tensorOutput = this->mTensors.back();
+
+    for (size_t i = 0; i + 1 < this->mTensors.size(); i++) {
+        this->mTensors[i]->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eMemoryWrite,
+          vk::AccessFlagBits::eShaderRead,
+          vk::PipelineStageFlagBits::eAllCommands,
+          vk::PipelineStageFlagBits::eComputeShader);
+    }
+    tensorOutput->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eMemoryWrite,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::PipelineStageFlagBits::eAllCommands,
+      vk::PipelineStageFlagBits::eComputeShader);
+    if (this->mColumns) {
+        // Orders the reads of a previous evaluation of the sequence before
+        // the columns are written again
+        this->mColumns->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eShaderRead,
+          vk::AccessFlagBits::eShaderWrite,
+          vk::PipelineStageFlagBits::eComputeShader,
+          vk::PipelineStageFlagBits::eComputeShader);
+    }
+
+    for (size_t i = 0; i < this->mAlgorithms.size(); i++) {
+        this->mAlgorithms[i]->recordDispatch(this->mWorkgroups[i].x,
+                                             this->mWorkgroups[i].y,
+                                             this->mWorkgroups[i].z);
+
+        if (i + 1 < this->mAlgorithms.size()) {
+            this->mColumns->recordBufferMemoryBarrier(
+              this->mCommandBuffer,
+              vk::AccessFlagBits::eShaderWrite,
+              vk::AccessFlagBits::eShaderRead,
+              vk::PipelineStageFlagBits::eComputeShader,
+              vk::PipelineStageFlagBits::eComputeShader);
+        }
+    }
+
+    tensorOutput->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::AccessFlagBits::eMemoryRead,
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eAllCommands);
+}
+
+void
+OpConv2D::initOutputSize()
+{
+    uint32_t paddedHeight = this->mHeight + 2 * this->mPaddingY;
+    uint32_t paddedWidth = this->mWidth + 2 * this->mPaddingX;
+    if (this->mStrideY == 0 || this->mStrideX == 0 ||
+        this->mKernelHeight > paddedHeight ||
+        this->mKernelWidth > paddedWidth) {
+        throw std::runtime_error(
+          "Kompute OpConv2D kernel of size " +
+          std::to_string(this->mKernelHeight) + "x" +
+          std::to_string(this->mKernelWidth) +
+          " does not fit in the padded input of size " +
+          std::to_string(paddedHeight) + "x" + std::to_string(paddedWidth) +
+          " or the stride is zero");
+    }
+
+    this->mOutputHeight =
+      (paddedHeight - this->mKernelHeight) / this->mStrideY + 1;
+    this->mOutputWidth = (paddedWidth - this->mKernelWidth) / this->mStrideX + 1;
+}
+
+void
+OpConv2D::initConvolution(const std::vector<uint32_t>& outputShape)
+{
+    std::shared_ptr<Tensor> tensorOutput = this->mTensors.back();
+    std::vector<uint32_t> tensorOutputShape = tensorShape(tensorOutput);
+
+    uint32_t outputSize = this->mBatches * this->mFilters *
+                          this->mOutputHeight * this->mOutputWidth;
+    // Outputs with a single dimension only need to match the output size
+    if (tensorOutput->size() != outputSize ||
+        (tensorOutputShape.size() > 1 && tensorOutputShape != outputShape)) {
+        throw std::runtime_error(
+          "Kompute OpConv2D output of shape " +
+          shapeToString(tensorOutputShape) +
+          " does not match the shape of the convolution " +
+          shapeToString(outputShape));
+    }
+    if (this->mTensors.size() == 4 &&
+        this->mTensors[2]->size() != this->mFilters) {
+        throw std::runtime_error(
+          "Kompute OpConv2D bias of size " +
+          std::to_string(this->mTensors[2]->size()) +
+          " does not match the number of filters " +
+          std::to_string(this->mFilters));
+    }
+
+    this->initTileSize();
+
+    // The direct convolution keeps the input patch of a tile of the output
+    // for a channel in shared memory
+    uint32_t patchSize =
+      ((this->mTileY - 1) * this->mStrideY + this->mKernelHeight) *
+      ((this->mTileX - 1) * this->mStrideX + this->mKernelWidth);
+    bool patchFits = patchSize * sizeof(float) <=
+                     this->mPhysicalDevice->getProperties()
+                       .limits.maxComputeSharedMemorySize;
+
+    bool direct = this->mConvAlgorithm == ConvAlgorithms::eDirect;
+    if (this->mConvAlgorithm == ConvAlgorithms::eAuto) {
+        direct = patchFits && this->mKernelHeight * this->mKernelWidth <=
+                                KP_CONV_DIRECT_MAX_KERNEL_SIZE;
+    }
+    if (direct && !patchFits) {
+        throw std::runtime_error(
+          "Kompute OpConv2D direct convolution needs " +
+          std::to_string(patchSize) +
+          " floats of shared memory which exceeds the device limits");
+    }
+
+    this->mAlgorithms.clear();
+    this->mWorkgroups.clear();
+    this->mColumns = nullptr;
+
+    // The shaders bind the bias in every case, so a placeholder is bound
+    // when the convolution has no bias
+    bool hasBias = this->mTensors.size() == 4;
+    std::shared_ptr<Tensor> bias =
+      hasBias ? this->mTensors[2] : this->createInternalTensor(1);
+    std::vector<uint32_t> dimensions = this->dimensionConstants();
+
+    uint32_t outputTilesX =
+      (this->mOutputWidth + this->mTileX - 1) / this->mTileX;
+    uint32_t outputTilesY =
+      (this->mOutputHeight + this->mTileY - 1) / this->mTileY;
+
+    if (direct) {
+        std::vector<uint32_t> constants = dimensions;
+        constants.insert(constants.end(),
+                         { this->mTileX, this->mTileY, hasBias ? 1u : 0u });
+        this->mAlgorithms.push_back(this->createAlgorithm(
+          KP_OPERATION_SHADER_DATA(opconv2ddirect),
+          { this->mTensors[0], this->mTensors[1], bias, this->mTensors.back() },
+          constants));
+        this->mWorkgroups.push_back(this->tiledWorkgroup(
+          outputTilesX, outputTilesY, this->mBatches * this->mFilters));
+    } else {
+        // Each column holds the input patch of an output position, so the
+        // convolution is the product of the weights and the columns
+        uint32_t rows =
+          this->mChannels * this->mKernelHeight * this->mKernelWidth;
+        uint32_t columns =
+          this->mBatches * this->mOutputHeight * this->mOutputWidth;
+        this->mColumns = this->createInternalTensor(rows * columns);
+
+        uint32_t workgroupSize = this->mTileSize * this->mTileSize;
+        std::vector<uint32_t> im2colConstants = dimensions;
+        im2colConstants.push_back(workgroupSize);
+        this->mAlgorithms.push_back(
+          this->createAlgorithm(KP_OPERATION_SHADER_DATA(opconv2dim2col),
+                                { this->mTensors[0], this->mColumns },
+                                im2colConstants));
+        this->mWorkgroups.push_back(this->tiledWorkgroup(
+          (rows * columns + workgroupSize - 1) / workgroupSize, 1, 1));
+
+        std::vector<uint32_t> gemmConstants = dimensions;
+        gemmConstants.insert(
+          gemmConstants.end(),
+          { this->mTileSize, this->mTileSize, hasBias ? 1u : 0u });
+        this->mAlgorithms.push_back(this->createAlgorithm(
+          KP_OPERATION_SHADER_DATA(opconv2dgemm),
+          { this->mTensors[1], this->mColumns, bias, this->mTensors.back() },
+          gemmConstants));
+        this->mWorkgroups.push_back(this->tiledWorkgroup(
+          (columns + this->mTileSize - 1) / this->mTileSize,
+          (this->mFilters + this->mTileSize - 1) / this->mTileSize,
+          1));
+    }
+
+    SPDLOG_DEBUG("Kompute OpConv2D using {} convolution with tiles of {}x{}",
+                 direct ? "direct" : "im2col",
+                 this->mTileX,
+                 this->mTileY);
+}
+
+void
+OpConv2D::initTileSize()
+{
+    vk::PhysicalDeviceLimits limits =
+      this->mPhysicalDevice->getProperties().limits;
+
+    // Square power of two tiles bounded by the workgroup limits of the device
+    this->mTileSize = KP_DEFAULT_CONV_TILE_SIZE;
+    while (this->mTileSize > 1 &&
+           (this->mTileSize * this->mTileSize >
+              limits.maxComputeWorkGroupInvocations ||
+            this->mTileSize > limits.maxComputeWorkGroupSize[0] ||
+            this->mTileSize > limits.maxComputeWorkGroupSize[1])) {
+        this->mTileSize /= 2;
+    }
+    this->mTileX = this->mTileSize;
+    this->mTileY = this->mTileSize;
+
+    // Outputs shorter than the tile, such as the ones of the 1-D convolution,
+    // use wider tiles with the same number of invocations
+    while (this->mTileY > 1 && this->mTileY / 2 >= this->mOutputHeight &&
+           this->mTileX * 2 <= limits.maxComputeWorkGroupSize[0]) {
+        this->mTileY /= 2;
+        this->mTileX *= 2;
+    }
+}
+
+OpAlgoBase::KomputeWorkgroup
+OpConv2D::tiledWorkgroup(uint32_t tilesX, uint32_t tilesY, uint32_t tilesZ)
+{
+    // The shaders stride over the tiles beyond the dispatch limits
+    vk::PhysicalDeviceLimits limits =
+      this->mPhysicalDevice->getProperties().limits;
+    return { std::max<uint32_t>(
+               std::min(tilesX, limits.maxComputeWorkGroupCount[0]), 1),
+             std::max<uint32_t>(
+               std::min(tilesY, limits.maxComputeWorkGroupCount[1]), 1),
+             std::max<uint32_t>(
+               std::min(tilesZ, limits.maxComputeWorkGroupCount[2]), 1) };
+}
+
+std::vector<uint32_t>
+OpConv2D::dimensionConstants()
+{
+    return { this->mBatches,     this->mChannels,     this->mHeight,
+             this->mWidth,       this->mFilters,      this->mKernelHeight,
+             this->mKernelWidth, this->mStrideY,      this->mStrideX,
+             this->mPaddingY,    this->mPaddingX,     this->mOutputHeight,
+             this->mOutputWidth };
+}
+
+} // End namespace kp
@@ -0,0 +1,690 @@
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#if RELEASE
+#include "kompute/shaders/shaderopelementwisebinary.hpp"
+#include "kompute/shaders/shaderopelementwiseunary.hpp"
+#endif
+
+#include "kompute/operations/OpElementwise.hpp"
+
+namespace kp {
+
+ElementwiseExpr
+ElementwiseExpr::make(NodeTypes nodeType,
+                      const std::string& op,
+                      std::vector<ElementwiseExpr> args)
+{
+    std::shared_ptr<Node> node = std::make_shared<Node>();
+    node->nodeType = nodeType;
+    node->op = op;
+    for (const ElementwiseExpr& arg : args) {
+        if (!arg.mNode) {
+            throw std::runtime_error(
+              "Kompute ElementwiseExpr operand is an empty expression");
+        }
+        node->args.push_back(arg.mNode);
+    }
+
+    ElementwiseExpr expression;
+    expression.mNode = node;
+    return expression;
+}
+
+ElementwiseExpr
+ElementwiseExpr::input(uint32_t index)
+{
+    ElementwiseExpr expression = make(NodeTypes::eInput, "", {});
+    std::const_pointer_cast<Node>(expression.mNode)->inputIndex = index;
+    return expression;
+}
+
+ElementwiseExpr
+ElementwiseExpr::constant(float value)
+{
+    ElementwiseExpr expression = make(NodeTypes::eConstant, "", {});
+    std::const_pointer_cast<Node>(expression.mNode)->value = value;
+    return expression;
+}
+
+ElementwiseExpr
+ElementwiseExpr::relu(const ElementwiseExpr& x)
+{
+    return make(NodeTypes::eFunction, "relu", { x });
+}
+
+ElementwiseExpr
+ElementwiseExpr::sigmoid(const ElementwiseExpr& x)
+{
+    return make(NodeTypes::eFunction, "sigmoid", { x });
+}
+
+ElementwiseExpr
+ElementwiseExpr::exp(const ElementwiseExpr& x)
+{
+    return make(NodeTypes::eFunction, "exp", { x });
+}
+
+ElementwiseExpr
+ElementwiseExpr::log(const ElementwiseExpr& x)
+{
+    return make(NodeTypes::eFunction, "log", { x });
+}
+
+ElementwiseExpr
+ElementwiseExpr::tanh(const ElementwiseExpr& x)
+{
+    return make(NodeTypes::eFunction, "tanh", { x });
+}
+
+ElementwiseExpr
+ElementwiseExpr::abs(const ElementwiseExpr& x)
+{
+    return make(NodeTypes::eFunction, "abs", { x });
+}
+
+ElementwiseExpr
+ElementwiseExpr::sqrt(const ElementwiseExpr& x)
+{
+    return make(NodeTypes::eFunction, "sqrt", { x });
+}
+
+ElementwiseExpr
+ElementwiseExpr::max(const ElementwiseExpr& lhs, const ElementwiseExpr& rhs)
+{
+    return make(NodeTypes::eFunction, "max", { lhs, rhs });
+}
+
+ElementwiseExpr
+ElementwiseExpr::min(const ElementwiseExpr& lhs, const ElementwiseExpr& rhs)
+{
+    return make(NodeTypes::eFunction, "min", { lhs, rhs });
+}
+
+ElementwiseExpr
+ElementwiseExpr::greater(const ElementwiseExpr& lhs, const ElementwiseExpr& rhs)
+{
+    return make(NodeTypes::eComparison, ">", { lhs, rhs });
+}
+
+ElementwiseExpr
+ElementwiseExpr::less(const ElementwiseExpr& lhs, const ElementwiseExpr& rhs)
+{
+    return make(NodeTypes::eComparison, "<", { lhs, rhs });
+}
+
+ElementwiseExpr
+ElementwiseExpr::equal(const ElementwiseExpr& lhs, const ElementwiseExpr& rhs)
+{
+    return make(NodeTypes::eComparison, "==", { lhs, rhs });
+}
+
+ElementwiseExpr
+ElementwiseExpr::operator-() const
+{
+    return make(NodeTypes::eUnary, "-", { *this });
+}
+
+ElementwiseExpr
+ElementwiseExpr::operator+(const ElementwiseExpr& rhs) const
+{
+    return make(NodeTypes::eBinary, "+", { *this, rhs });
+}
+
+ElementwiseExpr
+ElementwiseExpr::operator-(const ElementwiseExpr& rhs) const
+{
+    return make(NodeTypes::eBinary, "-", { *this, rhs });
+}
+
+ElementwiseExpr
+ElementwiseExpr::operator*(const ElementwiseExpr& rhs) const
+{
+    return make(NodeTypes::eBinary, "*", { *this, rhs });
+}
+
+ElementwiseExpr
+ElementwiseExpr::operator/(const ElementwiseExpr& rhs) const
+{
+    return make(NodeTypes::eBinary, "/", { *this, rhs });
+}
+
+ElementwiseExpr
+ElementwiseExpr::operator+(float rhs) const
+{
+    return *this + ElementwiseExpr::constant(rhs);
+}
+
+ElementwiseExpr
+ElementwiseExpr::operator-(float rhs) const
+{
+    return *this - ElementwiseExpr::constant(rhs);
+}
+
+ElementwiseExpr
+ElementwiseExpr::operator*(float rhs) const
+{
+    return *this * ElementwiseExpr::constant(rhs);
+}
+
+ElementwiseExpr
+ElementwiseExpr::operator/(float rhs) const
+{
+    return *this / ElementwiseExpr::constant(rhs);
+}
+
+ElementwiseExpr
+operator+(float lhs, const ElementwiseExpr& rhs)
+{
+    return ElementwiseExpr::constant(lhs) + rhs;
+}
+
+ElementwiseExpr
+operator-(float lhs, const ElementwiseExpr& rhs)
+{
+    return ElementwiseExpr::constant(lhs) - rhs;
+}
+
+ElementwiseExpr
+operator*(float lhs, const ElementwiseExpr& rhs)
+{
+    return ElementwiseExpr::constant(lhs) * rhs;
+}
+
+ElementwiseExpr
+operator/(float lhs, const ElementwiseExpr& rhs)
+{
+    return ElementwiseExpr::constant(lhs) / rhs;
+}
+
+std::string
+ElementwiseExpr::generate(const std::vector<std::string>& inputs,
+                          const std::string& type) const
+{
+    if (!this->mNode) {
+        throw std::runtime_error(
+          "Kompute ElementwiseExpr cannot generate an empty expression");
+    }
+    return generateNode(this->mNode, inputs, type);
+}
+
+uint32_t
+ElementwiseExpr::numInputs() const
+{
+    if (!this->mNode) {
+        return 0;
+    }
+    return numInputsNode(this->mNode);
+}
+
+std::string
+ElementwiseExpr::generateNode(const std::shared_ptr<const Node>& node,
+                              const std::vector<std::string>& inputs,
+                              const std::string& type)
+{
+    std::vector<std::string> args;
+    for (const std::shared_ptr<const Node>& arg : node->args) {
+        args.push_back(generateNode(arg, inputs, type));
+    }
+
+    switch (node->nodeType) {
+        case NodeTypes::eInput:
+            if (node->inputIndex >= inputs.size()) {
+                throw std::runtime_error(
+                  "Kompute ElementwiseExpr input index out of range: " +
+                  std::to_string(node->inputIndex));
+            }
+            return inputs[node->inputIndex];
+        case NodeTypes::eConstant: {
+            // Constants are generated from their bits so they are exact
+            uint32_t bits = 0;
+            memcpy(&bits, &node->value, sizeof(float));
+            return type + "(uintBitsToFloat(" + std::to_string(bits) + "u))";
+        }
+        case NodeTypes::eUnary:
+            return "(" + node->op + args[0] + ")";
+        case NodeTypes::eBinary:
+            return "(" + args[0] + " " + node->op + " " + args[1] + ")";
+        case NodeTypes::eComparison:
+            // Vector comparisons return boolean vectors in GLSL
+            if (type == "vec4") {
+                std::string function = node->op == ">"   ? "greaterThan"
+                                       : node->op == "<" ? "lessThan"
+                                                         : "equal";
+                return "vec4(" + function + "(" + args[0] + ", " + args[1] +
+                       "))";
+            }
+            return "float(" + args[0] + " " + node->op + " " + args[1] + ")";
+        case NodeTypes::eFunction:
+            if (node->op == "relu") {
+                return "max(" + args[0] + ", " + type + "(0))";
+            }
+            if (node->op == "sigmoid") {
+                return "(" + type + "(1) / (" + type + "(1) + exp(-" +
+                       args[0] + ")))";
+            }
+            if (args.size() == 2) {
+                return node->op + "(" + args[0] + ", " + args[1] + ")";
+            }
+            return node->op + "(" + args[0] + ")";
+    }
+    return "";
+}
+
+uint32_t
+ElementwiseExpr::numInputsNode(const std::shared_ptr<const Node>& node)
+{
+    uint32_t numInputs =
+      node->nodeType == NodeTypes::eInput ? node->inputIndex + 1 : 0;
+    for (const std::shared_ptr<const Node>& arg : node->args) {
+        numInputs = std::max(numInputs, numInputsNode(arg));
+    }
+    return numInputs;
+}
+
+OpElementwise::OpElementwise()
+{
+    SPDLOG_DEBUG("Kompute OpElementwise constructor base");
+}
+
+OpElementwise::OpElementwise(
+  std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+  std::shared_ptr<vk::Device> device,
+  std::shared_ptr<vk::CommandBuffer> commandBuffer,
+  std::vector<std::shared_ptr<Tensor>>& tensors,
+  const ElementwiseExpr& expression)
+  : OpAlgoBase(physicalDevice, device, commandBuffer, tensors)
+{
+    SPDLOG_DEBUG("Kompute OpElementwise constructor with params");
+
+    this->mExpression = expression;
+}
+
+OpElementwise::~OpElementwise()
+{
+    SPDLOG_DEBUG("Kompute OpElementwise destructor started");
+}
+
+void
+OpElementwise::init()
+{
+    SPDLOG_DEBUG("Kompute OpElementwise init called");
+
+    if (this->mTensors.size() < this->mExpression.numInputs() + 1) {
+        throw std::runtime_error(
+          "Kompute OpElementwise expression reads " +
+          std::to_string(this->mExpression.numInputs()) +
+          " inputs but was called with " +
+          std::to_string(this->mTensors.size()) + " tensors");
+    }
+
+    std::shared_ptr<Tensor> tensorOutput = this->mTensors.back();
+    std::vector<uint32_t> outputShape = tensorShape(tensorOutput);
+
+    // The inputs are broadcast following the NumPy rules, where dimensions
+    // are aligned from the innermost one and dimensions of size one are
+    // repeated
+    this->mShape = this->mTensors.size() > 1 ? std::vector<uint32_t>()
+                                             : outputShape;
+    for (size_t i = 0; i + 1 < this->mTensors.size(); i++) {
+        std::vector<uint32_t> inputShape = tensorShape(this->mTensors[i]);
+        if (inputShape.size() > this->mShape.size()) {
+            this->mShape.insert(this->mShape.begin(),
+                                inputShape.size() - this->mShape.size(),
+                                1);
+        }
+        uint32_t offset = this->mShape.size() - inputShape.size();
+        for (size_t j = 0; j < inputShape.size(); j++) {
+            uint32_t& dimension = this->mShape[offset + j];
+            if (dimension == 1) {
+                dimension = inputShape[j];
+            } else if (inputShape[j] != 1 && inputShape[j] != dimension) {
+                throw std::runtime_error(
+                  "Kompute OpElementwise input " + std::to_string(i) +
+                  " of shape " + shapeToString(inputShape) +
+                  " cannot be broadcast to shape " +
+                  shapeToString(this->mShape));
+            }
+        }
+    }
+
+    uint32_t broadcastSize = 1;
+    for (uint32_t dimension : this->mShape) {
+        broadcastSize *= dimension;
+    }
+    // Outputs with a single dimension only need to match the broadcast size
+    if (broadcastSize != tensorOutput->size() ||
+        (outputShape.size() > 1 && outputShape != this->mShape)) {
+        throw std::runtime_error(
+          "Kompute OpElementwise output of shape " +
+          shapeToString(outputShape) +
+          " does not match the broadcast shape of the inputs " +
+          shapeToString(this->mShape));
+    }
+
+    vk::PhysicalDeviceLimits limits =
+      this->mPhysicalDevice->getProperties().limits;
+    this->mWorkgroupSize =
+      std::min({ (uint32_t)KP_DEFAULT_ELEMENTWISE_WORKGROUP_SIZE,
+                 limits.maxComputeWorkGroupInvocations,
+                 limits.maxComputeWorkGroupSize[0] });
+    this->mWorkgroupSize = std::max<uint32_t>(this->mWorkgroupSize, 1);
+
+    // Each invocation processes a vec4, and the shader strides over the
+    // tensor when it needs more workgroups than can be dispatched
+    uint32_t numVec4 = (tensorOutput->size() + 3) / 4;
+    uint32_t numWorkgroups =
+      (numVec4 + this->mWorkgroupSize - 1) / this->mWorkgroupSize;
+    if (limits.maxComputeWorkGroupCount[0] > 0) {
+        numWorkgroups =
+          std::min(numWorkgroups, limits.maxComputeWorkGroupCount[0]);
+    }
+    this->mKomputeWorkgroup = { std::max<uint32_t>(numWorkgroups, 1), 1, 1 };
+
+    if (this->mOperationType == OperationTypes::eExpression) {
+        std::string shader = this->generateShader();
+        SPDLOG_DEBUG("Kompute OpElementwise generated shader: {}", shader);
+        this->mShaderDataRaw = std::vector<char>(shader.begin(), shader.end());
+    } else {
+        this->setOperationShader();
+    }
+
+    OpAlgoBase::init();
+}
+
+void
+OpElementwise::record()
+{
+    SPDLOG_DEBUG("Kompute OpElementwise record called");
+
+    std::shared_ptr<Tensor> tensorOutput = this->mTensors.back();
+
+    // Barriers for the writes of previous operations, including previous
+    // element wise operations recorded in the same sequence
+    for (size_t i = 0; i + 1 < this->mTensors.size(); i++) {
+        this->mTensors[i]->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eMemoryWrite,
+          vk::AccessFlagBits::eShaderRead,
+          vk::PipelineStageFlagBits::eAllCommands,
+          vk::PipelineStageFlagBits::eComputeShader);
+    }
+    tensorOutput->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eMemoryWrite,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::PipelineStageFlagBits::eAllCommands,
+      vk::PipelineStageFlagBits::eComputeShader);
+
+    this->mAlgorithm->recordDispatch(this->mKomputeWorkgroup.x,
+                                     this->mKomputeWorkgroup.y,
+                                     this->mKomputeWorkgroup.z);
+
+    tensorOutput->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::AccessFlagBits::eMemoryRead,
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eAllCommands);
+}
+
+std::string
+OpElementwise::generateShader()
+{
+    uint32_t outputIndex = this->mTensors.size() - 1;
+    std::string output = std::to_string(outputIndex);
+
+    std::stringstream shader;
+    shader << "#version 450\n\n";
+    shader << "layout(local_size_x = " << this->mWorkgroupSize << ") in;\n\n";
+    for (uint32_t i = 0; i < this->mTensors.size(); i++) {
+        // The scalar view aliases the same binding to address the elements
+        // of the last vec4 that are within the tensor
+        shader << "layout(set = 0, binding = " << i << ") buffer tensor" << i
+               << " { vec4 values" << i << "[]; };\n";
+        shader << "layout(set = 0, binding = " << i << ") buffer scalarTensor"
+               << i << " { float scalars" << i << "[]; };\n";
+    }
+    shader << "\nlayout(constant_id = " << outputIndex
+           << ") const uint LEN_OUT = 0;\n\n";
+    // The index of the element of each broadcast input is computed from the
+    // index of the output element with the strides generated into the shader
+    for (uint32_t i = 0; i + 1 < this->mTensors.size(); i++) {
+        if (this->isBroadcast(i)) {
+            shader << "uint index" << i << "(uint e)\n{\n";
+            shader << "    return " << this->generateBroadcastIndex(i)
+                   << ";\n}\n\n";
+        }
+    }
+    shader << "void main()\n{\n";
+    shader << "    uint numVec4 = (LEN_OUT + 3) / 4;\n";
+    shader << "    uint stride = gl_NumWorkGroups.x * gl_WorkGroupSize.x;\n";
+    shader << "    for (uint i = gl_GlobalInvocationID.x; i < numVec4; i += "
+              "stride) {\n";
+    shader << "        if (i * 4 + 4 <= LEN_OUT) {\n";
+    shader << "            values" << output << "[i] = "
+           << this->mExpression.generate(this->generateInputs("i", ""), "vec4")
+           << ";\n";
+    shader << "        } else {\n";
+    shader << "            for (uint c = 0; i * 4 + c < LEN_OUT; c++) {\n";
+    shader << "                scalars" << output << "[i * 4 + c] = "
+           << this->mExpression.generate(this->generateInputs("i", "c"),
+                                         "float")
+           << ";\n";
+    shader << "            }\n";
+    shader << "        }\n";
+    shader << "    }\n";
+    shader << "}\n";
+
+    return shader.str();
+}
+
+std::vector<std::string>
+OpElementwise::generateInputs(const std::string& vecIndex,
+                              const std::string& component)
+{
+    std::vector<std::string> inputs;
+    for (uint32_t i = 0; i + 1 < this->mTensors.size(); i++) {
+        std::string values = "values" + std::to_string(i);
+        std::string scalars = "scalars" + std::to_string(i);
+        std::string index = "index" + std::to_string(i);
+
+        if (!this->isBroadcast(i)) {
+            if (component.empty()) {
+                inputs.push_back(values + "[" + vecIndex + "]");
+            } else {
+                inputs.push_back(scalars + "[" + vecIndex + " * 4 + " +
+                                 component + "]");
+            }
+        } else if (this->mTensors[i]->size() == 1) {
+            inputs.push_back(component.empty() ? "vec4(" + scalars + "[0])"
+                                               : scalars + "[0]");
+        } else if (!component.empty()) {
+            inputs.push_back(scalars + "[" + index + "(" + vecIndex +
+                             " * 4 + " + component + ")]");
+        } else if (this->isBroadcastVectorizable(i)) {
+            inputs.push_back(values + "[" + index + "(" + vecIndex +
+                             " * 4) / 4]");
+        } else {
+            std::string input = "vec4(";
+            for (uint32_t c = 0; c < 4; c++) {
+                input += (c ? ", " : "") + scalars + "[" + index + "(" +
+                         vecIndex + " * 4 + " + std::to_string(c) + ")]";
+            }
+            inputs.push_back(input + ")");
+        }
+    }
+    return inputs;
+}
+
+bool
+OpElementwise::isBroadcast(uint32_t tensorIndex)
+{
+    return this->mTensors[tensorIndex]->size() !=
+           this->mTensors.back()->size();
+}
+
+bool
+OpElementwise::isBroadcastVectorizable(uint32_t tensorIndex)
+{
+    // The four elements of a vec4 of the output are read from a vec4 of the
+    // input when the innermost dimensions that are not broadcast span a
+    // multiple of four elements
+    std::vector<uint32_t> inputShape = this->broadcastShape(tensorIndex);
+    uint32_t extent = 1;
+    for (size_t d = this->mShape.size(); d > 0; d--) {
+        if (inputShape[d - 1] != this->mShape[d - 1]) {
+            break;
+        }
+        extent *= this->mShape[d - 1];
+    }
+    return extent % 4 == 0;
+}
+
+std::string
+OpElementwise::generateBroadcastIndex(uint32_t tensorIndex)
+{
+    std::vector<uint32_t> inputShape = this->broadcastShape(tensorIndex);
+    uint32_t rank = this->mShape.size();
+
+    std::vector<uint32_t> outputStrides(rank, 1);
+    std::vector<uint32_t> inputStrides(rank, 1);
+    for (uint32_t d = rank; d > 1; d--) {
+        outputStrides[d - 2] = outputStrides[d - 1] * this->mShape[d - 1];
+        inputStrides[d - 2] = inputStrides[d - 1] * inputShape[d - 1];
+    }
+
+    // Consecutive dimensions which are not broadcast are indexed with a
+    // single division and modulo
+    std::string index;
+    uint32_t outerSize = 1;
+    uint32_t d = 0;
+    while (d < rank) {
+        if (inputShape[d] != this->mShape[d]) {
+            outerSize *= this->mShape[d];
+            d++;
+            continue;
+        }
+        uint32_t extent = 1;
+        while (d < rank && inputShape[d] == this->mShape[d]) {
+            extent *= this->mShape[d];
+            d++;
+        }
+        if (extent == 1) {
+            continue;
+        }
+
+        std::string term = "e";
+        if (outputStrides[d - 1] != 1) {
+            term = "(e / " + std::to_string(outputStrides[d - 1]) + "u)";
+        }
+        if (outerSize > 1) {
+            term = "(" + term + " % " + std::to_string(extent) + "u)";
+        }
+        if (inputStrides[d - 1] != 1) {
+            term += " * " + std::to_string(inputStrides[d - 1]) + "u";
+        }
+        index += (index.empty() ? "" : " + ") + term;
+        outerSize *= extent;
+    }
+    return index.empty() ? "0u" : index;
+}
+
+void
+OpElementwise::setOperationShader()
+{
+    bool isBinary = this->mOperationType == OperationTypes::eAdd ||
+                    this->mOperationType == OperationTypes::eSub ||
+                    this->mOperationType == OperationTypes::eDiv;
+    uint32_t numInputs = isBinary ? 2 : 1;
+    if (this->mTensors.size() != numInputs + 1) {
+        throw std::runtime_error(
+          "Kompute OpElementwise operation expects " +
+          std::to_string(numInputs + 1) + " tensors but was called with " +
+          std::to_string(this->mTensors.size()) + " tensors");
+    }
+
+    uint32_t operation = 0;
+    switch (this->mOperationType) {
+        case OperationTypes::eSub:
+        case OperationTypes::eSigmoid:
+            operation = 1;
+            break;
+        case OperationTypes::eDiv:
+        case OperationTypes::eExp:
+            operation = 2;
+            break;
+        case OperationTypes::eTanh:
+            operation = 3;
+            break;
+        case OperationTypes::eScale:
+            operation = 4;
+            break;
+        case OperationTypes::eAddScalar:
+            operation = 5;
+            break;
+        default:
+            break;
+    }
+
+    // The shape is padded to the dimensions of the shaders, where the
+    // outermost dimensions of size one do not change the indices
+    uint32_t rank = this->mShape.size();
+    std::vector<uint32_t> shape(KP_MAX_DIM_SIZE - rank, 1);
+    shape.insert(shape.end(), this->mShape.begin(), this->mShape.end());
+    std::vector<uint32_t> strides(KP_MAX_DIM_SIZE, 1);
+    for (uint32_t d = KP_MAX_DIM_SIZE - 1; d > 0; d--) {
+        strides[d - 1] = strides[d] * shape[d];
+    }
+
+    if (isBinary) {
+        this->mSpecializationConstants = { operation, this->mWorkgroupSize };
+    } else {
+        uint32_t scalarBits;
+        std::memcpy(&scalarBits, &this->mScalar, sizeof(float));
+        this->mSpecializationConstants = { operation,
+                                           scalarBits,
+                                           this->mWorkgroupSize };
+    }
+    this->mSpecializationConstants.insert(
+      this->mSpecializationConstants.end(), shape.begin(), shape.end());
+    this->mSpecializationConstants.insert(
+      this->mSpecializationConstants.end(), strides.begin(), strides.end());
+
+    // The strides of the broadcast dimensions of each input are zero, so the
+    // shaders repeat their elements
+    for (uint32_t i = 0; i < numInputs; i++) {
+        std::vector<uint32_t> inputShape = this->broadcastShape(i);
+        inputShape.insert(inputShape.begin(), KP_MAX_DIM_SIZE - rank, 1);
+        uint32_t inputStride = 1;
+        std::vector<uint32_t> inputStrides(KP_MAX_DIM_SIZE, 0);
+        for (uint32_t d = KP_MAX_DIM_SIZE; d > 0; d--) {
+            if (inputShape[d - 1] == shape[d - 1]) {
+                inputStrides[d - 1] = inputStride;
+            }
+            inputStride *= inputShape[d - 1];
+        }
+        this->mSpecializationConstants.insert(
+          this->mSpecializationConstants.end(),
+          inputStrides.begin(),
+          inputStrides.end());
+        this->mSpecializationConstants.push_back(
+          this->isBroadcastVectorizable(i) ? 1 : 0);
+    }
+
+    this->mShaderDataRaw = isBinary
+                             ? KP_OPERATION_SHADER_DATA(opelementwisebinary)
+                             : KP_OPERATION_SHADER_DATA(opelementwiseunary);
+}
+
+std::vector<uint32_t>
+OpElementwise::broadcastShape(uint32_t tensorIndex)
+{
+    std::vector<uint32_t> inputShape = tensorShape(this->mTensors[tensorIndex]);
+    inputShape.insert(
+      inputShape.begin(), this->mShape.size() - inputShape.size(), 1);
+    return inputShape;
+}
+
+} // End namespace kp
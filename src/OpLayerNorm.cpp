@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cstring>
+
+#if RELEASE
+#include "kompute/shaders/shaderoplayernorm.hpp"
+#endif
+
+#include "kompute/operations/OpLayerNorm.hpp"
+
+namespace kp {
+
+OpLayerNorm::OpLayerNorm()
+{
+    SPDLOG_DEBUG("Kompute OpLayerNorm constructor base");
+}
+
+OpLayerNorm::OpLayerNorm(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                         std::shared_ptr<vk::Device> device,
+                         std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                         std::vector<std::shared_ptr<Tensor>>& tensors,
+                         NormTypes normType,
+                         float epsilon)
+  : OpAlgoBase(physicalDevice, device, commandBuffer, tensors, "")
+{
+    SPDLOG_DEBUG("Kompute OpLayerNorm constructor with params");
+
+    this->mNormType = normType;
+    this->mEpsilon = epsilon;
+
+#ifndef RELEASE
+    this->mShaderFilePath = "shaders/glsl/oplayernorm.comp";
+#endif
+}
+
+OpLayerNorm::~OpLayerNorm()
+{
+    SPDLOG_DEBUG("Kompute OpLayerNorm destructor started");
+}
+
+void
+OpLayerNorm::init()
+{
+    SPDLOG_DEBUG("Kompute OpLayerNorm init called");
+
+    if (this->mTensors.size() < 3 || this->mTensors.size() > 4) {
+        throw std::runtime_error(
+          "Kompute OpLayerNorm called with " +
+          std::to_string(this->mTensors.size()) +
+          " tensors but expected the input, scale, optional shift and output "
+          "tensors");
+    }
+
+    for (std::shared_ptr<Tensor> tensor : this->mTensors) {
+        if (!tensor->isInit()) {
+            throw std::runtime_error(
+              "Kompute OpLayerNorm all tensor parameters must be initialised");
+        }
+    }
+
+    std::shared_ptr<Tensor> tensorInput = this->mTensors.front();
+    std::shared_ptr<Tensor> tensorOutput = this->mTensors.back();
+    uint32_t rowSize = tensorShape(tensorInput).back();
+    for (size_t i = 1; i + 1 < this->mTensors.size(); i++) {
+        if (this->mTensors[i]->size() != rowSize) {
+            throw std::runtime_error(
+              "Kompute OpLayerNorm tensor " + std::to_string(i) +
+              " of size " + std::to_string(this->mTensors[i]->size()) +
+              " does not match the size of the rows " +
+              std::to_string(rowSize));
+        }
+    }
+    if (tensorOutput->size() != tensorInput->size()) {
+        throw std::runtime_error(
+          "Kompute OpLayerNorm output of size " +
+          std::to_string(tensorOutput->size()) +
+          " does not match the input size " +
+          std::to_string(tensorInput->size()));
+    }
+
+    // The shader always binds a shift, so the scale is bound in its place
+    // when there is none and the shift is disabled by specialisation
+    bool hasShift = this->mTensors.size() == 4;
+    std::vector<std::shared_ptr<Tensor>> bindings = this->mTensors;
+    if (!hasShift) {
+        bindings.insert(bindings.begin() + 2, this->mTensors[1]);
+    }
+
+    uint32_t epsilonBits;
+    std::memcpy(&epsilonBits, &this->mEpsilon, sizeof(float));
+    uint32_t workgroupSize = this->powerOfTwoWorkgroupSize(std::min<uint32_t>(
+      KP_DEFAULT_LAYER_NORM_WORKGROUP_SIZE, rowSize * 2 - 1));
+    this->mSpecializationConstants = {
+        this->mNormType == NormTypes::eRmsNorm ? 1u : 0u,
+        hasShift ? 1u : 0u,
+        epsilonBits,
+        workgroupSize
+    };
+
+    uint32_t numRows = tensorInput->size() / rowSize;
+    uint32_t maxWorkgroupCount =
+      this->mPhysicalDevice->getProperties().limits.maxComputeWorkGroupCount[0];
+    this->mKomputeWorkgroup = { std::min(numRows, maxWorkgroupCount), 1, 1 };
+
+    this->mAlgorithm = this->createAlgorithm(
+      this->fetchSpirvBinaryData(), bindings, this->mSpecializationConstants);
+}
+
+void
+OpLayerNorm::record()
+{
+    SPDLOG_DEBUG("Kompute OpLayerNorm record called");
+
+    std::shared_ptr<Tensor> tensorOutput = this->mTensors.back();
+
+    for (size_t i = 0; i + 1 < this->mTensors.size(); i++) {
+        this->mTensors[i]->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eMemoryWrite,
+          vk::AccessFlagBits::eShaderRead,
+          vk::PipelineStageFlagBits::eAllCommands,
+          vk::PipelineStageFlagBits::eComputeShader);
+    }
+    tensorOutput->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eMemoryWrite,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::PipelineStageFlagBits::eAllCommands,
+      vk::PipelineStageFlagBits::eComputeShader);
+
+    this->mAlgorithm->recordDispatch(this->mKomputeWorkgroup.x,
+                                     this->mKomputeWorkgroup.y,
+                                     this->mKomputeWorkgroup.z);
+
+    tensorOutput->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::AccessFlagBits::eMemoryRead,
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eAllCommands);
+}
+
+#if RELEASE
+std::vector<char>
+OpLayerNorm::fetchSpirvBinaryData()
+{
+    SPDLOG_WARN("Kompute OpLayerNorm Running shaders directly from header");
+
+    return std::vector<char>(
+      shader_data::shaders_glsl_oplayernorm_comp_spv,
+      shader_data::shaders_glsl_oplayernorm_comp_spv +
+        kp::shader_data::shaders_glsl_oplayernorm_comp_spv_len);
+}
+#endif
+
+} // End namespace kp
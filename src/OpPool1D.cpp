@@ -0,0 +1,63 @@
+#include "kompute/operations/OpPool1D.hpp"
+
+namespace kp {
+
+OpPool1D::OpPool1D()
+{
+    SPDLOG_DEBUG("Kompute OpPool1D constructor base");
+}
+
+OpPool1D::OpPool1D(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                   std::shared_ptr<vk::Device> device,
+                   std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                   std::vector<std::shared_ptr<Tensor>>& tensors,
+                   PoolTypes poolType,
+                   uint32_t kernelSize,
+                   uint32_t stride)
+  : OpPool2D(physicalDevice,
+             device,
+             commandBuffer,
+             tensors,
+             poolType,
+             kernelSize,
+             stride)
+{
+    SPDLOG_DEBUG("Kompute OpPool1D constructor with params");
+
+    this->mKernelHeight = 1;
+    this->mStrideY = 1;
+}
+
+OpPool1D::~OpPool1D()
+{
+    SPDLOG_DEBUG("Kompute OpPool1D destructor started");
+}
+
+void
+OpPool1D::init()
+{
+    SPDLOG_DEBUG("Kompute OpPool1D init called");
+
+    if (this->mTensors.size() != 2) {
+        throw std::runtime_error(
+          "Kompute OpPool1D called with " +
+          std::to_string(this->mTensors.size()) +
+          " tensors but expected the input and output tensors");
+    }
+
+    std::vector<uint32_t> inputShape = tensorShape(this->mTensors[0]);
+    if (inputShape.size() < 2 || inputShape.size() > 3) {
+        throw std::runtime_error(
+          "Kompute OpPool1D expected an input of shape (N, C, L) or (C, L) "
+          "but got " +
+          shapeToString(inputShape));
+    }
+
+    this->mHeight = 1;
+    this->mWidth = inputShape.back();
+
+    this->initPooling(
+      std::vector<uint32_t>(inputShape.begin(), inputShape.end() - 1), 1);
+}
+
+} // End namespace kp
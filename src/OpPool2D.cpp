@@ -0,0 +1,182 @@
+#include <algorithm>
+
+#if RELEASE
+#include "kompute/shaders/shaderoppool2d.hpp"
+#endif
+
+#include "kompute/operations/OpPool2D.hpp"
+
+namespace kp {
+
+OpPool2D::OpPool2D()
+{
+    SPDLOG_DEBUG("Kompute OpPool2D constructor base");
+}
+
+OpPool2D::OpPool2D(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                   std::shared_ptr<vk::Device> device,
+                   std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                   std::vector<std::shared_ptr<Tensor>>& tensors,
+                   PoolTypes poolType,
+                   uint32_t kernelSize,
+                   uint32_t stride)
+  : OpAlgoBase(physicalDevice, device, commandBuffer, tensors)
+{
+    SPDLOG_DEBUG("Kompute OpPool2D constructor with params");
+
+    this->mPoolType = poolType;
+    this->mKernelHeight = kernelSize;
+    this->mKernelWidth = kernelSize;
+    this->mStrideY = stride ? stride : kernelSize;
+    this->mStrideX = stride ? stride : kernelSize;
+
+#ifndef RELEASE
+    this->mShaderFilePath = "shaders/glsl/oppool2d.comp";
+#endif
+}
+
+OpPool2D::~OpPool2D()
+{
+    SPDLOG_DEBUG("Kompute OpPool2D destructor started");
+}
+
+void
+OpPool2D::init()
+{
+    SPDLOG_DEBUG("Kompute OpPool2D init called");
+
+    if (this->mTensors.size() != 2) {
+        throw std::runtime_error(
+          "Kompute OpPool2D called with " +
+          std::to_string(this->mTensors.size()) +
+          " tensors but expected the input and output tensors");
+    }
+
+    std::vector<uint32_t> inputShape = tensorShape(this->mTensors[0]);
+    if (inputShape.size() < 3) {
+        throw std::runtime_error(
+          "Kompute OpPool2D expected an input of shape (N, C, H, W) or (C, "
+          "H, W) but got " +
+          shapeToString(inputShape));
+    }
+
+    this->mHeight = inputShape[inputShape.size() - 2];
+    this->mWidth = inputShape[inputShape.size() - 1];
+
+    this->initPooling(
+      std::vector<uint32_t>(inputShape.begin(), inputShape.end() - 2), 2);
+}
+
+void
+OpPool2D::record()
+{
+    SPDLOG_DEBUG("Kompute OpPool2D record called");
+
+    this->mTensors[0]->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eMemoryWrite,
+      vk::AccessFlagBits::eShaderRead,
+      vk::PipelineStageFlagBits::eAllCommands,
+      vk::PipelineStageFlagBits::eComputeShader);
+    this->mTensors[1]->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eMemoryWrite,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::PipelineStageFlagBits::eAllCommands,
+      vk::PipelineStageFlagBits::eComputeShader);
+
+    this->mAlgorithm->recordDispatch(this->mKomputeWorkgroup.x,
+                                     this->mKomputeWorkgroup.y,
+                                     this->mKomputeWorkgroup.z);
+
+    this->mTensors[1]->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::AccessFlagBits::eMemoryRead,
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eAllCommands);
+}
+
+void
+OpPool2D::initPooling(std::vector<uint32_t> outputShape,
+                      uint32_t spatialDimensions)
+{
+    if (this->mKernelHeight == 0 || this->mKernelWidth == 0 ||
+        this->mKernelHeight > this->mHeight ||
+        this->mKernelWidth > this->mWidth) {
+        throw std::runtime_error(
+          "Kompute OpPool2D kernel of size " +
+          std::to_string(this->mKernelHeight) + "x" +
+          std::to_string(this->mKernelWidth) +
+          " is empty or does not fit in the input of size " +
+          std::to_string(this->mHeight) + "x" + std::to_string(this->mWidth));
+    }
+
+    this->mPlanes = 1;
+    for (uint32_t dimension : outputShape) {
+        this->mPlanes *= dimension;
+    }
+    this->mOutputHeight =
+      (this->mHeight - this->mKernelHeight) / this->mStrideY + 1;
+    this->mOutputWidth = (this->mWidth - this->mKernelWidth) / this->mStrideX + 1;
+    if (spatialDimensions == 2) {
+        outputShape.push_back(this->mOutputHeight);
+    }
+    outputShape.push_back(this->mOutputWidth);
+
+    std::shared_ptr<Tensor> tensorOutput = this->mTensors[1];
+    std::vector<uint32_t> tensorOutputShape = tensorShape(tensorOutput);
+    uint32_t outputSize =
+      this->mPlanes * this->mOutputHeight * this->mOutputWidth;
+    // Outputs with a single dimension only need to match the output size
+    if (tensorOutput->size() != outputSize ||
+        (tensorOutputShape.size() > 1 && tensorOutputShape != outputShape)) {
+        throw std::runtime_error(
+          "Kompute OpPool2D output of shape " +
+          shapeToString(tensorOutputShape) +
+          " does not match the shape of the pooling " +
+          shapeToString(outputShape));
+    }
+
+    vk::PhysicalDeviceLimits limits =
+      this->mPhysicalDevice->getProperties().limits;
+    this->mWorkgroupSize =
+      std::min({ (uint32_t)KP_DEFAULT_POOL_WORKGROUP_SIZE,
+                 limits.maxComputeWorkGroupInvocations,
+                 limits.maxComputeWorkGroupSize[0] });
+    this->mWorkgroupSize = std::max<uint32_t>(this->mWorkgroupSize, 1);
+
+    // Each invocation computes an output, and the shader strides over the
+    // outputs when they need more workgroups than can be dispatched
+    uint32_t numWorkgroups =
+      (outputSize + this->mWorkgroupSize - 1) / this->mWorkgroupSize;
+    if (limits.maxComputeWorkGroupCount[0] > 0) {
+        numWorkgroups =
+          std::min(numWorkgroups, limits.maxComputeWorkGroupCount[0]);
+    }
+    this->mKomputeWorkgroup = { std::max<uint32_t>(numWorkgroups, 1), 1, 1 };
+
+    this->mSpecializationConstants = {
+        this->mHeight,       this->mWidth,        this->mKernelHeight,
+        this->mKernelWidth,  this->mStrideY,      this->mStrideX,
+        this->mOutputHeight, this->mOutputWidth,  this->mWorkgroupSize,
+        this->mPoolType == PoolTypes::eAverage ? 1u : 0u
+    };
+
+    OpAlgoBase::init();
+}
+
+#if RELEASE
+std::vector<char>
+OpPool2D::fetchSpirvBinaryData()
+{
+    SPDLOG_WARN("Kompute OpPool2D Running shaders directly from header");
+
+    return std::vector<char>(
+      shader_data::shaders_glsl_oppool2d_comp_spv,
+      shader_data::shaders_glsl_oppool2d_comp_spv +
+        kp::shader_data::shaders_glsl_oppool2d_comp_spv_len);
+}
+#endif
+
+} // End namespace kp
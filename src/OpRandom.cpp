@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cstring>
+
+#if RELEASE
+#include "kompute/shaders/shaderoprandom.hpp"
+#endif
+
+#include "kompute/operations/OpRandom.hpp"
+
+namespace kp {
+
+OpRandom::OpRandom()
+{
+    SPDLOG_DEBUG("Kompute OpRandom constructor base");
+}
+
+OpRandom::OpRandom(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                   std::shared_ptr<vk::Device> device,
+                   std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                   std::vector<std::shared_ptr<Tensor>>& tensors,
+                   RandomDistributions distribution,
+                   uint64_t seed,
+                   uint64_t offset,
+                   float first,
+                   float second)
+  : OpAlgoBase(physicalDevice, device, commandBuffer, tensors)
+{
+    SPDLOG_DEBUG("Kompute OpRandom constructor with params seed: {}, "
+                 "offset: {}",
+                 seed,
+                 offset);
+
+    this->mDistribution = distribution;
+    this->mSeed = seed;
+    this->mOffset = offset;
+    this->mFirst = first;
+    this->mSecond = second;
+}
+
+OpRandom::~OpRandom()
+{
+    SPDLOG_DEBUG("Kompute OpRandom destructor started");
+}
+
+void
+OpRandom::init()
+{
+    SPDLOG_DEBUG("Kompute OpRandom init called");
+
+    if (this->mTensors.size() < 1) {
+        throw std::runtime_error(
+          "Kompute OpRandom called with less than 1 tensor");
+    }
+    for (std::shared_ptr<Tensor> tensor : this->mTensors) {
+        if (!tensor->isInit()) {
+            throw std::runtime_error(
+              "Kompute OpRandom all tensor parameters must be initialised");
+        }
+    }
+    if (this->mDistribution == RandomDistributions::eNormal &&
+        !(this->mSecond >= 0)) {
+        throw std::runtime_error(
+          "Kompute OpRandom normal distribution standard deviation must not "
+          "be negative, got " +
+          std::to_string(this->mSecond));
+    }
+    if (this->mDistribution == RandomDistributions::eBernoulli &&
+        !(this->mFirst >= 0 && this->mFirst <= 1)) {
+        throw std::runtime_error(
+          "Kompute OpRandom Bernoulli distribution probability must be "
+          "between 0 and 1, got " +
+          std::to_string(this->mFirst));
+    }
+
+    this->mWorkgroupSize =
+      this->powerOfTwoWorkgroupSize(KP_DEFAULT_RANDOM_WORKGROUP_SIZE);
+    uint32_t maxWorkgroupCount =
+      this->mPhysicalDevice->getProperties().limits.maxComputeWorkGroupCount[0];
+
+    uint32_t firstBits;
+    uint32_t secondBits;
+    std::memcpy(&firstBits, &this->mFirst, sizeof(float));
+    std::memcpy(&secondBits, &this->mSecond, sizeof(float));
+
+    std::vector<char> shader = KP_OPERATION_SHADER_DATA(oprandom);
+
+    this->mAlgorithms.clear();
+    this->mNumWorkgroups.clear();
+
+    // Each tensor starts at its position in the stream, which is split into
+    // the counter that generates it and the position within the counter
+    uint64_t position = this->mOffset;
+    for (std::shared_ptr<Tensor> tensor : this->mTensors) {
+        uint64_t counter = position / KP_RANDOM_VALUES_PER_COUNTER;
+        uint32_t lead = position % KP_RANDOM_VALUES_PER_COUNTER;
+
+        this->mAlgorithms.push_back(
+          this->createAlgorithm(shader,
+                                { tensor },
+                                { (uint32_t)this->mSeed,
+                                  (uint32_t)(this->mSeed >> 32),
+                                  (uint32_t)counter,
+                                  (uint32_t)(counter >> 32),
+                                  lead,
+                                  (uint32_t)this->mDistribution,
+                                  firstBits,
+                                  secondBits,
+                                  this->mWorkgroupSize }));
+
+        uint64_t numCounters =
+          (lead + (uint64_t)tensor->size() + KP_RANDOM_VALUES_PER_COUNTER - 1) /
+          KP_RANDOM_VALUES_PER_COUNTER;
+        uint64_t numWorkgroups =
+          (numCounters + this->mWorkgroupSize - 1) / this->mWorkgroupSize;
+        this->mNumWorkgroups.push_back(std::max<uint32_t>(
+          std::min<uint64_t>(numWorkgroups, maxWorkgroupCount), 1));
+
+        position += tensor->size();
+    }
+}
+
+void
+OpRandom::record()
+{
+    SPDLOG_DEBUG("Kompute OpRandom record called");
+
+    for (size_t i = 0; i < this->mTensors.size(); i++) {
+        this->mTensors[i]->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eMemoryWrite,
+          vk::AccessFlagBits::eShaderWrite,
+          vk::PipelineStageFlagBits::eAllCommands,
+          vk::PipelineStageFlagBits::eComputeShader);
+
+        this->mAlgorithms[i]->recordDispatch(this->mNumWorkgroups[i], 1, 1);
+
+        this->mTensors[i]->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eShaderWrite,
+          vk::AccessFlagBits::eMemoryRead,
+          vk::PipelineStageFlagBits::eComputeShader,
+          vk::PipelineStageFlagBits::eAllCommands);
+    }
+}
+
+} // End namespace kp
@@ -0,0 +1,231 @@
+#include <algorithm>
+
+#if RELEASE
+#include "kompute/shaders/shaderopscan.hpp"
+#include "kompute/shaders/shaderopscanadd.hpp"
+#include "kompute/shaders/shaderopscansubgroup.hpp"
+#endif
+
+#include "kompute/DevicePolicy.hpp"
+
+#include "kompute/operations/OpScan.hpp"
+
+namespace kp {
+
+OpScan::OpScan()
+{
+    SPDLOG_DEBUG("Kompute OpScan constructor base");
+}
+
+OpScan::OpScan(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+               std::shared_ptr<vk::Device> device,
+               std::shared_ptr<vk::CommandBuffer> commandBuffer,
+               std::vector<std::shared_ptr<Tensor>>& tensors,
+               ScanTypes scanType)
+  : OpAlgoBase(physicalDevice, device, commandBuffer, tensors)
+{
+    SPDLOG_DEBUG("Kompute OpScan constructor with params");
+
+    this->mScanType = scanType;
+}
+
+OpScan::~OpScan()
+{
+    SPDLOG_DEBUG("Kompute OpScan destructor started");
+}
+
+void
+OpScan::init()
+{
+    SPDLOG_DEBUG("Kompute OpScan init called");
+
+    if (this->mTensors.size() != 2) {
+        throw std::runtime_error(
+          "Kompute OpScan called with " +
+          std::to_string(this->mTensors.size()) +
+          " tensors but expected the input and output tensors");
+    }
+
+    std::shared_ptr<Tensor> tensorInput = this->mTensors[0];
+    std::shared_ptr<Tensor> tensorOutput = this->mTensors[1];
+
+    if (!(tensorInput->isInit() && tensorOutput->isInit())) {
+        throw std::runtime_error(
+          "Kompute OpScan all tensor parameters must be initialised");
+    }
+    if (tensorInput->size() == 0 ||
+        tensorInput->size() != tensorOutput->size()) {
+        throw std::runtime_error(
+          "Kompute OpScan input and output must have the same size. Input: " +
+          std::to_string(tensorInput->size()) +
+          " Output: " + std::to_string(tensorOutput->size()));
+    }
+
+    this->initScan(tensorInput, tensorOutput, this->mScanType, true);
+}
+
+void
+OpScan::record()
+{
+    SPDLOG_DEBUG("Kompute OpScan record called");
+
+    this->recordScan();
+}
+
+void
+OpScan::initScan(std::shared_ptr<Tensor> input,
+                 std::shared_ptr<Tensor> output,
+                 ScanTypes scanType,
+                 bool isFloat)
+{
+    this->initDeviceLimits();
+
+    this->mScanInputs.clear();
+    this->mScanOutputs.clear();
+    this->mScanSums.clear();
+    this->mScanAlgorithms.clear();
+    this->mAddAlgorithms.clear();
+
+    uint32_t blockSize = this->mWorkgroupSize * KP_SCAN_ITEMS_PER_INVOCATION;
+
+    std::vector<char> scanShader = this->mUseSubgroups
+                                     ? KP_OPERATION_SHADER_DATA(opscansubgroup)
+                                     : KP_OPERATION_SHADER_DATA(opscan);
+
+    // Each level scans the block sums of the level below in place, until the
+    // block sums fit in a single block
+    while (true) {
+        bool exclusive =
+          this->mScanInputs.empty() && scanType == ScanTypes::eExclusive;
+        uint32_t numBlocks = (input->size() + blockSize - 1) / blockSize;
+        std::shared_ptr<Tensor> sums = this->createInternalTensor(numBlocks);
+
+        this->mScanAlgorithms.push_back(
+          this->createAlgorithm(scanShader,
+                                { input, output, sums },
+                                { this->mWorkgroupSize,
+                                  KP_SCAN_ITEMS_PER_INVOCATION,
+                                  exclusive ? 1u : 0u,
+                                  isFloat ? 1u : 0u }));
+
+        this->mScanInputs.push_back(input);
+        this->mScanOutputs.push_back(output);
+        this->mScanSums.push_back(sums);
+
+        if (numBlocks == 1) {
+            break;
+        }
+        input = sums;
+        output = sums;
+    }
+
+    std::vector<char> addShader = KP_OPERATION_SHADER_DATA(opscanadd);
+    for (size_t i = 0; i + 1 < this->mScanSums.size(); i++) {
+        this->mAddAlgorithms.push_back(this->createAlgorithm(
+          addShader,
+          { this->mScanOutputs[i], this->mScanSums[i] },
+          { this->mWorkgroupSize,
+            KP_SCAN_ITEMS_PER_INVOCATION,
+            isFloat ? 1u : 0u }));
+    }
+
+    SPDLOG_DEBUG("Kompute OpScan created {} levels with workgroup size {} "
+                 "and subgroups {}",
+                 this->mScanSums.size(),
+                 this->mWorkgroupSize,
+                 this->mUseSubgroups);
+}
+
+void
+OpScan::recordScan()
+{
+    for (size_t i = 0; i < this->mScanAlgorithms.size(); i++) {
+        this->mScanInputs[i]->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eMemoryWrite,
+          vk::AccessFlagBits::eShaderRead,
+          vk::PipelineStageFlagBits::eAllCommands,
+          vk::PipelineStageFlagBits::eComputeShader);
+
+        this->mScanAlgorithms[i]->recordDispatch(
+          this->dispatchSize(this->mScanSums[i]->size(), 1), 1, 1);
+
+        this->mScanOutputs[i]->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eShaderWrite,
+          vk::AccessFlagBits::eShaderRead,
+          vk::PipelineStageFlagBits::eComputeShader,
+          vk::PipelineStageFlagBits::eComputeShader);
+        this->mScanSums[i]->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eShaderWrite,
+          vk::AccessFlagBits::eShaderRead,
+          vk::PipelineStageFlagBits::eComputeShader,
+          vk::PipelineStageFlagBits::eComputeShader);
+    }
+
+    // The scanned block sums are added back from the top level down, where
+    // the first block of each level does not need an offset
+    for (size_t i = this->mAddAlgorithms.size(); i > 0; i--) {
+        this->mAddAlgorithms[i - 1]->recordDispatch(
+          this->dispatchSize(this->mScanSums[i - 1]->size() - 1, 1), 1, 1);
+
+        this->mScanOutputs[i - 1]->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eShaderWrite,
+          vk::AccessFlagBits::eShaderRead,
+          vk::PipelineStageFlagBits::eComputeShader,
+          vk::PipelineStageFlagBits::eComputeShader);
+    }
+
+    this->mScanOutputs[0]->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::AccessFlagBits::eMemoryRead,
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eAllCommands);
+
+    SPDLOG_DEBUG("Kompute OpScan recorded {} levels of blocks of size {}",
+                 this->mScanAlgorithms.size(),
+                 this->mWorkgroupSize * KP_SCAN_ITEMS_PER_INVOCATION);
+}
+
+uint32_t
+OpScan::dispatchSize(uint32_t count, uint32_t perWorkgroup)
+{
+    uint32_t numWorkgroups = (count + perWorkgroup - 1) / perWorkgroup;
+    if (this->mMaxWorkgroupCount > 0) {
+        numWorkgroups = std::min(numWorkgroups, this->mMaxWorkgroupCount);
+    }
+    return std::max<uint32_t>(numWorkgroups, 1);
+}
+
+void
+OpScan::initDeviceLimits()
+{
+    DeviceInfo deviceInfo =
+      DeviceInfo::fromPhysicalDevice(*this->mPhysicalDevice, 0);
+
+    // The workgroup size is a power of two so the subgroups evenly divide it
+    uint32_t maxWorkgroupSize =
+      std::min({ (uint32_t)KP_DEFAULT_SCAN_WORKGROUP_SIZE,
+                 deviceInfo.maxComputeWorkGroupInvocations,
+                 deviceInfo.maxComputeWorkGroupSize[0] });
+    this->mWorkgroupSize = 1;
+    while (this->mWorkgroupSize * 2 <= maxWorkgroupSize) {
+        this->mWorkgroupSize *= 2;
+    }
+
+    this->mMaxWorkgroupCount =
+      this->mPhysicalDevice->getProperties().limits.maxComputeWorkGroupCount[0];
+
+    // The sums of the subgroups are scanned by the first subgroup, so there
+    // cannot be more subgroups than invocations in a subgroup
+    uint32_t subgroupSize = deviceInfo.subgroupSize;
+    this->mUseSubgroups = deviceInfo.hasSubgroupArithmetic &&
+                          subgroupSize > 0 &&
+                          this->mWorkgroupSize % subgroupSize == 0 &&
+                          subgroupSize * subgroupSize >= this->mWorkgroupSize;
+}
+
+} // End namespace kp
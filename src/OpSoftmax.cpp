@@ -0,0 +1,111 @@
+#include <algorithm>
+
+#if RELEASE
+#include "kompute/shaders/shaderopsoftmax.hpp"
+#endif
+
+#include "kompute/operations/OpSoftmax.hpp"
+
+namespace kp {
+
+OpSoftmax::OpSoftmax()
+{
+    SPDLOG_DEBUG("Kompute OpSoftmax constructor base");
+}
+
+OpSoftmax::OpSoftmax(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                     std::shared_ptr<vk::Device> device,
+                     std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                     std::vector<std::shared_ptr<Tensor>>& tensors)
+  : OpAlgoBase(physicalDevice, device, commandBuffer, tensors, "")
+{
+    SPDLOG_DEBUG("Kompute OpSoftmax constructor with params");
+
+#ifndef RELEASE
+    this->mShaderFilePath = "shaders/glsl/opsoftmax.comp";
+#endif
+}
+
+OpSoftmax::~OpSoftmax()
+{
+    SPDLOG_DEBUG("Kompute OpSoftmax destructor started");
+}
+
+void
+OpSoftmax::init()
+{
+    SPDLOG_DEBUG("Kompute OpSoftmax init called");
+
+    if (this->mTensors.size() != 2) {
+        throw std::runtime_error(
+          "Kompute OpSoftmax called with " +
+          std::to_string(this->mTensors.size()) +
+          " tensors but expected the input and output tensors");
+    }
+    if (this->mTensors[0]->size() != this->mTensors[1]->size()) {
+        throw std::runtime_error(
+          "Kompute OpSoftmax output of size " +
+          std::to_string(this->mTensors[1]->size()) +
+          " does not match the input size " +
+          std::to_string(this->mTensors[0]->size()));
+    }
+
+    uint32_t rowSize = tensorShape(this->mTensors[0]).back();
+    uint32_t numRows = this->mTensors[0]->size() / rowSize;
+
+    // Rows shorter than the workgroup use smaller workgroups
+    uint32_t workgroupSize = this->powerOfTwoWorkgroupSize(
+      std::min<uint32_t>(KP_DEFAULT_SOFTMAX_WORKGROUP_SIZE, rowSize * 2 - 1));
+    this->mSpecializationConstants = { rowSize, workgroupSize };
+
+    uint32_t maxWorkgroupCount =
+      this->mPhysicalDevice->getProperties().limits.maxComputeWorkGroupCount[0];
+    this->mKomputeWorkgroup = { std::min(numRows, maxWorkgroupCount), 1, 1 };
+
+    OpAlgoBase::init();
+}
+
+void
+OpSoftmax::record()
+{
+    SPDLOG_DEBUG("Kompute OpSoftmax record called");
+
+    this->mTensors[0]->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eMemoryWrite,
+      vk::AccessFlagBits::eShaderRead,
+      vk::PipelineStageFlagBits::eAllCommands,
+      vk::PipelineStageFlagBits::eComputeShader);
+    this->mTensors[1]->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eMemoryWrite,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::PipelineStageFlagBits::eAllCommands,
+      vk::PipelineStageFlagBits::eComputeShader);
+
+    this->mAlgorithm->recordDispatch(this->mKomputeWorkgroup.x,
+                                     this->mKomputeWorkgroup.y,
+                                     this->mKomputeWorkgroup.z);
+
+    this->mTensors[1]->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::AccessFlagBits::eMemoryRead,
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eAllCommands);
+}
+
+#if RELEASE
+std::vector<char>
+OpSoftmax::fetchSpirvBinaryData()
+{
+    SPDLOG_WARN("Kompute OpSoftmax Running shaders directly from header");
+
+    return std::vector<char>(
+      shader_data::shaders_glsl_opsoftmax_comp_spv,
+      shader_data::shaders_glsl_opsoftmax_comp_spv +
+        kp::shader_data::shaders_glsl_opsoftmax_comp_spv_len);
+}
+#endif
+
+} // End namespace kp
@@ -0,0 +1,259 @@
+#if RELEASE
+#include "kompute/shaders/shaderopsorthistogram.hpp"
+#include "kompute/shaders/shaderopsortload.hpp"
+#include "kompute/shaders/shaderopsortscatter.hpp"
+#include "kompute/shaders/shaderopsortstore.hpp"
+#endif
+
+#include "kompute/operations/OpSort.hpp"
+
+namespace kp {
+
+OpSort::OpSort()
+{
+    SPDLOG_DEBUG("Kompute OpSort constructor base");
+}
+
+OpSort::OpSort(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+               std::shared_ptr<vk::Device> device,
+               std::shared_ptr<vk::CommandBuffer> commandBuffer,
+               std::vector<std::shared_ptr<Tensor>>& tensors,
+               KeyTypes keyType,
+               SortOrders sortOrder)
+  : OpScan(physicalDevice,
+           device,
+           commandBuffer,
+           tensors,
+           ScanTypes::eExclusive)
+{
+    SPDLOG_DEBUG("Kompute OpSort constructor with params");
+
+    this->mKeyType = keyType;
+    this->mSortOrder = sortOrder;
+}
+
+OpSort::~OpSort()
+{
+    SPDLOG_DEBUG("Kompute OpSort destructor started");
+}
+
+void
+OpSort::init()
+{
+    SPDLOG_DEBUG("Kompute OpSort init called");
+
+    if (this->mTensors.size() < 1 || this->mTensors.size() > 2) {
+        throw std::runtime_error(
+          "Kompute OpSort called with " +
+          std::to_string(this->mTensors.size()) +
+          " tensors but expected the keys and optionally the values tensors");
+    }
+
+    for (std::shared_ptr<Tensor> tensor : this->mTensors) {
+        if (!tensor->isInit()) {
+            throw std::runtime_error(
+              "Kompute OpSort all tensor parameters must be initialised");
+        }
+    }
+
+    std::shared_ptr<Tensor> tensorKeys = this->mTensors[0];
+    std::shared_ptr<Tensor> tensorValues =
+      this->mTensors.size() > 1 ? this->mTensors[1] : nullptr;
+
+    if (tensorKeys->size() == 0 ||
+        (tensorValues && tensorValues->size() != tensorKeys->size())) {
+        throw std::runtime_error(
+          "Kompute OpSort keys and values must have the same size. Keys: " +
+          std::to_string(tensorKeys->size()) + " Values: " +
+          std::to_string(tensorValues ? tensorValues->size() : 0));
+    }
+
+    this->initSort(tensorKeys, tensorValues, tensorKeys, tensorValues);
+}
+
+void
+OpSort::record()
+{
+    SPDLOG_DEBUG("Kompute OpSort record called");
+
+    this->recordSort();
+}
+
+void
+OpSort::initSort(std::shared_ptr<Tensor> keys,
+                 std::shared_ptr<Tensor> values,
+                 std::shared_ptr<Tensor> outputKeys,
+                 std::shared_ptr<Tensor> outputValues)
+{
+    bool hasValues = outputValues != nullptr;
+    bool indexValues = hasValues && !values;
+    uint32_t size = keys->size();
+
+    this->initDeviceLimits();
+
+    uint32_t blockSize = this->mWorkgroupSize * KP_SCAN_ITEMS_PER_INVOCATION;
+    uint32_t numBlocks = (size + blockSize - 1) / blockSize;
+
+    // The histogram is laid out digit major, so its exclusive scan is the
+    // position of the keys of each digit of each block
+    this->mHistogram =
+      this->createInternalTensor((1 << KP_SORT_RADIX_BITS) * numBlocks);
+    this->initScan(
+      this->mHistogram, this->mHistogram, ScanTypes::eExclusive, false);
+
+    this->mSortInputs = { keys };
+    this->mSortOutputs = { outputKeys };
+    this->mSortKeys = { this->createInternalTensor(size),
+                        this->createInternalTensor(size) };
+    this->mSortValues.clear();
+    if (values) {
+        this->mSortInputs.push_back(values);
+    }
+    if (hasValues) {
+        this->mSortOutputs.push_back(outputValues);
+        this->mSortValues = { this->createInternalTensor(size),
+                              this->createInternalTensor(size) };
+    }
+
+    // The shaders bind the values in every case, so a placeholder is bound
+    // to the values that are not used
+    this->mSortPlaceholder = this->createInternalTensor(1);
+    std::shared_ptr<Tensor> sortValues[2] = { this->mSortPlaceholder,
+                                              this->mSortPlaceholder };
+    if (hasValues) {
+        sortValues[0] = this->mSortValues[0];
+        sortValues[1] = this->mSortValues[1];
+    }
+
+    uint32_t floatKeys = this->mKeyType == KeyTypes::eFloat ? 1 : 0;
+    uint32_t descending = this->mSortOrder == SortOrders::eDescending ? 1 : 0;
+    uint32_t valuesMode = !hasValues ? 0 : (indexValues ? 2 : 1);
+
+    this->mLoadAlgorithm = this->createAlgorithm(
+      KP_OPERATION_SHADER_DATA(opsortload),
+      { keys,
+        values ? values : this->mSortPlaceholder,
+        this->mSortKeys[0],
+        sortValues[0] },
+      { this->mWorkgroupSize, floatKeys, descending, valuesMode });
+
+    // The passes alternate between the two intermediate tensors, ending in
+    // the first one as the number of passes is even
+    std::vector<char> histogramShader =
+      KP_OPERATION_SHADER_DATA(opsorthistogram);
+    std::vector<char> scatterShader = KP_OPERATION_SHADER_DATA(opsortscatter);
+    this->mHistogramAlgorithms.clear();
+    this->mScatterAlgorithms.clear();
+    for (uint32_t shift = 0; shift < 32; shift += KP_SORT_RADIX_BITS) {
+        uint32_t source = (shift / KP_SORT_RADIX_BITS) % 2;
+        uint32_t destination = 1 - source;
+
+        this->mHistogramAlgorithms.push_back(
+          this->createAlgorithm(histogramShader,
+                                { this->mSortKeys[source], this->mHistogram },
+                                { this->mWorkgroupSize,
+                                  KP_SCAN_ITEMS_PER_INVOCATION,
+                                  KP_SORT_RADIX_BITS,
+                                  shift }));
+
+        this->mScatterAlgorithms.push_back(
+          this->createAlgorithm(scatterShader,
+                                { this->mSortKeys[source],
+                                  sortValues[source],
+                                  this->mHistogram,
+                                  this->mSortKeys[destination],
+                                  sortValues[destination] },
+                                { this->mWorkgroupSize,
+                                  KP_SCAN_ITEMS_PER_INVOCATION,
+                                  KP_SORT_RADIX_BITS,
+                                  shift,
+                                  hasValues ? 1u : 0u }));
+    }
+
+    this->mStoreAlgorithm = this->createAlgorithm(
+      KP_OPERATION_SHADER_DATA(opsortstore),
+      { this->mSortKeys[0],
+        sortValues[0],
+        outputKeys,
+        hasValues ? outputValues : this->mSortPlaceholder },
+      { this->mWorkgroupSize, floatKeys, descending, valuesMode });
+}
+
+void
+OpSort::recordSort()
+{
+    uint32_t size = this->mSortKeys[0]->size();
+    uint32_t blockSize = this->mWorkgroupSize * KP_SCAN_ITEMS_PER_INVOCATION;
+    uint32_t numBlocks = (size + blockSize - 1) / blockSize;
+
+    for (std::shared_ptr<Tensor> tensor : this->mSortInputs) {
+        tensor->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eMemoryWrite,
+          vk::AccessFlagBits::eShaderRead,
+          vk::PipelineStageFlagBits::eAllCommands,
+          vk::PipelineStageFlagBits::eComputeShader);
+    }
+
+    this->mLoadAlgorithm->recordDispatch(
+      this->dispatchSize(size, this->mWorkgroupSize), 1, 1);
+    this->recordShaderBarrier(this->mSortKeys[0]);
+    if (this->mSortValues.size()) {
+        this->recordShaderBarrier(this->mSortValues[0]);
+    }
+
+    for (size_t i = 0; i < this->mHistogramAlgorithms.size(); i++) {
+        uint32_t destination = 1 - i % 2;
+
+        this->mHistogramAlgorithms[i]->recordDispatch(
+          this->dispatchSize(numBlocks, 1), 1, 1);
+
+        this->recordScan();
+
+        this->mScatterAlgorithms[i]->recordDispatch(
+          this->dispatchSize(numBlocks, 1), 1, 1);
+
+        // The histogram barrier orders the reads of the scatter before the
+        // writes of the next histogram
+        this->recordShaderBarrier(this->mHistogram);
+        this->recordShaderBarrier(this->mSortKeys[destination]);
+        if (this->mSortValues.size()) {
+            this->recordShaderBarrier(this->mSortValues[destination]);
+        }
+    }
+
+    for (std::shared_ptr<Tensor> tensor : this->mSortOutputs) {
+        tensor->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eMemoryWrite,
+          vk::AccessFlagBits::eShaderWrite,
+          vk::PipelineStageFlagBits::eAllCommands,
+          vk::PipelineStageFlagBits::eComputeShader);
+    }
+
+    this->mStoreAlgorithm->recordDispatch(
+      this->dispatchSize(this->mSortOutputs[0]->size(), this->mWorkgroupSize),
+      1,
+      1);
+
+    for (std::shared_ptr<Tensor> tensor : this->mSortOutputs) {
+        tensor->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eShaderWrite,
+          vk::AccessFlagBits::eMemoryRead,
+          vk::PipelineStageFlagBits::eComputeShader,
+          vk::PipelineStageFlagBits::eAllCommands);
+    }
+}
+
+void
+OpSort::recordShaderBarrier(std::shared_ptr<Tensor> tensor)
+{
+    tensor->recordBufferMemoryBarrier(this->mCommandBuffer,
+                                      vk::AccessFlagBits::eShaderWrite,
+                                      vk::AccessFlagBits::eShaderRead,
+                                      vk::PipelineStageFlagBits::eComputeShader,
+                                      vk::PipelineStageFlagBits::eComputeShader);
+}
+
+} // End namespace kp
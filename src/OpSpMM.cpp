@@ -0,0 +1,56 @@
+#include "kompute/operations/OpSpMM.hpp"
+
+namespace kp {
+
+OpSpMM::OpSpMM()
+{
+    SPDLOG_DEBUG("Kompute OpSpMM constructor base");
+}
+
+OpSpMM::OpSpMM(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+               std::shared_ptr<vk::Device> device,
+               std::shared_ptr<vk::CommandBuffer> commandBuffer,
+               std::vector<std::shared_ptr<Tensor>>& tensors,
+               std::shared_ptr<SparseTensor> matrix)
+  : OpSpMV(physicalDevice, device, commandBuffer, tensors, matrix)
+{
+    SPDLOG_DEBUG("Kompute OpSpMM constructor with params");
+}
+
+OpSpMM::~OpSpMM()
+{
+    SPDLOG_DEBUG("Kompute OpSpMM destructor started");
+}
+
+void
+OpSpMM::init()
+{
+    SPDLOG_DEBUG("Kompute OpSpMM init called");
+
+    if (this->mTensors.size() != 2) {
+        throw std::runtime_error(
+          "Kompute OpSpMM called with " +
+          std::to_string(this->mTensors.size()) +
+          " tensors but expected the input and output tensors");
+    }
+    if (!this->mMatrix) {
+        throw std::runtime_error("Kompute OpSpMM provided with null matrix");
+    }
+
+    // The input can either be reshaped into its rows and columns or hold
+    // the rows of the dense matrix in a single dimension
+    uint32_t columns = this->mMatrix->columns();
+    std::vector<uint32_t> inputShape = tensorShape(this->mTensors[0]);
+    if (this->mTensors[0]->size() % columns != 0 ||
+        (inputShape.size() == 2 && inputShape[0] != columns) ||
+        inputShape.size() > 2) {
+        throw std::runtime_error(
+          "Kompute OpSpMM input of shape " + shapeToString(inputShape) +
+          " does not have the " + std::to_string(columns) +
+          " rows of the columns of the matrix");
+    }
+
+    this->initMultiplication(this->mTensors[0]->size() / columns);
+}
+
+} // End namespace kp
@@ -0,0 +1,191 @@
+#include <algorithm>
+
+#if RELEASE
+#include "kompute/shaders/shaderopspmvcsr.hpp"
+#include "kompute/shaders/shaderopspmvcsrshared.hpp"
+#include "kompute/shaders/shaderopspmvcsrsubgroup.hpp"
+#include "kompute/shaders/shaderopspmvell.hpp"
+#endif
+
+#include "kompute/DevicePolicy.hpp"
+
+#include "kompute/operations/OpSpMV.hpp"
+
+namespace kp {
+
+OpSpMV::OpSpMV()
+{
+    SPDLOG_DEBUG("Kompute OpSpMV constructor base");
+}
+
+OpSpMV::OpSpMV(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+               std::shared_ptr<vk::Device> device,
+               std::shared_ptr<vk::CommandBuffer> commandBuffer,
+               std::vector<std::shared_ptr<Tensor>>& tensors,
+               std::shared_ptr<SparseTensor> matrix)
+  : OpAlgoBase(physicalDevice, device, commandBuffer, tensors)
+{
+    SPDLOG_DEBUG("Kompute OpSpMV constructor with params");
+
+    this->mMatrix = matrix;
+}
+
+OpSpMV::~OpSpMV()
+{
+    SPDLOG_DEBUG("Kompute OpSpMV destructor started");
+}
+
+void
+OpSpMV::init()
+{
+    SPDLOG_DEBUG("Kompute OpSpMV init called");
+
+    if (this->mTensors.size() != 2) {
+        throw std::runtime_error(
+          "Kompute OpSpMV called with " +
+          std::to_string(this->mTensors.size()) +
+          " tensors but expected the input and output tensors");
+    }
+
+    this->initMultiplication(1);
+}
+
+void
+OpSpMV::initMultiplication(uint32_t denseColumns)
+{
+    if (!this->mMatrix) {
+        throw std::runtime_error("Kompute OpSpMV provided with null matrix");
+    }
+
+    std::vector<std::shared_ptr<Tensor>> bindings = this->mMatrix->tensors();
+    bindings.push_back(this->mTensors[0]);
+    bindings.push_back(this->mTensors[1]);
+    for (std::shared_ptr<Tensor> tensor : bindings) {
+        if (!tensor->isInit()) {
+            throw std::runtime_error(
+              "Kompute OpSpMV all tensor parameters and matrix tensors must "
+              "be initialised");
+        }
+    }
+
+    uint32_t rows = this->mMatrix->rows();
+    uint32_t columns = this->mMatrix->columns();
+    if (this->mTensors[0] == this->mTensors[1]) {
+        throw std::runtime_error(
+          "Kompute OpSpMV output cannot be the same tensor as the input");
+    }
+    if (this->mTensors[0]->size() != columns * denseColumns ||
+        this->mTensors[1]->size() != rows * denseColumns) {
+        throw std::runtime_error(
+          "Kompute OpSpMV matrix of " + std::to_string(rows) + " rows and " +
+          std::to_string(columns) + " columns expected input of size " +
+          std::to_string(columns * denseColumns) + " and output of size " +
+          std::to_string(rows * denseColumns) +
+          " but got input: " + std::to_string(this->mTensors[0]->size()) +
+          " output: " + std::to_string(this->mTensors[1]->size()));
+    }
+
+    this->mWorkgroupSize =
+      this->powerOfTwoWorkgroupSize(KP_DEFAULT_SPARSE_WORKGROUP_SIZE);
+
+    // The sizes of the tensors take the constant ids of their bindings, and
+    // are followed by the dimensions and the workgroup size
+    std::vector<uint32_t> specializationConstants = { rows, denseColumns };
+    if (this->mMatrix->format() == SparseTensor::SparseFormats::eELL) {
+        specializationConstants.push_back(this->mMatrix->ellWidth() /
+                                          KP_SPARSE_ELL_VECTOR_SIZE);
+    }
+    specializationConstants.push_back(this->mWorkgroupSize);
+
+    std::vector<char> shader;
+    uint32_t numWorkgroups = 0;
+    if (this->mMatrix->format() == SparseTensor::SparseFormats::eELL) {
+        shader = KP_OPERATION_SHADER_DATA(opspmvell);
+        numWorkgroups = this->dispatchSize(rows * denseColumns);
+    } else if (denseColumns > 1) {
+        // Consecutive invocations compute consecutive columns of a row, so the
+        // reads of the rows of the dense input are coalesced
+        shader = KP_OPERATION_SHADER_DATA(opspmvcsr);
+        numWorkgroups = this->dispatchSize(rows * denseColumns);
+    } else {
+        DeviceInfo deviceInfo =
+          DeviceInfo::fromPhysicalDevice(*this->mPhysicalDevice, 0);
+        uint32_t subgroupSize = deviceInfo.subgroupSize;
+        if (deviceInfo.hasSubgroupArithmetic && subgroupSize > 0 &&
+            subgroupSize <= this->mWorkgroupSize &&
+            this->mWorkgroupSize % subgroupSize == 0) {
+            shader = KP_OPERATION_SHADER_DATA(opspmvcsrsubgroup);
+            numWorkgroups = this->dispatchSize(rows * subgroupSize);
+        } else {
+            // Short rows would leave most of a fixed size group idle
+            uint32_t averageRowSize =
+              (this->mMatrix->nonZeros() + rows - 1) / rows;
+            uint32_t maxLanes = std::min<uint32_t>(KP_SPARSE_CSR_MAX_LANES,
+                                                   this->mWorkgroupSize);
+            uint32_t lanes = 1;
+            while (lanes < averageRowSize && lanes * 2 <= maxLanes) {
+                lanes *= 2;
+            }
+            shader = KP_OPERATION_SHADER_DATA(opspmvcsrshared);
+            specializationConstants.push_back(lanes);
+            numWorkgroups = this->dispatchSize(rows * lanes);
+        }
+    }
+
+    this->mAlgorithm =
+      this->createAlgorithm(shader, bindings, specializationConstants);
+    this->mKomputeWorkgroup = { numWorkgroups, 1, 1 };
+
+    SPDLOG_DEBUG("Kompute OpSpMV created multiplication of {} non zeros by "
+                 "{} columns with {} workgroups of size {}",
+                 this->mMatrix->nonZeros(),
+                 denseColumns,
+                 numWorkgroups,
+                 this->mWorkgroupSize);
+}
+
+void
+OpSpMV::record()
+{
+    SPDLOG_DEBUG("Kompute OpSpMV record called");
+
+    std::vector<std::shared_ptr<Tensor>> inputs = this->mMatrix->tensors();
+    inputs.push_back(this->mTensors[0]);
+    for (std::shared_ptr<Tensor> tensor : inputs) {
+        tensor->recordBufferMemoryBarrier(
+          this->mCommandBuffer,
+          vk::AccessFlagBits::eMemoryWrite,
+          vk::AccessFlagBits::eShaderRead,
+          vk::PipelineStageFlagBits::eAllCommands,
+          vk::PipelineStageFlagBits::eComputeShader);
+    }
+    this->mTensors[1]->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eMemoryWrite,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::PipelineStageFlagBits::eAllCommands,
+      vk::PipelineStageFlagBits::eComputeShader);
+
+    this->mAlgorithm->recordDispatch(this->mKomputeWorkgroup.x,
+                                     this->mKomputeWorkgroup.y,
+                                     this->mKomputeWorkgroup.z);
+
+    this->mTensors[1]->recordBufferMemoryBarrier(
+      this->mCommandBuffer,
+      vk::AccessFlagBits::eShaderWrite,
+      vk::AccessFlagBits::eMemoryRead,
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eAllCommands);
+}
+
+uint32_t
+OpSpMV::dispatchSize(uint32_t count)
+{
+    uint32_t maxWorkgroupCount =
+      this->mPhysicalDevice->getProperties().limits.maxComputeWorkGroupCount[0];
+    uint32_t numWorkgroups =
+      (count + this->mWorkgroupSize - 1) / this->mWorkgroupSize;
+    return std::max<uint32_t>(std::min(numWorkgroups, maxWorkgroupCount), 1);
+}
+
+} // End namespace kp
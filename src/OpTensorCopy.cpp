@@ -68,9 +68,23 @@ OpTensorCopy::postEval()
 {
     SPDLOG_DEBUG("Kompute OpTensorCopy postEval called");
 
-    // Copy the data from the first tensor into all the tensors
+    // Tensors wrapping host memory do not hold a data vector to copy from
+    std::shared_ptr<Tensor> copyFromTensor = this->mTensors[0];
+    std::vector<float> hostPointerData;
+    if (copyFromTensor->hostPointer()) {
+        hostPointerData.assign(copyFromTensor->hostPointer(),
+                               copyFromTensor->hostPointer() +
+                                 copyFromTensor->size());
+    }
+    const std::vector<float>& copyFromData =
+      copyFromTensor->hostPointer() ? hostPointerData : copyFromTensor->data();
+
+    // Copy the data from the first tensor into all the tensors, except the
+    // ones importing host memory which the GPU has already written into
     for (size_t i = 1; i < this->mTensors.size(); i++) {
-        this->mTensors[i]->setData(this->mTensors[0]->data());
+        if (!this->mTensors[i]->isHostMemoryImported()) {
+            this->mTensors[i]->setData(copyFromData);
+        }
     }
 }
 
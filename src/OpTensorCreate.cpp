@@ -40,9 +40,11 @@ OpTensorCreate::init()
             throw std::runtime_error(
               "Kompute OpTensorCreate: Tensor has already been initialized");
         }
-        if (tensor->tensorType() == Tensor::TensorTypes::eDevice) {
-            tensor->init(this->mPhysicalDevice, this->mDevice);
+        tensor->init(
+          this->mPhysicalDevice, this->mDevice, this->mEnabledExtensions);
 
+        if (tensor->tensorType() == Tensor::TensorTypes::eDevice &&
+            !tensor->isUnifiedMemory()) {
             std::shared_ptr<Tensor> stagingTensor = std::make_shared<Tensor>(
               tensor->data(), Tensor::TensorTypes::eStaging);
 
@@ -54,8 +56,7 @@ OpTensorCreate::init()
 
         } else {
 
-            tensor->init(this->mPhysicalDevice, this->mDevice);
-
+            // Device tensors in unified memory are mapped directly as staging
             tensor->mapDataIntoHostMemory();
 
             // We push a nullptr when no staging tensor is needed to match
@@ -71,7 +72,7 @@ OpTensorCreate::record()
     SPDLOG_DEBUG("Kompute OpTensorCreate record called");
 
     for (size_t i = 0; i < this->mTensors.size(); i++) {
-        if (this->mTensors[i]->tensorType() == Tensor::TensorTypes::eDevice) {
+        if (this->mStagingTensors[i]) {
             this->mTensors[i]->recordCopyFrom(
               this->mCommandBuffer, this->mStagingTensors[i], false);
         }
@@ -90,4 +91,11 @@ OpTensorCreate::postEval()
     SPDLOG_DEBUG("Kompute OpTensorCreate postEval called");
 }
 
+void
+OpTensorCreate::setEnabledExtensions(
+  const std::vector<std::string>& enabledExtensions)
+{
+    this->mEnabledExtensions = enabledExtensions;
+}
+
 }
@@ -14,10 +14,15 @@ OpTensorSyncDevice::OpTensorSyncDevice(
   std::shared_ptr<vk::PhysicalDevice> physicalDevice,
   std::shared_ptr<vk::Device> device,
   std::shared_ptr<vk::CommandBuffer> commandBuffer,
-  std::vector<std::shared_ptr<Tensor>> tensors)
+  std::vector<std::shared_ptr<Tensor>> tensors,
+  std::vector<Tensor::Range> ranges)
   : OpBase(physicalDevice, device, commandBuffer, tensors, false)
 {
-    SPDLOG_DEBUG("Kompute OpTensorSyncDevice constructor with params");
+    SPDLOG_DEBUG("Kompute OpTensorSyncDevice constructor with params and {} "
+                 "ranges",
+                 ranges.size());
+
+    this->mRanges = Tensor::coalesceRanges(ranges);
 }
 
 OpTensorSyncDevice::~OpTensorSyncDevice()
@@ -46,7 +51,16 @@ OpTensorSyncDevice::init()
               "TensorTypes::eStorage and hence cannot be used to receive or "
               "pass data.");
         }
-        if (tensor->tensorType() == Tensor::TensorTypes::eDevice) {
+        for (const Tensor::Range& range : this->mRanges) {
+            if (range.offset + range.size > tensor->size()) {
+                throw std::runtime_error(
+                  "Kompute OpTensorSyncDevice range is out of bounds of "
+                  "tensor with size " +
+                  std::to_string(tensor->size()));
+            }
+        }
+        if (tensor->tensorType() == Tensor::TensorTypes::eDevice &&
+            !tensor->isUnifiedMemory()) {
 
             std::shared_ptr<Tensor> stagingTensor = std::make_shared<Tensor>(
               tensor->data(), Tensor::TensorTypes::eStaging);
@@ -56,8 +70,9 @@ OpTensorSyncDevice::init()
             this->mStagingTensors.push_back(stagingTensor);
 
         } else {
-            // We push a nullptr when no staging tensor is needed to match
-            // index number in array to have one to one mapping with tensors
+            // We push a nullptr when no staging tensor is needed, including
+            // device tensors in unified memory which are mapped directly, to
+            // match index number in array to have one to one mapping
             this->mStagingTensors.push_back(nullptr);
         }
     }
@@ -68,11 +83,25 @@ OpTensorSyncDevice::record()
 {
     SPDLOG_DEBUG("Kompute OpTensorSyncDevice record called");
 
+    // The copy regions from the staging tensors are part of the command
+    // buffer so they are resolved when recorded, whereas the dirty ranges are
+    // only consumed when the operation is evaluated
+    this->mRecordedRanges.clear();
     for (size_t i = 0; i < this->mTensors.size(); i++) {
-        if (this->mTensors[i]->tensorType() == Tensor::TensorTypes::eDevice) {
+        std::vector<Tensor::Range> ranges;
+
+        if (this->mStagingTensors[i]) {
+            ranges = this->resolveRanges(this->mTensors[i]);
+
+            SPDLOG_DEBUG("Kompute OpTensorSyncDevice tensor {} recorded with "
+                         "{} ranges",
+                         i,
+                         ranges.size());
+
             this->mTensors[i]->recordCopyFrom(
-              this->mCommandBuffer, this->mStagingTensors[i], false);
+              this->mCommandBuffer, this->mStagingTensors[i], ranges, false);
         }
+        this->mRecordedRanges.push_back(ranges);
     }
 }
 
@@ -81,14 +110,48 @@ OpTensorSyncDevice::preEval()
 {
     SPDLOG_DEBUG("Kompute OpTensorSyncDevice preEval called");
 
-    // Performing sync of data as eval can be called multiple times with same op
+    // Performing sync of data as eval can be called multiple times with same
+    // op, so the dirty ranges are resolved on every evaluation
     for (size_t i = 0; i < this->mTensors.size(); i++) {
-        if (this->mTensors[i]->tensorType() == Tensor::TensorTypes::eDevice) {
-            this->mStagingTensors[i]->setData(this->mTensors[i]->data());
-            this->mStagingTensors[i]->mapDataIntoHostMemory();
+        std::shared_ptr<Tensor> tensor = this->mTensors[i];
+
+        if (this->mStagingTensors[i]) {
+            const std::vector<Tensor::Range>& recordedRanges =
+              this->mRecordedRanges[i];
+
+            // Only the recorded copy regions reach the device tensor, so
+            // ranges marked after recording have to be within them
+            for (const Tensor::Range& dirtyRange : tensor->dirtyRanges()) {
+                bool recorded = false;
+                for (const Tensor::Range& recordedRange : recordedRanges) {
+                    if (dirtyRange.offset >= recordedRange.offset &&
+                        dirtyRange.offset + dirtyRange.size <=
+                          recordedRange.offset + recordedRange.size) {
+                        recorded = true;
+                        break;
+                    }
+                }
+                if (!recorded) {
+                    throw std::runtime_error(
+                      "Kompute OpTensorSyncDevice tensor has dirty ranges "
+                      "outside of the ranges recorded, the operation has to "
+                      "be recorded again to transfer them");
+                }
+            }
+
+            this->mStagingTensors[i]->setData(tensor->data(), recordedRanges);
+            this->mStagingTensors[i]->mapDataIntoHostMemory(recordedRanges);
         } else {
-            this->mTensors[i]->mapDataFromHostMemory();
+            std::vector<Tensor::Range> ranges = this->resolveRanges(tensor);
+
+            SPDLOG_DEBUG("Kompute OpTensorSyncDevice tensor {} mapped with {} "
+                         "ranges",
+                         i,
+                         ranges.size());
+
+            tensor->mapDataIntoHostMemory(ranges);
         }
+        tensor->clearDirtyRanges();
     }
 }
 
@@ -98,4 +161,17 @@ OpTensorSyncDevice::postEval()
     SPDLOG_DEBUG("Kompute OpTensorSyncDevice postEval called");
 }
 
+std::vector<Tensor::Range>
+OpTensorSyncDevice::resolveRanges(std::shared_ptr<Tensor> tensor)
+{
+    std::vector<Tensor::Range> ranges = this->mRanges;
+    if (ranges.empty()) {
+        ranges = tensor->dirtyRanges();
+    }
+    if (ranges.empty()) {
+        ranges.push_back({ 0, tensor->size() });
+    }
+    return ranges;
+}
+
 }
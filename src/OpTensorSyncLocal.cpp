@@ -14,10 +14,15 @@ OpTensorSyncLocal::OpTensorSyncLocal(
   std::shared_ptr<vk::PhysicalDevice> physicalDevice,
   std::shared_ptr<vk::Device> device,
   std::shared_ptr<vk::CommandBuffer> commandBuffer,
-  std::vector<std::shared_ptr<Tensor>> tensors)
+  std::vector<std::shared_ptr<Tensor>> tensors,
+  std::vector<Tensor::Range> ranges)
   : OpBase(physicalDevice, device, commandBuffer, tensors, false)
 {
-    SPDLOG_DEBUG("Kompute OpTensorSyncLocal constructor with params");
+    SPDLOG_DEBUG("Kompute OpTensorSyncLocal constructor with params and {} "
+                 "ranges",
+                 ranges.size());
+
+    this->mRanges = Tensor::coalesceRanges(ranges);
 }
 
 OpTensorSyncLocal::~OpTensorSyncLocal()
@@ -46,7 +51,16 @@ OpTensorSyncLocal::init()
               "TensorTypes::eStorage and hence cannot be used to receive or "
               "pass data.");
         }
-        if (tensor->tensorType() == Tensor::TensorTypes::eDevice) {
+        for (const Tensor::Range& range : this->mRanges) {
+            if (range.offset + range.size > tensor->size()) {
+                throw std::runtime_error(
+                  "Kompute OpTensorSyncLocal range is out of bounds of "
+                  "tensor with size " +
+                  std::to_string(tensor->size()));
+            }
+        }
+        if (tensor->tensorType() == Tensor::TensorTypes::eDevice &&
+            !tensor->isUnifiedMemory()) {
 
             std::shared_ptr<Tensor> stagingTensor = std::make_shared<Tensor>(
               tensor->data(), Tensor::TensorTypes::eStaging);
@@ -57,8 +71,9 @@ OpTensorSyncLocal::init()
 
         } else {
 
-            // We push a nullptr when no staging tensor is needed to match
-            // index number in array to have one to one mapping with tensors
+            // We push a nullptr when no staging tensor is needed, including
+            // device tensors in unified memory which are mapped directly, to
+            // match index number in array to have one to one mapping
             this->mStagingTensors.push_back(nullptr);
         }
     }
@@ -69,11 +84,26 @@ OpTensorSyncLocal::record()
 {
     SPDLOG_DEBUG("Kompute OpTensorSyncLocal record called");
 
+    this->mTensorRanges.clear();
     for (size_t i = 0; i < this->mTensors.size(); i++) {
-        if (this->mTensors[i]->tensorType() == Tensor::TensorTypes::eDevice) {
+        std::vector<Tensor::Range> ranges = this->mRanges;
+        if (ranges.empty()) {
+            ranges.push_back({ 0, this->mTensors[i]->size() });
+        }
+
+        if (this->mStagingTensors[i]) {
             this->mStagingTensors[i]->recordCopyFrom(
-              this->mCommandBuffer, this->mTensors[i], true);
+              this->mCommandBuffer, this->mTensors[i], ranges, true);
+        } else if (this->mTensors[i]->isUnifiedMemory()) {
+            // Makes the writes of previous operations visible to the host
+            this->mTensors[i]->recordBufferMemoryBarrier(
+              this->mCommandBuffer,
+              vk::AccessFlagBits::eMemoryWrite,
+              vk::AccessFlagBits::eHostRead,
+              vk::PipelineStageFlagBits::eAllCommands,
+              vk::PipelineStageFlagBits::eHost);
         }
+        this->mTensorRanges.push_back(ranges);
     }
 }
 
@@ -90,11 +120,13 @@ OpTensorSyncLocal::postEval()
 
     SPDLOG_DEBUG("Kompute OpTensorSyncLocal mapping data into tensor local");
     for (size_t i = 0; i < this->mTensors.size(); i++) {
-        if (this->mTensors[i]->tensorType() == Tensor::TensorTypes::eDevice) {
-            this->mStagingTensors[i]->mapDataFromHostMemory();
-            this->mTensors[i]->setData(this->mStagingTensors[i]->data());
+        const std::vector<Tensor::Range>& ranges = this->mTensorRanges[i];
+        if (this->mStagingTensors[i]) {
+            this->mStagingTensors[i]->mapDataFromHostMemory(ranges);
+            this->mTensors[i]->setData(this->mStagingTensors[i]->data(),
+                                       ranges);
         } else {
-            this->mTensors[i]->mapDataFromHostMemory();
+            this->mTensors[i]->mapDataFromHostMemory(ranges);
         }
     }
 }
@@ -0,0 +1,64 @@
+#include "kompute/operations/OpTopK.hpp"
+
+namespace kp {
+
+OpTopK::OpTopK()
+{
+    SPDLOG_DEBUG("Kompute OpTopK constructor base");
+}
+
+OpTopK::OpTopK(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+               std::shared_ptr<vk::Device> device,
+               std::shared_ptr<vk::CommandBuffer> commandBuffer,
+               std::vector<std::shared_ptr<Tensor>>& tensors,
+               SortOrders sortOrder)
+  : OpSort(physicalDevice,
+           device,
+           commandBuffer,
+           tensors,
+           KeyTypes::eFloat,
+           sortOrder)
+{
+    SPDLOG_DEBUG("Kompute OpTopK constructor with params");
+}
+
+OpTopK::~OpTopK()
+{
+    SPDLOG_DEBUG("Kompute OpTopK destructor started");
+}
+
+void
+OpTopK::init()
+{
+    SPDLOG_DEBUG("Kompute OpTopK init called");
+
+    if (this->mTensors.size() != 3) {
+        throw std::runtime_error(
+          "Kompute OpTopK called with " +
+          std::to_string(this->mTensors.size()) +
+          " tensors but expected the input, values and indices tensors");
+    }
+
+    for (std::shared_ptr<Tensor> tensor : this->mTensors) {
+        if (!tensor->isInit()) {
+            throw std::runtime_error(
+              "Kompute OpTopK all tensor parameters must be initialised");
+        }
+    }
+
+    uint32_t k = this->mTensors[1]->size();
+    if (k == 0 || k > this->mTensors[0]->size() ||
+        this->mTensors[2]->size() != k) {
+        throw std::runtime_error(
+          "Kompute OpTopK values and indices must have the same size of at "
+          "most the input size. Input: " +
+          std::to_string(this->mTensors[0]->size()) +
+          " Values: " + std::to_string(k) +
+          " Indices: " + std::to_string(this->mTensors[2]->size()));
+    }
+
+    this->initSort(
+      this->mTensors[0], nullptr, this->mTensors[1], this->mTensors[2]);
+}
+
+} // End namespace kp
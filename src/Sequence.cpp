@@ -1,4 +1,5 @@
 
+#include "kompute/CompletionThread.hpp"
 #include "kompute/Sequence.hpp"
 
 namespace kp {
@@ -12,7 +13,11 @@ Sequence::Sequence()
 Sequence::Sequence(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
                    std::shared_ptr<vk::Device> device,
                    std::shared_ptr<vk::Queue> computeQueue,
-                   uint32_t queueIndex)
+                   uint32_t queueIndex,
+                   std::shared_ptr<ShaderCache> shaderCache,
+                   std::shared_ptr<DescriptorPoolArena> descriptorPoolArena,
+                   std::shared_ptr<std::mutex> queueMutex,
+                   const std::vector<std::string>& enabledExtensions)
 {
     SPDLOG_DEBUG("Kompute Sequence Constructor with existing device & queue");
 
@@ -20,6 +25,10 @@ Sequence::Sequence(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
     this->mDevice = device;
     this->mComputeQueue = computeQueue;
     this->mQueueIndex = queueIndex;
+    this->mShaderCache = shaderCache;
+    this->mDescriptorPoolArena = descriptorPoolArena;
+    this->mQueueMutex = queueMutex;
+    this->mEnabledExtensions = enabledExtensions;
     this->mIsInit = true;
 }
 
@@ -137,20 +146,36 @@ Sequence::evalAsync()
         return false;
     }
 
-    this->mIsRunning = true;
-
+    // The sequence is only running once the operations have been prepared,
+    // so an operation throwing in preEval does not leave it running
     for (size_t i = 0; i < this->mOperations.size(); i++) {
         this->mOperations[i]->preEval();
     }
 
+    this->mIsRunning = true;
+
     vk::SubmitInfo submitInfo(
       0, nullptr, nullptr, 1, this->mCommandBuffer.get());
 
     this->mFence = this->mDevice->createFence(vk::FenceCreateInfo());
 
+    // The descriptor sets retired while the command buffer is in flight are
+    // only freed by the arena once the submission has completed
+    if (this->mDescriptorPoolArena) {
+        this->mSubmission =
+          this->mDescriptorPoolArena->beginSubmission(this->mFence);
+    }
+
     SPDLOG_DEBUG(
       "Kompute sequence submitting command buffer into compute queue");
 
+    // Queue submissions are externally synchronized so the queue mutex is
+    // held when the queue is shared across threads
+    std::unique_lock<std::mutex> queueLock;
+    if (this->mQueueMutex) {
+        queueLock = std::unique_lock<std::mutex>(*this->mQueueMutex);
+    }
+
     this->mComputeQueue->submit(1, &submitInfo, this->mFence);
 
     return true;
@@ -166,16 +191,24 @@ Sequence::evalAwait(uint64_t waitFor)
 
     vk::Result result =
       this->mDevice->waitForFences(1, &this->mFence, VK_TRUE, waitFor);
-    this->mDevice->destroy(
-      this->mFence, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
-
-    this->mIsRunning = false;
 
+    // The submission may still be using the fence so it is kept alive to
+    // allow evalAwait to be called again until the sequence completes
     if (result == vk::Result::eTimeout) {
-        SPDLOG_WARN("Kompute Sequence evalAwait timed out");
+        SPDLOG_DEBUG("Kompute Sequence evalAwait timed out");
         return false;
     }
 
+    // The arena polls the fence until the submission is ended
+    if (this->mDescriptorPoolArena) {
+        this->mDescriptorPoolArena->endSubmission(this->mSubmission);
+    }
+
+    this->mDevice->destroy(
+      this->mFence, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+
+    this->mIsRunning = false;
+
     for (size_t i = 0; i < this->mOperations.size(); i++) {
         this->mOperations[i]->postEval();
     }
@@ -183,6 +216,38 @@ Sequence::evalAwait(uint64_t waitFor)
     return true;
 }
 
+void
+Sequence::setCompletionThread(
+  std::shared_ptr<CompletionThread> completionThread)
+{
+    this->mCompletionThread = completionThread;
+}
+
+#if KOMPUTE_ENABLE_COROUTINES
+SequenceAwaitable
+Sequence::evalCoro(CoroExecutor executor)
+{
+    if (!this->mCompletionThread) {
+        throw std::runtime_error(
+          "Kompute Sequence evalCoro called without completion thread");
+    }
+
+    return SequenceAwaitable(
+      this->shared_from_this(), this->mCompletionThread, executor);
+}
+#endif
+
+bool
+Sequence::isComplete()
+{
+    if (!this->mIsRunning) {
+        return true;
+    }
+
+    return this->mDevice->getFenceStatus(this->mFence) ==
+           vk::Result::eSuccess;
+}
+
 bool
 Sequence::isRunning()
 {
@@ -201,6 +266,12 @@ Sequence::isInit()
     return this->mIsInit;
 }
 
+std::mutex&
+Sequence::mutex()
+{
+    return this->mMutex;
+}
+
 void
 Sequence::freeMemoryDestroyGPUResources()
 {
@@ -249,6 +320,13 @@ Sequence::freeMemoryDestroyGPUResources()
         this->mOperations.clear();
     }
 
+    // Freeing the command buffer requires the submission to have completed,
+    // so it no longer holds back the retired descriptor sets of the arena
+    if (this->mIsRunning && this->mDescriptorPoolArena) {
+        this->mDescriptorPoolArena->endSubmission(this->mSubmission);
+        this->mIsRunning = false;
+    }
+
     this->mIsInit = false;
 
 }
@@ -0,0 +1,65 @@
+
+#include "kompute/CompletionThread.hpp"
+#include "kompute/Sequence.hpp"
+#include "kompute/SequenceAwaitable.hpp"
+
+#if KOMPUTE_ENABLE_COROUTINES
+
+namespace kp {
+
+SequenceAwaitable::SequenceAwaitable(
+  std::shared_ptr<Sequence> sequence,
+  std::shared_ptr<CompletionThread> completionThread,
+  CoroExecutor executor)
+{
+    this->mSequence = sequence;
+    this->mCompletionThread = completionThread;
+    this->mExecutor = executor;
+}
+
+bool
+SequenceAwaitable::await_ready() noexcept
+{
+    return false;
+}
+
+bool
+SequenceAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    SPDLOG_DEBUG("Kompute SequenceAwaitable suspending coroutine");
+
+    {
+        std::lock_guard<std::mutex> lock(this->mSequence->mutex());
+        bool isSubmitted = this->mSequence->evalAsync();
+        this->mFuture =
+          this->mCompletionThread->track(this->mSequence, isSubmitted);
+    }
+
+    EvalFuture future = this->mFuture;
+    if (future.ready()) {
+        return false;
+    }
+
+    // The coroutine may be resumed, and this awaitable destroyed, as soon as
+    // the continuation is chained, so only local copies are used from here
+    CoroExecutor executor = this->mExecutor;
+    future.then([handle, executor](EvalFuture) {
+        if (executor) {
+            executor([handle]() { handle.resume(); });
+        } else {
+            handle.resume();
+        }
+    });
+
+    return true;
+}
+
+bool
+SequenceAwaitable::await_resume()
+{
+    return this->mFuture.get();
+}
+
+} // End namespace kp
+
+#endif // KOMPUTE_ENABLE_COROUTINES
@@ -0,0 +1,239 @@
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "kompute/ShaderCache.hpp"
+#include "kompute/ShaderCompiler.hpp"
+
+namespace kp {
+
+ShaderCache::ShaderCache()
+{
+    SPDLOG_DEBUG("Kompute ShaderCache base constructor");
+}
+
+ShaderCache::ShaderCache(std::shared_ptr<vk::Device> device)
+{
+    SPDLOG_DEBUG("Kompute ShaderCache constructor with device");
+
+    this->mDevice = device;
+}
+
+ShaderCache::~ShaderCache()
+{
+    SPDLOG_DEBUG("Kompute ShaderCache destructor started");
+
+    this->freeMemoryDestroyGPUResources();
+}
+
+std::shared_ptr<vk::ShaderModule>
+ShaderCache::getOrCreateFromFile(const std::string& shaderFilePath)
+{
+    SPDLOG_DEBUG("Kompute ShaderCache getOrCreateFromFile with path: {}",
+                 shaderFilePath);
+
+    struct stat fileStat;
+    if (stat(shaderFilePath.c_str(), &fileStat) != 0) {
+        throw std::runtime_error("Error reading file: " + shaderFilePath);
+    }
+
+    size_t shaderFileSize = static_cast<size_t>(fileStat.st_size);
+    if (!shaderFileSize) {
+        throw std::runtime_error("Error reading empty file: " +
+                                 shaderFilePath);
+    }
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    std::unordered_map<std::string, FileShaderEntry>::iterator found =
+      this->mFileShaderModules.find(shaderFilePath);
+
+    if (found != this->mFileShaderModules.end()) {
+        if (found->second.modificationTime == fileStat.st_mtime &&
+            found->second.size == shaderFileSize) {
+            SPDLOG_DEBUG("Kompute ShaderCache found cached shader module");
+            return found->second.shaderModule;
+        }
+        // Modified shader files are reloaded, and the module of the previous
+        // version is only needed by pipelines that have already been created
+        SPDLOG_DEBUG("Kompute ShaderCache replacing modified shader module");
+        this->mDevice->destroy(
+          *found->second.shaderModule,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mFileShaderModules.erase(found);
+    }
+
+    std::shared_ptr<vk::ShaderModule> shaderModule;
+
+#if defined(_WIN32)
+    std::ifstream fileStream(shaderFilePath, std::ios::binary | std::ios::in);
+
+    if (!fileStream.good()) {
+        throw std::runtime_error("Error reading file: " + shaderFilePath);
+    }
+
+    std::vector<char> shaderDataRaw(shaderFileSize);
+    fileStream.read(shaderDataRaw.data(), shaderFileSize);
+    fileStream.close();
+
+    shaderModule =
+      this->createShaderModule(shaderDataRaw.data(), shaderDataRaw.size());
+#else
+    int fileDescriptor = open(shaderFilePath.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        throw std::runtime_error("Error reading file: " + shaderFilePath);
+    }
+
+    // The file is mapped instead of read as it is only used to create the
+    // shader module
+    void* mapped = mmap(
+      nullptr, shaderFileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    close(fileDescriptor);
+
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Error memory mapping file: " +
+                                 shaderFilePath);
+    }
+
+    try {
+        shaderModule = this->createShaderModule(
+          static_cast<const char*>(mapped), shaderFileSize);
+    } catch (...) {
+        munmap(mapped, shaderFileSize);
+        throw;
+    }
+    munmap(mapped, shaderFileSize);
+#endif
+
+    SPDLOG_DEBUG("Kompute ShaderCache loaded {} bytes from file",
+                 shaderFileSize);
+
+    FileShaderEntry fileShaderEntry;
+    fileShaderEntry.shaderModule = shaderModule;
+    fileShaderEntry.modificationTime = fileStat.st_mtime;
+    fileShaderEntry.size = shaderFileSize;
+    this->mFileShaderModules.insert({ shaderFilePath, fileShaderEntry });
+
+    return shaderModule;
+}
+
+std::shared_ptr<vk::ShaderModule>
+ShaderCache::getOrCreateFromData(const std::vector<char>& shaderFileData)
+{
+    SPDLOG_DEBUG("Kompute ShaderCache getOrCreateFromData with size: {}",
+                 shaderFileData.size());
+
+    if (!shaderFileData.size()) {
+        throw std::runtime_error(
+          "Kompute ShaderCache provided with empty shader data");
+    }
+
+    uint64_t shaderKey = ShaderCache::hashShaderData(shaderFileData);
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    std::unordered_map<uint64_t, std::shared_ptr<vk::ShaderModule>>::iterator
+      found = this->mDataShaderModules.find(shaderKey);
+
+    if (found != this->mDataShaderModules.end()) {
+        SPDLOG_DEBUG("Kompute ShaderCache found cached shader module");
+        return found->second;
+    }
+
+    std::shared_ptr<vk::ShaderModule> shaderModule =
+      this->createShaderModule(shaderFileData.data(), shaderFileData.size());
+
+    this->mDataShaderModules.insert({ shaderKey, shaderModule });
+
+    return shaderModule;
+}
+
+size_t
+ShaderCache::size()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    return this->mFileShaderModules.size() + this->mDataShaderModules.size();
+}
+
+void
+ShaderCache::freeMemoryDestroyGPUResources()
+{
+    SPDLOG_DEBUG("Kompute ShaderCache freeMemoryDestroyGPUResources called");
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        if (this->mFileShaderModules.size() ||
+            this->mDataShaderModules.size()) {
+            SPDLOG_ERROR("Kompute ShaderCache freeMemoryDestroyGPUResources "
+                         "called with null Device pointer");
+        }
+        return;
+    }
+
+    for (const std::pair<const std::string, FileShaderEntry>& shaderPair :
+         this->mFileShaderModules) {
+        this->mDevice->destroy(
+          *shaderPair.second.shaderModule,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    this->mFileShaderModules.clear();
+
+    for (const std::pair<const uint64_t, std::shared_ptr<vk::ShaderModule>>&
+           shaderPair :
+         this->mDataShaderModules) {
+        this->mDevice->destroy(
+          *shaderPair.second,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    this->mDataShaderModules.clear();
+
+    SPDLOG_DEBUG("Kompute ShaderCache destroyed shader modules");
+}
+
+std::shared_ptr<vk::ShaderModule>
+ShaderCache::createShaderModule(const char* data, size_t size)
+{
+    SPDLOG_DEBUG("Kompute ShaderCache creating shader module. Size: {}", size);
+
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute ShaderCache device is null");
+    }
+
+    // Shaders provided as GLSL source are compiled once per cache entry
+    std::vector<char> spirvData = ShaderCompiler::toSpirv(data, size);
+
+    vk::ShaderModuleCreateInfo shaderModuleInfo(
+      vk::ShaderModuleCreateFlags(),
+      spirvData.size(),
+      (const uint32_t*)spirvData.data());
+
+    std::shared_ptr<vk::ShaderModule> shaderModule =
+      std::make_shared<vk::ShaderModule>();
+    this->mDevice->createShaderModule(
+      &shaderModuleInfo, nullptr, shaderModule.get());
+
+    return shaderModule;
+}
+
+uint64_t
+ShaderCache::hashShaderData(const std::vector<char>& shaderFileData)
+{
+    // 64 bit FNV-1a, which hashes the content in place without copying it
+    uint64_t hash = 14695981039346656037ULL;
+    for (char byte : shaderFileData) {
+        hash ^= static_cast<uint8_t>(byte);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+}
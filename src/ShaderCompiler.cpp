@@ -0,0 +1,148 @@
+#include <cstring>
+
+#if KOMPUTE_ENABLE_SHADER_COMPILATION
+#include <mutex>
+
+#include <glslang/Public/ShaderLang.h>
+#include <glslang/SPIRV/GlslangToSpv.h>
+#endif
+
+#include "kompute/ShaderCompiler.hpp"
+
+#define KP_SPIRV_MAGIC_NUMBER 0x07230203
+
+namespace kp {
+
+#if KOMPUTE_ENABLE_SHADER_COMPILATION
+// The limits only need to accept the compute shaders, as the limits of the
+// device are validated when the pipeline is created
+static TBuiltInResource
+computeShaderResources()
+{
+    TBuiltInResource resources = {};
+    resources.maxComputeWorkGroupCountX = 65535;
+    resources.maxComputeWorkGroupCountY = 65535;
+    resources.maxComputeWorkGroupCountZ = 65535;
+    resources.maxComputeWorkGroupSizeX = 65535;
+    resources.maxComputeWorkGroupSizeY = 65535;
+    resources.maxComputeWorkGroupSizeZ = 65535;
+    resources.maxComputeUniformComponents = 1024;
+    resources.maxComputeTextureImageUnits = 16;
+    resources.maxComputeImageUniforms = 8;
+    resources.maxComputeAtomicCounters = 8;
+    resources.maxComputeAtomicCounterBuffers = 8;
+    resources.maxCombinedShaderOutputResources = 8;
+    resources.maxImageUnits = 8;
+    resources.maxCombinedImageUnitsAndFragmentOutputs = 8;
+    resources.maxCombinedAtomicCounters = 8;
+    resources.maxCombinedAtomicCounterBuffers = 8;
+    resources.maxAtomicCounterBindings = 1;
+    resources.maxAtomicCounterBufferSize = 16384;
+    resources.limits.nonInductiveForLoops = true;
+    resources.limits.whileLoops = true;
+    resources.limits.doWhileLoops = true;
+    resources.limits.generalUniformIndexing = true;
+    resources.limits.generalAttributeMatrixVectorIndexing = true;
+    resources.limits.generalVaryingIndexing = true;
+    resources.limits.generalSamplerIndexing = true;
+    resources.limits.generalVariableIndexing = true;
+    resources.limits.generalConstantMatrixVectorIndexing = true;
+    return resources;
+}
+#endif
+
+bool
+ShaderCompiler::isSpirv(const char* data, size_t size)
+{
+    if (size < sizeof(uint32_t) || size % sizeof(uint32_t) != 0) {
+        return false;
+    }
+    uint32_t magicNumber;
+    std::memcpy(&magicNumber, data, sizeof(uint32_t));
+    return magicNumber == KP_SPIRV_MAGIC_NUMBER;
+}
+
+bool
+ShaderCompiler::isCompilationEnabled()
+{
+#if KOMPUTE_ENABLE_SHADER_COMPILATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::vector<char>
+ShaderCompiler::compileSource(const std::string& source)
+{
+    SPDLOG_DEBUG("Kompute ShaderCompiler compiling source of size: {}",
+                 source.size());
+
+#if KOMPUTE_ENABLE_SHADER_COMPILATION
+    static std::once_flag initializeFlag;
+    std::call_once(initializeFlag, []() { glslang::InitializeProcess(); });
+
+    // Subgroup operations require Vulkan 1.1 and SPIR-V 1.3
+    glslang::TShader shader(EShLangCompute);
+    const char* sources[] = { source.c_str() };
+    shader.setStrings(sources, 1);
+    shader.setEnvInput(
+      glslang::EShSourceGlsl, EShLangCompute, glslang::EShClientVulkan, 100);
+    shader.setEnvClient(glslang::EShClientVulkan,
+                        glslang::EShTargetVulkan_1_1);
+    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_3);
+
+    TBuiltInResource resources = computeShaderResources();
+    EShMessages messages =
+      static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules);
+
+    if (!shader.parse(&resources, 450, false, messages)) {
+        throw std::runtime_error(
+          std::string("Kompute ShaderCompiler failed to compile shader: ") +
+          shader.getInfoLog());
+    }
+
+    glslang::TProgram program;
+    program.addShader(&shader);
+    if (!program.link(messages)) {
+        throw std::runtime_error(
+          std::string("Kompute ShaderCompiler failed to link shader: ") +
+          program.getInfoLog());
+    }
+
+    std::vector<unsigned int> spirv;
+    glslang::GlslangToSpv(*program.getIntermediate(EShLangCompute), spirv);
+
+    std::vector<char> spirvData(spirv.size() * sizeof(unsigned int));
+    std::memcpy(spirvData.data(), spirv.data(), spirvData.size());
+
+    SPDLOG_DEBUG("Kompute ShaderCompiler compiled {} bytes of SPIR-V",
+                 spirvData.size());
+
+    return spirvData;
+#else
+    (void)source;
+    throw std::runtime_error(
+      "Kompute ShaderCompiler cannot compile GLSL source as Kompute was built "
+      "without KOMPUTE_OPT_ENABLE_SHADER_COMPILATION");
+#endif
+}
+
+std::vector<char>
+ShaderCompiler::toSpirv(const char* data, size_t size)
+{
+    if (isSpirv(data, size)) {
+        return std::vector<char>(data, data + size);
+    }
+
+    if (isCompilationEnabled()) {
+        return compileSource(std::string(data, size));
+    }
+
+    SPDLOG_WARN("Kompute ShaderCompiler shader is not SPIR-V and Kompute was "
+                "built without KOMPUTE_OPT_ENABLE_SHADER_COMPILATION, so it is "
+                "passed as GLSL source which requires VK_NV_glsl_shader");
+    return std::vector<char>(data, data + size);
+}
+
+}
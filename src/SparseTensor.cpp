@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <cstring>
+
+#include "kompute/SparseTensor.hpp"
+
+namespace kp {
+
+static std::vector<float>
+uintTensorData(const std::vector<uint32_t>& data)
+{
+    std::vector<float> tensorData(data.size());
+    std::memcpy(tensorData.data(), data.data(), data.size() * sizeof(uint32_t));
+    return tensorData;
+}
+
+static std::vector<uint32_t>
+tensorUintData(std::shared_ptr<Tensor> tensor)
+{
+    std::vector<uint32_t> data(tensor->size());
+    std::memcpy(data.data(), tensor->data().data(), data.size() * sizeof(float));
+    return data;
+}
+
+SparseTensor::SparseTensor()
+{
+    SPDLOG_DEBUG("Kompute SparseTensor base constructor");
+}
+
+SparseTensor::SparseTensor(uint32_t rows,
+                           uint32_t columns,
+                           const std::vector<uint32_t>& rowOffsets,
+                           const std::vector<uint32_t>& columnIndices,
+                           const std::vector<float>& values,
+                           SparseFormats format,
+                           Tensor::TensorTypes tensorType)
+{
+    SPDLOG_DEBUG("Kompute SparseTensor constructor rows: {}, columns: {}, "
+                 "non zeros: {}",
+                 rows,
+                 columns,
+                 values.size());
+
+    this->mFormat = format;
+    this->mRows = rows;
+    this->mColumns = columns;
+
+    this->initTensors(rowOffsets, columnIndices, values, tensorType);
+}
+
+SparseTensor::SparseTensor(const std::vector<float>& dense,
+                           uint32_t rows,
+                           uint32_t columns,
+                           SparseFormats format,
+                           Tensor::TensorTypes tensorType)
+{
+    SPDLOG_DEBUG("Kompute SparseTensor constructor from dense rows: {}, "
+                 "columns: {}",
+                 rows,
+                 columns);
+
+    if (dense.size() != (size_t)rows * columns) {
+        throw std::runtime_error(
+          "Kompute SparseTensor dense data of size " +
+          std::to_string(dense.size()) + " does not match " +
+          std::to_string(rows) + " rows of " + std::to_string(columns) +
+          " columns");
+    }
+
+    this->mFormat = format;
+    this->mRows = rows;
+    this->mColumns = columns;
+
+    std::vector<uint32_t> rowOffsets = { 0 };
+    std::vector<uint32_t> columnIndices;
+    std::vector<float> values;
+    for (uint32_t row = 0; row < rows; row++) {
+        for (uint32_t column = 0; column < columns; column++) {
+            float value = dense[(size_t)row * columns + column];
+            if (value != 0) {
+                columnIndices.push_back(column);
+                values.push_back(value);
+            }
+        }
+        rowOffsets.push_back(values.size());
+    }
+
+    this->initTensors(rowOffsets, columnIndices, values, tensorType);
+}
+
+void
+SparseTensor::initTensors(const std::vector<uint32_t>& rowOffsets,
+                          const std::vector<uint32_t>& columnIndices,
+                          const std::vector<float>& values,
+                          Tensor::TensorTypes tensorType)
+{
+    if (this->mRows == 0 || this->mColumns == 0) {
+        throw std::runtime_error(
+          "Kompute SparseTensor requires at least one row and column");
+    }
+    if (rowOffsets.size() != this->mRows + 1) {
+        throw std::runtime_error(
+          "Kompute SparseTensor expected " + std::to_string(this->mRows + 1) +
+          " row offsets but got " + std::to_string(rowOffsets.size()));
+    }
+    if (columnIndices.size() != values.size() || rowOffsets[0] != 0 ||
+        rowOffsets.back() != values.size()) {
+        throw std::runtime_error(
+          "Kompute SparseTensor row offsets must start at zero and end at the "
+          "number of column indices and values, which must be equal. "
+          "Column indices: " +
+          std::to_string(columnIndices.size()) +
+          " Values: " + std::to_string(values.size()));
+    }
+
+    uint32_t maxRowSize = 0;
+    for (uint32_t row = 0; row < this->mRows; row++) {
+        if (rowOffsets[row + 1] < rowOffsets[row]) {
+            throw std::runtime_error(
+              "Kompute SparseTensor row offsets must not decrease, found at "
+              "row " +
+              std::to_string(row));
+        }
+        maxRowSize =
+          std::max(maxRowSize, rowOffsets[row + 1] - rowOffsets[row]);
+    }
+    for (uint32_t column : columnIndices) {
+        if (column >= this->mColumns) {
+            throw std::runtime_error(
+              "Kompute SparseTensor column index " + std::to_string(column) +
+              " out of range for " + std::to_string(this->mColumns) +
+              " columns");
+        }
+    }
+
+    this->mNonZeros = values.size();
+
+    if (this->mFormat == SparseFormats::eCSR) {
+        // Tensors cannot be empty, so a matrix without non zero elements keeps
+        // a single unused element
+        std::vector<uint32_t> storedColumns = columnIndices;
+        std::vector<float> storedValues = values;
+        if (storedValues.empty()) {
+            storedColumns.push_back(0);
+            storedValues.push_back(0);
+        }
+
+        this->mEllWidth = 0;
+        this->mRowOffsets =
+          std::make_shared<Tensor>(uintTensorData(rowOffsets), tensorType);
+        this->mColumnIndices =
+          std::make_shared<Tensor>(uintTensorData(storedColumns), tensorType);
+        this->mValues = std::make_shared<Tensor>(storedValues, tensorType);
+        return;
+    }
+
+    uint32_t vectorSize = KP_SPARSE_ELL_VECTOR_SIZE;
+    this->mEllWidth =
+      std::max((maxRowSize + vectorSize - 1) / vectorSize, 1u) * vectorSize;
+
+    // The padding elements read the first column with a value of zero
+    size_t ellSize = (size_t)this->mRows * this->mEllWidth;
+    std::vector<uint32_t> ellColumns(ellSize, 0);
+    std::vector<float> ellValues(ellSize, 0);
+    for (uint32_t row = 0; row < this->mRows; row++) {
+        for (uint32_t i = rowOffsets[row]; i < rowOffsets[row + 1]; i++) {
+            uint32_t entry = i - rowOffsets[row];
+            size_t index =
+              ((size_t)(entry / vectorSize) * this->mRows + row) * vectorSize +
+              entry % vectorSize;
+            ellColumns[index] = columnIndices[i];
+            ellValues[index] = values[i];
+        }
+    }
+
+    this->mRowOffsets = nullptr;
+    this->mColumnIndices =
+      std::make_shared<Tensor>(uintTensorData(ellColumns), tensorType);
+    this->mValues = std::make_shared<Tensor>(ellValues, tensorType);
+
+    SPDLOG_DEBUG("Kompute SparseTensor ELL width {} for {} non zeros",
+                 this->mEllWidth,
+                 this->mNonZeros);
+}
+
+SparseTensor::SparseFormats
+SparseTensor::format()
+{
+    return this->mFormat;
+}
+
+uint32_t
+SparseTensor::rows()
+{
+    return this->mRows;
+}
+
+uint32_t
+SparseTensor::columns()
+{
+    return this->mColumns;
+}
+
+uint32_t
+SparseTensor::nonZeros()
+{
+    return this->mNonZeros;
+}
+
+uint32_t
+SparseTensor::ellWidth()
+{
+    return this->mEllWidth;
+}
+
+std::shared_ptr<Tensor>
+SparseTensor::rowOffsets()
+{
+    return this->mRowOffsets;
+}
+
+std::shared_ptr<Tensor>
+SparseTensor::columnIndices()
+{
+    return this->mColumnIndices;
+}
+
+std::shared_ptr<Tensor>
+SparseTensor::values()
+{
+    return this->mValues;
+}
+
+std::vector<std::shared_ptr<Tensor>>
+SparseTensor::tensors()
+{
+    if (this->mFormat == SparseFormats::eCSR) {
+        return { this->mRowOffsets, this->mColumnIndices, this->mValues };
+    }
+    return { this->mColumnIndices, this->mValues };
+}
+
+std::vector<float>
+SparseTensor::dense()
+{
+    std::vector<float> dense((size_t)this->mRows * this->mColumns, 0);
+    std::vector<uint32_t> columnIndices = tensorUintData(this->mColumnIndices);
+    std::vector<float>& values = this->mValues->data();
+
+    if (this->mFormat == SparseFormats::eCSR) {
+        std::vector<uint32_t> rowOffsets = tensorUintData(this->mRowOffsets);
+        for (uint32_t row = 0; row < this->mRows; row++) {
+            for (uint32_t i = rowOffsets[row]; i < rowOffsets[row + 1]; i++) {
+                dense[(size_t)row * this->mColumns + columnIndices[i]] +=
+                  values[i];
+            }
+        }
+        return dense;
+    }
+
+    uint32_t vectorSize = KP_SPARSE_ELL_VECTOR_SIZE;
+    for (uint32_t row = 0; row < this->mRows; row++) {
+        for (uint32_t entry = 0; entry < this->mEllWidth; entry++) {
+            size_t index =
+              ((size_t)(entry / vectorSize) * this->mRows + row) * vectorSize +
+              entry % vectorSize;
+            dense[(size_t)row * this->mColumns + columnIndices[index]] +=
+              values[index];
+        }
+    }
+    return dense;
+}
+
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 
 #include "kompute/Tensor.hpp"
 
@@ -9,7 +10,7 @@ Tensor::Tensor()
     this->mTensorType = TensorTypes::eDevice;
 }
 
-Tensor::Tensor(const std::vector<float>& data, TensorTypes tensorType)
+Tensor::Tensor(std::vector<float> data, TensorTypes tensorType)
 {
 #if DEBUG
     SPDLOG_DEBUG("Kompute Tensor constructor data length: {}, and type: {}",
@@ -17,8 +18,26 @@ Tensor::Tensor(const std::vector<float>& data, TensorTypes tensorType)
                  tensorType);
 #endif
 
-    this->mData = data;
     this->mShape = { static_cast<uint32_t>(data.size()) };
+    this->mData = std::move(data);
+    this->mTensorType = tensorType;
+}
+
+Tensor::Tensor(float* data, uint32_t size, TensorTypes tensorType)
+{
+    SPDLOG_DEBUG("Kompute Tensor host pointer constructor size: {}", size);
+
+    if (!data) {
+        throw std::runtime_error("Kompute Tensor host pointer is null");
+    }
+    if (tensorType == TensorTypes::eDevice) {
+        throw std::runtime_error(
+          "Kompute Tensor wrapping host memory must be of type "
+          "TensorTypes::eStaging or TensorTypes::eStorage");
+    }
+
+    this->mShape = { size };
+    this->mHostPointer = data;
     this->mTensorType = tensorType;
 }
 
@@ -27,7 +46,7 @@ Tensor::~Tensor()
     SPDLOG_DEBUG("Kompute Tensor destructor started. Type: {}",
                  this->tensorType());
 
-    if (this->isInit()) {
+    if (!this->mParent && this->isInit()) {
         this->freeMemoryDestroyGPUResources();
     }
 
@@ -36,14 +55,26 @@ Tensor::~Tensor()
 
 void
 Tensor::init(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
-             std::shared_ptr<vk::Device> device)
+             std::shared_ptr<vk::Device> device,
+             const std::vector<std::string>& enabledExtensions)
 {
     SPDLOG_DEBUG("Kompute Tensor running init with Vulkan params and num data "
                  "elementS: {}",
                  this->mData.size());
 
+    if (this->mParent) {
+        throw std::runtime_error(
+          "Kompute Tensor init called on a view, which is initialised with "
+          "its parent tensor");
+    }
+
     this->mPhysicalDevice = physicalDevice;
     this->mDevice = device;
+    this->mIsExternalMemoryHostEnabled =
+      std::find(enabledExtensions.begin(),
+                enabledExtensions.end(),
+                VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME) !=
+      enabledExtensions.end();
 
     this->mIsInit = true;
 
@@ -53,13 +84,19 @@ Tensor::init(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
 std::vector<float>&
 Tensor::data()
 {
+    // Views do not hold host data of their own, so the vector returned is
+    // refreshed from the range of the host data of the parent
+    if (this->mParent) {
+        const float* parentData = this->hostData();
+        this->mData.assign(parentData, parentData + this->size());
+    }
     return this->mData;
 }
 
 float&
 Tensor::operator[](int index)
 {
-    return this->mData[index];
+    return this->hostData()[index];
 }
 
 uint64_t
@@ -68,10 +105,20 @@ Tensor::memorySize()
     return this->size() * sizeof(float);
 }
 
+uint64_t
+Tensor::memoryOffset()
+{
+    return this->mOffset * sizeof(float);
+}
+
 uint32_t
 Tensor::size()
 {
-    return this->mShape[0];
+    uint32_t size = this->mShape[0];
+    for (uint32_t i = 1; i < KP_MAX_DIM_SIZE && this->mShape[i]; i++) {
+        size *= this->mShape[i];
+    }
+    return size;
 }
 
 std::array<uint32_t, KP_MAX_DIM_SIZE>
@@ -80,6 +127,29 @@ Tensor::shape()
     return this->mShape;
 }
 
+void
+Tensor::reshape(const std::vector<uint32_t>& shape)
+{
+    uint32_t size = shape.empty() ? 0 : 1;
+    for (uint32_t dimension : shape) {
+        if (dimension == 0) {
+            throw std::runtime_error(
+              "Kompute Tensor reshape dimensions must be larger than zero");
+        }
+        size *= dimension;
+    }
+    if (shape.size() > KP_MAX_DIM_SIZE || size != this->size()) {
+        throw std::runtime_error(
+          "Kompute Tensor reshape into " + std::to_string(shape.size()) +
+          " dimensions with " + std::to_string(size) +
+          " elements is not valid for a tensor of size " +
+          std::to_string(this->size()));
+    }
+
+    this->mShape = {};
+    std::copy(shape.begin(), shape.end(), this->mShape.begin());
+}
+
 Tensor::TensorTypes
 Tensor::tensorType()
 {
@@ -89,38 +159,217 @@ Tensor::tensorType()
 bool
 Tensor::isInit()
 {
+    if (this->mParent) {
+        return this->mParent->isInit();
+    }
     return this->mIsInit && this->mBuffer && this->mMemory;
 }
 
+std::shared_ptr<Tensor>
+Tensor::view(uint32_t offset, uint32_t size)
+{
+    SPDLOG_DEBUG("Kompute Tensor creating view with offset: {}, size: {}",
+                 offset,
+                 size);
+
+    if (size == 0 || offset + size > this->size()) {
+        throw std::runtime_error(
+          "Kompute Tensor view range out of bounds, offset: " +
+          std::to_string(offset) + " size: " + std::to_string(size) +
+          " tensor size: " + std::to_string(this->size()));
+    }
+
+    if (this->mHostPointer) {
+        throw std::runtime_error(
+          "Kompute Tensor views of tensors wrapping host memory are not "
+          "supported");
+    }
+
+    // Views always refer to the tensor owning the memory so the offsets of
+    // nested views do not need to be resolved recursively
+    std::shared_ptr<Tensor> parent = this->mParent;
+    uint32_t parentOffset = offset + this->mOffset;
+    if (!parent) {
+        try {
+            parent = this->shared_from_this();
+        } catch (const std::bad_weak_ptr&) {
+            throw std::runtime_error(
+              "Kompute Tensor view requires the tensor to be owned by a "
+              "shared pointer");
+        }
+    }
+
+    std::shared_ptr<Tensor> view = std::make_shared<Tensor>();
+    view->mParent = parent;
+    view->mOffset = parentOffset;
+    view->mShape = { size };
+    view->mTensorType = parent->mTensorType;
+    view->mFreeBuffer = false;
+    view->mFreeMemory = false;
+
+    return view;
+}
+
+bool
+Tensor::isView()
+{
+    return this->mParent != nullptr;
+}
+
+std::shared_ptr<Tensor>
+Tensor::parent()
+{
+    return this->mParent;
+}
+
+float*
+Tensor::hostPointer()
+{
+    return this->mHostPointer;
+}
+
+bool
+Tensor::isHostMemoryImported()
+{
+    return this->mIsHostMemoryImported;
+}
+
+bool
+Tensor::isUnifiedMemory()
+{
+    if (this->mParent) {
+        return this->mParent->mIsUnifiedMemory;
+    }
+    return this->mIsUnifiedMemory;
+}
+
 void
 Tensor::setData(const std::vector<float>& data)
 {
-    if (data.size() != this->mData.size()) {
+    if (data.size() != this->size()) {
         throw std::runtime_error(
           "Kompute Tensor Cannot set data of different sizes");
     }
+    if (this->mHostPointer || this->mParent) {
+        memcpy(this->hostData(), data.data(), this->memorySize());
+        return;
+    }
     this->mData = data;
 }
 
+void
+Tensor::setData(const std::vector<float>& data,
+                const std::vector<Range>& ranges)
+{
+    if (data.size() != this->size()) {
+        throw std::runtime_error(
+          "Kompute Tensor Cannot set data of different sizes");
+    }
+    this->validateRanges(ranges);
+
+    for (const Range& range : ranges) {
+        std::copy(data.begin() + range.offset,
+                  data.begin() + range.offset + range.size,
+                  this->hostData() + range.offset);
+    }
+}
+
+std::vector<Tensor::Range>
+Tensor::coalesceRanges(std::vector<Range> ranges)
+{
+    std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) {
+        return a.offset < b.offset;
+    });
+
+    std::vector<Range> coalescedRanges;
+    for (const Range& range : ranges) {
+        if (range.size == 0) {
+            continue;
+        }
+        if (!coalescedRanges.empty()) {
+            Range& lastRange = coalescedRanges.back();
+            uint32_t lastEnd = lastRange.offset + lastRange.size;
+            if (range.offset <= lastEnd) {
+                lastRange.size =
+                  std::max(lastEnd, range.offset + range.size) -
+                  lastRange.offset;
+                continue;
+            }
+        }
+        coalescedRanges.push_back(range);
+    }
+    return coalescedRanges;
+}
+
+void
+Tensor::markDirty(uint32_t offset, uint32_t size)
+{
+    this->validateRanges({ { offset, size } });
+
+    this->mDirtyRanges.push_back({ offset, size });
+    this->mDirtyRanges = Tensor::coalesceRanges(this->mDirtyRanges);
+}
+
+std::vector<Tensor::Range>
+Tensor::dirtyRanges()
+{
+    return this->mDirtyRanges;
+}
+
+void
+Tensor::clearDirtyRanges()
+{
+    this->mDirtyRanges.clear();
+}
+
+void
+Tensor::recordCopyFrom(std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                       std::shared_ptr<Tensor> copyFromTensor,
+                       bool createBarrier)
+{
+    this->recordCopyFrom(
+      commandBuffer, copyFromTensor, { { 0, this->size() } }, createBarrier);
+}
+
 void
 Tensor::recordCopyFrom(std::shared_ptr<vk::CommandBuffer> commandBuffer,
                        std::shared_ptr<Tensor> copyFromTensor,
+                       const std::vector<Range>& ranges,
                        bool createBarrier)
 {
-    SPDLOG_DEBUG("Kompute Tensor recordCopyFrom called");
+    SPDLOG_DEBUG("Kompute Tensor recordCopyFrom called with {} ranges",
+                 ranges.size());
 
-    if (!this->mIsInit || !copyFromTensor->mIsInit) {
+    if (!this->isInit() || !copyFromTensor->isInit()) {
         throw std::runtime_error(
           "Kompute Tensor attempted to run createBuffer without init");
     }
+    if (copyFromTensor->memorySize() < this->memorySize()) {
+        throw std::runtime_error(
+          "Kompute Tensor recordCopyFrom source tensor is smaller than the "
+          "destination tensor");
+    }
+    this->validateRanges(ranges);
+
+    std::vector<vk::BufferCopy> copyRegions;
+    for (const Range& range : ranges) {
+        vk::DeviceSize rangeOffset = range.offset * sizeof(float);
+        copyRegions.push_back(
+          vk::BufferCopy(copyFromTensor->memoryOffset() + rangeOffset,
+                         this->memoryOffset() + rangeOffset,
+                         range.size * sizeof(float)));
+    }
 
-    vk::DeviceSize bufferSize(this->memorySize());
-    vk::BufferCopy copyRegion(0, 0, bufferSize);
+    if (copyRegions.empty()) {
+        SPDLOG_DEBUG("Kompute Tensor recordCopyFrom skipped with no ranges");
+        return;
+    }
 
-    SPDLOG_DEBUG("Kompute Tensor copying data size {}.", bufferSize);
+    SPDLOG_DEBUG("Kompute Tensor copying data with {} regions.",
+                 copyRegions.size());
 
     commandBuffer->copyBuffer(
-      *copyFromTensor->mBuffer, *this->mBuffer, copyRegion);
+      *copyFromTensor->getBuffer(), *this->getBuffer(), copyRegions);
 
     if (createBarrier) {
         // Buffer to ensure wait until data is copied to staging buffer
@@ -132,6 +381,48 @@ Tensor::recordCopyFrom(std::shared_ptr<vk::CommandBuffer> commandBuffer,
     }
 }
 
+void
+Tensor::recordCopyFromBuffer(std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                             const vk::Buffer& buffer,
+                             const std::vector<vk::BufferCopy>& copyRegions)
+{
+    SPDLOG_DEBUG("Kompute Tensor recordCopyFromBuffer called with {} regions",
+                 copyRegions.size());
+
+    if (!this->isInit()) {
+        throw std::runtime_error(
+          "Kompute Tensor attempted to run recordCopyFromBuffer without init");
+    }
+
+    std::vector<vk::BufferCopy> tensorCopyRegions = copyRegions;
+    for (vk::BufferCopy& copyRegion : tensorCopyRegions) {
+        copyRegion.dstOffset += this->memoryOffset();
+    }
+
+    commandBuffer->copyBuffer(buffer, *this->getBuffer(), tensorCopyRegions);
+}
+
+void
+Tensor::recordCopyToBuffer(std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                           const vk::Buffer& buffer,
+                           const std::vector<vk::BufferCopy>& copyRegions)
+{
+    SPDLOG_DEBUG("Kompute Tensor recordCopyToBuffer called with {} regions",
+                 copyRegions.size());
+
+    if (!this->isInit()) {
+        throw std::runtime_error(
+          "Kompute Tensor attempted to run recordCopyToBuffer without init");
+    }
+
+    std::vector<vk::BufferCopy> tensorCopyRegions = copyRegions;
+    for (vk::BufferCopy& copyRegion : tensorCopyRegions) {
+        copyRegion.srcOffset += this->memoryOffset();
+    }
+
+    commandBuffer->copyBuffer(*this->getBuffer(), buffer, tensorCopyRegions);
+}
+
 void
 Tensor::recordBufferMemoryBarrier(
   std::shared_ptr<vk::CommandBuffer> commandBuffer,
@@ -145,7 +436,8 @@ Tensor::recordBufferMemoryBarrier(
     vk::DeviceSize bufferSize = this->memorySize();
 
     vk::BufferMemoryBarrier bufferMemoryBarrier;
-    bufferMemoryBarrier.buffer = *this->mBuffer;
+    bufferMemoryBarrier.buffer = *this->getBuffer();
+    bufferMemoryBarrier.offset = this->memoryOffset();
     bufferMemoryBarrier.size = bufferSize;
     bufferMemoryBarrier.srcAccessMask = srcAccessMask;
     bufferMemoryBarrier.dstAccessMask = dstAccessMask;
@@ -164,57 +456,172 @@ vk::DescriptorBufferInfo
 Tensor::constructDescriptorBufferInfo()
 {
     vk::DeviceSize bufferSize = this->memorySize();
-    return vk::DescriptorBufferInfo(*this->mBuffer,
-                                    0, // offset
-                                    bufferSize);
+    vk::DeviceSize bufferOffset = this->memoryOffset();
+
+    if (this->mParent && bufferOffset > 0) {
+        vk::DeviceSize minOffsetAlignment =
+          this->mParent->mPhysicalDevice->getProperties()
+            .limits.minStorageBufferOffsetAlignment;
+        if (bufferOffset % minOffsetAlignment != 0) {
+            throw std::runtime_error(
+              "Kompute Tensor view offset of " + std::to_string(bufferOffset) +
+              " bytes is not aligned to the minimum storage buffer offset "
+              "alignment of " +
+              std::to_string(minOffsetAlignment) + " bytes");
+        }
+    }
+
+    return vk::DescriptorBufferInfo(
+      *this->getBuffer(), bufferOffset, bufferSize);
 }
 
 void
 Tensor::mapDataFromHostMemory()
+{
+    this->mapDataFromHostMemory({ { 0, this->size() } });
+}
+
+void
+Tensor::mapDataFromHostMemory(const std::vector<Range>& ranges)
 {
     SPDLOG_DEBUG("Kompute Tensor mapping data from host buffer");
 
-    if (this->mTensorType != TensorTypes::eStaging) {
+    if (this->mIsHostMemoryImported) {
+        SPDLOG_DEBUG("Kompute Tensor skipping map of imported host memory");
+        return;
+    }
+    if (this->mTensorType != TensorTypes::eStaging && !this->mHostPointer &&
+        !this->isUnifiedMemory()) {
         SPDLOG_ERROR(
           "Mapping tensor data manually from DEVICE buffer instead of "
           "using record GPU command with staging buffer");
         return;
     }
-
-    vk::DeviceSize bufferSize = this->memorySize();
-    void* mapped = this->mDevice->mapMemory(
-      *this->mMemory, 0, bufferSize, vk::MemoryMapFlags());
-    vk::MappedMemoryRange mappedMemoryRange(*this->mMemory, 0, bufferSize);
-    this->mDevice->invalidateMappedMemoryRanges(mappedMemoryRange);
-    memcpy(this->mData.data(), mapped, bufferSize);
-    this->mDevice->unmapMemory(*this->mMemory);
+    this->validateRanges(ranges);
+
+    std::shared_ptr<vk::Device> device = this->getDevice();
+    std::shared_ptr<vk::DeviceMemory> memory = this->getMemory();
+
+    // The whole memory is mapped and invalidated as the ranges are not
+    // necessarily aligned to the non coherent atom size of the device
+    void* mapped =
+      device->mapMemory(*memory, 0, VK_WHOLE_SIZE, vk::MemoryMapFlags());
+    vk::MappedMemoryRange mappedMemoryRange(*memory, 0, VK_WHOLE_SIZE);
+    device->invalidateMappedMemoryRanges(mappedMemoryRange);
+    const float* mappedData = reinterpret_cast<const float*>(
+      static_cast<char*>(mapped) + this->memoryOffset());
+    for (const Range& range : ranges) {
+        memcpy(this->hostData() + range.offset,
+               mappedData + range.offset,
+               range.size * sizeof(float));
+    }
+    device->unmapMemory(*memory);
 }
 
 void
 Tensor::mapDataIntoHostMemory()
+{
+    this->mapDataIntoHostMemory({ { 0, this->size() } });
+}
+
+void
+Tensor::mapDataIntoHostMemory(const std::vector<Range>& ranges)
 {
 
     SPDLOG_DEBUG("Kompute Tensor local mapping tensor data to host buffer");
 
-    if (this->mTensorType != TensorTypes::eStaging) {
+    if (this->mIsHostMemoryImported) {
+        SPDLOG_DEBUG("Kompute Tensor skipping map of imported host memory");
+        return;
+    }
+    if (this->mTensorType != TensorTypes::eStaging && !this->mHostPointer &&
+        !this->isUnifiedMemory()) {
         SPDLOG_ERROR("Mapping tensor data manually to DEVICE memory instead of "
                      "using record GPU command with staging buffer");
         return;
     }
+    this->validateRanges(ranges);
+
+    std::shared_ptr<vk::Device> device = this->getDevice();
+    std::shared_ptr<vk::DeviceMemory> memory = this->getMemory();
+
+    void* mapped =
+      device->mapMemory(*memory, 0, VK_WHOLE_SIZE, vk::MemoryMapFlags());
+    float* mappedData = reinterpret_cast<float*>(static_cast<char*>(mapped) +
+                                                 this->memoryOffset());
+    for (const Range& range : ranges) {
+        memcpy(mappedData + range.offset,
+               this->hostData() + range.offset,
+               range.size * sizeof(float));
+    }
+    vk::MappedMemoryRange mappedRange(*memory, 0, VK_WHOLE_SIZE);
+    device->flushMappedMemoryRanges(1, &mappedRange);
+    device->unmapMemory(*memory);
+}
+
+std::shared_ptr<vk::Buffer>
+Tensor::getBuffer()
+{
+    if (this->mParent) {
+        return this->mParent->mBuffer;
+    }
+    return this->mBuffer;
+}
 
-    vk::DeviceSize bufferSize = this->memorySize();
+std::shared_ptr<vk::DeviceMemory>
+Tensor::getMemory()
+{
+    if (this->mParent) {
+        return this->mParent->mMemory;
+    }
+    return this->mMemory;
+}
 
-    void* mapped = this->mDevice->mapMemory(
-      *this->mMemory, 0, bufferSize, vk::MemoryMapFlags());
-    memcpy(mapped, this->mData.data(), bufferSize);
-    vk::MappedMemoryRange mappedRange(*this->mMemory, 0, bufferSize);
-    this->mDevice->flushMappedMemoryRanges(1, &mappedRange);
-    this->mDevice->unmapMemory(*this->mMemory);
+std::shared_ptr<vk::Device>
+Tensor::getDevice()
+{
+    if (this->mParent) {
+        return this->mParent->mDevice;
+    }
+    return this->mDevice;
+}
+
+float*
+Tensor::hostData()
+{
+    if (this->mParent) {
+        return this->mParent->hostData() + this->mOffset;
+    }
+    if (this->mHostPointer) {
+        return this->mHostPointer;
+    }
+    return this->mData.data();
+}
+
+void
+Tensor::validateRanges(const std::vector<Range>& ranges)
+{
+    for (const Range& range : ranges) {
+        if (range.offset + range.size > this->size()) {
+            throw std::runtime_error(
+              "Kompute Tensor range out of bounds, offset: " +
+              std::to_string(range.offset) +
+              " size: " + std::to_string(range.size) +
+              " tensor size: " + std::to_string(this->size()));
+        }
+    }
 }
 
 vk::BufferUsageFlags
 Tensor::getBufferUsageFlags()
 {
+    // Host memory can be bound to shaders as well as used to transfer data
+    if (this->mHostPointer) {
+        return vk::BufferUsageFlagBits::eStorageBuffer |
+               vk::BufferUsageFlagBits::eTransferSrc |
+               vk::BufferUsageFlagBits::eTransferDst;
+    }
+
     switch (this->mTensorType) {
         case TensorTypes::eDevice:
             return vk::BufferUsageFlagBits::eStorageBuffer |
@@ -236,6 +643,10 @@ Tensor::getBufferUsageFlags()
 vk::MemoryPropertyFlags
 Tensor::getMemoryPropertyFlags()
 {
+    if (this->mHostPointer) {
+        return vk::MemoryPropertyFlagBits::eHostVisible;
+    }
+
     switch (this->mTensorType) {
         case TensorTypes::eDevice:
             return vk::MemoryPropertyFlagBits::eDeviceLocal;
@@ -268,6 +679,10 @@ Tensor::createBuffer()
         throw std::runtime_error("Kompute Tensor device is null");
     }
 
+    if (this->mHostPointer && this->createHostPointerBuffer()) {
+        return;
+    }
+
     this->mFreeBuffer = true;
 
     vk::BufferUsageFlags usageFlags = this->getBufferUsageFlags();
@@ -298,16 +713,39 @@ Tensor::createBuffer()
       this->getMemoryPropertyFlags();
 
     uint32_t memoryTypeIndex = -1;
-    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
-        if (memoryRequirements.memoryTypeBits & (1 << i)) {
-            if ((memoryProperties.memoryTypes[i].propertyFlags &
-                 memoryPropertyFlags) == memoryPropertyFlags) {
-                memoryTypeIndex = i;
-                break;
+
+#ifndef KOMPUTE_DISABLE_UNIFIED_MEMORY
+    // Device tensors are allocated in memory that is also host visible when
+    // available, so they can be mapped directly instead of through staging
+    if (this->mTensorType == TensorTypes::eDevice) {
+        uint32_t unifiedMemoryTypeIndex =
+          this->findUnifiedMemoryTypeIndex(memoryProperties,
+                                           memoryRequirements.memoryTypeBits);
+        if (unifiedMemoryTypeIndex < memoryProperties.memoryTypeCount) {
+            memoryTypeIndex = unifiedMemoryTypeIndex;
+            memoryPropertyFlags =
+              memoryProperties.memoryTypes[unifiedMemoryTypeIndex]
+                .propertyFlags;
+            this->mIsUnifiedMemory = true;
+        } else {
+            SPDLOG_DEBUG("Kompute Tensor no host visible device local memory "
+                         "type found, falling back to the staging tensor");
+        }
+    }
+#endif
+
+    if (memoryTypeIndex == (uint32_t)-1) {
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+            if (memoryRequirements.memoryTypeBits & (1 << i)) {
+                if ((memoryProperties.memoryTypes[i].propertyFlags &
+                     memoryPropertyFlags) == memoryPropertyFlags) {
+                    memoryTypeIndex = i;
+                    break;
+                }
             }
         }
     }
-    if (memoryTypeIndex < 0) {
+    if (memoryTypeIndex == (uint32_t)-1) {
         throw std::runtime_error(
           "Memory type index for buffer creation not found");
     }
@@ -332,12 +770,183 @@ Tensor::createBuffer()
     SPDLOG_DEBUG("Kompute Tensor buffer & memory creation successful");
 }
 
+uint32_t
+Tensor::findUnifiedMemoryTypeIndex(
+  const vk::PhysicalDeviceMemoryProperties& memoryProperties,
+  uint32_t memoryTypeBits)
+{
+    vk::MemoryPropertyFlags unifiedMemoryPropertyFlags =
+      vk::MemoryPropertyFlagBits::eDeviceLocal |
+      vk::MemoryPropertyFlagBits::eHostVisible;
+
+    vk::DeviceSize largestDeviceLocalHeapSize = 0;
+    for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+        if (memoryProperties.memoryHeaps[i].flags &
+            vk::MemoryHeapFlagBits::eDeviceLocal) {
+            largestDeviceLocalHeapSize =
+              std::max(largestDeviceLocalHeapSize,
+                       memoryProperties.memoryHeaps[i].size);
+        }
+    }
+
+    // Discrete devices without resizable BAR only expose a small host
+    // visible window of the device memory, which is not used for tensors
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        const vk::MemoryType& memoryType = memoryProperties.memoryTypes[i];
+        if ((memoryTypeBits & (1 << i)) &&
+            (memoryType.propertyFlags & unifiedMemoryPropertyFlags) ==
+              unifiedMemoryPropertyFlags &&
+            memoryProperties.memoryHeaps[memoryType.heapIndex].size >=
+              largestDeviceLocalHeapSize) {
+            return i;
+        }
+    }
+    return memoryProperties.memoryTypeCount;
+}
+
+bool
+Tensor::createHostPointerBuffer()
+{
+    SPDLOG_DEBUG("Kompute Tensor importing host pointer as buffer memory");
+
+    // The manager enables the extension when the device supports it
+    if (!this->mIsExternalMemoryHostEnabled) {
+        SPDLOG_WARN("Kompute Tensor {} is not enabled in the device, falling "
+                    "back to copying the host memory",
+                    VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+        return false;
+    }
+    PFN_vkGetMemoryHostPointerPropertiesEXT getMemoryHostPointerProperties =
+      reinterpret_cast<PFN_vkGetMemoryHostPointerPropertiesEXT>(
+        vkGetDeviceProcAddr(*this->mDevice,
+                            "vkGetMemoryHostPointerPropertiesEXT"));
+    if (!getMemoryHostPointerProperties) {
+        SPDLOG_WARN("Kompute Tensor vkGetMemoryHostPointerPropertiesEXT could "
+                    "not be loaded, falling back to copying the host memory");
+        return false;
+    }
+
+    vk::DeviceSize hostPointerAlignment =
+      this->mPhysicalDevice
+        ->getProperties2<vk::PhysicalDeviceProperties2,
+                         vk::PhysicalDeviceExternalMemoryHostPropertiesEXT>()
+        .get<vk::PhysicalDeviceExternalMemoryHostPropertiesEXT>()
+        .minImportedHostPointerAlignment;
+    if (reinterpret_cast<uintptr_t>(this->mHostPointer) %
+          hostPointerAlignment !=
+        0) {
+        SPDLOG_WARN("Kompute Tensor host pointer is not aligned to {} bytes, "
+                    "falling back to copying the host memory",
+                    hostPointerAlignment);
+        return false;
+    }
+    // Rounding the size up instead would import memory past the end of the
+    // host memory provided
+    if (this->memorySize() % hostPointerAlignment != 0) {
+        SPDLOG_WARN("Kompute Tensor host memory size {} is not a multiple of "
+                    "{} bytes, falling back to copying the host memory",
+                    this->memorySize(),
+                    hostPointerAlignment);
+        return false;
+    }
+
+    VkMemoryHostPointerPropertiesEXT hostPointerProperties = {};
+    hostPointerProperties.sType =
+      VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT;
+    VkResult result = getMemoryHostPointerProperties(
+      *this->mDevice,
+      VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT,
+      this->mHostPointer,
+      &hostPointerProperties);
+    if (result != VK_SUCCESS) {
+        SPDLOG_WARN("Kompute Tensor host pointer properties could not be "
+                    "retrieved, falling back to copying the host memory");
+        return false;
+    }
+
+    vk::ExternalMemoryBufferCreateInfo externalMemoryBufferInfo(
+      vk::ExternalMemoryHandleTypeFlagBits::eHostAllocationEXT);
+
+    vk::BufferCreateInfo bufferInfo(vk::BufferCreateFlags(),
+                                    this->memorySize(),
+                                    this->getBufferUsageFlags(),
+                                    vk::SharingMode::eExclusive);
+    bufferInfo.pNext = &externalMemoryBufferInfo;
+
+    std::shared_ptr<vk::Buffer> buffer = std::make_shared<vk::Buffer>();
+    this->mDevice->createBuffer(&bufferInfo, nullptr, buffer.get());
+
+    vk::MemoryRequirements memoryRequirements =
+      this->mDevice->getBufferMemoryRequirements(*buffer);
+
+    uint32_t memoryTypeBits =
+      memoryRequirements.memoryTypeBits & hostPointerProperties.memoryTypeBits;
+    if (memoryRequirements.size > this->memorySize()) {
+        SPDLOG_WARN("Kompute Tensor buffer requires {} bytes which is more "
+                    "than the host memory, falling back to copying the host "
+                    "memory",
+                    memoryRequirements.size);
+        this->mDevice->destroy(
+          *buffer, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        return false;
+    }
+    if (!memoryTypeBits) {
+        SPDLOG_WARN("Kompute Tensor no memory type can import the host "
+                    "pointer, falling back to copying the host memory");
+        this->mDevice->destroy(
+          *buffer, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        return false;
+    }
+    uint32_t memoryTypeIndex = 0;
+    while (!(memoryTypeBits & (1 << memoryTypeIndex))) {
+        memoryTypeIndex++;
+    }
+
+    vk::DeviceSize allocationSize = this->memorySize();
+
+    SPDLOG_DEBUG("Kompute Tensor importing host memory index: {}, size {}",
+                 memoryTypeIndex,
+                 allocationSize);
+
+    vk::ImportMemoryHostPointerInfoEXT importMemoryHostPointerInfo(
+      vk::ExternalMemoryHandleTypeFlagBits::eHostAllocationEXT,
+      this->mHostPointer);
+
+    vk::MemoryAllocateInfo memoryAllocateInfo(allocationSize,
+                                              memoryTypeIndex);
+    memoryAllocateInfo.pNext = &importMemoryHostPointerInfo;
+
+    this->mBuffer = buffer;
+    this->mFreeBuffer = true;
+
+    this->mMemory = std::make_shared<vk::DeviceMemory>();
+    this->mDevice->allocateMemory(
+      &memoryAllocateInfo, nullptr, this->mMemory.get());
+    this->mFreeMemory = true;
+
+    this->mDevice->bindBufferMemory(*this->mBuffer, *this->mMemory, 0);
+
+    this->mIsHostMemoryImported = true;
+
+    SPDLOG_DEBUG("Kompute Tensor host memory import successful");
+
+    return true;
+}
+
 void
 Tensor::freeMemoryDestroyGPUResources()
 {
     SPDLOG_DEBUG("Kompute Tensor started freeMemoryDestroyGPUResources");
 
+    if (this->mParent) {
+        SPDLOG_WARN("Kompute Tensor freeMemoryDestroyGPUResources called on a "
+                    "view, which does not own any GPU resources");
+        return;
+    }
+
     this->mIsInit = false;
+    this->mIsHostMemoryImported = false;
+    this->mIsUnifiedMemory = false;
 
     if (!this->mDevice) {
         SPDLOG_ERROR(
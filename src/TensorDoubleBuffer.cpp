@@ -0,0 +1,86 @@
+
+#include "kompute/TensorDoubleBuffer.hpp"
+
+namespace kp {
+
+TensorDoubleBuffer::TensorDoubleBuffer()
+{
+    SPDLOG_DEBUG("Kompute TensorDoubleBuffer base constructor");
+}
+
+TensorDoubleBuffer::TensorDoubleBuffer(const std::vector<float>& data,
+                                       Tensor::TensorTypes tensorType)
+{
+    SPDLOG_DEBUG("Kompute TensorDoubleBuffer constructor data length: {}",
+                 data.size());
+
+    this->mTensors[0] = std::make_shared<Tensor>(data, tensorType);
+    this->mTensors[1] = std::make_shared<Tensor>(data, tensorType);
+}
+
+TensorDoubleBuffer::TensorDoubleBuffer(std::shared_ptr<Tensor> front,
+                                       std::shared_ptr<Tensor> back)
+{
+    SPDLOG_DEBUG("Kompute TensorDoubleBuffer constructor with tensors");
+
+    if (!front || !back) {
+        throw std::runtime_error(
+          "Kompute TensorDoubleBuffer provided with null tensor");
+    }
+    if (front == back) {
+        throw std::runtime_error(
+          "Kompute TensorDoubleBuffer requires two different tensors");
+    }
+    if (front->size() != back->size()) {
+        throw std::runtime_error(
+          "Kompute TensorDoubleBuffer tensors must have the same size " +
+          std::to_string(front->size()) + " and " +
+          std::to_string(back->size()));
+    }
+
+    this->mTensors[0] = front;
+    this->mTensors[1] = back;
+}
+
+std::shared_ptr<Tensor>
+TensorDoubleBuffer::read()
+{
+    return this->mTensors[this->mReadIndex];
+}
+
+std::shared_ptr<Tensor>
+TensorDoubleBuffer::write()
+{
+    return this->mTensors[1 - this->mReadIndex];
+}
+
+std::shared_ptr<Tensor>
+TensorDoubleBuffer::tensor(uint32_t index)
+{
+    if (index > 1) {
+        throw std::runtime_error(
+          "Kompute TensorDoubleBuffer index out of range: " +
+          std::to_string(index));
+    }
+    return this->mTensors[index];
+}
+
+std::vector<std::shared_ptr<Tensor>>
+TensorDoubleBuffer::tensors()
+{
+    return { this->mTensors[0], this->mTensors[1] };
+}
+
+uint32_t
+TensorDoubleBuffer::readIndex()
+{
+    return this->mReadIndex;
+}
+
+void
+TensorDoubleBuffer::swap()
+{
+    this->mReadIndex = 1 - this->mReadIndex;
+}
+
+}
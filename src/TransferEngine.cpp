@@ -0,0 +1,664 @@
+#include <algorithm>
+#include <cstring>
+
+#include "kompute/TransferEngine.hpp"
+
+namespace kp {
+
+TransferEngine::TransferEngine()
+{
+    SPDLOG_DEBUG("Kompute TransferEngine base constructor");
+}
+
+TransferEngine::TransferEngine(
+  std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+  std::shared_ptr<vk::Device> device,
+  std::shared_ptr<vk::Queue> queue,
+  uint32_t queueIndex,
+  uint64_t chunkSize,
+  uint32_t numChunks,
+  std::shared_ptr<std::mutex> queueMutex)
+{
+    SPDLOG_DEBUG("Kompute TransferEngine constructor with chunk size: {}, "
+                 "and num chunks: {}",
+                 chunkSize,
+                 numChunks);
+
+    this->mPhysicalDevice = physicalDevice;
+    this->mDevice = device;
+    this->mQueue = queue;
+    this->mQueueIndex = queueIndex;
+    this->mQueueMutex = queueMutex;
+
+    // Chunks hold whole tensor elements so each copy region stays aligned
+    this->mChunkSize = std::max<uint64_t>(
+      chunkSize - chunkSize % sizeof(float), sizeof(float));
+    this->mNumChunks = numChunks > 0 ? numChunks : 1;
+}
+
+TransferEngine::~TransferEngine()
+{
+    SPDLOG_DEBUG("Kompute TransferEngine destructor started");
+
+    if (this->mIsInit) {
+        this->freeMemoryDestroyGPUResources();
+    }
+}
+
+void
+TransferEngine::init()
+{
+    SPDLOG_DEBUG("Kompute TransferEngine init called");
+
+    if (this->mIsInit) {
+        SPDLOG_WARN("Kompute TransferEngine init called when already init");
+        return;
+    }
+
+    if (!this->mPhysicalDevice) {
+        throw std::runtime_error(
+          "Kompute TransferEngine physical device is null");
+    }
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute TransferEngine device is null");
+    }
+    if (!this->mQueue) {
+        throw std::runtime_error("Kompute TransferEngine queue is null");
+    }
+
+    this->createCommandPool();
+
+    this->mStagingChunks.resize(this->mNumChunks);
+    for (StagingChunk& stagingChunk : this->mStagingChunks) {
+        this->createStagingChunk(stagingChunk);
+    }
+
+    this->mIsStopping = false;
+    this->mIsInit = true;
+
+    this->mWorker = std::thread(&TransferEngine::runWorker, this);
+}
+
+std::future<void>
+TransferEngine::uploadAsync(std::vector<std::shared_ptr<Tensor>> tensors)
+{
+    SPDLOG_DEBUG("Kompute TransferEngine uploadAsync called with {} tensors",
+                 tensors.size());
+
+    return this->enqueue([this, tensors]() {
+        for (const std::shared_ptr<Tensor>& tensor : tensors) {
+            this->uploadTensor(tensor);
+        }
+        this->waitAllStagingChunks();
+    });
+}
+
+std::future<void>
+TransferEngine::downloadAsync(std::vector<std::shared_ptr<Tensor>> tensors)
+{
+    SPDLOG_DEBUG("Kompute TransferEngine downloadAsync called with {} tensors",
+                 tensors.size());
+
+    return this->enqueue([this, tensors]() {
+        for (const std::shared_ptr<Tensor>& tensor : tensors) {
+            this->downloadTensor(tensor);
+        }
+        this->waitAllStagingChunks();
+    });
+}
+
+void
+TransferEngine::upload(std::vector<std::shared_ptr<Tensor>> tensors)
+{
+    this->uploadAsync(tensors).get();
+}
+
+void
+TransferEngine::download(std::vector<std::shared_ptr<Tensor>> tensors)
+{
+    this->downloadAsync(tensors).get();
+}
+
+std::future<void>
+TransferEngine::copyToAsync(std::shared_ptr<Tensor> srcTensor,
+                            std::shared_ptr<TransferEngine> dstEngine,
+                            std::shared_ptr<Tensor> dstTensor)
+{
+    SPDLOG_DEBUG("Kompute TransferEngine copyToAsync called");
+
+    if (!srcTensor || !dstTensor || !dstEngine) {
+        throw std::runtime_error(
+          "Kompute TransferEngine copyToAsync called with null parameters");
+    }
+    if (srcTensor->memorySize() != dstTensor->memorySize()) {
+        throw std::runtime_error(
+          "Kompute TransferEngine copyToAsync tensors have different sizes");
+    }
+
+    // The uploads are queued in the destination engine as chunks arrive, and
+    // are awaited by the returned future rather than by the worker, so
+    // engines copying into each other concurrently do not wait on each other
+    std::shared_ptr<PendingUploads> uploads =
+      std::make_shared<PendingUploads>();
+    std::future<void> future =
+      this->enqueue([this, srcTensor, dstEngine, dstTensor, uploads]() {
+          this->copyTensor(srcTensor, dstEngine, dstTensor, uploads);
+      });
+    std::shared_future<void> copyFuture = future.share();
+
+    return std::async(std::launch::deferred, [copyFuture, uploads]() {
+        std::exception_ptr exception;
+        try {
+            copyFuture.get();
+        } catch (...) {
+            exception = std::current_exception();
+        }
+        // The copy runs the callbacks of all its chunks before it finishes,
+        // even when it fails, so no upload is queued after this point
+        std::vector<std::future<void>> futures;
+        {
+            std::lock_guard<std::mutex> lock(uploads->mutex);
+            futures.swap(uploads->futures);
+        }
+        for (std::future<void>& upload : futures) {
+            try {
+                upload.get();
+            } catch (...) {
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+            }
+        }
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    });
+}
+
+void
+TransferEngine::copyTo(std::shared_ptr<Tensor> srcTensor,
+                       std::shared_ptr<TransferEngine> dstEngine,
+                       std::shared_ptr<Tensor> dstTensor)
+{
+    this->copyToAsync(srcTensor, dstEngine, dstTensor).get();
+}
+
+uint64_t
+TransferEngine::chunkSize()
+{
+    return this->mChunkSize;
+}
+
+uint32_t
+TransferEngine::numChunks()
+{
+    return this->mNumChunks;
+}
+
+bool
+TransferEngine::isInit()
+{
+    return this->mIsInit;
+}
+
+void
+TransferEngine::freeMemoryDestroyGPUResources()
+{
+    SPDLOG_DEBUG("Kompute TransferEngine freeMemoryDestroyGPUResources called");
+
+    if (!this->mIsInit) {
+        SPDLOG_ERROR("Kompute TransferEngine freeMemoryDestroyGPUResources "
+                     "called but engine is not initialized");
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mIsStopping = true;
+    }
+    this->mCondition.notify_all();
+
+    // The worker drains the queued transfers before it finishes
+    if (this->mWorker.joinable()) {
+        this->mWorker.join();
+    }
+
+    this->mIsInit = false;
+
+    if (!this->mDevice) {
+        SPDLOG_ERROR("Kompute TransferEngine freeMemoryDestroyGPUResources "
+                     "called with null Device pointer");
+        return;
+    }
+
+    for (StagingChunk& stagingChunk : this->mStagingChunks) {
+        if (stagingChunk.isInFlight) {
+            this->mDevice->waitForFences(
+              1, &stagingChunk.fence, VK_TRUE, UINT64_MAX);
+        }
+        this->mDevice->unmapMemory(stagingChunk.memory);
+        this->mDevice->destroy(
+          stagingChunk.fence,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mDevice->freeCommandBuffers(
+          *this->mCommandPool, 1, stagingChunk.commandBuffer.get());
+        this->mDevice->destroy(
+          stagingChunk.buffer,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mDevice->freeMemory(
+          stagingChunk.memory,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    this->mStagingChunks.clear();
+
+    if (this->mCommandPool) {
+        this->mDevice->destroy(
+          *this->mCommandPool,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mCommandPool = nullptr;
+    }
+
+    SPDLOG_DEBUG("Kompute TransferEngine destroyed GPU resources");
+}
+
+void
+TransferEngine::createCommandPool()
+{
+    SPDLOG_DEBUG("Kompute TransferEngine creating command pool");
+
+    // Command buffers are re-recorded for every chunk
+    vk::CommandPoolCreateInfo commandPoolInfo(
+      vk::CommandPoolCreateFlagBits::eResetCommandBuffer, this->mQueueIndex);
+    this->mCommandPool = std::make_shared<vk::CommandPool>();
+    this->mDevice->createCommandPool(
+      &commandPoolInfo, nullptr, this->mCommandPool.get());
+}
+
+void
+TransferEngine::createStagingChunk(StagingChunk& stagingChunk)
+{
+    SPDLOG_DEBUG("Kompute TransferEngine creating staging chunk of size: {}",
+                 this->mChunkSize);
+
+    vk::BufferCreateInfo bufferInfo(vk::BufferCreateFlags(),
+                                    this->mChunkSize,
+                                    vk::BufferUsageFlagBits::eTransferSrc |
+                                      vk::BufferUsageFlagBits::eTransferDst,
+                                    vk::SharingMode::eExclusive);
+    this->mDevice->createBuffer(&bufferInfo, nullptr, &stagingChunk.buffer);
+
+    vk::PhysicalDeviceMemoryProperties memoryProperties =
+      this->mPhysicalDevice->getMemoryProperties();
+
+    vk::MemoryRequirements memoryRequirements =
+      this->mDevice->getBufferMemoryRequirements(stagingChunk.buffer);
+
+    vk::MemoryPropertyFlags memoryPropertyFlags =
+      vk::MemoryPropertyFlagBits::eHostVisible;
+
+    uint32_t memoryTypeIndex = -1;
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        if (memoryRequirements.memoryTypeBits & (1 << i)) {
+            if ((memoryProperties.memoryTypes[i].propertyFlags &
+                 memoryPropertyFlags) == memoryPropertyFlags) {
+                memoryTypeIndex = i;
+                break;
+            }
+        }
+    }
+    if (memoryTypeIndex == (uint32_t)-1) {
+        throw std::runtime_error(
+          "Kompute TransferEngine memory type for staging chunk not found");
+    }
+
+    vk::MemoryAllocateInfo memoryAllocateInfo(memoryRequirements.size,
+                                              memoryTypeIndex);
+    this->mDevice->allocateMemory(
+      &memoryAllocateInfo, nullptr, &stagingChunk.memory);
+    this->mDevice->bindBufferMemory(stagingChunk.buffer, stagingChunk.memory, 0);
+
+    // Staging chunks stay mapped for the lifetime of the engine
+    stagingChunk.mapped = this->mDevice->mapMemory(
+      stagingChunk.memory, 0, VK_WHOLE_SIZE, vk::MemoryMapFlags());
+
+    vk::CommandBufferAllocateInfo commandBufferAllocateInfo(
+      *this->mCommandPool, vk::CommandBufferLevel::ePrimary, 1);
+    stagingChunk.commandBuffer = std::make_shared<vk::CommandBuffer>();
+    this->mDevice->allocateCommandBuffers(&commandBufferAllocateInfo,
+                                          stagingChunk.commandBuffer.get());
+
+    stagingChunk.fence = this->mDevice->createFence(vk::FenceCreateInfo());
+    stagingChunk.isInFlight = false;
+}
+
+std::future<void>
+TransferEngine::enqueue(std::function<void()> transfer)
+{
+    std::shared_ptr<std::packaged_task<void()>> task =
+      std::make_shared<std::packaged_task<void()>>([this, transfer]() {
+          try {
+              transfer();
+          } catch (...) {
+              // Ensure no chunk is left in flight for the next transfer
+              this->waitAllStagingChunks();
+              throw;
+          }
+      });
+
+    std::future<void> future = task->get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        if (!this->mIsInit || this->mIsStopping) {
+            throw std::runtime_error(
+              "Kompute TransferEngine transfer requested but engine is not "
+              "initialized");
+        }
+        this->mTasks.push_back([task]() { (*task)(); });
+    }
+    this->mCondition.notify_one();
+
+    return future;
+}
+
+void
+TransferEngine::runWorker()
+{
+    SPDLOG_DEBUG("Kompute TransferEngine worker started");
+
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(this->mMutex);
+            this->mCondition.wait(lock, [this]() {
+                return this->mIsStopping || !this->mTasks.empty();
+            });
+            if (this->mTasks.empty()) {
+                break;
+            }
+            task = std::move(this->mTasks.front());
+            this->mTasks.pop_front();
+        }
+        task();
+    }
+
+    SPDLOG_DEBUG("Kompute TransferEngine worker finished");
+}
+
+void
+TransferEngine::uploadTensor(std::shared_ptr<Tensor> tensor)
+{
+    SPDLOG_DEBUG("Kompute TransferEngine uploading tensor of size: {}",
+                 tensor->memorySize());
+
+    this->validateTransferTensor(tensor);
+
+    // Device tensors in unified memory are mapped without staging chunks
+    if (tensor->tensorType() == Tensor::TensorTypes::eStaging ||
+        tensor->isUnifiedMemory()) {
+        tensor->mapDataIntoHostMemory();
+        return;
+    }
+
+    const char* data = reinterpret_cast<const char*>(tensor->hostData());
+    uint64_t memorySize = tensor->memorySize();
+
+    for (uint64_t offset = 0; offset < memorySize; offset += this->mChunkSize) {
+        uint64_t size = std::min(this->mChunkSize, memorySize - offset);
+        this->uploadChunk(tensor, offset, data + offset, size);
+    }
+}
+
+void
+TransferEngine::downloadTensor(std::shared_ptr<Tensor> tensor)
+{
+    SPDLOG_DEBUG("Kompute TransferEngine downloading tensor of size: {}",
+                 tensor->memorySize());
+
+    this->validateTransferTensor(tensor);
+
+    // Device tensors in unified memory are mapped without staging chunks
+    if (tensor->tensorType() == Tensor::TensorTypes::eStaging ||
+        tensor->isUnifiedMemory()) {
+        tensor->mapDataFromHostMemory();
+        return;
+    }
+
+    uint64_t memorySize = tensor->memorySize();
+
+    for (uint64_t offset = 0; offset < memorySize; offset += this->mChunkSize) {
+        uint64_t size = std::min(this->mChunkSize, memorySize - offset);
+        this->downloadChunk(
+          tensor, offset, size, [tensor, offset, size](const char* mapped) {
+              char* data = reinterpret_cast<char*>(tensor->hostData());
+              memcpy(data + offset, mapped, size);
+          });
+    }
+}
+
+void
+TransferEngine::uploadChunk(std::shared_ptr<Tensor> tensor,
+                            uint64_t offset,
+                            const char* data,
+                            uint64_t size)
+{
+    // Waits only if the copy of this chunk from the previous round is
+    // still in flight, while the copies of the other chunks continue
+    StagingChunk& stagingChunk = this->acquireStagingChunk();
+
+    memcpy(stagingChunk.mapped, data, size);
+    vk::MappedMemoryRange mappedRange(stagingChunk.memory, 0, VK_WHOLE_SIZE);
+    this->mDevice->flushMappedMemoryRanges(1, &mappedRange);
+
+    stagingChunk.commandBuffer->begin(vk::CommandBufferBeginInfo(
+      vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+    tensor->recordCopyFromBuffer(stagingChunk.commandBuffer,
+                                 stagingChunk.buffer,
+                                 { vk::BufferCopy(0, offset, size) });
+    this->submitStagingChunk(stagingChunk);
+}
+
+void
+TransferEngine::downloadChunk(std::shared_ptr<Tensor> tensor,
+                              uint64_t offset,
+                              uint64_t size,
+                              std::function<void(const char*)> downloadCallback)
+{
+    // Acquiring a chunk copies out its previous download, which overlaps
+    // with the copies of the other chunks still in flight
+    StagingChunk& stagingChunk = this->acquireStagingChunk();
+
+    stagingChunk.commandBuffer->begin(vk::CommandBufferBeginInfo(
+      vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+    tensor->recordCopyToBuffer(stagingChunk.commandBuffer,
+                               stagingChunk.buffer,
+                               { vk::BufferCopy(offset, 0, size) });
+
+    vk::MemoryBarrier memoryBarrier(vk::AccessFlagBits::eTransferWrite,
+                                    vk::AccessFlagBits::eHostRead);
+    stagingChunk.commandBuffer->pipelineBarrier(
+      vk::PipelineStageFlagBits::eTransfer,
+      vk::PipelineStageFlagBits::eHost,
+      vk::DependencyFlags(),
+      memoryBarrier,
+      nullptr,
+      nullptr);
+
+    stagingChunk.downloadCallback = downloadCallback;
+
+    this->submitStagingChunk(stagingChunk);
+}
+
+void
+TransferEngine::copyTensor(
+  std::shared_ptr<Tensor> srcTensor,
+  std::shared_ptr<TransferEngine> dstEngine,
+  std::shared_ptr<Tensor> dstTensor,
+  std::shared_ptr<PendingUploads> uploads)
+{
+    SPDLOG_DEBUG("Kompute TransferEngine copying tensor of size: {}",
+                 srcTensor->memorySize());
+
+    this->validateTransferTensor(srcTensor);
+    this->validateTransferTensor(dstTensor);
+
+    bool isHostDataCopied = srcTensor->data().size() == srcTensor->size() &&
+                            dstTensor->data().size() == dstTensor->size();
+
+    // Buffers of the same logical device are copied without the host
+    if (*this->mDevice == *dstEngine->mDevice) {
+        SPDLOG_DEBUG("Kompute TransferEngine copying within the same device");
+
+        StagingChunk& stagingChunk = this->acquireStagingChunk();
+        stagingChunk.commandBuffer->begin(vk::CommandBufferBeginInfo(
+          vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+        dstTensor->recordCopyFrom(stagingChunk.commandBuffer, srcTensor, false);
+        this->submitStagingChunk(stagingChunk);
+        this->waitStagingChunk(stagingChunk);
+
+        if (isHostDataCopied) {
+            dstTensor->setData(srcTensor->data());
+        }
+        return;
+    }
+
+    uint64_t memorySize = srcTensor->memorySize();
+
+    try {
+        for (uint64_t offset = 0; offset < memorySize;
+             offset += this->mChunkSize) {
+            uint64_t size = std::min(this->mChunkSize, memorySize - offset);
+
+            // Each downloaded chunk is queued for upload in the destination
+            // engine, which uploads it while the next chunk is downloaded here
+            this->downloadChunk(
+              srcTensor,
+              offset,
+              size,
+              [dstEngine, dstTensor, offset, size, isHostDataCopied, uploads](
+                const char* mapped) {
+                  std::shared_ptr<std::vector<char>> data =
+                    std::make_shared<std::vector<char>>(mapped, mapped + size);
+                  std::future<void> upload = dstEngine->enqueue(
+                    [dstEngine, dstTensor, offset, isHostDataCopied, data]() {
+                        dstEngine->uploadChunk(
+                          dstTensor, offset, data->data(), data->size());
+                        if (isHostDataCopied) {
+                            char* hostData =
+                              reinterpret_cast<char*>(dstTensor->hostData());
+                            memcpy(
+                              hostData + offset, data->data(), data->size());
+                        }
+                    });
+                  std::lock_guard<std::mutex> lock(uploads->mutex);
+                  uploads->futures.push_back(std::move(upload));
+              });
+        }
+        this->waitAllStagingChunks();
+    } catch (...) {
+        // The chunks already submitted still run their callbacks before the
+        // error is returned, rather than in a later transfer of this engine
+        for (uint32_t i = 0; i < this->mNumChunks; i++) {
+            try {
+                this->waitStagingChunk(
+                  this->mStagingChunks[(this->mNextChunk + i) %
+                                       this->mNumChunks]);
+            } catch (...) {
+            }
+        }
+        throw;
+    }
+
+    std::future<void> upload = dstEngine->enqueue(
+      [dstEngine]() { dstEngine->waitAllStagingChunks(); });
+    std::lock_guard<std::mutex> lock(uploads->mutex);
+    uploads->futures.push_back(std::move(upload));
+}
+
+void
+TransferEngine::validateTransferTensor(std::shared_ptr<Tensor> tensor)
+{
+    if (!tensor->isInit()) {
+        throw std::runtime_error(
+          "Kompute TransferEngine tensor has not been initialized");
+    }
+    if (tensor->tensorType() == Tensor::TensorTypes::eStorage) {
+        throw std::runtime_error(
+          "Kompute TransferEngine tensor is of type TensorTypes::eStorage and "
+          "hence cannot be used to receive or pass data.");
+    }
+}
+
+TransferEngine::StagingChunk&
+TransferEngine::acquireStagingChunk()
+{
+    StagingChunk& stagingChunk =
+      this->mStagingChunks[this->mNextChunk % this->mNumChunks];
+    this->mNextChunk++;
+
+    this->waitStagingChunk(stagingChunk);
+
+    return stagingChunk;
+}
+
+void
+TransferEngine::submitStagingChunk(StagingChunk& stagingChunk)
+{
+    stagingChunk.commandBuffer->end();
+
+    vk::SubmitInfo submitInfo(
+      0, nullptr, nullptr, 1, stagingChunk.commandBuffer.get());
+
+    {
+        std::unique_lock<std::mutex> queueLock;
+        if (this->mQueueMutex) {
+            queueLock = std::unique_lock<std::mutex>(*this->mQueueMutex);
+        }
+        this->mQueue->submit(1, &submitInfo, stagingChunk.fence);
+    }
+    stagingChunk.isInFlight = true;
+}
+
+void
+TransferEngine::waitStagingChunk(StagingChunk& stagingChunk)
+{
+    if (!stagingChunk.isInFlight) {
+        return;
+    }
+
+    vk::Result result = this->mDevice->waitForFences(
+      1, &stagingChunk.fence, VK_TRUE, UINT64_MAX);
+    this->mDevice->resetFences(1, &stagingChunk.fence);
+    stagingChunk.isInFlight = false;
+
+    std::function<void(const char*)> downloadCallback =
+      stagingChunk.downloadCallback;
+    stagingChunk.downloadCallback = nullptr;
+
+    if (result != vk::Result::eSuccess) {
+        throw std::runtime_error(
+          "Kompute TransferEngine failed waiting for chunk copy: " +
+          vk::to_string(result));
+    }
+
+    if (downloadCallback) {
+        vk::MappedMemoryRange mappedRange(
+          stagingChunk.memory, 0, VK_WHOLE_SIZE);
+        this->mDevice->invalidateMappedMemoryRanges(1, &mappedRange);
+
+        downloadCallback(reinterpret_cast<const char*>(stagingChunk.mapped));
+    }
+}
+
+void
+TransferEngine::waitAllStagingChunks()
+{
+    // Chunks are waited in submission order so downloads are copied out in
+    // the order they were submitted
+    for (uint32_t i = 0; i < this->mNumChunks; i++) {
+        this->waitStagingChunk(
+          this->mStagingChunks[(this->mNextChunk + i) % this->mNumChunks]);
+    }
+}
+
+}
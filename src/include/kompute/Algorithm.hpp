@@ -2,6 +2,7 @@
 
 #include "kompute/Core.hpp"
 
+#include "kompute/DescriptorPoolArena.hpp"
 #include "kompute/Tensor.hpp"
 
 namespace kp {
@@ -29,6 +30,17 @@ class Algorithm
     Algorithm(std::shared_ptr<vk::Device> device,
               std::shared_ptr<vk::CommandBuffer> commandBuffer);
 
+    /**
+     * Sets the descriptor pool arena that will be used to retrieve the
+     * descriptor set layout and the descriptor set for the tensor parameters
+     * instead of creating a descriptor pool for this algorithm only. It must
+     * be set before the init function is called.
+     *
+     * @param descriptorPoolArena The arena to allocate descriptor sets from
+     */
+    void setDescriptorPoolArena(
+      std::shared_ptr<DescriptorPoolArena> descriptorPoolArena);
+
     /**
      * Initialiser for the shader data provided to the algorithm as well as
      * tensor parameters that will be used in shader.
@@ -36,9 +48,28 @@ class Algorithm
      * @param shaderFileData The bytes in spir-v format of the shader
      * @tensorParams The Tensors to be used in the Algorithm / shader for
      * processing
+     * @param specializationConstants Additional specialization constants
+     * whose constant ids follow the ones of the sizes of the tensors
      */
     void init(const std::vector<char>& shaderFileData,
-              std::vector<std::shared_ptr<Tensor>> tensorParams);
+              std::vector<std::shared_ptr<Tensor>> tensorParams,
+              const std::vector<uint32_t>& specializationConstants = {});
+
+    /**
+     * Initialiser for an existing shader module, such as the ones provided by
+     * the kp::ShaderCache, as well as tensor parameters that will be used in
+     * shader. The shader module is not owned by the Algorithm and hence it
+     * won't be destroyed together with the Algorithm.
+     *
+     * @param shaderModule The shader module to create the pipeline with
+     * @tensorParams The Tensors to be used in the Algorithm / shader for
+     * processing
+     * @param specializationConstants Additional specialization constants
+     * whose constant ids follow the ones of the sizes of the tensors
+     */
+    void init(std::shared_ptr<vk::ShaderModule> shaderModule,
+              std::vector<std::shared_ptr<Tensor>> tensorParams,
+              const std::vector<uint32_t>& specializationConstants = {});
 
     /**
      * Destructor for Algorithm which is responsible for freeing and desroying
@@ -48,7 +79,10 @@ class Algorithm
 
     /**
      * Records the dispatch function with the provided template parameters or
-     * alternatively using the size of the tensor by default.
+     * alternatively using the size of the tensor by default. If the
+     * descriptor pool arena has push descriptors enabled the tensor bindings
+     * are pushed into the command buffer, otherwise the descriptor set
+     * written during init is bound.
      *
      * @param x Layout X dispatch value
      * @param y Layout Y dispatch value
@@ -56,10 +90,30 @@ class Algorithm
      */
     void recordDispatch(uint32_t x = 1, uint32_t y = 1, uint32_t z = 1);
 
+    /**
+     * Records the dispatch function with a different set of tensors bound
+     * than the ones provided on init, which is used to alternate bindings
+     * such as in double buffered iterations without re-creating the pipeline.
+     * The tensors must match the number and sizes of the init tensors, and
+     * require push descriptors or a descriptor pool arena to be available.
+     *
+     * @param tensors The tensors to bind in the order of their binding index
+     * @param x Layout X dispatch value
+     * @param y Layout Y dispatch value
+     * @param z Layout Z dispatch value
+     */
+    void recordDispatch(const std::vector<std::shared_ptr<Tensor>>& tensors,
+                        uint32_t x = 1,
+                        uint32_t y = 1,
+                        uint32_t z = 1);
+
   private:
     // -------------- NEVER OWNED RESOURCES
     std::shared_ptr<vk::Device> mDevice;
     std::shared_ptr<vk::CommandBuffer> mCommandBuffer;
+    std::shared_ptr<DescriptorPoolArena> mDescriptorPoolArena;
+    std::shared_ptr<vk::DispatchLoaderDynamic> mPushDescriptorDispatcher;
+    std::vector<std::shared_ptr<Tensor>> mTensorParams;
 
     // -------------- OPTIONALLY OWNED RESOURCES
     std::shared_ptr<vk::DescriptorSetLayout> mDescriptorSetLayout;
@@ -83,7 +137,8 @@ class Algorithm
 
     // Parameters
     void createParameters(std::vector<std::shared_ptr<Tensor>>& tensorParams);
-    void createDescriptorPool();
+    void recordPushDescriptors(
+      const std::vector<std::shared_ptr<Tensor>>& tensors);
 };
 
 } // End namespace kp
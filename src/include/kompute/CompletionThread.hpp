@@ -0,0 +1,108 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "kompute/Core.hpp"
+
+#include "kompute/EvalFuture.hpp"
+#include "kompute/Sequence.hpp"
+
+#define KP_DEFAULT_COMPLETION_WAIT_TIMEOUT 1000000
+
+namespace kp {
+
+/**
+ * Background thread owned by the kp::Manager which awaits the sequences
+ * evaluated asynchronously and completes their kp::EvalFuture handles. The
+ * thread blocks on the fence of the oldest pending sequence with a short
+ * timeout and polls the rest, running the postEval of each sequence as soon as
+ * it finishes, so callers never block on a fence themselves.
+ *
+ * Sequences tracked by the completion thread must not be awaited directly, as
+ * their fences are destroyed once awaited, and should instead be waited
+ * through their future.
+ */
+class CompletionThread
+{
+  public:
+    /**
+     * Default constructor which does not start the thread until init is
+     * called.
+     *
+     * @param waitTimeout Number of nanoseconds the thread blocks on the fence
+     * of the oldest pending sequence before polling the others
+     */
+    CompletionThread(
+      uint64_t waitTimeout = KP_DEFAULT_COMPLETION_WAIT_TIMEOUT);
+
+    /**
+     * Destructor which waits for the pending sequences and stops the thread.
+     */
+    ~CompletionThread();
+
+    /**
+     * Starts the completion thread.
+     */
+    void init();
+
+    /**
+     * Tracks a sequence that has been evaluated asynchronously, so its
+     * future is completed once the sequence finishes.
+     *
+     * @param sequence The sequence evaluated asynchronously
+     * @param isSubmitted Whether the evalAsync of the sequence succeeded,
+     * otherwise the sequence is not tracked and the returned future is
+     * already completed as failed
+     * @return Future completed once the sequence has been awaited
+     */
+    EvalFuture track(std::shared_ptr<Sequence> sequence,
+                     bool isSubmitted = true);
+
+    /**
+     * Retrieves the future of a sequence that is currently being tracked.
+     *
+     * @param sequence The sequence to find the future for
+     * @return The future of the sequence, or an invalid future if the
+     * sequence is not being tracked
+     */
+    EvalFuture find(std::shared_ptr<Sequence> sequence);
+
+    /**
+     * Returns true if the completion thread has been started.
+     *
+     * @return Boolean stating whether the thread is running
+     */
+    bool isInit();
+
+    /**
+     * Waits for the pending sequences to finish and stops the thread.
+     */
+    void stop();
+
+  private:
+    struct PendingEval
+    {
+        std::shared_ptr<Sequence> sequence;
+        std::shared_ptr<EvalFutureState> state;
+    };
+
+    // -------------- ALWAYS OWNED RESOURCES
+    uint64_t mWaitTimeout = KP_DEFAULT_COMPLETION_WAIT_TIMEOUT;
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<PendingEval> mPendingEvals;
+    bool mIsStopping = false;
+    bool mIsInit = false;
+
+    // Worker util functions
+    void run();
+    void complete(const PendingEval& pendingEval,
+                  bool result,
+                  std::exception_ptr exception);
+};
+
+} // End namespace kp
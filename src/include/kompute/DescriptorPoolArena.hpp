@@ -0,0 +1,216 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Tensor.hpp"
+
+#define KP_DEFAULT_DESCRIPTOR_SETS_PER_POOL 64
+#define KP_DEFAULT_DESCRIPTORS_PER_SET 4
+
+namespace kp {
+
+/**
+ * Growable arena of descriptor pools which is owned by the Manager and shared
+ * across all the algorithms created in its sequences. The arena also caches
+ * the descriptor set layouts by number of bindings and the descriptor sets
+ * already written for a given tuple of tensor bindings, so re-recording the
+ * same operation on the same tensors does not allocate or write descriptors.
+ * When the device supports VK_KHR_push_descriptor the arena can also provide
+ * push descriptor set layouts, in which case algorithms push their bindings
+ * into the command buffer and no descriptor sets are allocated at all.
+ *
+ * Sets whose tensors have been destroyed are retired rather than freed, as
+ * command buffers already submitted may still reference them. The sequences
+ * register their submissions with beginSubmission and endSubmission, and a
+ * retired set is only freed once every submission that was in flight when it
+ * was retired has completed. The fences of the submissions are also polled
+ * when freeing, so submissions that are never awaited do not keep the sets
+ * from being freed.
+ */
+class DescriptorPoolArena
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    DescriptorPoolArena();
+
+    /**
+     * Default constructor with the device that will be used to create the
+     * descriptor pools, layouts and sets.
+     *
+     * @param device Vulkan logical device to create the resources with
+     * @param setsPerPool Number of descriptor sets allocated per pool, which
+     * is the size by which the arena grows when a pool is exhausted
+     */
+    DescriptorPoolArena(
+      std::shared_ptr<vk::Device> device,
+      uint32_t setsPerPool = KP_DEFAULT_DESCRIPTOR_SETS_PER_POOL);
+
+    /**
+     * Destructor which destroys all the descriptor pools, and hence the
+     * descriptor sets allocated from them, as well as the set layouts.
+     */
+    ~DescriptorPoolArena();
+
+    /**
+     * Retrieves the descriptor set layout with the number of storage buffer
+     * bindings provided, or creates it if it doesn't exist. Layouts with the
+     * same bindings are identically defined and hence compatible with all the
+     * pipelines created for the same number of tensors.
+     *
+     * @param numBindings The number of storage buffer bindings of the layout
+     * @return Shared pointer to the arena owned descriptor set layout
+     */
+    std::shared_ptr<vk::DescriptorSetLayout> getOrCreateDescriptorSetLayout(
+      uint32_t numBindings);
+
+    /**
+     * Retrieves the descriptor set already written with the tensors provided
+     * as bindings in the same order, or allocates and writes a new descriptor
+     * set with a single batched update if none exists.
+     *
+     * @param tensors The tensors to bind in the order of their binding index
+     * @return Descriptor set owned by the arena with the tensors bound
+     */
+    vk::DescriptorSet getOrCreateDescriptorSet(
+      const std::vector<std::shared_ptr<Tensor>>& tensors);
+
+    /**
+     * Enables the push descriptor fast path, which should only be called if
+     * the VK_KHR_push_descriptor extension has been enabled in the device.
+     *
+     * @param dispatcher Dynamic dispatcher initialised with the device to
+     * load the vkCmdPushDescriptorSetKHR function
+     */
+    void enablePushDescriptors(
+      std::shared_ptr<vk::DispatchLoaderDynamic> dispatcher);
+
+    /**
+     * Whether algorithms should push their descriptors into the command
+     * buffer instead of binding descriptor sets allocated from the arena.
+     *
+     * @return Boolean stating whether push descriptors are enabled
+     */
+    bool isPushDescriptorsEnabled();
+
+    /**
+     * Returns the dispatcher used to record the push descriptor commands.
+     *
+     * @return Shared pointer to the dispatcher, or null if push descriptors
+     * are not enabled
+     */
+    std::shared_ptr<vk::DispatchLoaderDynamic> pushDescriptorDispatcher();
+
+    /**
+     * Retrieves the push descriptor set layout with the number of storage
+     * buffer bindings provided, or creates it if it doesn't exist.
+     *
+     * @param numBindings The number of storage buffer bindings of the layout
+     * @return Shared pointer to the arena owned descriptor set layout
+     */
+    std::shared_ptr<vk::DescriptorSetLayout>
+    getOrCreatePushDescriptorSetLayout(uint32_t numBindings);
+
+    /**
+     * Registers a submission of a command buffer that may reference the
+     * descriptor sets of the arena, which has to be called before the
+     * command buffer is submitted.
+     *
+     * @param fence (Optional) Fence the submission signals, which is polled
+     * to find completed submissions until endSubmission is called, and has
+     * to stay valid until then. Submissions without a fence are in flight
+     * until endSubmission is called.
+     * @return Identifier of the submission to pass to endSubmission
+     */
+    uint64_t beginSubmission(vk::Fence fence = nullptr);
+
+    /**
+     * Marks the submission provided as completed once its fence has
+     * signalled, which has to be called before the fence is destroyed, and
+     * frees the retired descriptor sets that are no longer
+     * referenced by any submission in flight.
+     *
+     * @param submission Identifier returned by beginSubmission
+     */
+    void endSubmission(uint64_t submission);
+
+    /**
+     * Returns the number of descriptor pools currently allocated.
+     *
+     * @return Number of descriptor pools in the arena
+     */
+    size_t numDescriptorPools();
+
+    /**
+     * Returns the number of descriptor sets currently cached.
+     *
+     * @return Number of descriptor sets in the arena
+     */
+    size_t numDescriptorSets();
+
+    /**
+     * Returns the number of retired descriptor sets waiting for the
+     * submissions in flight to complete before they are freed.
+     *
+     * @return Number of retired descriptor sets in the arena
+     */
+    size_t numRetiredDescriptorSets();
+
+    /**
+     * Destroys the descriptor pools and descriptor set layouts owned by the
+     * arena.
+     */
+    void freeMemoryDestroyGPUResources();
+
+  private:
+    typedef std::vector<std::tuple<vk::Buffer, vk::DeviceSize, vk::DeviceSize>>
+      DescriptorSetKey;
+
+    struct DescriptorSetEntry
+    {
+        vk::DescriptorSet descriptorSet;
+        vk::DescriptorPool descriptorPool;
+        std::vector<std::weak_ptr<Tensor>> tensors;
+        uint64_t retiredAfterSubmission = 0; ///< Last submission begun when the set was retired
+    };
+
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::Device> mDevice;
+
+    // -------------- OPTIONALLY OWNED RESOURCES
+    std::shared_ptr<vk::DispatchLoaderDynamic> mPushDescriptorDispatcher;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    uint32_t mSetsPerPool = KP_DEFAULT_DESCRIPTOR_SETS_PER_POOL;
+    std::mutex mMutex;
+    std::vector<std::shared_ptr<vk::DescriptorPool>> mDescriptorPools;
+    std::unordered_map<uint32_t, std::shared_ptr<vk::DescriptorSetLayout>>
+      mDescriptorSetLayouts;
+    std::unordered_map<uint32_t, std::shared_ptr<vk::DescriptorSetLayout>>
+      mPushDescriptorSetLayouts;
+    std::map<DescriptorSetKey, DescriptorSetEntry> mDescriptorSets;
+    std::vector<DescriptorSetEntry> mRetiredDescriptorSets;
+    uint64_t mLastSubmission = 0;
+    std::map<uint64_t, vk::Fence> mSubmissionsInFlight;
+
+    // Create util functions
+    void createDescriptorPool(uint32_t numBindings);
+    vk::DescriptorSet allocateDescriptorSet(
+      std::shared_ptr<vk::DescriptorSetLayout> descriptorSetLayout,
+      uint32_t numBindings,
+      vk::DescriptorPool& descriptorPool);
+    std::shared_ptr<vk::DescriptorSetLayout> findOrCreateDescriptorSetLayout(
+      uint32_t numBindings,
+      bool isPushDescriptor = false);
+    void retireDescriptorSet(DescriptorSetEntry descriptorSetEntry);
+    void retireExpiredDescriptorSets();
+    void freeRetiredDescriptorSets();
+};
+
+} // End namespace kp
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "kompute/Core.hpp"
+
+namespace kp {
+
+/**
+ * Capabilities of a physical device as reported by kp::Manager::listDevices,
+ * which are also used by kp::DevicePolicy to choose the device of a manager.
+ */
+struct DeviceInfo
+{
+    uint32_t index = 0;
+    std::string name;
+    vk::PhysicalDeviceType deviceType = vk::PhysicalDeviceType::eOther;
+    uint32_t vendorID = 0;
+    uint32_t deviceID = 0;
+    uint32_t apiVersion = 0;
+    // Total size of the device local heaps in bytes
+    uint64_t deviceLocalMemorySize = 0;
+    // Whether a memory type is both device local and host visible
+    bool hasUnifiedMemory = false;
+    // Zero when the device does not support Vulkan 1.1
+    uint32_t subgroupSize = 0;
+    // Whether subgroup arithmetic operations are supported in compute shaders
+    bool hasSubgroupArithmetic = false;
+    uint32_t maxComputeWorkGroupInvocations = 0;
+    std::array<uint32_t, 3> maxComputeWorkGroupSize = { 0, 0, 0 };
+    uint32_t maxComputeSharedMemorySize = 0;
+    std::vector<uint32_t> computeQueueFamilyIndices;
+    // Compute queue family without graphics support, or -1 if there is none
+    uint32_t dedicatedComputeQueueFamilyIndex = -1;
+    std::vector<std::string> extensions;
+    vk::PhysicalDeviceFeatures features;
+
+    /**
+     * Queries the capabilities of a physical device.
+     *
+     * @param physicalDevice The physical device to query
+     * @param index The index of the physical device in the instance
+     * @return The capabilities of the physical device
+     */
+    static DeviceInfo fromPhysicalDevice(
+      const vk::PhysicalDevice& physicalDevice,
+      uint32_t index);
+
+    /**
+     * Returns true if the device supports the extension provided.
+     *
+     * @param extensionName The name of the extension
+     * @return Boolean stating whether the extension is supported
+     */
+    bool hasExtension(const std::string& extensionName) const;
+};
+
+/**
+ * Policy used by kp::Manager to choose the physical device to create its
+ * resources on. Devices that do not have a compute queue, the required
+ * extensions, a name matching the regex or that are rejected by the filter
+ * are discarded, and the remaining ones are ranked by device type and then by
+ * device local memory, falling back to the lowest index.
+ */
+struct DevicePolicy
+{
+    // Ranks discrete, then integrated, virtual and CPU devices
+    bool preferDiscrete = true;
+    // Ranks devices with more device local memory first
+    bool preferDeviceLocalMemory = true;
+    // Uses a compute queue family without graphics support when available
+    bool preferDedicatedComputeQueue = false;
+    // Extensions that the device must support, which are also enabled
+    std::vector<std::string> requiredExtensions;
+    // ECMAScript regex searched in the device name, ignored when empty
+    std::string nameRegex;
+    // Custom requirement such as features or limits, ignored when empty
+    std::function<bool(const DeviceInfo&)> filter;
+
+    /**
+     * Returns true if the device fulfils the requirements of the policy.
+     *
+     * @param deviceInfo The capabilities of the device
+     * @return Boolean stating whether the device can be selected
+     */
+    bool isSuitable(const DeviceInfo& deviceInfo) const;
+
+    /**
+     * Chooses the best suitable device, throwing if none is suitable.
+     *
+     * @param deviceInfos The capabilities of the available devices
+     * @return The index of the chosen device in the instance
+     */
+    uint32_t select(const std::vector<DeviceInfo>& deviceInfos) const;
+};
+
+} // End namespace kp
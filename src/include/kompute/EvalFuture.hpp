@@ -0,0 +1,148 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+#include "kompute/Core.hpp"
+
+namespace kp {
+
+/**
+ * State shared between the kp::EvalFuture handles of an asynchronous
+ * evaluation and the kp::CompletionThread that completes it, which holds the
+ * result of the evaluation and the continuations to run once it is ready.
+ */
+class EvalFutureState
+{
+  public:
+    /**
+     * Completes the state with the result of the evaluation, wakes up the
+     * waiting threads and runs the continuations in the calling thread.
+     *
+     * @param result Boolean stating whether the evaluation was successful
+     */
+    void setResult(bool result);
+
+    /**
+     * Completes the state with an exception raised by the evaluation, which
+     * is rethrown by get, and runs the continuations in the calling thread.
+     *
+     * @param exception The exception raised by the evaluation
+     */
+    void setException(std::exception_ptr exception);
+
+    /**
+     * Adds a continuation to run once the state is completed, or runs it
+     * straight away in the calling thread if it already is.
+     *
+     * @param continuation Function to run once the state is completed
+     */
+    void addContinuation(std::function<void()> continuation);
+
+    /**
+     * Returns true if the state has been completed.
+     *
+     * @return Boolean stating whether the state is completed
+     */
+    bool isReady();
+
+    /**
+     * Waits until the state is completed or the timeout expires.
+     *
+     * @param waitFor Number of nanoseconds to wait before timing out
+     * @return Boolean stating whether the state is completed
+     */
+    bool wait(uint64_t waitFor);
+
+    /**
+     * Waits until the state is completed and returns its result.
+     *
+     * @return Boolean stating whether the evaluation was successful
+     */
+    bool get();
+
+  private:
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mIsReady = false;
+    bool mResult = false;
+    std::exception_ptr mException;
+    std::vector<std::function<void()>> mContinuations;
+
+    void complete();
+};
+
+/**
+ * Lightweight handle to an asynchronous evaluation returned by the
+ * kp::Manager evalOpAsync functions. The evaluation is awaited by the
+ * completion thread of the manager, so the handle can be polled, waited with
+ * a timeout or chained with continuations without the caller having to await
+ * the sequence. Handles are cheap to copy and all copies refer to the same
+ * evaluation.
+ */
+class EvalFuture
+{
+  public:
+    /**
+     * Base constructor which creates an invalid handle not referring to any
+     * evaluation.
+     */
+    EvalFuture();
+
+    /**
+     * Constructor with the shared state of the evaluation.
+     *
+     * @param state The state completed by the completion thread
+     */
+    EvalFuture(std::shared_ptr<EvalFutureState> state);
+
+    /**
+     * Returns true if the handle refers to an evaluation.
+     *
+     * @return Boolean stating whether the handle is valid
+     */
+    bool valid();
+
+    /**
+     * Returns true without blocking if the evaluation has finished and the
+     * postEval of its operations has run.
+     *
+     * @return Boolean stating whether the evaluation has finished
+     */
+    bool ready();
+
+    /**
+     * Waits until the evaluation has finished or the timeout expires.
+     *
+     * @param waitFor Number of nanoseconds to wait before timing out
+     * @return Boolean stating whether the evaluation has finished
+     */
+    bool wait(uint64_t waitFor = UINT64_MAX);
+
+    /**
+     * Waits until the evaluation has finished and returns whether it was
+     * successful, rethrowing any exception raised by the evaluation.
+     *
+     * @return Boolean stating whether the evaluation was successful
+     */
+    bool get();
+
+    /**
+     * Chains a continuation that is called with this handle once the
+     * evaluation has finished. The continuation runs in the completion thread
+     * of the manager, or in the calling thread if the evaluation has already
+     * finished, so it should be short and must not wait on other futures.
+     *
+     * @param continuation Function called with the finished handle
+     * @return Handle that is ready once the continuation has run, which
+     * rethrows any exception raised by the continuation
+     */
+    EvalFuture then(std::function<void(EvalFuture)> continuation);
+
+  private:
+    std::shared_ptr<EvalFutureState> mState;
+};
+
+} // End namespace kp
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <mutex>
 #include <unordered_map>
 
 #include "kompute/Core.hpp"
 
 #include "kompute/Sequence.hpp"
+#include "kompute/CompletionThread.hpp"
+#include "kompute/DescriptorPoolArena.hpp"
+#include "kompute/DevicePolicy.hpp"
+#include "kompute/ShaderCache.hpp"
+#include "kompute/TransferEngine.hpp"
 
 #include "kompute/operations/OpTensorCreate.hpp"
 
@@ -13,7 +19,15 @@
 namespace kp {
 
 /**
-    Base orchestrator which creates and manages device and child components
+    Base orchestrator which creates and manages device and child components.
+
+    The manager is thread safe: the registry of managed sequences is guarded by
+   a mutex, submissions into each queue are serialised by a per queue mutex,
+   and the eval functions hold the mutex of the sequence they record into, as
+   each sequence owns the command pool it records with and command pools
+   cannot be used from several threads at once. Threads evaluating in parallel
+   should hence use the default anonymous sequences or different named
+   sequences, as evaluations of the same named sequence are serialised.
 */
 class Manager
 {
@@ -36,6 +50,18 @@ class Manager
     Manager(uint32_t physicalDeviceIndex,
             const std::vector<uint32_t>& familyQueueIndices = {});
 
+    /**
+     * Similar to base constructor but chooses the device to create the
+     * resources on with the policy provided, enabling the extensions it
+     * requires.
+     *
+     * @param devicePolicy The policy used to choose the physical device
+     * @param familyQueueIndices (Optional) List of queue indices to add for
+     * explicit allocation, otherwise a compute queue is chosen by the policy
+     */
+    Manager(const DevicePolicy& devicePolicy,
+            const std::vector<uint32_t>& familyQueueIndices = {});
+
     /**
      * Manager constructor which allows your own vulkan application to integrate
      * with the vulkan kompute use.
@@ -44,11 +70,17 @@ class Manager
      * @param physicalDevice Vulkan physical device to use for application
      * @param device Vulkan logical device to use for all base resources
      * @param physicalDeviceIndex Index for vulkan physical device used
+     * @param familyQueueIndices (Optional) Family index of each of the queues
+     * the device was created with to use for the sequences, where repeated
+     * families take the next queue of the family, otherwise the first queue
+     * of the first compute family, which the device must have been created
+     * with
      */
     Manager(std::shared_ptr<vk::Instance> instance,
             std::shared_ptr<vk::PhysicalDevice> physicalDevice,
             std::shared_ptr<vk::Device> device,
-            uint32_t physicalDeviceIndex);
+            uint32_t physicalDeviceIndex,
+            const std::vector<uint32_t>& familyQueueIndices = {});
 
     /**
      * Manager destructor which would ensure all owned resources are destroyed
@@ -56,6 +88,22 @@ class Manager
      */
     ~Manager();
 
+    /**
+     * Lists the physical devices available with their capabilities, which
+     * creates a temporary instance so it can be called before creating a
+     * manager.
+     *
+     * @return The capabilities of each physical device in index order
+     */
+    static std::vector<DeviceInfo> listDevices();
+
+    /**
+     * Returns the index of the physical device used by the manager.
+     *
+     * @return The index of the physical device in the instance
+     */
+    uint32_t physicalDeviceIndex();
+
     /**
      * Get or create a managed Sequence that will be contained by this manager.
      * If the named sequence does not currently exist, it would be created and
@@ -98,6 +146,8 @@ class Manager
         std::shared_ptr<kp::Sequence> sq =
           this->getOrCreateManagedSequence(sequenceName);
 
+        std::lock_guard<std::mutex> lock(sq->mutex());
+
         SPDLOG_DEBUG("Kompute Manager evalOp running sequence BEGIN");
         sq->begin();
 
@@ -125,31 +175,38 @@ class Manager
                        TArgs&&... params)
     {
         SPDLOG_DEBUG("Kompute Manager evalOp Default triggered");
-        this->mCurrentSequenceIndex++;
         this->evalOp<T>(tensors,
-                        KP_DEFAULT_SESSION +
-                          std::to_string(this->mCurrentSequenceIndex),
+                        this->nextDefaultSequenceName(),
                         std::forward<TArgs>(params)...);
     }
 
     /**
      * Function that evaluates operation against named sequence asynchronously.
+     * The sequence is awaited by the completion thread of the manager, so the
+     * returned future can be used instead of calling evalOpAwait.
      *
      * @param tensors The tensors to be used in the operation recorded
      * @param sequenceName The name of the sequence to be retrieved or created
      * @param params Template parameters that will be used to initialise
      * Operation to allow for extensible configurations on initialisation
+     * @return Future that is ready once the sequence finishes and the postEval
+     * of the operation has run
      */
     template<typename T, typename... TArgs>
-    void evalOpAsync(std::vector<std::shared_ptr<Tensor>> tensors,
-                     std::string sequenceName,
-                     TArgs&&... params)
+    EvalFuture evalOpAsync(std::vector<std::shared_ptr<Tensor>> tensors,
+                           std::string sequenceName,
+                           TArgs&&... params)
     {
         SPDLOG_DEBUG("Kompute Manager evalOpAsync triggered");
 
         std::shared_ptr<kp::Sequence> sq =
           this->getOrCreateManagedSequence(sequenceName);
 
+        std::shared_ptr<CompletionThread> completionThread =
+          this->getOrCreateCompletionThread();
+
+        std::lock_guard<std::mutex> lock(sq->mutex());
+
         SPDLOG_DEBUG("Kompute Manager evalOpAsync running sequence BEGIN");
         sq->begin();
 
@@ -160,9 +217,10 @@ class Manager
         sq->end();
 
         SPDLOG_DEBUG("Kompute Manager evalOpAsync running sequence EVAL");
-        sq->evalAsync();
+        bool isSubmitted = sq->evalAsync();
 
         SPDLOG_DEBUG("Kompute Manager evalOpAsync running sequence SUCCESS");
+        return completionThread->track(sq, isSubmitted);
     }
 
     /**
@@ -172,21 +230,23 @@ class Manager
      * @param tensors The tensors to be used in the operation recorded
      * @param params Template parameters that will be used to initialise
      * Operation to allow for extensible configurations on initialisation
+     * @return Future that is ready once the sequence finishes and the postEval
+     * of the operation has run
      */
     template<typename T, typename... TArgs>
-    void evalOpAsyncDefault(std::vector<std::shared_ptr<Tensor>> tensors,
-                            TArgs&&... params)
+    EvalFuture evalOpAsyncDefault(std::vector<std::shared_ptr<Tensor>> tensors,
+                                  TArgs&&... params)
     {
         SPDLOG_DEBUG("Kompute Manager evalOpAsyncDefault triggered");
-        this->mCurrentSequenceIndex++;
-        this->evalOpAsync<T>(tensors,
-                             KP_DEFAULT_SESSION +
-                               std::to_string(this->mCurrentSequenceIndex),
+        return this->evalOpAsync<T>(tensors,
+                             this->nextDefaultSequenceName(),
                              std::forward<TArgs>(params)...);
     }
 
     /**
-     * Operation that awaits for named sequence to finish.
+     * Operation that awaits for named sequence to finish. If the sequence was
+     * evaluated through evalOpAsync this waits on its future, as the sequence
+     * is awaited by the completion thread.
      *
      * @param sequenceName The name of the sequence to wait for termination
      * @param waitFor The amount of time to wait before timing out
@@ -195,16 +255,26 @@ class Manager
     {
         SPDLOG_DEBUG("Kompute Manager evalOpAwait triggered with sequence {}",
                      sequenceName);
-        std::unordered_map<std::string, std::shared_ptr<Sequence>>::iterator
-          found = this->mManagedSequences.find(sequenceName);
-
-        if (found != this->mManagedSequences.end()) {
-            if (std::shared_ptr<kp::Sequence> sq = found->second) {
-                SPDLOG_DEBUG("Kompute Manager evalOpAwait running sequence "
-                             "Sequence EVAL AWAIT");
-                if (sq->isRunning()) {
-                    sq->evalAwait(waitFor);
-                }
+        std::shared_ptr<kp::Sequence> sq =
+          this->findManagedSequence(sequenceName);
+
+        EvalFuture future;
+        if (sq) {
+            future = this->findEvalFuture(sq);
+        }
+
+        if (future.valid()) {
+            SPDLOG_DEBUG("Kompute Manager evalOpAwait waiting on future");
+            if (future.wait(waitFor)) {
+                future.get();
+            }
+        } else if (sq) {
+            std::lock_guard<std::mutex> lock(sq->mutex());
+
+            SPDLOG_DEBUG("Kompute Manager evalOpAwait running sequence "
+                         "Sequence EVAL AWAIT");
+            if (sq->isRunning()) {
+                sq->evalAwait(waitFor);
             }
             SPDLOG_DEBUG(
               "Kompute Manager evalOpAwait running sequence SUCCESS");
@@ -214,7 +284,10 @@ class Manager
     }
 
     /**
-     * Operation that awaits for default sequence to finish.
+     * Operation that awaits for the last default sequence created to finish.
+     * When several threads evaluate default sequences asynchronously the last
+     * one created may belong to another thread, so named sequences should be
+     * awaited instead.
      *
      * @param tensors The tensors to be used in the operation recorded
      * @param params Template parameters that will be used to initialise
@@ -223,9 +296,7 @@ class Manager
     void evalOpAwaitDefault(uint64_t waitFor = UINT64_MAX)
     {
         SPDLOG_DEBUG("Kompute Manager evalOpAwaitDefault triggered");
-        this->evalOpAwait(KP_DEFAULT_SESSION +
-                            std::to_string(this->mCurrentSequenceIndex),
-                          waitFor);
+        this->evalOpAwait(this->currentDefaultSequenceName(), waitFor);
     }
 
     /**
@@ -253,6 +324,39 @@ class Manager
         return tensor;
     }
 
+    /**
+     * Returns the shader cache owned by the manager, which is shared across
+     * all the algorithm operations recorded in the managed sequences.
+     *
+     * @return Shared pointer to the manager owned shader cache
+     */
+    std::shared_ptr<ShaderCache> shaderCache();
+
+    /**
+     * Returns the descriptor pool arena owned by the manager, which is shared
+     * across all the algorithm operations recorded in the managed sequences.
+     *
+     * @return Shared pointer to the manager owned descriptor pool arena
+     */
+    std::shared_ptr<DescriptorPoolArena> descriptorPoolArena();
+
+    /**
+     * Create a streaming transfer engine owned by the manager, which uploads
+     * and downloads tensor data in chunks from a worker thread on the queue
+     * provided. A queue not used by the sequences should be provided, which
+     * can be requested by passing the compute queue family index more than
+     * once in the family queue indices of the manager constructor.
+     *
+     * @param queueIndex The queue to use from the available queues
+     * @param chunkSize Size in bytes of each staging chunk
+     * @param numChunks Number of staging chunks that can be in flight
+     * @return Shared pointer to the manager owned transfer engine
+     */
+    std::shared_ptr<TransferEngine> createTransferEngine(
+      uint32_t queueIndex = 0,
+      uint64_t chunkSize = KP_DEFAULT_TRANSFER_CHUNK_SIZE,
+      uint32_t numChunks = KP_DEFAULT_TRANSFER_NUM_CHUNKS);
+
   private:
     // -------------- OPTIONALLY OWNED RESOURCES
     std::shared_ptr<vk::Instance> mInstance = nullptr;
@@ -265,9 +369,18 @@ class Manager
     // -------------- ALWAYS OWNED RESOURCES
     std::unordered_map<std::string, std::shared_ptr<Sequence>>
       mManagedSequences;
+    std::mutex mManagedSequencesMutex;
+    std::vector<std::shared_ptr<TransferEngine>> mTransferEngines;
 
     std::vector<uint32_t> mComputeQueueFamilyIndices;
     std::vector<std::shared_ptr<vk::Queue>> mComputeQueues;
+    std::vector<std::shared_ptr<std::mutex>> mComputeQueueMutexes;
+    std::vector<std::string> mEnabledExtensions;
+
+    std::shared_ptr<ShaderCache> mShaderCache = nullptr;
+    std::shared_ptr<DescriptorPoolArena> mDescriptorPoolArena = nullptr;
+    std::shared_ptr<CompletionThread> mCompletionThread = nullptr;
+    std::mutex mCompletionThreadMutex;
 
     uint32_t mCurrentSequenceIndex = -1;
 
@@ -280,7 +393,22 @@ class Manager
 
     // Create functions
     void createInstance();
-    void createDevice(const std::vector<uint32_t>& familyQueueIndices = {});
+    void createDevice(const std::vector<uint32_t>& familyQueueIndices = {},
+                      const std::vector<std::string>& requiredExtensions = {});
+    void createComputeQueues();
+    static std::vector<DeviceInfo> enumerateDevices(
+      const vk::Instance& instance);
+    static uint32_t findComputeQueueFamilyIndex(
+      const vk::PhysicalDevice& physicalDevice);
+    std::shared_ptr<Sequence> createSequence(uint32_t queueIndex);
+    std::shared_ptr<CompletionThread> getOrCreateCompletionThread();
+    EvalFuture findEvalFuture(std::shared_ptr<Sequence> sequence);
+
+    // Sequence registry functions
+    std::shared_ptr<Sequence> findManagedSequence(
+      const std::string& sequenceName);
+    std::string nextDefaultSequenceName();
+    std::string currentDefaultSequenceName();
 };
 
 } // End namespace kp
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <exception>
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Manager.hpp"
+
+#include "kompute/operations/OpTensorSyncDevice.hpp"
+#include "kompute/operations/OpTensorSyncLocal.hpp"
+
+namespace kp {
+
+/**
+    Coordinator which owns one kp::Manager per device to run data parallel
+   workloads. Tensors are sharded along their leading dimension with one shard
+   per device, the same operation is evaluated on the shards of every device
+   in parallel, and the shards are gathered or all-reduced back on the host.
+
+    The same physical device index can be provided several times, in which
+   case each manager creates its own logical device on it, which allows
+   running the multi device paths with a single GPU or CPU implementation.
+*/
+class MultiDeviceManager
+{
+  public:
+    /**
+     * Reductions supported by allReduce.
+     */
+    enum class ReduceOps
+    {
+        eSum = 0,
+        eMean = 1,
+    };
+
+    /**
+     * Constructor which creates a manager for each of the physical devices
+     * provided.
+     *
+     * @param physicalDeviceIndices The indices of the physical devices to use
+     */
+    MultiDeviceManager(const std::vector<uint32_t>& physicalDeviceIndices);
+
+    /**
+     * Constructor which coordinates managers created by the application, for
+     * example with a kp::DevicePolicy each.
+     *
+     * @param managers The managers of each device
+     */
+    MultiDeviceManager(const std::vector<std::shared_ptr<Manager>>& managers);
+
+    /**
+     * Destructor which releases the managers, destroying their resources
+     * unless also referenced by the application.
+     */
+    ~MultiDeviceManager();
+
+    /**
+     * Returns the number of devices coordinated.
+     *
+     * @return The number of managers
+     */
+    uint32_t size();
+
+    /**
+     * Returns the manager of a device.
+     *
+     * @param deviceIndex The position of the device in the coordinator
+     * @return Shared pointer to the manager of the device
+     */
+    std::shared_ptr<Manager> manager(uint32_t deviceIndex);
+
+    /**
+     * Splits the data along its leading dimension into one tensor per device,
+     * each created in the memory of its device. The rows are distributed as
+     * evenly as possible, with the first devices receiving one more row when
+     * they cannot be split equally.
+     *
+     * @param data The data to shard
+     * @param rowSize Number of elements in each row of the leading dimension
+     * @param tensorType The type of the tensors created on each device
+     * @return The shard of each device in device order
+     */
+    std::vector<std::shared_ptr<Tensor>> shard(
+      const std::vector<float>& data,
+      uint32_t rowSize = 1,
+      Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice);
+
+    /**
+     * Creates a full copy of the data in the memory of each device, as used
+     * for weights shared by all the shards.
+     *
+     * @param data The data to replicate
+     * @param tensorType The type of the tensors created on each device
+     * @return The copy of each device in device order
+     */
+    std::vector<std::shared_ptr<Tensor>> replicate(
+      const std::vector<float>& data,
+      Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice);
+
+    /**
+     * Syncs the shards of each device into local memory in parallel and
+     * concatenates them in device order.
+     *
+     * @param shards The shard of each device in device order
+     * @return The gathered data
+     */
+    std::vector<float> gather(
+      const std::vector<std::shared_ptr<Tensor>>& shards);
+
+    /**
+     * Reduces tensors of the same size across the devices on the host, such
+     * as the gradients computed from each shard, and syncs the result back
+     * into the tensor of each device.
+     *
+     * @param tensors The tensor of each device in device order
+     * @param reduceOp The reduction to apply element wise
+     * @return The reduced data
+     */
+    std::vector<float> allReduce(
+      const std::vector<std::shared_ptr<Tensor>>& tensors,
+      ReduceOps reduceOp = ReduceOps::eSum);
+
+    /**
+     * Evaluates the same operation on every device in parallel, which
+     * receives the shard of each of the sharded tensors provided for its
+     * device, and waits for all of them to finish, throwing if the
+     * evaluation of any device failed.
+     *
+     * @param shardedTensors The shards of each tensor of the operation, as
+     * returned by shard or replicate
+     * @param params Template parameters that will be used to initialise
+     * Operation to allow for extensible configurations on initialisation
+     */
+    template<typename T, typename... TArgs>
+    void evalOp(
+      const std::vector<std::vector<std::shared_ptr<Tensor>>>& shardedTensors,
+      const TArgs&... params)
+    {
+        SPDLOG_DEBUG("Kompute MultiDeviceManager evalOp triggered");
+
+        std::vector<EvalFuture> futures;
+        try {
+            for (uint32_t i = 0; i < this->mManagers.size(); i++) {
+                futures.push_back(this->mManagers[i]->evalOpAsyncDefault<T>(
+                  this->deviceTensors(shardedTensors, i), params...));
+            }
+        } catch (...) {
+            this->awaitAll(futures, std::current_exception());
+        }
+        this->awaitAll(futures);
+    }
+
+  private:
+    // -------------- ALWAYS OWNED RESOURCES
+    std::vector<std::shared_ptr<Manager>> mManagers;
+
+    std::vector<std::shared_ptr<Tensor>> deviceTensors(
+      const std::vector<std::vector<std::shared_ptr<Tensor>>>& shardedTensors,
+      uint32_t deviceIndex);
+    void awaitAll(std::vector<EvalFuture>& futures,
+                  std::exception_ptr exception = nullptr);
+    void validateTensors(const std::vector<std::shared_ptr<Tensor>>& tensors);
+};
+
+} // End namespace kp
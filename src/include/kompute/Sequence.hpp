@@ -1,15 +1,25 @@
 #pragma once
 
+#include <mutex>
+
 #include "kompute/Core.hpp"
 
+#include "kompute/DescriptorPoolArena.hpp"
+#include "kompute/SequenceAwaitable.hpp"
+#include "kompute/ShaderCache.hpp"
+
+#include "kompute/operations/OpAlgoBase.hpp"
 #include "kompute/operations/OpBase.hpp"
+#include "kompute/operations/OpTensorCreate.hpp"
 
 namespace kp {
 
+class CompletionThread;
+
 /**
  *  Container of operations that can be sent to GPU as batch
  */
-class Sequence
+class Sequence : public std::enable_shared_from_this<Sequence>
 {
   public:
     /**
@@ -25,11 +35,26 @@ class Sequence
      * @param device Vulkan logical device
      * @param computeQueue Vulkan compute queue
      * @param queueIndex Vulkan compute queue index in device
+     * @param shaderCache (Optional) Shader cache to share across the
+     * algorithm operations recorded in this sequence
+     * @param descriptorPoolArena (Optional) Descriptor pool arena to allocate
+     * the descriptor sets of the algorithm operations recorded in this sequence
+     * @param queueMutex (Optional) Mutex held while submitting into the compute
+     * queue, which has to be provided if the queue is shared with other
+     * sequences that may be evaluated from other threads
+     * @param enabledExtensions (Optional) Extensions enabled in the device,
+     * which are passed to the tensors created by the operations recorded in
+     * this sequence
      */
-    Sequence(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
-             std::shared_ptr<vk::Device> device,
-             std::shared_ptr<vk::Queue> computeQueue,
-             uint32_t queueIndex);
+    Sequence(
+      std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+      std::shared_ptr<vk::Device> device,
+      std::shared_ptr<vk::Queue> computeQueue,
+      uint32_t queueIndex,
+      std::shared_ptr<ShaderCache> shaderCache = nullptr,
+      std::shared_ptr<DescriptorPoolArena> descriptorPoolArena = nullptr,
+      std::shared_ptr<std::mutex> queueMutex = nullptr,
+      const std::vector<std::string>& enabledExtensions = {});
     /**
      * Destructor for sequence which is responsible for cleaning all subsequent
      * owned operations.
@@ -79,11 +104,49 @@ class Sequence
      * Eval Await waits for the fence to finish processing and then once it
      * finishes, it runs the postEval of all operations.
      *
-     * @param waitFor Number of milliseconds to wait before timing out.
+     * @param waitFor Number of nanoseconds to wait before timing out. If the
+     * wait times out the sequence remains running and evalAwait can be called
+     * again.
      * @return Boolean stating whether execution was successful.
      */
     bool evalAwait(uint64_t waitFor = UINT64_MAX);
 
+    /**
+     * Returns true if the GPU has finished executing the submission of the
+     * last evalAsync without blocking, which allows polling a running
+     * sequence. Once it returns true evalAwait can be called to run the
+     * postEval of the operations without waiting.
+     *
+     * @return Boolean stating whether the submitted work has completed, which
+     * is also true if the sequence is not running.
+     */
+    bool isComplete();
+
+    /**
+     * Sets the completion thread that awaits the sequence when it is
+     * evaluated through evalCoro, which the manager sets on the sequences it
+     * creates when built with coroutines enabled.
+     *
+     * @param completionThread The completion thread of the manager
+     */
+    void setCompletionThread(
+      std::shared_ptr<CompletionThread> completionThread);
+
+#if KOMPUTE_ENABLE_COROUTINES
+    /**
+     * Returns a C++20 awaitable which submits the recorded operations when
+     * awaited with co_await, and resumes the coroutine once the completion
+     * thread has awaited the sequence and run the postEval of the operations.
+     * The sequence must be owned by a shared pointer and have a completion
+     * thread set, as is the case for the sequences created by the manager.
+     *
+     * @param executor (Optional) Executor to resume the coroutine with, which
+     * otherwise is resumed in the completion thread
+     * @return Awaitable which evaluates to whether execution was successful
+     */
+    SequenceAwaitable evalCoro(CoroExecutor executor = nullptr);
+#endif
+
     /**
      * Returns true if the sequence is currently in recording activated.
      *
@@ -106,6 +169,17 @@ class Sequence
      */
     bool isInit();
 
+    /**
+     * Returns the mutex that guards the command pool and command buffer owned
+     * by the sequence. Vulkan command pools are externally synchronized, so
+     * this mutex has to be held by any thread that records or evaluates the
+     * sequence while other threads may use it, which is how the manager
+     * serialises concurrent evaluations of the same named sequence.
+     *
+     * @return Reference to the mutex of the sequence
+     */
+    std::mutex& mutex();
+
     /**
      * Destroys and frees the GPU resources which include the buffer and memory
      * and sets the sequence as init=False.
@@ -148,6 +222,21 @@ class Sequence
 
         std::unique_ptr<OpBase> baseOpPtr{ baseOp };
 
+        if (OpAlgoBase* algoOp = dynamic_cast<OpAlgoBase*>(baseOp)) {
+            if (this->mShaderCache) {
+                SPDLOG_DEBUG("Kompute Sequence setting shader cache");
+                algoOp->setShaderCache(this->mShaderCache);
+            }
+            if (this->mDescriptorPoolArena) {
+                SPDLOG_DEBUG("Kompute Sequence setting descriptor pool arena");
+                algoOp->setDescriptorPoolArena(this->mDescriptorPoolArena);
+            }
+        }
+        if (OpTensorCreate* createOp = dynamic_cast<OpTensorCreate*>(baseOp)) {
+            SPDLOG_DEBUG("Kompute Sequence setting enabled extensions");
+            createOp->setEnabledExtensions(this->mEnabledExtensions);
+        }
+
         SPDLOG_DEBUG(
           "Kompute Sequence running init on OpBase derived class instance");
         baseOpPtr->init();
@@ -167,6 +256,13 @@ class Sequence
     std::shared_ptr<vk::Device> mDevice = nullptr;
     std::shared_ptr<vk::Queue> mComputeQueue = nullptr;
     uint32_t mQueueIndex = -1;
+    std::shared_ptr<ShaderCache> mShaderCache = nullptr;
+    std::shared_ptr<DescriptorPoolArena> mDescriptorPoolArena = nullptr;
+    std::shared_ptr<std::mutex> mQueueMutex = nullptr;
+    std::vector<std::string> mEnabledExtensions;
+    // Declared regardless of KOMPUTE_ENABLE_COROUTINES so the layout of the
+    // class does not depend on whether coroutines are enabled
+    std::shared_ptr<CompletionThread> mCompletionThread = nullptr;
 
     // -------------- OPTIONALLY OWNED RESOURCES
     std::shared_ptr<vk::CommandPool> mCommandPool = nullptr;
@@ -176,7 +272,9 @@ class Sequence
 
     // -------------- ALWAYS OWNED RESOURCES
     vk::Fence mFence;
+    uint64_t mSubmission = 0;
     std::vector<std::unique_ptr<OpBase>> mOperations;
+    std::mutex mMutex;
 
     // State
     bool mIsInit = false;
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <functional>
+
+#include "kompute/Core.hpp"
+
+#include "kompute/EvalFuture.hpp"
+
+#if KOMPUTE_ENABLE_COROUTINES
+
+#include <coroutine>
+
+namespace kp {
+
+class Sequence;
+class CompletionThread;
+
+/**
+ * Executor used to resume the coroutines awaiting a sequence, which receives
+ * the function that resumes the coroutine and is expected to run it, for
+ * example by posting it into the event loop of the application.
+ */
+typedef std::function<void(std::function<void()>)> CoroExecutor;
+
+/**
+ * C++20 awaitable returned by kp::Sequence::evalCoro, which submits the
+ * recorded sequence when awaited and suspends the awaiting coroutine until
+ * the completion thread of the manager has awaited the sequence. A single
+ * completion thread serves all the sequences of the manager, so any number of
+ * coroutines can be suspended on in flight GPU work without a thread each.
+ *
+ * This is only available when Kompute is built with
+ * KOMPUTE_OPT_ENABLE_COROUTINES, which compiles the library as C++20.
+ */
+class SequenceAwaitable
+{
+  public:
+    /**
+     * Constructor with the sequence to submit and the completion thread that
+     * will await it.
+     *
+     * @param sequence The recorded sequence to evaluate
+     * @param completionThread The completion thread that awaits the sequence
+     * @param executor (Optional) Executor to resume the coroutine with, which
+     * otherwise is resumed in the completion thread
+     */
+    SequenceAwaitable(std::shared_ptr<Sequence> sequence,
+                      std::shared_ptr<CompletionThread> completionThread,
+                      CoroExecutor executor = nullptr);
+
+    /**
+     * The sequence is always submitted when awaited, so the coroutine is
+     * never resumed straight away.
+     *
+     * @return Always false
+     */
+    bool await_ready() noexcept;
+
+    /**
+     * Submits the sequence and schedules the resumption of the coroutine once
+     * the completion thread has awaited it.
+     *
+     * @param handle Handle of the awaiting coroutine
+     * @return False if the sequence could not be submitted, in which case the
+     * coroutine continues without suspending
+     */
+    bool await_suspend(std::coroutine_handle<> handle);
+
+    /**
+     * Returns the result of the evaluation once the coroutine is resumed,
+     * rethrowing any exception raised by the postEval of the operations.
+     *
+     * @return Boolean stating whether the evaluation was successful
+     */
+    bool await_resume();
+
+  private:
+    std::shared_ptr<Sequence> mSequence;
+    std::shared_ptr<CompletionThread> mCompletionThread;
+    CoroExecutor mExecutor;
+    EvalFuture mFuture;
+};
+
+} // End namespace kp
+
+#endif // KOMPUTE_ENABLE_COROUTINES
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+
+#include "kompute/Core.hpp"
+
+namespace kp {
+
+/**
+ * Cache of Vulkan shader modules which is owned by the Manager and shared
+ * across all the operations that are recorded in its sequences. Shaders
+ * loaded from files are memory mapped and created only once per path, and are
+ * replaced when the file is modified, and shaders provided as data are
+ * created only once per unique content, identified by a hash of the content,
+ * which avoids reading and compiling the same shader every time an operation
+ * is recorded.
+ */
+class ShaderCache
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    ShaderCache();
+
+    /**
+     * Default constructor with the device that will be used to create the
+     * shader modules.
+     *
+     * @param device Vulkan logical device to create the shader modules with
+     */
+    ShaderCache(std::shared_ptr<vk::Device> device);
+
+    /**
+     * Destructor which destroys all the shader modules owned by the cache.
+     */
+    ~ShaderCache();
+
+    /**
+     * Retrieves the shader module for the file provided, or creates it by
+     * memory mapping the file if it has not been loaded before or if the file
+     * has been modified since it was last loaded, in which case the shader
+     * module of the previous version is destroyed.
+     *
+     * @param shaderFilePath Path to the shader in either spirv or raw format
+     * @return Shared pointer to the cache owned shader module
+     */
+    std::shared_ptr<vk::ShaderModule> getOrCreateFromFile(
+      const std::string& shaderFilePath);
+
+    /**
+     * Retrieves the shader module for the shader data provided, or creates it
+     * if no shader module with the same content has been created before.
+     *
+     * @param shaderFileData The bytes of the shader in spirv or raw format
+     * @return Shared pointer to the cache owned shader module
+     */
+    std::shared_ptr<vk::ShaderModule> getOrCreateFromData(
+      const std::vector<char>& shaderFileData);
+
+    /**
+     * Returns the number of shader modules currently owned by the cache.
+     *
+     * @return Number of shader modules in the cache
+     */
+    size_t size();
+
+    /**
+     * Destroys all the shader modules owned by the cache. Shader modules are
+     * only required during pipeline creation so existing algorithms are not
+     * affected.
+     */
+    void freeMemoryDestroyGPUResources();
+
+  private:
+    struct FileShaderEntry
+    {
+        std::shared_ptr<vk::ShaderModule> shaderModule;
+        time_t modificationTime = 0;
+        size_t size = 0;
+    };
+
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::Device> mDevice;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::mutex mMutex;
+    std::unordered_map<std::string, FileShaderEntry> mFileShaderModules;
+    std::unordered_map<uint64_t, std::shared_ptr<vk::ShaderModule>>
+      mDataShaderModules;
+
+    // Create util functions
+    std::shared_ptr<vk::ShaderModule> createShaderModule(const char* data,
+                                                         size_t size);
+    static uint64_t hashShaderData(const std::vector<char>& shaderFileData);
+};
+
+} // End namespace kp
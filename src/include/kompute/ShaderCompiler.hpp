@@ -0,0 +1,56 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+namespace kp {
+
+/**
+ * Converts the shaders provided to algorithms into the SPIR-V binary format
+ * that is required by vkCreateShaderModule. SPIR-V binaries are returned
+ * unchanged, and GLSL compute shader source, such as the shaders generated
+ * by the operations at runtime, is compiled with glslang when Kompute is
+ * built with KOMPUTE_OPT_ENABLE_SHADER_COMPILATION. Without it GLSL source is
+ * passed to the driver as it is, which is only accepted by devices with the
+ * VK_NV_glsl_shader extension.
+ */
+class ShaderCompiler
+{
+  public:
+    /**
+     * Returns true if the data provided starts with the SPIR-V magic number.
+     *
+     * @param data The bytes of the shader
+     * @param size The number of bytes of the shader
+     * @return Boolean stating whether the shader is a SPIR-V binary
+     */
+    static bool isSpirv(const char* data, size_t size);
+
+    /**
+     * Returns true if Kompute was built with the runtime shader compiler.
+     *
+     * @return Boolean stating whether GLSL source can be compiled
+     */
+    static bool isCompilationEnabled();
+
+    /**
+     * Compiles GLSL compute shader source into SPIR-V targeting Vulkan 1.1,
+     * throwing with the log of the compiler if it fails or if Kompute was
+     * built without the runtime shader compiler.
+     *
+     * @param source The GLSL source of the compute shader
+     * @return The bytes of the SPIR-V binary
+     */
+    static std::vector<char> compileSource(const std::string& source);
+
+    /**
+     * Returns the SPIR-V binary of the shader provided, compiling it if it is
+     * GLSL source and the runtime shader compiler is enabled.
+     *
+     * @param data The bytes of the shader in spirv or raw format
+     * @param size The number of bytes of the shader
+     * @return The bytes of the shader to create the shader module with
+     */
+    static std::vector<char> toSpirv(const char* data, size_t size);
+};
+
+} // End namespace kp
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Tensor.hpp"
+
+#define KP_SPARSE_ELL_VECTOR_SIZE 4
+
+namespace kp {
+
+/**
+ * Sparse matrix that bundles the kp::Tensor of its indices and non zero
+ * values, which are used by kp::OpSpMV and kp::OpSpMM. The indices are stored
+ * as the bits of 32 bit unsigned integers in the float tensors.
+ *
+ * In the CSR format the matrix holds the offsets of the rows into the column
+ * indices and values of the non zero elements. In the ELL format every row is
+ * padded with zeros to the number of non zero elements of the longest row,
+ * rounded up to a multiple of KP_SPARSE_ELL_VECTOR_SIZE. The padded rows are
+ * stored in slices of KP_SPARSE_ELL_VECTOR_SIZE columns, where the slices of
+ * consecutive rows are contiguous, so each invocation loads a vector of
+ * elements of its row and consecutive invocations load consecutive vectors.
+ * ELL is faster when the rows have a similar number of non zero elements,
+ * while CSR does not waste memory on padding when they do not.
+ */
+class SparseTensor
+{
+  public:
+    /**
+     * Storage formats of the sparse matrix.
+     */
+    enum class SparseFormats
+    {
+        eCSR = 0,
+        eELL = 1,
+    };
+
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    SparseTensor();
+
+    /**
+     * Constructor with the matrix in CSR format, which is converted when the
+     * format requested is ELL.
+     *
+     * @param rows Number of rows of the matrix
+     * @param columns Number of columns of the matrix
+     * @param rowOffsets Offsets of each row into the column indices and values, followed by the number of non zero elements
+     * @param columnIndices Column of each non zero element
+     * @param values Value of each non zero element
+     * @param format Format of the tensors of the matrix
+     * @param tensorType Type for the tensors which is of type TensorTypes
+     */
+    SparseTensor(uint32_t rows,
+                 uint32_t columns,
+                 const std::vector<uint32_t>& rowOffsets,
+                 const std::vector<uint32_t>& columnIndices,
+                 const std::vector<float>& values,
+                 SparseFormats format = SparseFormats::eCSR,
+                 Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice);
+
+    /**
+     * Constructor with a dense matrix in row major order, from which the non
+     * zero elements are kept.
+     *
+     * @param dense Values of the dense matrix in row major order
+     * @param rows Number of rows of the matrix
+     * @param columns Number of columns of the matrix
+     * @param format Format of the tensors of the matrix
+     * @param tensorType Type for the tensors which is of type TensorTypes
+     */
+    SparseTensor(const std::vector<float>& dense,
+                 uint32_t rows,
+                 uint32_t columns,
+                 SparseFormats format = SparseFormats::eCSR,
+                 Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice);
+
+    /**
+     * Returns the format of the tensors of the matrix.
+     *
+     * @return The format of the matrix
+     */
+    SparseFormats format();
+
+    /**
+     * Returns the number of rows of the matrix.
+     *
+     * @return The number of rows
+     */
+    uint32_t rows();
+
+    /**
+     * Returns the number of columns of the matrix.
+     *
+     * @return The number of columns
+     */
+    uint32_t columns();
+
+    /**
+     * Returns the number of non zero elements of the matrix, without the
+     * padding of the ELL format.
+     *
+     * @return The number of non zero elements
+     */
+    uint32_t nonZeros();
+
+    /**
+     * Returns the number of elements stored for each row in the ELL format,
+     * including the padding, or zero in the CSR format.
+     *
+     * @return The padded width of the rows
+     */
+    uint32_t ellWidth();
+
+    /**
+     * Returns the tensor with the offsets of the rows in the CSR format, or
+     * nullptr in the ELL format.
+     *
+     * @return Shared pointer to the tensor of row offsets
+     */
+    std::shared_ptr<Tensor> rowOffsets();
+
+    /**
+     * Returns the tensor with the column of each stored element.
+     *
+     * @return Shared pointer to the tensor of column indices
+     */
+    std::shared_ptr<Tensor> columnIndices();
+
+    /**
+     * Returns the tensor with the value of each stored element.
+     *
+     * @return Shared pointer to the tensor of values
+     */
+    std::shared_ptr<Tensor> values();
+
+    /**
+     * Returns all the tensors of the matrix, which can be used to create or
+     * synchronise them together.
+     *
+     * @return Vector containing the tensors of the matrix
+     */
+    std::vector<std::shared_ptr<Tensor>> tensors();
+
+    /**
+     * Expands the host data of the tensors into a dense matrix, which
+     * reflects the device data after the tensors are synchronised.
+     *
+     * @return Values of the dense matrix in row major order
+     */
+    std::vector<float> dense();
+
+  private:
+    // -------------- ALWAYS OWNED RESOURCES
+    SparseFormats mFormat = SparseFormats::eCSR;
+    uint32_t mRows = 0;
+    uint32_t mColumns = 0;
+    uint32_t mNonZeros = 0;
+    uint32_t mEllWidth = 0;
+    std::shared_ptr<Tensor> mRowOffsets;
+    std::shared_ptr<Tensor> mColumnIndices;
+    std::shared_ptr<Tensor> mValues;
+
+    void initTensors(const std::vector<uint32_t>& rowOffsets,
+                     const std::vector<uint32_t>& columnIndices,
+                     const std::vector<float>& values,
+                     Tensor::TensorTypes tensorType);
+};
+
+} // End namespace kp
@@ -2,7 +2,7 @@
 
 #include "kompute/Core.hpp"
 
-#define KP_MAX_DIM_SIZE 1
+#define KP_MAX_DIM_SIZE 4
 
 namespace kp {
 
@@ -14,7 +14,7 @@ namespace kp {
  * would be used to store their respective data. The tensors can be used for GPU
  * data storage or transfer.
  */
-class Tensor
+class Tensor : public std::enable_shared_from_this<Tensor>
 {
   public:
     /**
@@ -30,6 +30,25 @@ class Tensor
         eStorage = 2, ///< Type is Device memory (only)
     };
 
+    /**
+     * Contiguous range of elements of a tensor, used to transfer only part of
+     * the data of the tensor between the host and the device.
+     */
+    struct Range
+    {
+        uint32_t offset; ///< Index of the first element in the range
+        uint32_t size;   ///< Number of elements in the range
+    };
+
+    /**
+     * Sorts the ranges provided and merges the ones that overlap or are
+     * adjacent, so they can be transferred with the least copy regions.
+     *
+     * @param ranges Ranges of elements to coalesce
+     * @return Sorted ranges without overlapping or adjacent ranges
+     */
+    static std::vector<Range> coalesceRanges(std::vector<Range> ranges);
+
     /**
      *  Base constructor, should not be used unless explicitly intended.
      */
@@ -37,14 +56,37 @@ class Tensor
 
     /**
      *  Default constructor with data provided which would be used to create the
-     * respective vulkan buffer and memory.
+     * respective vulkan buffer and memory. The data is moved into the tensor
+     * so temporary vectors are not copied.
      *
      *  @param data Vector of data that will be used by the tensor
      *  @param tensorType Type for the tensor which is of type TensorTypes
      */
-    Tensor(const std::vector<float>& data,
+    Tensor(std::vector<float> data,
            TensorTypes tensorType = TensorTypes::eDevice);
 
+    /**
+     * Constructor that wraps existing host memory instead of holding a data
+     * vector, which is imported as the memory of the vulkan buffer through
+     * VK_EXT_external_memory_host so the GPU reads and writes it directly
+     * without any memcpy. The pointer and the size in bytes must be aligned to
+     * the minImportedHostPointerAlignment of the device (usually the page
+     * size), and the memory must remain valid until the tensor is destroyed.
+     * When the extension is not among the enabled extensions passed to init, or
+     * the pointer or size are not aligned, the tensor falls back to host
+     * visible memory and the data is copied between the pointer and the memory
+     * when mapped.
+     *
+     * The host data of the tensor is the memory pointed to, so data() returns
+     * an empty vector and setData copies into the memory pointed to.
+     *
+     *  @param data Pointer to the host memory to wrap
+     *  @param size Number of elements in the host memory
+     *  @param tensorType Type for the tensor, which can only be
+     * TensorTypes::eStaging or TensorTypes::eStorage
+     */
+    Tensor(float* data, uint32_t size, TensorTypes tensorType);
+
     /**
      * Destructor which is in charge of freeing vulkan resources unless they
      * have been provided externally.
@@ -56,9 +98,16 @@ class Tensor
      * as well as creates the respective staging tensors. The staging tensors
      * would only be created for the tensors of type TensorType::eDevice as
      * otherwise there is no need to copy from host memory.
+     *
+     * @param physicalDevice Vulkan physical device of the buffer memory
+     * @param device Vulkan logical device to create the buffer with
+     * @param enabledExtensions (Optional) Extensions enabled in the device,
+     * where VK_EXT_external_memory_host allows importing the host memory of
+     * tensors wrapping a host pointer
      */
     void init(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
-              std::shared_ptr<vk::Device> device);
+              std::shared_ptr<vk::Device> device,
+              const std::vector<std::string>& enabledExtensions = {});
 
     /**
      * Destroys and frees the GPU resources which include the buffer and memory.
@@ -68,12 +117,23 @@ class Tensor
     /**
      * Returns the vector of data currently contained by the Tensor. It is
      * important to ensure that there is no out-of-sync data with the GPU
-     * memory.
+     * memory. Tensors wrapping host memory return an empty vector, and views
+     * return a copy of their range of the data of the parent tensor, which is
+     * refreshed on every call, so views are modified through setData,
+     * the subscript operator or hostData instead.
      *
      * @return Reference to vector of elements representing the data in the
      * tensor.
      */
     std::vector<float>& data();
+    /**
+     * Returns a pointer to the host data of the tensor, which for tensors
+     * wrapping host memory is the host pointer and for views points into the
+     * data of the parent tensor at the offset of the view.
+     *
+     * @return Pointer to the first element of the host data of the tensor
+     */
+    float* hostData();
     /**
      * Overrides the subscript operator to expose the underlying data's
      * subscript operator which in this case would be its underlying
@@ -90,6 +150,20 @@ class Tensor
      * @return Unsigned integer representing the total number of elements
      */
     uint32_t size();
+    /**
+     * Returns the size in bytes of the data of the Tensor, which is also the
+     * size of its buffer or of its range in the parent buffer for views.
+     *
+     * @return Unsigned integer representing the size in bytes
+     */
+    uint64_t memorySize();
+    /**
+     * Returns the offset in bytes where the data of the Tensor starts in its
+     * buffer, which is always zero unless the tensor is a view.
+     *
+     * @return Unsigned integer representing the offset in bytes
+     */
+    uint64_t memoryOffset();
     /**
      * Returns the shape of the tensor, which includes the number of dimensions
      * and the size per dimension.
@@ -98,6 +172,15 @@ class Tensor
      * respective dimension is not active.
      */
     std::array<uint32_t, KP_MAX_DIM_SIZE> shape();
+    /**
+     * Sets the shape of the tensor without modifying its data, which is used
+     * by the operations that broadcast their inputs. Tensors are created with
+     * a single dimension of the size of their data.
+     *
+     * @param shape The size of each dimension, outermost first, whose product
+     * must match the size of the tensor
+     */
+    void reshape(const std::vector<uint32_t>& shape);
     /**
      * Retrieve the tensor type of the Tensor
      *
@@ -110,17 +193,112 @@ class Tensor
      * provisioned.
      */
     bool isInit();
+    /**
+     * Creates a view over a contiguous range of the elements of the tensor,
+     * which shares the vulkan buffer and memory of the tensor instead of
+     * allocating its own. Views can be bound to shaders and used as the source
+     * or destination of copies and syncs, which only transfer the range of the
+     * view. Views of views are created over the original tensor with the
+     * offsets combined, and the tensor must be owned by a shared pointer.
+     *
+     * The view does not hold host data of its own, so it reads and writes the
+     * respective range of the host data of the tensor, and changes made to
+     * the tensor data after the view is created are seen by the view. The view
+     * is initialised once
+     * the tensor is initialised, so views can be created before or after the
+     * tensor is created with OpTensorCreate, but not created on their own.
+     *
+     * @param offset Number of elements from the start of the tensor where the
+     * view starts
+     * @param size Number of elements in the view
+     * @return Shared pointer to the view
+     */
+    std::shared_ptr<Tensor> view(uint32_t offset, uint32_t size);
+    /**
+     * Returns true if the tensor is a view over the memory of another tensor.
+     *
+     * @return Boolean stating whether the tensor is a view
+     */
+    bool isView();
+    /**
+     * Retrieves the tensor that owns the memory of a view.
+     *
+     * @return The parent tensor of the view, or nullptr if the tensor is not a
+     * view
+     */
+    std::shared_ptr<Tensor> parent();
+    /**
+     * Retrieves the host memory wrapped by the tensor.
+     *
+     * @return Pointer to the host memory, or nullptr if the tensor holds a
+     * data vector instead
+     */
+    float* hostPointer();
+    /**
+     * Returns true if the host memory wrapped by the tensor has been imported
+     * as the memory of its buffer, or false if the tensor does not wrap host
+     * memory or fell back to copying it into host visible memory.
+     *
+     * @return Boolean stating whether the host memory is used by the GPU
+     */
+    bool isHostMemoryImported();
+    /**
+     * Returns true if the tensor is of type TensorTypes::eDevice and was
+     * allocated in device local memory that is also host visible, as found in
+     * integrated GPUs, CPU implementations and devices with resizable BAR.
+     * These tensors are mapped directly by the sync operations instead of
+     * copied through staging tensors.
+     *
+     * @return Boolean stating whether the tensor memory is host visible
+     */
+    bool isUnifiedMemory();
 
     /**
      * Sets / resets the vector data of the tensor. This function does not
      * perform any copies into GPU memory and is only performed on the host.
+     * For views the respective range of the parent data is also updated.
      */
     void setData(const std::vector<float>& data);
+    /**
+     * Sets the vector data of the tensor only in the ranges provided, from
+     * the elements in the same positions of the data provided. This function
+     * is only performed on the host.
+     *
+     * @param data Vector of data with the same size as the tensor
+     * @param ranges Ranges of elements to set
+     */
+    void setData(const std::vector<float>& data,
+                 const std::vector<Range>& ranges);
+
+    /**
+     * Marks a range of the host data as modified, so that the following
+     * OpTensorSyncDevice only transfers the modified ranges of the tensor
+     * instead of all of its data. Ranges marked are coalesced with the ranges
+     * already marked. When no range has been marked the whole tensor is
+     * considered modified, as changes made through data() cannot be tracked.
+     *
+     * @param offset Index of the first element modified
+     * @param size Number of elements modified
+     */
+    void markDirty(uint32_t offset, uint32_t size);
+    /**
+     * Retrieves the coalesced ranges marked as modified in the host data.
+     *
+     * @return Ranges of elements modified since they were last cleared
+     */
+    std::vector<Range> dirtyRanges();
+    /**
+     * Clears the ranges marked as modified, which is done by
+     * OpTensorSyncDevice when it is evaluated.
+     */
+    void clearDirtyRanges();
 
     /**
      * Records a copy from the memory of the tensor provided to the current
      * thensor. This is intended to pass memory into a processing, to perform
-     * a staging buffer transfer, or to gather output (between others).
+     * a staging buffer transfer, or to gather output (between others). Only
+     * the range of the current tensor is copied, so either tensor can be a
+     * view, and the tensor copied from must be at least as large.
      *
      * @param commandBuffer Vulkan Command Buffer to record the commands into
      * @param copyFromTensor Tensor to copy the data from
@@ -131,6 +309,50 @@ class Tensor
                         std::shared_ptr<Tensor> copyFromTensor,
                         bool createBarrier);
 
+    /**
+     * Records a copy of the ranges provided from the memory of the tensor
+     * provided to the current tensor, with one copy region per range at the
+     * same element offsets in both tensors.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the commands into
+     * @param copyFromTensor Tensor to copy the data from
+     * @param ranges Ranges of elements to copy
+     * @param createBarrier Whether to create a barrier that ensures the data is
+     * copied before further operations.
+     */
+    void recordCopyFrom(std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                        std::shared_ptr<Tensor> copyFromTensor,
+                        const std::vector<Range>& ranges,
+                        bool createBarrier);
+
+    /**
+     * Records a copy of the regions provided from an external buffer into the
+     * memory of the current tensor, where the destination offsets of the
+     * regions are relative to the start of the tensor (or of the view range).
+     * This is used to
+     * transfer data in chunks from staging buffers not owned by a tensor.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the commands into
+     * @param buffer Vulkan buffer to copy the data from
+     * @param copyRegions Regions to copy with offsets in bytes
+     */
+    void recordCopyFromBuffer(std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                              const vk::Buffer& buffer,
+                              const std::vector<vk::BufferCopy>& copyRegions);
+
+    /**
+     * Records a copy of the regions provided from the memory of the current
+     * tensor into an external buffer, where the source offsets of the regions
+     * are relative to the start of the tensor (or of the view range).
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the commands into
+     * @param buffer Vulkan buffer to copy the data into
+     * @param copyRegions Regions to copy with offsets in bytes
+     */
+    void recordCopyToBuffer(std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                            const vk::Buffer& buffer,
+                            const std::vector<vk::BufferCopy>& copyRegions);
+
     /**
      * Records the buffer memory barrier into the command buffer which
      * ensures that relevant data transfers are carried out correctly.
@@ -151,21 +373,39 @@ class Tensor
     /**
      * Constructs a vulkan descriptor buffer info which can be used to specify
      * and reference the underlying buffer component of the tensor without
-     * exposing it.
+     * exposing it. Views are bound with their offset and range in the buffer
+     * of the parent, which must be aligned to the minimum storage buffer
+     * offset alignment of the device.
      *
      * @return Descriptor buffer info with own buffer
      */
     vk::DescriptorBufferInfo constructDescriptorBufferInfo();
     /**
      * Maps data from the Host Visible GPU memory into the data vector. It
-     * requires the Tensor to be of staging type for it to work.
+     * requires the Tensor to be of staging type, or a device tensor in unified
+     * memory, for it to work.
      */
     void mapDataFromHostMemory();
+    /**
+     * Maps the ranges provided from the Host Visible GPU memory into the data
+     * vector. It requires the Tensor to be of staging type for it to work.
+     *
+     * @param ranges Ranges of elements to map
+     */
+    void mapDataFromHostMemory(const std::vector<Range>& ranges);
     /**
      * Maps data from the data vector into the Host Visible GPU memory. It
-     * requires the tensor to be of staging type for it to work.
+     * requires the tensor to be of staging type, or a device tensor in unified
+     * memory, for it to work.
      */
     void mapDataIntoHostMemory();
+    /**
+     * Maps the ranges provided from the data vector into the Host Visible GPU
+     * memory. It requires the tensor to be of staging type for it to work.
+     *
+     * @param ranges Ranges of elements to map
+     */
+    void mapDataIntoHostMemory(const std::vector<Range>& ranges);
 
   private:
     // -------------- NEVER OWNED RESOURCES
@@ -181,17 +421,32 @@ class Tensor
     // -------------- ALWAYS OWNED RESOURCES
     std::vector<float> mData;
 
+    std::shared_ptr<Tensor> mParent;
+    uint32_t mOffset = 0;
+    std::vector<Range> mDirtyRanges;
+    float* mHostPointer = nullptr;
+    bool mIsHostMemoryImported = false;
+    bool mIsExternalMemoryHostEnabled = false;
+    bool mIsUnifiedMemory = false;
+
     TensorTypes mTensorType = TensorTypes::eDevice;
 
-    std::array<uint32_t, KP_MAX_DIM_SIZE> mShape;
+    std::array<uint32_t, KP_MAX_DIM_SIZE> mShape = {};
     bool mIsInit = false;
 
     void createBuffer(); // Creates the vulkan buffer
+    bool createHostPointerBuffer(); // Imports the host memory as buffer memory
 
     // Private util functions
+    std::shared_ptr<vk::Buffer> getBuffer();
+    std::shared_ptr<vk::DeviceMemory> getMemory();
+    std::shared_ptr<vk::Device> getDevice();
+    void validateRanges(const std::vector<Range>& ranges);
+    uint32_t findUnifiedMemoryTypeIndex(
+      const vk::PhysicalDeviceMemoryProperties& memoryProperties,
+      uint32_t memoryTypeBits);
     vk::BufferUsageFlags getBufferUsageFlags();
     vk::MemoryPropertyFlags getMemoryPropertyFlags();
-    uint64_t memorySize();
 };
 
 } // End namespace kp
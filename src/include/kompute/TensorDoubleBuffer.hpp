@@ -0,0 +1,94 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Tensor.hpp"
+
+namespace kp {
+
+/**
+ * Pair of tensors of the same size and type used by iterative kernels, where
+ * one tensor is read and the other is written on each iteration and the roles
+ * are swapped afterwards. This avoids copying the output back into the input
+ * between iterations, as only the descriptor bindings are alternated.
+ */
+class TensorDoubleBuffer
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    TensorDoubleBuffer();
+
+    /**
+     * Default constructor with the data that will be used to create both of
+     * the tensors, which initially contain the same data.
+     *
+     * @param data Vector of data that will be used by both tensors
+     * @param tensorType Type for both tensors which is of type TensorTypes
+     */
+    TensorDoubleBuffer(
+      const std::vector<float>& data,
+      Tensor::TensorTypes tensorType = Tensor::TensorTypes::eDevice);
+
+    /**
+     * Constructor with two existing tensors, where the first tensor is the
+     * one initially read from and the second the one initially written to.
+     *
+     * @param front Tensor that is initially read from
+     * @param back Tensor that is initially written to
+     */
+    TensorDoubleBuffer(std::shared_ptr<Tensor> front,
+                       std::shared_ptr<Tensor> back);
+
+    /**
+     * Returns the tensor that holds the latest data and is read from in the
+     * next iteration.
+     *
+     * @return Shared pointer to the tensor currently read from
+     */
+    std::shared_ptr<Tensor> read();
+
+    /**
+     * Returns the tensor that is written to in the next iteration.
+     *
+     * @return Shared pointer to the tensor currently written to
+     */
+    std::shared_ptr<Tensor> write();
+
+    /**
+     * Returns the tensor with the index provided, where the tensor with index
+     * 0 is the first tensor provided or created regardless of the roles.
+     *
+     * @param index The index of the tensor which is either 0 or 1
+     * @return Shared pointer to the tensor at the index provided
+     */
+    std::shared_ptr<Tensor> tensor(uint32_t index);
+
+    /**
+     * Returns both of the tensors in their creation order, which can be used
+     * to create or synchronise them together.
+     *
+     * @return Vector containing both tensors
+     */
+    std::vector<std::shared_ptr<Tensor>> tensors();
+
+    /**
+     * Returns the index of the tensor that is currently read from.
+     *
+     * @return Index of the read tensor which is either 0 or 1
+     */
+    uint32_t readIndex();
+
+    /**
+     * Swaps the read and write roles of the tensors.
+     */
+    void swap();
+
+  private:
+    // -------------- ALWAYS OWNED RESOURCES
+    std::shared_ptr<Tensor> mTensors[2];
+    uint32_t mReadIndex = 0;
+};
+
+} // End namespace kp
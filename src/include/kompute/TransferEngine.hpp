@@ -0,0 +1,236 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Tensor.hpp"
+
+#define KP_DEFAULT_TRANSFER_CHUNK_SIZE (16 * 1024 * 1024)
+#define KP_DEFAULT_TRANSFER_NUM_CHUNKS 2
+
+namespace kp {
+
+/**
+ * Streaming transfer engine that moves tensor data between the host and the
+ * device in chunks through a ring of persistently mapped staging buffers.
+ * Transfers are executed by a CPU worker thread, which fills the staging
+ * chunk k+1 while the GPU copies chunk k, and are submitted to the queue of
+ * the engine so they can overlap with compute submitted in other queues.
+ *
+ * The queue should preferably not be used by other sequences so transfers
+ * don't serialise with compute, and if it is shared the queue mutex has to be
+ * provided as Vulkan queue submissions are externally synchronized. It should
+ * belong to the same queue family as the queues that use the tensors, as the
+ * tensor buffers are created with exclusive sharing mode.
+ */
+class TransferEngine
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    TransferEngine();
+
+    /**
+     * Default constructor with the core vulkan components and the size of the
+     * staging ring used for the transfers.
+     *
+     * @param physicalDevice Vulkan physical device to find the memory types
+     * @param device Vulkan logical device to create the resources with
+     * @param queue Vulkan queue the transfers are submitted to
+     * @param queueIndex Vulkan queue family index of the queue
+     * @param chunkSize Size in bytes of each staging chunk
+     * @param numChunks Number of staging chunks in the ring, which is the
+     * number of chunk copies that can be in flight at the same time
+     * @param queueMutex (Optional) Mutex held while submitting into the queue,
+     * which has to be provided if the queue is shared with sequences
+     */
+    TransferEngine(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                   std::shared_ptr<vk::Device> device,
+                   std::shared_ptr<vk::Queue> queue,
+                   uint32_t queueIndex,
+                   uint64_t chunkSize = KP_DEFAULT_TRANSFER_CHUNK_SIZE,
+                   uint32_t numChunks = KP_DEFAULT_TRANSFER_NUM_CHUNKS,
+                   std::shared_ptr<std::mutex> queueMutex = nullptr);
+
+    /**
+     * Destructor which waits for the pending transfers and destroys the GPU
+     * resources owned by the engine.
+     */
+    ~TransferEngine();
+
+    /**
+     * Creates the command pool, the staging chunks and their command buffers
+     * and fences, and starts the worker thread.
+     */
+    void init();
+
+    /**
+     * Queues the upload of the host data of the tensors provided into their
+     * device memory and returns without waiting for it. The host data of the
+     * tensors must not be modified until the transfer finishes.
+     *
+     * @param tensors Tensors of type eDevice or eStaging to upload
+     * @return Future that becomes ready once the data is in device memory,
+     * which rethrows any error raised by the transfer
+     */
+    std::future<void> uploadAsync(std::vector<std::shared_ptr<Tensor>> tensors);
+
+    /**
+     * Queues the download of the device memory of the tensors provided into
+     * their host data and returns without waiting for it.
+     *
+     * @param tensors Tensors of type eDevice or eStaging to download
+     * @return Future that becomes ready once the host data has been updated,
+     * which rethrows any error raised by the transfer
+     */
+    std::future<void> downloadAsync(
+      std::vector<std::shared_ptr<Tensor>> tensors);
+
+    /**
+     * Uploads the host data of the tensors and waits until it is completed.
+     *
+     * @param tensors Tensors of type eDevice or eStaging to upload
+     */
+    void upload(std::vector<std::shared_ptr<Tensor>> tensors);
+
+    /**
+     * Downloads the device memory of the tensors and waits until it is
+     * completed.
+     *
+     * @param tensors Tensors of type eDevice or eStaging to download
+     */
+    void download(std::vector<std::shared_ptr<Tensor>> tensors);
+
+    /**
+     * Queues the copy of a tensor into a tensor of another manager, whose
+     * transfer engine is provided, and returns without waiting for it. When
+     * both engines share the logical device the buffers are copied directly,
+     * otherwise the data is bounced through the host in chunks, with the
+     * engine downloading chunk k+1 from its device while the destination
+     * engine uploads chunk k to the other device. The host data of the
+     * destination tensor is also updated, as with kp::OpTensorCopy.
+     *
+     * @param srcTensor Tensor of type eDevice or eStaging of this engine
+     * @param dstEngine Transfer engine of the device of the destination
+     * @param dstTensor Tensor of type eDevice or eStaging of the same size
+     * @return Future that becomes ready once the data is in the memory of the
+     * destination tensor, which rethrows any error raised by the transfer
+     */
+    std::future<void> copyToAsync(std::shared_ptr<Tensor> srcTensor,
+                                  std::shared_ptr<TransferEngine> dstEngine,
+                                  std::shared_ptr<Tensor> dstTensor);
+
+    /**
+     * Copies a tensor into a tensor of another manager and waits until it is
+     * completed.
+     *
+     * @param srcTensor Tensor of type eDevice or eStaging of this engine
+     * @param dstEngine Transfer engine of the device of the destination
+     * @param dstTensor Tensor of type eDevice or eStaging of the same size
+     */
+    void copyTo(std::shared_ptr<Tensor> srcTensor,
+                std::shared_ptr<TransferEngine> dstEngine,
+                std::shared_ptr<Tensor> dstTensor);
+
+    /**
+     * Returns the size in bytes of the staging chunks.
+     *
+     * @return Chunk size in bytes
+     */
+    uint64_t chunkSize();
+
+    /**
+     * Returns the number of staging chunks in the ring.
+     *
+     * @return Number of staging chunks
+     */
+    uint32_t numChunks();
+
+    /**
+     * Returns true if the init function has been carried out successfully.
+     *
+     * @return Boolean representing whether the engine is initialised
+     */
+    bool isInit();
+
+    /**
+     * Stops the worker thread after the queued transfers complete and
+     * destroys the GPU resources owned by the engine.
+     */
+    void freeMemoryDestroyGPUResources();
+
+  private:
+    struct StagingChunk
+    {
+        vk::Buffer buffer;
+        vk::DeviceMemory memory;
+        void* mapped = nullptr;
+        std::shared_ptr<vk::CommandBuffer> commandBuffer;
+        vk::Fence fence;
+        bool isInFlight = false;
+        std::function<void(const char*)> downloadCallback; ///< Receives the mapped chunk once the fence is signalled
+    };
+
+    struct PendingUploads
+    {
+        std::mutex mutex; ///< Guards the futures as the callbacks queue them
+        std::vector<std::future<void>> futures; ///< Uploads in the order the chunks were downloaded
+    };
+
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice;
+    std::shared_ptr<vk::Device> mDevice;
+    std::shared_ptr<vk::Queue> mQueue;
+    uint32_t mQueueIndex = -1;
+    std::shared_ptr<std::mutex> mQueueMutex;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    uint64_t mChunkSize = KP_DEFAULT_TRANSFER_CHUNK_SIZE;
+    uint32_t mNumChunks = KP_DEFAULT_TRANSFER_NUM_CHUNKS;
+    std::shared_ptr<vk::CommandPool> mCommandPool;
+    std::vector<StagingChunk> mStagingChunks;
+    uint64_t mNextChunk = 0;
+    bool mIsInit = false;
+
+    std::thread mWorker;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<std::function<void()>> mTasks;
+    bool mIsStopping = false;
+
+    // Create util functions
+    void createCommandPool();
+    void createStagingChunk(StagingChunk& stagingChunk);
+
+    // Worker util functions
+    std::future<void> enqueue(std::function<void()> transfer);
+    void runWorker();
+    void uploadTensor(std::shared_ptr<Tensor> tensor);
+    void downloadTensor(std::shared_ptr<Tensor> tensor);
+    void uploadChunk(std::shared_ptr<Tensor> tensor,
+                     uint64_t offset,
+                     const char* data,
+                     uint64_t size);
+    void downloadChunk(std::shared_ptr<Tensor> tensor,
+                       uint64_t offset,
+                       uint64_t size,
+                       std::function<void(const char*)> downloadCallback);
+    void copyTensor(std::shared_ptr<Tensor> srcTensor,
+                    std::shared_ptr<TransferEngine> dstEngine,
+                    std::shared_ptr<Tensor> dstTensor,
+                    std::shared_ptr<PendingUploads> uploads);
+    void validateTransferTensor(std::shared_ptr<Tensor> tensor);
+    StagingChunk& acquireStagingChunk();
+    void submitStagingChunk(StagingChunk& stagingChunk);
+    void waitStagingChunk(StagingChunk& stagingChunk);
+    void waitAllStagingChunks();
+};
+
+} // End namespace kp
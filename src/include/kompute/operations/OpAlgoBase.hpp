@@ -7,10 +7,27 @@
 #include "kompute/shaders/shaderopmult.hpp"
 
 #include "kompute/Algorithm.hpp"
+#include "kompute/ShaderCache.hpp"
 #include "kompute/Tensor.hpp"
 
 #include "kompute/operations/OpBase.hpp"
 
+/**
+ * Shader data of the compute shader shaders/glsl/<name>.comp for operations
+ * that create several algorithms. Release builds use the SPIR-V embedded in
+ * kompute/shaders/shader<name>.hpp, which has to be included, and other
+ * builds read the shader file as done for the shader of the operation.
+ */
+#if RELEASE
+#define KP_OPERATION_SHADER_DATA(name)                                         \
+    std::vector<char>(kp::shader_data::shaders_glsl_##name##_comp_spv,         \
+                      kp::shader_data::shaders_glsl_##name##_comp_spv +        \
+                        kp::shader_data::shaders_glsl_##name##_comp_spv_len)
+#else
+#define KP_OPERATION_SHADER_DATA(name)                                         \
+    kp::OpAlgoBase::readShaderFile("shaders/glsl/" #name ".comp")
+#endif
+
 namespace kp {
 
 /**
@@ -125,8 +142,31 @@ class OpAlgoBase : public OpBase
      */
     virtual void postEval() override;
 
+    /**
+     * Sets the shader cache that will be used to retrieve the shader module
+     * instead of loading and creating it on every init. This is set by the
+     * kp::Sequence with the cache owned by the kp::Manager before the init
+     * function is called.
+     *
+     * @param shaderCache The shader cache to retrieve shader modules from
+     */
+    void setShaderCache(std::shared_ptr<ShaderCache> shaderCache);
+
+    /**
+     * Sets the descriptor pool arena that the algorithm will use to retrieve
+     * its descriptor set layout and descriptor set instead of creating its own
+     * descriptor pool. This is set by the kp::Sequence with the arena owned by
+     * the kp::Manager before the init function is called.
+     *
+     * @param descriptorPoolArena The arena to allocate descriptor sets from
+     */
+    void setDescriptorPoolArena(
+      std::shared_ptr<DescriptorPoolArena> descriptorPoolArena);
+
   protected:
     // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<ShaderCache> mShaderCache; ///< Optional shader cache shared across operations
+    std::shared_ptr<DescriptorPoolArena> mDescriptorPoolArena; ///< Optional descriptor pool arena shared across operations
 
     // -------------- OPTIONALLY OWNED RESOURCES
     std::shared_ptr<Algorithm> mAlgorithm;
@@ -138,8 +178,76 @@ class OpAlgoBase : public OpBase
 
     std::string mShaderFilePath; ///< Optional member variable which can be provided for the OpAlgoBase to find the data automatically and load for processing
     std::vector<char> mShaderDataRaw; ///< Optional member variable which can be provided to contain either the raw shader content or the spirv binary content
+    std::vector<uint32_t> mSpecializationConstants; ///< Optional specialization constants passed to the algorithm after the sizes of the tensors, which allows precompiled shaders to be specialised for each operation
 
     virtual std::vector<char> fetchSpirvBinaryData();
+
+    /**
+     * Reads the data of a shader file, which is either the raw shader content
+     * or the spirv binary content.
+     *
+     * @param shaderFilePath The path of the shader file
+     * @return The bytes of the shader file
+     */
+    static std::vector<char> readShaderFile(const std::string& shaderFilePath);
+
+    /**
+     * Initialises the algorithm with the tensors of the operation, using the
+     * shader cache when available so the shader module is only created once
+     * per shader file or unique shader data.
+     */
+    void initAlgorithm();
+
+    /**
+     * Creates an additional algorithm which shares the shader cache and the
+     * descriptor pool arena of the operation, for operations that record
+     * several dispatches with different shaders or tensors.
+     *
+     * @param shaderData The raw shader content or the spirv binary content
+     * @param tensors The tensors bound to the algorithm in binding order
+     * @param specializationConstants Additional specialization constants whose constant ids follow the ones of the sizes of the tensors
+     * @return Shared pointer to the initialised algorithm
+     */
+    std::shared_ptr<Algorithm> createAlgorithm(
+      const std::vector<char>& shaderData,
+      const std::vector<std::shared_ptr<Tensor>>& tensors,
+      const std::vector<uint32_t>& specializationConstants = {});
+
+    /**
+     * Creates a device tensor owned by the operation, such as the block sums
+     * or the intermediate results of operations with several dispatches.
+     *
+     * @param size The number of 32 bit elements of the tensor
+     * @return The initialised tensor
+     */
+    std::shared_ptr<Tensor> createInternalTensor(uint32_t size);
+
+    /**
+     * Returns the largest power of two workgroup size supported by the device
+     * that does not exceed a maximum, for shaders that reduce values within
+     * a workgroup.
+     *
+     * @param maxSize The maximum workgroup size
+     * @return The workgroup size, which is at least one
+     */
+    uint32_t powerOfTwoWorkgroupSize(uint32_t maxSize);
+
+    /**
+     * Returns the active dimensions of the shape of a tensor, outermost first.
+     *
+     * @param tensor The tensor to return the shape of
+     * @return The size of each active dimension
+     */
+    static std::vector<uint32_t> tensorShape(
+      const std::shared_ptr<Tensor>& tensor);
+
+    /**
+     * Formats a shape for the error messages of the operations.
+     *
+     * @param shape The size of each dimension
+     * @return The shape as a string such as (2, 3)
+     */
+    static std::string shapeToString(const std::vector<uint32_t>& shape);
 };
 
 } // End namespace kp
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+#include "kompute/TensorDoubleBuffer.hpp"
+
+#include "kompute/operations/OpAlgoBase.hpp"
+
+namespace kp {
+
+/**
+ * Operation that runs a shader for a number of iterations over a
+ * kp::TensorDoubleBuffer, where the shader reads from binding 0 and writes to
+ * binding 1. The bindings of the two tensors are swapped between iterations
+ * so the output of one iteration is the input of the next without any copies.
+ * The tensors provided must start with the read and write tensors of the
+ * double buffer, followed by any other tensors which keep their bindings.
+ */
+class OpAlgoDoubleBuffer : public OpAlgoBase
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpAlgoDoubleBuffer();
+
+    /**
+     * Constructor that enables a file to be passed to the operation with
+     * the contents of the shader. This can be either in raw format or in
+     * compiled SPIR-V binary format.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, starting with the read and write tensors of the double buffer
+     * @param doubleBuffer Double buffer whose tensor roles are alternated
+     * @param iterations Number of times the shader is dispatched per evaluation
+     * @param shaderFilePath Parameter to specify the shader to load (either in spirv or raw format)
+     * @param komputeWorkgroup Optional parameter to specify the layout for processing
+     */
+    OpAlgoDoubleBuffer(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           std::shared_ptr<TensorDoubleBuffer> doubleBuffer,
+           uint32_t iterations,
+           std::string shaderFilePath,
+           KomputeWorkgroup komputeWorkgroup = KomputeWorkgroup());
+
+    /**
+     * Constructor that enables raw shader data to be passed to the main operation
+     * which can be either in raw shader glsl code or in compiled SPIR-V binary.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, starting with the read and write tensors of the double buffer
+     * @param doubleBuffer Double buffer whose tensor roles are alternated
+     * @param iterations Number of times the shader is dispatched per evaluation
+     * @param shaderDataRaw Parameter to specify the shader data either in binary or raw form
+     * @param komputeWorkgroup Optional parameter to specify the layout for processing
+     */
+    OpAlgoDoubleBuffer(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           std::shared_ptr<TensorDoubleBuffer> doubleBuffer,
+           uint32_t iterations,
+           const std::vector<char>& shaderDataRaw,
+           KomputeWorkgroup komputeWorkgroup = KomputeWorkgroup());
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpAlgoDoubleBuffer() override;
+
+    /**
+     * Validates that the first two tensors are the read and write tensors of
+     * the double buffer and initialises the algorithm with them.
+     */
+    virtual void init() override;
+
+    /**
+     * Records all the iterations, with a barrier between iterations on the
+     * tensor written so the next iteration reads the latest data, and with the
+     * bindings of the double buffer tensors swapped on each iteration.
+     */
+    virtual void record() override;
+
+    /**
+     * Validates that the double buffer roles are the same as when the
+     * operation was recorded, as the recorded bindings cannot be changed.
+     */
+    virtual void preEval() override;
+
+    /**
+     * Swaps the double buffer roles if an odd number of iterations was run,
+     * so the read tensor of the double buffer contains the latest output.
+     */
+    virtual void postEval() override;
+
+  protected:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<TensorDoubleBuffer> mDoubleBuffer; ///< Double buffer with the tensors that alternate read and write roles
+
+    // -------------- ALWAYS OWNED RESOURCES
+    uint32_t mIterations = 1;
+    uint32_t mRecordedReadIndex = 0;
+};
+
+} // End namespace kp
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpAlgoBase.hpp"
+
+#define KP_DEFAULT_ATTENTION_TILE_SIZE 64
+
+namespace kp {
+
+/**
+ * Operation that computes the scaled dot product attention of queries, keys
+ * and values, which is the softmax of the scaled products of each query with
+ * the keys used to weight the values.
+ *
+ * The tensors are the queries of shape (..., LQ, D), the keys of shape
+ * (..., LK, D), the values of shape (..., LK, DV) and the output of shape
+ * (..., LQ, DV), where the leading dimensions such as the batches and the
+ * heads have the same total size in all tensors, and the output can also be a
+ * tensor of a single dimension of the same size.
+ *
+ * The attention is tiled in the style of FlashAttention: each workgroup
+ * computes a tile of query rows and loads tiles of the keys and values into
+ * shared memory, computing the softmax online so the matrix of scores is
+ * never written to memory. The tiles are sized from the shared memory limits
+ * of the device and the shader is compiled ahead of time and specialised with
+ * the dimensions of the tensors.
+ */
+class OpAttention : public OpAlgoBase
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpAttention();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the queries, keys, values and output tensors
+     * @param causal Whether each query only attends to the keys up to its position, where the queries are aligned with the last keys
+     * @param scale The scale of the products of the queries and the keys, which defaults to the inverse square root of their dimension when zero
+     */
+    OpAttention(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                std::shared_ptr<vk::Device> device,
+                std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                std::vector<std::shared_ptr<Tensor>>& tensors,
+                bool causal = false,
+                float scale = 0.0f);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpAttention() override;
+
+    /**
+     * Validates the shapes of the tensors, sizes the tiles and creates the
+     * algorithm specialised for the dimensions of the tensors.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatch of the attention with the barriers of the input
+     * and output tensors.
+     */
+    virtual void record() override;
+
+#if RELEASE
+    /**
+     * If RELEASE=1 it will be using the static version of the shader which is
+     * loaded using this file directly. Otherwise it should not override the function.
+     */
+    std::vector<char> fetchSpirvBinaryData() override;
+#endif
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    bool mCausal = false;
+    float mScale = 0.0f;
+};
+
+} // End namespace kp
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpAlgoBase.hpp"
+
+#define KP_DEFAULT_BATCH_NORM_WORKGROUP_SIZE 256
+
+namespace kp {
+
+/**
+ * Operation that applies the batch normalisation of inference, which
+ * normalises each channel of the input with its running mean and variance
+ * and then scales and shifts it.
+ *
+ * The tensors are the input of shape (N, C, ...), the scale, shift, mean and
+ * variance tensors of size C, and the output which has the same size as the
+ * input and can be the input itself. Inputs without a batch dimension can be
+ * reshaped with a leading dimension of one.
+ */
+class OpBatchNorm : public OpAlgoBase
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpBatchNorm();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input, scale, shift, mean, variance and output tensors
+     * @param epsilon Value added to the variance to avoid divisions by zero
+     */
+    OpBatchNorm(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                std::shared_ptr<vk::Device> device,
+                std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                std::vector<std::shared_ptr<Tensor>>& tensors,
+                float epsilon = 1e-5f);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpBatchNorm() override;
+
+    /**
+     * Validates the shapes of the tensors and creates the algorithm of the
+     * normalisation.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatch of the normalisation with the barriers of the
+     * input and output tensors.
+     */
+    virtual void record() override;
+
+#if RELEASE
+    /**
+     * If RELEASE=1 it will be using the static version of the shader which is
+     * loaded using this file directly. Otherwise it should not override the function.
+     */
+    std::vector<char> fetchSpirvBinaryData() override;
+#endif
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    float mEpsilon = 1e-5f;
+    uint32_t mChannels = 0;
+    uint32_t mChannelSize = 0; ///< Number of consecutive elements of each channel, which is the product of the dimensions after the channels
+    uint32_t mWorkgroupSize = KP_DEFAULT_BATCH_NORM_WORKGROUP_SIZE;
+};
+
+} // End namespace kp
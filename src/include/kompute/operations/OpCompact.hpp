@@ -0,0 +1,85 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpElementwise.hpp"
+#include "kompute/operations/OpScan.hpp"
+
+namespace kp {
+
+/**
+ * Operation that keeps the elements of the first tensor for which a predicate
+ * is non-zero, writing them contiguously and in their original order into the
+ * output tensor, and the number of elements kept into a count tensor of a
+ * single element.
+ *
+ * The predicate is a kp::ElementwiseExpr over the input tensors, where input
+ * 0 is the tensor compacted and further inputs such as a tensor of flags can
+ * also be referenced, so the tensors are the inputs followed by the output and
+ * the count. The predicate is evaluated into flags, which are scanned with the
+ * block scan of kp::OpScan to find the position of each element kept. The
+ * flags are evaluated by a shader generated from the predicate as done by
+ * kp::OpElementwise, which requires Kompute to be built with
+ * KOMPUTE_OPT_ENABLE_SHADER_COMPILATION, while the scan and the scatter use
+ * the precompiled shaders of the operations.
+ */
+class OpCompact : public OpScan
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpCompact();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input tensors followed by the output and count tensors
+     * @param predicate Expression evaluated for each element, which is kept when the expression is non-zero
+     */
+    OpCompact(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+              std::shared_ptr<vk::Device> device,
+              std::shared_ptr<vk::CommandBuffer> commandBuffer,
+              std::vector<std::shared_ptr<Tensor>>& tensors,
+              const ElementwiseExpr& predicate);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithms
+     * and the intermediate tensors but does not destroy the underlying tensors
+     */
+    virtual ~OpCompact() override;
+
+    /**
+     * Validates the sizes of the tensors, creates the flags and offsets
+     * tensors and the algorithms that evaluate the predicate, scan the flags
+     * and scatter the elements kept.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatches that evaluate the predicate, scan the flags and
+     * scatter the elements kept, with the barriers between them.
+     */
+    virtual void record() override;
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    ElementwiseExpr mPredicate;
+    std::shared_ptr<Tensor> mFlags;
+    std::shared_ptr<Tensor> mOffsets;
+    std::shared_ptr<Algorithm> mFlagsAlgorithm;
+    std::shared_ptr<Algorithm> mScatterAlgorithm;
+
+  private:
+    std::string generateFlagsShader();
+};
+
+} // End namespace kp
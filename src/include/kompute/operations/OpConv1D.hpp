@@ -0,0 +1,64 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpConv2D.hpp"
+
+namespace kp {
+
+/**
+ * Operation that computes the 1-D convolution of an input tensor with the
+ * filters of a weights tensor, adding an optional bias per filter.
+ *
+ * The tensors are the input of shape (N, C, L) or (C, L), the weights of
+ * shape (K, C, KL), optionally the bias of size K, and the output of shape
+ * (N, K, OL) or (K, OL), where the output can also be a tensor of a single
+ * dimension of the same size. The convolution is computed by kp::OpConv2D
+ * with a height of one, which uses wide tiles for outputs of a single row.
+ */
+class OpConv1D : public OpConv2D
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpConv1D();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input, weights, optional bias and output tensors
+     * @param stride The step between the input positions of consecutive outputs
+     * @param padding The number of zeros added on each side of the input
+     * @param convAlgorithm The algorithm used to compute the convolution
+     */
+    OpConv1D(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+             std::shared_ptr<vk::Device> device,
+             std::shared_ptr<vk::CommandBuffer> commandBuffer,
+             std::vector<std::shared_ptr<Tensor>>& tensors,
+             uint32_t stride = 1,
+             uint32_t padding = 0,
+             ConvAlgorithms convAlgorithm = ConvAlgorithms::eAuto);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithms
+     * and the intermediate tensors but does not destroy the underlying tensors
+     */
+    virtual ~OpConv1D() override;
+
+    /**
+     * Validates the shapes of the tensors and creates the algorithms of the
+     * convolution.
+     */
+    virtual void init() override;
+};
+
+} // End namespace kp
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpAlgoBase.hpp"
+
+#define KP_DEFAULT_CONV_TILE_SIZE 16
+#define KP_CONV_DIRECT_MAX_KERNEL_SIZE 16
+
+namespace kp {
+
+/**
+ * Operation that computes the 2-D convolution of an input tensor with the
+ * filters of a weights tensor, adding an optional bias per filter.
+ *
+ * The tensors are the input of shape (N, C, H, W) or (C, H, W), the weights
+ * of shape (K, C, KH, KW), optionally the bias of size K, and the output of
+ * shape (N, K, OH, OW) or (K, OH, OW), where the output can also be a tensor
+ * of a single dimension of the same size. The shapes are set with
+ * kp::Tensor::reshape.
+ *
+ * Small kernels are computed directly, where each workgroup loads the input
+ * patch of a tile of the output into shared memory for each channel. Large
+ * kernels are unfolded into a matrix of input patches which is multiplied by
+ * the weights with a tiled matrix multiplication. The tiles are sized from
+ * the workgroup and shared memory limits of the device. The shaders are
+ * precompiled and specialised for the dimensions of the convolution when the
+ * pipelines are created.
+ */
+class OpConv2D : public OpAlgoBase
+{
+  public:
+    /**
+     * Algorithms used to compute the convolution, where eAuto uses the
+     * direct convolution for small kernels that fit in shared memory.
+     */
+    enum class ConvAlgorithms
+    {
+        eAuto = 0,
+        eDirect = 1,
+        eIm2col = 2,
+    };
+
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpConv2D();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input, weights, optional bias and output tensors
+     * @param stride The step between the input positions of consecutive outputs in each spatial dimension
+     * @param padding The number of zeros added on each side of each spatial dimension of the input
+     * @param convAlgorithm The algorithm used to compute the convolution
+     */
+    OpConv2D(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+             std::shared_ptr<vk::Device> device,
+             std::shared_ptr<vk::CommandBuffer> commandBuffer,
+             std::vector<std::shared_ptr<Tensor>>& tensors,
+             uint32_t stride = 1,
+             uint32_t padding = 0,
+             ConvAlgorithms convAlgorithm = ConvAlgorithms::eAuto);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithms
+     * and the intermediate tensors but does not destroy the underlying tensors
+     */
+    virtual ~OpConv2D() override;
+
+    /**
+     * Validates the shapes of the tensors and creates the algorithms of the
+     * convolution.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatches of the convolution with the barriers between
+     * them.
+     */
+    virtual void record() override;
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    ConvAlgorithms mConvAlgorithm = ConvAlgorithms::eAuto;
+    uint32_t mBatches = 1;
+    uint32_t mChannels = 0;
+    uint32_t mHeight = 0;
+    uint32_t mWidth = 0;
+    uint32_t mFilters = 0;
+    uint32_t mKernelHeight = 0;
+    uint32_t mKernelWidth = 0;
+    uint32_t mStrideY = 1;
+    uint32_t mStrideX = 1;
+    uint32_t mPaddingY = 0;
+    uint32_t mPaddingX = 0;
+    uint32_t mOutputHeight = 0;
+    uint32_t mOutputWidth = 0;
+    uint32_t mTileSize = KP_DEFAULT_CONV_TILE_SIZE;
+    uint32_t mTileX = KP_DEFAULT_CONV_TILE_SIZE;
+    uint32_t mTileY = KP_DEFAULT_CONV_TILE_SIZE;
+    std::shared_ptr<Tensor> mColumns;
+    std::vector<std::shared_ptr<Algorithm>> mAlgorithms;
+    std::vector<KomputeWorkgroup> mWorkgroups;
+
+    /**
+     * Computes the spatial size of the output from the dimensions set by
+     * init, throwing if the kernel is larger than the padded input.
+     */
+    void initOutputSize();
+
+    /**
+     * Validates the output tensor and creates the algorithms of the
+     * convolution from the dimensions set by init, which allows the 1-D
+     * convolution to reuse the 2-D one.
+     *
+     * @param outputShape The expected shape of the output tensor
+     */
+    void initConvolution(const std::vector<uint32_t>& outputShape);
+
+  private:
+    void initTileSize();
+    KomputeWorkgroup tiledWorkgroup(uint32_t tilesX,
+                                    uint32_t tilesY,
+                                    uint32_t tilesZ);
+    std::vector<uint32_t> dimensionConstants();
+};
+
+} // End namespace kp
@@ -0,0 +1,280 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpAlgoBase.hpp"
+
+#define KP_DEFAULT_ELEMENTWISE_WORKGROUP_SIZE 256
+
+namespace kp {
+
+/**
+ * Expression evaluated element wise by kp::OpElementwise, composed of the
+ * input tensors of the operation, scalar constants, arithmetic operators and
+ * math functions. The whole expression is generated into a single shader, so
+ * chains such as relu(a * b + c) are fused without writing the intermediate
+ * results into device memory.
+ */
+class ElementwiseExpr
+{
+  public:
+    /**
+     * Expression reading the element of an input tensor of the operation.
+     *
+     * @param index The position of the tensor in the operation tensors
+     * @return The expression of the input
+     */
+    static ElementwiseExpr input(uint32_t index);
+
+    /**
+     * Expression of a scalar constant broadcast to every element, which is
+     * generated into the shader code.
+     *
+     * @param value The value of the constant
+     * @return The expression of the constant
+     */
+    static ElementwiseExpr constant(float value);
+
+    static ElementwiseExpr relu(const ElementwiseExpr& x);
+    static ElementwiseExpr sigmoid(const ElementwiseExpr& x);
+    static ElementwiseExpr exp(const ElementwiseExpr& x);
+    static ElementwiseExpr log(const ElementwiseExpr& x);
+    static ElementwiseExpr tanh(const ElementwiseExpr& x);
+    static ElementwiseExpr abs(const ElementwiseExpr& x);
+    static ElementwiseExpr sqrt(const ElementwiseExpr& x);
+    static ElementwiseExpr max(const ElementwiseExpr& lhs,
+                               const ElementwiseExpr& rhs);
+    static ElementwiseExpr min(const ElementwiseExpr& lhs,
+                               const ElementwiseExpr& rhs);
+
+    /**
+     * Comparisons of two expressions, which evaluate to one where the
+     * comparison holds and to zero otherwise, as used for masks and for the
+     * predicates of kp::OpCompact.
+     */
+    static ElementwiseExpr greater(const ElementwiseExpr& lhs,
+                                   const ElementwiseExpr& rhs);
+    static ElementwiseExpr less(const ElementwiseExpr& lhs,
+                                const ElementwiseExpr& rhs);
+    static ElementwiseExpr equal(const ElementwiseExpr& lhs,
+                                 const ElementwiseExpr& rhs);
+
+    ElementwiseExpr operator-() const;
+    ElementwiseExpr operator+(const ElementwiseExpr& rhs) const;
+    ElementwiseExpr operator-(const ElementwiseExpr& rhs) const;
+    ElementwiseExpr operator*(const ElementwiseExpr& rhs) const;
+    ElementwiseExpr operator/(const ElementwiseExpr& rhs) const;
+    ElementwiseExpr operator+(float rhs) const;
+    ElementwiseExpr operator-(float rhs) const;
+    ElementwiseExpr operator*(float rhs) const;
+    ElementwiseExpr operator/(float rhs) const;
+
+    /**
+     * Generates the GLSL code of the expression.
+     *
+     * @param inputs The GLSL code reading the element of each input tensor
+     * @param type The GLSL type the expression is evaluated as, either float
+     * or vec4
+     * @return The GLSL code of the expression
+     */
+    std::string generate(const std::vector<std::string>& inputs,
+                         const std::string& type) const;
+
+    /**
+     * Returns the number of input tensors read by the expression.
+     *
+     * @return One more than the highest input index used
+     */
+    uint32_t numInputs() const;
+
+  private:
+    enum class NodeTypes
+    {
+        eInput,
+        eConstant,
+        eUnary,
+        eBinary,
+        eComparison,
+        eFunction,
+    };
+
+    struct Node
+    {
+        NodeTypes nodeType;
+        std::string op;
+        uint32_t inputIndex = 0;
+        float value = 0;
+        std::vector<std::shared_ptr<const Node>> args;
+    };
+
+    std::shared_ptr<const Node> mNode;
+
+    static ElementwiseExpr make(NodeTypes nodeType,
+                                const std::string& op,
+                                std::vector<ElementwiseExpr> args);
+    static std::string generateNode(const std::shared_ptr<const Node>& node,
+                                    const std::vector<std::string>& inputs,
+                                    const std::string& type);
+    static uint32_t numInputsNode(const std::shared_ptr<const Node>& node);
+};
+
+ElementwiseExpr
+operator+(float lhs, const ElementwiseExpr& rhs);
+ElementwiseExpr
+operator-(float lhs, const ElementwiseExpr& rhs);
+ElementwiseExpr
+operator*(float lhs, const ElementwiseExpr& rhs);
+ElementwiseExpr
+operator/(float lhs, const ElementwiseExpr& rhs);
+
+/**
+ * Operation that evaluates an element wise expression over input tensors and
+ * writes it into the last tensor provided. The shader is generated from the
+ * expression, processes four elements per invocation with vec4 loads and
+ * stores, and uses a workgroup size within the limits of the device, striding
+ * over the tensors when they exceed the dispatch limits.
+ *
+ * The inputs are broadcast following the NumPy rules based on the shape of
+ * each tensor, so for example a bias of shape (N) can be added to each row of
+ * a tensor of shape (M, N). The strides of each broadcast input are generated
+ * into the shader, so the index computation is specialised for the shapes
+ * when the pipeline is created.
+ *
+ * As the shader is GLSL source it is compiled to SPIR-V by kp::ShaderCompiler,
+ * which requires Kompute to be built with KOMPUTE_OPT_ENABLE_SHADER_COMPILATION.
+ * The operations with a fixed unary, binary or scalar expression, such as
+ * kp::OpAdd or kp::OpRelu, instead use precompiled shaders which receive the
+ * operation and the broadcast strides as specialization constants, so only
+ * fused expressions require the shader compiler.
+ */
+class OpElementwise : public OpAlgoBase
+{
+  public:
+    /**
+     * Types of the operations with a fixed expression, which are evaluated
+     * with the precompiled shaders, or eExpression for fused expressions
+     * which are generated into a shader.
+     */
+    enum class OperationTypes
+    {
+        eExpression,
+        eAdd,
+        eSub,
+        eDiv,
+        eRelu,
+        eSigmoid,
+        eExp,
+        eTanh,
+        eScale,
+        eAddScalar,
+    };
+
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpElementwise();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input tensors followed by the output tensor
+     * @param expression Expression evaluated for each element of the output
+     */
+    OpElementwise(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                  std::shared_ptr<vk::Device> device,
+                  std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                  std::vector<std::shared_ptr<Tensor>>& tensors,
+                  const ElementwiseExpr& expression);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpElementwise() override;
+
+    /**
+     * Validates that the inputs can be broadcast to the shape of the output,
+     * generates the shader of the expression, or selects the precompiled
+     * shader of the operation type, and creates the algorithm that evaluates
+     * it.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatch of the shader, together with the barriers that make
+     * the writes of previous operations visible to the shader and the output
+     * visible to subsequent operations, so element wise operations can be
+     * chained within a sequence.
+     */
+    virtual void record() override;
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    ElementwiseExpr mExpression;
+    OperationTypes mOperationType = OperationTypes::eExpression;
+    float mScalar = 0;
+    uint32_t mWorkgroupSize = KP_DEFAULT_ELEMENTWISE_WORKGROUP_SIZE;
+    std::vector<uint32_t> mShape;
+
+    /**
+     * Generates the GLSL code of the shader, which is overridden by the
+     * operations that change how the inputs are indexed.
+     *
+     * @return The GLSL code of the shader
+     */
+    virtual std::string generateShader();
+
+    /**
+     * Returns the GLSL code reading the element of each input tensor for the
+     * given vec4 index and component, where the component is empty for the
+     * vec4 load.
+     *
+     * @param vecIndex The GLSL variable holding the vec4 index
+     * @param component The GLSL code of the component, or empty for vec4
+     * @return The GLSL code reading each input
+     */
+    virtual std::vector<std::string> generateInputs(
+      const std::string& vecIndex,
+      const std::string& component);
+
+    /**
+     * Returns whether an input is broadcast, in which case the index of its
+     * elements is computed from the index of the output element.
+     *
+     * @param tensorIndex The position of the input in the operation tensors
+     * @return Whether the input is smaller than the output
+     */
+    bool isBroadcast(uint32_t tensorIndex);
+
+    /**
+     * Returns whether the vec4 of output elements of a broadcast input can be
+     * read with a single vec4 load instead of four scalar loads.
+     *
+     * @param tensorIndex The position of the input in the operation tensors
+     * @return Whether the input is read with vec4 loads
+     */
+    bool isBroadcastVectorizable(uint32_t tensorIndex);
+
+    /**
+     * Generates the GLSL code computing the index of the element of a
+     * broadcast input from the index e of the output element.
+     *
+     * @param tensorIndex The position of the input in the operation tensors
+     * @return The GLSL code of the index
+     */
+    std::string generateBroadcastIndex(uint32_t tensorIndex);
+
+  private:
+    std::vector<uint32_t> broadcastShape(uint32_t tensorIndex);
+    void setOperationShader();
+};
+
+} // End namespace kp
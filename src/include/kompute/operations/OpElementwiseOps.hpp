@@ -0,0 +1,361 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpElementwise.hpp"
+
+namespace kp {
+
+/**
+ * Operation that adds two tensors element wise and outputs on a third tensor,
+ * broadcasting the shapes of the inputs.
+ */
+class OpAdd : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpAdd() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the lhs, rhs and output tensors
+     */
+    OpAdd(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+          std::shared_ptr<vk::Device> device,
+          std::shared_ptr<vk::CommandBuffer> commandBuffer,
+          std::vector<std::shared_ptr<Tensor>> tensors)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::input(0) + ElementwiseExpr::input(1))
+    {
+        SPDLOG_DEBUG("Kompute OpAdd constructor with params");
+
+        this->mOperationType = OperationTypes::eAdd;
+    }
+};
+
+/**
+ * Operation that subtracts the second tensor from the first one element wise
+ * and outputs on a third tensor, broadcasting the shapes of the inputs.
+ */
+class OpSub : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpSub() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the lhs, rhs and output tensors
+     */
+    OpSub(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+          std::shared_ptr<vk::Device> device,
+          std::shared_ptr<vk::CommandBuffer> commandBuffer,
+          std::vector<std::shared_ptr<Tensor>> tensors)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::input(0) - ElementwiseExpr::input(1))
+    {
+        SPDLOG_DEBUG("Kompute OpSub constructor with params");
+
+        this->mOperationType = OperationTypes::eSub;
+    }
+};
+
+/**
+ * Operation that divides the first tensor by the second one element wise and
+ * outputs on a third tensor, broadcasting the shapes of the inputs.
+ */
+class OpDiv : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpDiv() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the lhs, rhs and output tensors
+     */
+    OpDiv(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+          std::shared_ptr<vk::Device> device,
+          std::shared_ptr<vk::CommandBuffer> commandBuffer,
+          std::vector<std::shared_ptr<Tensor>> tensors)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::input(0) / ElementwiseExpr::input(1))
+    {
+        SPDLOG_DEBUG("Kompute OpDiv constructor with params");
+
+        this->mOperationType = OperationTypes::eDiv;
+    }
+};
+
+/**
+ * Operation that applies the rectified linear unit max(x, 0) element wise to
+ * a tensor and outputs on a second tensor.
+ */
+class OpRelu : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpRelu() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     */
+    OpRelu(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>> tensors)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::relu(ElementwiseExpr::input(0)))
+    {
+        SPDLOG_DEBUG("Kompute OpRelu constructor with params");
+
+        this->mOperationType = OperationTypes::eRelu;
+    }
+};
+
+/**
+ * Operation that applies the logistic function 1 / (1 + exp(-x)) element wise
+ * to a tensor and outputs on a second tensor.
+ */
+class OpSigmoid : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpSigmoid() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     */
+    OpSigmoid(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+              std::shared_ptr<vk::Device> device,
+              std::shared_ptr<vk::CommandBuffer> commandBuffer,
+              std::vector<std::shared_ptr<Tensor>> tensors)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::sigmoid(ElementwiseExpr::input(0)))
+    {
+        SPDLOG_DEBUG("Kompute OpSigmoid constructor with params");
+
+        this->mOperationType = OperationTypes::eSigmoid;
+    }
+};
+
+/**
+ * Operation that applies the exponential function element wise to a tensor
+ * and outputs on a second tensor.
+ */
+class OpExp : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpExp() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     */
+    OpExp(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+          std::shared_ptr<vk::Device> device,
+          std::shared_ptr<vk::CommandBuffer> commandBuffer,
+          std::vector<std::shared_ptr<Tensor>> tensors)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::exp(ElementwiseExpr::input(0)))
+    {
+        SPDLOG_DEBUG("Kompute OpExp constructor with params");
+
+        this->mOperationType = OperationTypes::eExp;
+    }
+};
+
+/**
+ * Operation that applies the hyperbolic tangent element wise to a tensor and
+ * outputs on a second tensor.
+ */
+class OpTanh : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpTanh() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     */
+    OpTanh(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>> tensors)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::tanh(ElementwiseExpr::input(0)))
+    {
+        SPDLOG_DEBUG("Kompute OpTanh constructor with params");
+
+        this->mOperationType = OperationTypes::eTanh;
+    }
+};
+
+/**
+ * Operation that multiplies a tensor by a scalar element wise and outputs on
+ * a second tensor. The scalar is passed to the shader as a specialization
+ * constant.
+ */
+class OpScale : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpScale() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     * @param scale The scalar each element is multiplied by
+     */
+    OpScale(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+            std::shared_ptr<vk::Device> device,
+            std::shared_ptr<vk::CommandBuffer> commandBuffer,
+            std::vector<std::shared_ptr<Tensor>> tensors,
+            float scale)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::input(0) * scale)
+    {
+        SPDLOG_DEBUG("Kompute OpScale constructor with params");
+
+        this->mOperationType = OperationTypes::eScale;
+        this->mScalar = scale;
+    }
+};
+
+/**
+ * Operation that adds a scalar to a tensor element wise and outputs on a
+ * second tensor. The scalar is passed to the shader as a specialization
+ * constant.
+ */
+class OpAddScalar : public OpElementwise
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpAddScalar() {}
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     * @param scalar The scalar added to each element
+     */
+    OpAddScalar(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                std::shared_ptr<vk::Device> device,
+                std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                std::vector<std::shared_ptr<Tensor>> tensors,
+                float scalar)
+      : OpElementwise(physicalDevice,
+                      device,
+                      commandBuffer,
+                      tensors,
+                      ElementwiseExpr::input(0) + scalar)
+    {
+        SPDLOG_DEBUG("Kompute OpAddScalar constructor with params");
+
+        this->mOperationType = OperationTypes::eAddScalar;
+        this->mScalar = scalar;
+    }
+};
+
+} // End namespace kp
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpAlgoBase.hpp"
+
+#define KP_DEFAULT_LAYER_NORM_WORKGROUP_SIZE 256
+
+namespace kp {
+
+/**
+ * Operation that normalises each row of the last dimension of the input
+ * tensor, and then scales and optionally shifts it per column.
+ *
+ * The tensors are the input, the scale of the size of the rows, optionally
+ * the shift of the same size, and the output which has the same size as the
+ * input and can be the input itself. Layer normalisation subtracts the mean
+ * of each row and divides by its standard deviation, while RMS normalisation
+ * only divides by the root mean square of each row. Each workgroup reduces a
+ * row with Welford's algorithm, so the variance is computed in a single
+ * numerically stable pass.
+ */
+class OpLayerNorm : public OpAlgoBase
+{
+  public:
+    /**
+     * Types of normalisation of the rows.
+     */
+    enum class NormTypes
+    {
+        eLayerNorm = 0,
+        eRmsNorm = 1,
+    };
+
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpLayerNorm();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input, scale, optional shift and output tensors
+     * @param normType Whether the rows are normalised by their standard deviation or their root mean square
+     * @param epsilon Value added to the variance or mean square to avoid divisions by zero
+     */
+    OpLayerNorm(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                std::shared_ptr<vk::Device> device,
+                std::shared_ptr<vk::CommandBuffer> commandBuffer,
+                std::vector<std::shared_ptr<Tensor>>& tensors,
+                NormTypes normType = NormTypes::eLayerNorm,
+                float epsilon = 1e-5f);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpLayerNorm() override;
+
+    /**
+     * Validates the shapes of the tensors and creates the algorithm
+     * specialised for the row size and the type of normalisation.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatch of the normalisation with the barriers of the
+     * input and output tensors.
+     */
+    virtual void record() override;
+
+#if RELEASE
+    /**
+     * If RELEASE=1 it will be using the static version of the shader which is
+     * loaded using this file directly. Otherwise it should not override the function.
+     */
+    std::vector<char> fetchSpirvBinaryData() override;
+#endif
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    NormTypes mNormType = NormTypes::eLayerNorm;
+    float mEpsilon = 1e-5f;
+};
+
+} // End namespace kp
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpPool2D.hpp"
+
+namespace kp {
+
+/**
+ * Operation that computes the maximum or the average of each window of the
+ * last dimension of an input tensor.
+ *
+ * The tensors are the input of shape (N, C, L) or (C, L) and the output of
+ * shape (N, C, OL) or (C, OL), where the output can also be a tensor of a
+ * single dimension of the same size. The pooling is computed by kp::OpPool2D
+ * with windows of a height of one.
+ */
+class OpPool1D : public OpPool2D
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpPool1D();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     * @param poolType Whether the maximum or the average of each window is computed
+     * @param kernelSize The size of the windows
+     * @param stride The step between consecutive windows, which defaults to the kernel size when zero
+     */
+    OpPool1D(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+             std::shared_ptr<vk::Device> device,
+             std::shared_ptr<vk::CommandBuffer> commandBuffer,
+             std::vector<std::shared_ptr<Tensor>>& tensors,
+             PoolTypes poolType,
+             uint32_t kernelSize,
+             uint32_t stride = 0);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpPool1D() override;
+
+    /**
+     * Validates the shapes of the tensors and creates the algorithm of the
+     * pooling.
+     */
+    virtual void init() override;
+};
+
+} // End namespace kp
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpAlgoBase.hpp"
+
+#define KP_DEFAULT_POOL_WORKGROUP_SIZE 256
+
+namespace kp {
+
+/**
+ * Operation that computes the maximum or the average of each window of the
+ * spatial dimensions of an input tensor.
+ *
+ * The tensors are the input of shape (N, C, H, W) or (C, H, W) and the output
+ * of shape (N, C, OH, OW) or (C, OH, OW), where the output can also be a
+ * tensor of a single dimension of the same size. The windows are square and
+ * do not overlap unless the stride is smaller than the kernel size.
+ */
+class OpPool2D : public OpAlgoBase
+{
+  public:
+    /**
+     * Reduction computed over each window.
+     */
+    enum class PoolTypes
+    {
+        eMax = 0,
+        eAverage = 1,
+    };
+
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpPool2D();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     * @param poolType Whether the maximum or the average of each window is computed
+     * @param kernelSize The size of the windows in each spatial dimension
+     * @param stride The step between consecutive windows, which defaults to the kernel size when zero
+     */
+    OpPool2D(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+             std::shared_ptr<vk::Device> device,
+             std::shared_ptr<vk::CommandBuffer> commandBuffer,
+             std::vector<std::shared_ptr<Tensor>>& tensors,
+             PoolTypes poolType,
+             uint32_t kernelSize,
+             uint32_t stride = 0);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpPool2D() override;
+
+    /**
+     * Validates the shapes of the tensors and creates the algorithm of the
+     * pooling.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatch of the pooling with the barriers of the input and
+     * output tensors.
+     */
+    virtual void record() override;
+
+#if RELEASE
+    /**
+     * If RELEASE=1 it will be using the static version of the shader which is
+     * loaded using this file directly. Otherwise it should not override the function.
+     */
+    std::vector<char> fetchSpirvBinaryData() override;
+#endif
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    PoolTypes mPoolType = PoolTypes::eMax;
+    uint32_t mPlanes = 0; ///< Number of windows of each position, which is the batches times the channels
+    uint32_t mHeight = 0;
+    uint32_t mWidth = 0;
+    uint32_t mKernelHeight = 0;
+    uint32_t mKernelWidth = 0;
+    uint32_t mStrideY = 1;
+    uint32_t mStrideX = 1;
+    uint32_t mOutputHeight = 0;
+    uint32_t mOutputWidth = 0;
+    uint32_t mWorkgroupSize = KP_DEFAULT_POOL_WORKGROUP_SIZE;
+
+    /**
+     * Validates the output tensor and creates the algorithm of the pooling
+     * from the dimensions set by init, which allows the 1-D pooling to reuse
+     * the 2-D one.
+     *
+     * @param outputShape The expected shape of the output tensor without the output spatial dimensions, which are appended
+     * @param spatialDimensions The number of spatial dimensions of the output, either one or two
+     */
+    void initPooling(std::vector<uint32_t> outputShape,
+                     uint32_t spatialDimensions);
+};
+
+} // End namespace kp
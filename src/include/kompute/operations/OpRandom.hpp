@@ -0,0 +1,105 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpAlgoBase.hpp"
+
+#define KP_DEFAULT_RANDOM_WORKGROUP_SIZE 256
+#define KP_RANDOM_VALUES_PER_COUNTER 4
+
+namespace kp {
+
+/**
+ * Operation that fills the tensors provided with random numbers generated on
+ * the device, overwriting their contents without any upload of data.
+ *
+ * The numbers are generated with the counter based Philox4x32-10 generator,
+ * keyed by the seed, where each counter generates KP_RANDOM_VALUES_PER_COUNTER
+ * numbers. The element at index i of the tensors takes the number at position
+ * offset + i of the stream of the seed, and the tensors after the first one
+ * continue the stream from the end of the tensor before them. The results
+ * only depend on the seed and the positions, so generating a tensor in parts
+ * with the corresponding offsets gives the same numbers as generating it at
+ * once.
+ */
+class OpRandom : public OpAlgoBase
+{
+  public:
+    /**
+     * Distributions of the random numbers. The uniform distribution is in
+     * the range [first, second), the normal distribution has a mean of first
+     * and a standard deviation of second, computed with the Box-Muller
+     * transform, and the Bernoulli distribution is one with a probability of
+     * first and zero otherwise.
+     */
+    enum class RandomDistributions
+    {
+        eUniform = 0,
+        eNormal = 1,
+        eBernoulli = 2,
+    };
+
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpRandom();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, which are filled with random numbers
+     * @param distribution The distribution of the random numbers
+     * @param seed The key of the generator, where each seed generates a different stream of numbers
+     * @param offset The position in the stream of the first element of the first tensor
+     * @param first The lower bound of the uniform distribution, the mean of the normal distribution or the probability of the Bernoulli distribution
+     * @param second The upper bound of the uniform distribution or the standard deviation of the normal distribution
+     */
+    OpRandom(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+             std::shared_ptr<vk::Device> device,
+             std::shared_ptr<vk::CommandBuffer> commandBuffer,
+             std::vector<std::shared_ptr<Tensor>>& tensors,
+             RandomDistributions distribution = RandomDistributions::eUniform,
+             uint64_t seed = 0,
+             uint64_t offset = 0,
+             float first = 0.0f,
+             float second = 1.0f);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithms
+     * but does not destroy the underlying tensors
+     */
+    virtual ~OpRandom() override;
+
+    /**
+     * Validates the parameters of the distribution and creates the algorithm
+     * that fills each tensor at its position in the stream.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatches that fill each tensor with the barriers on the
+     * tensors.
+     */
+    virtual void record() override;
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    RandomDistributions mDistribution = RandomDistributions::eUniform;
+    uint64_t mSeed = 0;
+    uint64_t mOffset = 0;
+    float mFirst = 0.0f;
+    float mSecond = 1.0f;
+    uint32_t mWorkgroupSize = KP_DEFAULT_RANDOM_WORKGROUP_SIZE;
+    std::vector<std::shared_ptr<Algorithm>> mAlgorithms;
+    std::vector<uint32_t> mNumWorkgroups;
+};
+
+} // End namespace kp
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpAlgoBase.hpp"
+
+#define KP_DEFAULT_SCAN_WORKGROUP_SIZE 256
+#define KP_SCAN_ITEMS_PER_INVOCATION 4
+
+namespace kp {
+
+/**
+ * Operation that computes the prefix sum of the first tensor into the second
+ * tensor, which can be the same tensor to scan in place.
+ *
+ * The scan is a multi-level block scan: each workgroup scans a block of the
+ * tensor and writes the total of the block into a tensor of block sums, which
+ * is scanned recursively until it fits in a single block, and the scanned
+ * block sums are then added back into the blocks of the level below. The
+ * workgroup scan uses subgroup arithmetic when the device supports it in
+ * compute shaders, and shared memory otherwise.
+ */
+class OpScan : public OpAlgoBase
+{
+  public:
+    /**
+     * Types of scan, where the inclusive scan sums each element with the ones
+     * before it and the exclusive scan only sums the ones before it.
+     */
+    enum class ScanTypes
+    {
+        eInclusive = 0,
+        eExclusive = 1,
+    };
+
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpScan();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     * @param scanType Whether the scan is inclusive or exclusive
+     */
+    OpScan(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           ScanTypes scanType = ScanTypes::eInclusive);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithms
+     * and the block sums tensors but does not destroy the underlying tensors
+     */
+    virtual ~OpScan() override;
+
+    /**
+     * Validates the sizes of the tensors, creates the block sums tensors of
+     * each level and the algorithms that scan and propagate them.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatches of each level of the scan with the barriers
+     * between them.
+     */
+    virtual void record() override;
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    ScanTypes mScanType = ScanTypes::eInclusive;
+    uint32_t mWorkgroupSize = KP_DEFAULT_SCAN_WORKGROUP_SIZE;
+    uint32_t mMaxWorkgroupCount = 0;
+    bool mUseSubgroups = false;
+    std::vector<std::shared_ptr<Tensor>> mScanInputs;
+    std::vector<std::shared_ptr<Tensor>> mScanOutputs;
+    std::vector<std::shared_ptr<Tensor>> mScanSums;
+    std::vector<std::shared_ptr<Algorithm>> mScanAlgorithms;
+    std::vector<std::shared_ptr<Algorithm>> mAddAlgorithms;
+
+    /**
+     * Creates the levels of the scan of a tensor into another tensor.
+     *
+     * @param input The tensor to scan
+     * @param output The tensor the scan is written into
+     * @param scanType Whether the scan is inclusive or exclusive
+     * @param isFloat Whether the elements are float, otherwise they are uint
+     */
+    void initScan(std::shared_ptr<Tensor> input,
+                  std::shared_ptr<Tensor> output,
+                  ScanTypes scanType,
+                  bool isFloat);
+
+    /**
+     * Records the dispatches of the scan created by initScan.
+     */
+    void recordScan();
+
+    /**
+     * Returns the number of workgroups to dispatch for a number of blocks or
+     * elements, bound by the dispatch limits of the device as the shaders
+     * stride over the remaining ones.
+     *
+     * @param count The number of blocks or elements
+     * @param perWorkgroup The number processed by each workgroup
+     * @return The number of workgroups
+     */
+    uint32_t dispatchSize(uint32_t count, uint32_t perWorkgroup);
+
+    /**
+     * Queries the workgroup size, the dispatch limits and the subgroup
+     * support of the device, which is also done by initScan.
+     */
+    void initDeviceLimits();
+};
+
+} // End namespace kp
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpAlgoBase.hpp"
+
+#define KP_DEFAULT_SOFTMAX_WORKGROUP_SIZE 256
+
+namespace kp {
+
+/**
+ * Operation that computes the softmax of each row of the last dimension of
+ * the first tensor into the second tensor, which can be the same tensor.
+ *
+ * Each workgroup reduces a row into its maximum and the sum of the
+ * exponentials relative to the maximum in a single pass, rescaling the
+ * partial sums when the maximum increases, so large inputs do not overflow.
+ * The shader is compiled ahead of time and specialised with the row size and
+ * the workgroup size of the device.
+ */
+class OpSoftmax : public OpAlgoBase
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpSoftmax();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input and output tensors
+     */
+    OpSoftmax(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+              std::shared_ptr<vk::Device> device,
+              std::shared_ptr<vk::CommandBuffer> commandBuffer,
+              std::vector<std::shared_ptr<Tensor>>& tensors);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpSoftmax() override;
+
+    /**
+     * Validates the shapes of the tensors and creates the algorithm
+     * specialised for the row size.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatch of the softmax with the barriers of the input and
+     * output tensors.
+     */
+    virtual void record() override;
+
+#if RELEASE
+    /**
+     * If RELEASE=1 it will be using the static version of the shader which is
+     * loaded using this file directly. Otherwise it should not override the function.
+     */
+    std::vector<char> fetchSpirvBinaryData() override;
+#endif
+};
+
+} // End namespace kp
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpScan.hpp"
+
+#define KP_SORT_RADIX_BITS 4
+
+namespace kp {
+
+/**
+ * Operation that sorts the keys of the first tensor in place with a stable
+ * least significant digit radix sort, and optionally reorders a second tensor
+ * of values of the same size together with the keys.
+ *
+ * Each pass of the sort computes a histogram of the digits of each block of
+ * keys, scans it with the block scan of kp::OpScan into the position of each
+ * digit of each block, and scatters the keys of each block into their
+ * positions. The keys are mapped to unsigned integers that preserve their
+ * order, so float keys are sorted numerically including negative values.
+ */
+class OpSort : public OpScan
+{
+  public:
+    /**
+     * Interpretation of the 32 bit elements of the keys tensor, where eUint
+     * keys hold the bits of unsigned integers in the tensor memory.
+     */
+    enum class KeyTypes
+    {
+        eFloat = 0,
+        eUint = 1,
+    };
+
+    /**
+     * Order of the sorted keys.
+     */
+    enum class SortOrders
+    {
+        eAscending = 0,
+        eDescending = 1,
+    };
+
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpSort();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the keys tensor optionally followed by a values tensor
+     * @param keyType Whether the keys are floats or unsigned integers
+     * @param sortOrder Whether the keys are sorted in ascending or descending order
+     */
+    OpSort(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           KeyTypes keyType = KeyTypes::eFloat,
+           SortOrders sortOrder = SortOrders::eAscending);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithms
+     * and the intermediate tensors but does not destroy the underlying tensors
+     */
+    virtual ~OpSort() override;
+
+    /**
+     * Validates the sizes of the tensors, creates the intermediate tensors
+     * and the algorithms of each pass of the sort.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatches of each pass of the sort with the barriers
+     * between them.
+     */
+    virtual void record() override;
+
+  protected:
+    // -------------- ALWAYS OWNED RESOURCES
+    KeyTypes mKeyType = KeyTypes::eFloat;
+    SortOrders mSortOrder = SortOrders::eAscending;
+    std::vector<std::shared_ptr<Tensor>> mSortInputs;
+    std::vector<std::shared_ptr<Tensor>> mSortOutputs;
+    std::vector<std::shared_ptr<Tensor>> mSortKeys;
+    std::vector<std::shared_ptr<Tensor>> mSortValues;
+    std::shared_ptr<Tensor> mHistogram;
+    std::shared_ptr<Tensor> mSortPlaceholder;
+    std::shared_ptr<Algorithm> mLoadAlgorithm;
+    std::shared_ptr<Algorithm> mStoreAlgorithm;
+    std::vector<std::shared_ptr<Algorithm>> mHistogramAlgorithms;
+    std::vector<std::shared_ptr<Algorithm>> mScatterAlgorithms;
+
+    /**
+     * Creates the passes that sort keys and values into output tensors,
+     * where only the first elements that fit in the outputs are stored.
+     *
+     * @param keys The keys to sort
+     * @param values The values reordered with the keys, or nullptr to use the index of each key as its value
+     * @param outputKeys The tensor the first sorted keys are written into
+     * @param outputValues The tensor the values of the first sorted keys are written into, or nullptr to only sort the keys
+     */
+    void initSort(std::shared_ptr<Tensor> keys,
+                  std::shared_ptr<Tensor> values,
+                  std::shared_ptr<Tensor> outputKeys,
+                  std::shared_ptr<Tensor> outputValues);
+
+    /**
+     * Records the dispatches of the sort created by initSort.
+     */
+    void recordSort();
+
+  private:
+    void recordShaderBarrier(std::shared_ptr<Tensor> tensor);
+};
+
+} // End namespace kp
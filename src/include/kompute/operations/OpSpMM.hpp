@@ -0,0 +1,63 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/SparseTensor.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpSpMV.hpp"
+
+namespace kp {
+
+/**
+ * Operation that multiplies a kp::SparseTensor by the dense matrix of the
+ * first tensor, writing the result into the second tensor. The dense matrices
+ * are in row major order, where the first tensor has as many rows as the
+ * columns of the sparse matrix, and the second tensor as many rows as the
+ * rows of the sparse matrix, with the same number of columns.
+ *
+ * Each invocation computes an element of the output, and consecutive
+ * invocations compute consecutive columns of a row so they share the non zero
+ * elements of the row and read consecutive elements of the dense matrix.
+ */
+class OpSpMM : public OpSpMV
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpSpMM();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the dense input and output tensors
+     * @param matrix Sparse matrix whose tensors must be initialised
+     */
+    OpSpMM(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           std::shared_ptr<SparseTensor> matrix);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpSpMM() override;
+
+    /**
+     * Computes the number of columns of the dense matrices from the shape of
+     * the input, validates the sizes of the tensors and creates the algorithm
+     * of the multiplication.
+     */
+    virtual void init() override;
+};
+
+} // End namespace kp
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/SparseTensor.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpAlgoBase.hpp"
+
+#define KP_DEFAULT_SPARSE_WORKGROUP_SIZE 256
+#define KP_SPARSE_CSR_MAX_LANES 32
+
+namespace kp {
+
+/**
+ * Operation that multiplies a kp::SparseTensor by the dense vector of the
+ * first tensor, writing the result into the second tensor. The size of the
+ * first tensor is the number of columns of the matrix and the size of the
+ * second tensor is the number of rows.
+ *
+ * Matrices in the CSR format are multiplied with a subgroup per row, where
+ * the invocations of the subgroup stride over the non zero elements of the
+ * row and their products are summed with subgroup arithmetic. Devices without
+ * subgroup arithmetic use groups of invocations sized from the average number
+ * of non zero elements of the rows, which are summed in shared memory.
+ * Matrices in the ELL format are multiplied with an invocation per row, which
+ * loads the padded row in vectors of KP_SPARSE_ELL_VECTOR_SIZE elements.
+ */
+class OpSpMV : public OpAlgoBase
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpSpMV();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the dense input and output tensors
+     * @param matrix Sparse matrix whose tensors must be initialised
+     */
+    OpSpMV(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           std::shared_ptr<SparseTensor> matrix);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    virtual ~OpSpMV() override;
+
+    /**
+     * Validates the sizes of the tensors against the matrix and creates the
+     * algorithm of the multiplication.
+     */
+    virtual void init() override;
+
+    /**
+     * Records the dispatch of the multiplication with the barriers on the
+     * tensors of the matrix, the input and the output.
+     */
+    virtual void record() override;
+
+  protected:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<SparseTensor> mMatrix; ///< Sparse matrix multiplied by the first tensor
+
+    // -------------- ALWAYS OWNED RESOURCES
+    uint32_t mWorkgroupSize = KP_DEFAULT_SPARSE_WORKGROUP_SIZE;
+
+    /**
+     * Validates the tensors of the matrix and creates the algorithm that
+     * multiplies it by a dense matrix of the number of columns provided, in
+     * row major order, which is a vector when there is a single column.
+     *
+     * @param denseColumns The number of columns of the dense input and output
+     */
+    void initMultiplication(uint32_t denseColumns);
+
+  private:
+    uint32_t dispatchSize(uint32_t count);
+};
+
+} // End namespace kp
@@ -67,10 +67,22 @@ class OpTensorCreate : public OpBase
      */
     virtual void postEval() override;
 
+    /**
+     * Sets the extensions enabled in the device, which are passed to the
+     * tensors when they are initialised so they only use the features of the
+     * extensions available. This is set by the kp::Sequence with the
+     * extensions enabled by the kp::Manager before the init function is
+     * called.
+     *
+     * @param enabledExtensions The names of the extensions enabled
+     */
+    void setEnabledExtensions(
+      const std::vector<std::string>& enabledExtensions);
 
   private:
     // Never owned resources
     std::vector<std::shared_ptr<Tensor>> mStagingTensors;
+    std::vector<std::string> mEnabledExtensions;
 };
 
 } // End namespace kp
@@ -9,7 +9,7 @@
 namespace kp {
 
 /**
-    Operation that syncs tensor's device by mapping local data into the device memory. For TensorTypes::eDevice it will use a staging tensor to perform the copy. For TensorTypes::eStaging it will only copy the data and perform a map, which will be executed during the record (as opposed to during the sequence eval/submit). This function cannot be carried out for TensorTypes::eStaging.
+    Operation that syncs tensor's device by mapping local data into the device memory. For TensorTypes::eDevice it will use a staging tensor to perform the copy, unless the tensor is in unified memory in which case it is mapped directly. For TensorTypes::eStaging it will only copy the data and perform a map, which will be executed during the record (as opposed to during the sequence eval/submit). This function cannot be carried out for TensorTypes::eStaging.
 */
 class OpTensorSyncDevice : public OpBase
 {
@@ -23,11 +23,13 @@ class OpTensorSyncDevice : public OpBase
      * @param device Vulkan logical device for passing to Algorithm
      * @param commandBuffer Vulkan Command Buffer to record commands into
      * @param tensors Tensors that will be used to create in operation.
+     * @param ranges (Optional) Ranges of elements to sync for all the tensors, which otherwise syncs the ranges marked as dirty in each tensor or the whole tensor if none are marked.
      */
     OpTensorSyncDevice(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
                    std::shared_ptr<vk::Device> device,
                    std::shared_ptr<vk::CommandBuffer> commandBuffer,
-                   std::vector<std::shared_ptr<Tensor>> tensors);
+                   std::vector<std::shared_ptr<Tensor>> tensors,
+                   std::vector<Tensor::Range> ranges = {});
 
     /**
      * Default destructor. This class does not manage memory so it won't be expecting the parent to perform a release.
@@ -40,12 +42,12 @@ class OpTensorSyncDevice : public OpBase
     void init() override;
 
     /**
-     * For device tensors, it records the copy command to the device tensor from the temporary staging tensor.
+     * For device tensors, it records the copy command to the device tensor from the temporary staging tensor, with one copy region per coalesced range. The copy regions are resolved from the dirty ranges when recorded, but the dirty ranges are only cleared when the operation is evaluated.
      */
     void record() override;
 
     /**
-     * Does not perform any preEval commands.
+     * Maps the ranges of the local data into the staging tensors, or into the tensors themselves if they are of type TensorTypes::eStaging or in unified memory, and clears the dirty ranges of the tensors. The ranges of tensors mapped directly are resolved from the dirty ranges on every evaluation. Tensors transferred through a staging tensor always transfer the ranges recorded, and ranges marked dirty after recording that are not within them throw an exception as the operation has to be recorded again.
      */
     virtual void preEval() override;
 
@@ -57,6 +59,13 @@ class OpTensorSyncDevice : public OpBase
   private:
     // Never owned resources
     std::vector<std::shared_ptr<Tensor>> mStagingTensors;
+
+    // Always owned resources
+    std::vector<Tensor::Range> mRanges;
+    std::vector<std::vector<Tensor::Range>> mRecordedRanges;
+
+    // Resolves the explicit ranges, the dirty ranges or the whole tensor
+    std::vector<Tensor::Range> resolveRanges(std::shared_ptr<Tensor> tensor);
 };
 
 } // End namespace kp
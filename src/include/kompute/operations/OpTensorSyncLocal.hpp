@@ -9,7 +9,7 @@
 namespace kp {
 
 /**
-    Operation that syncs tensor's local data by mapping the data from device memory into the local vector. For TensorTypes::eDevice it will use a staging tensor to perform the copy. For TensorTypes::eStaging it will only copy the data and perform a map, which will be executed during the postSubmit (there will be no copy during the sequence eval/submit). This function cannot be carried out for TensorTypes::eStaging.
+    Operation that syncs tensor's local data by mapping the data from device memory into the local vector. For TensorTypes::eDevice it will use a staging tensor to perform the copy, unless the tensor is in unified memory in which case it is mapped directly. For TensorTypes::eStaging it will only copy the data and perform a map, which will be executed during the postSubmit (there will be no copy during the sequence eval/submit). This function cannot be carried out for TensorTypes::eStaging.
 */
 class OpTensorSyncLocal : public OpBase
 {
@@ -23,11 +23,13 @@ class OpTensorSyncLocal : public OpBase
      * @param device Vulkan logical device for passing to Algorithm
      * @param commandBuffer Vulkan Command Buffer to record commands into
      * @param tensors Tensors that will be used to create in operation.
+     * @param ranges (Optional) Ranges of elements to sync for all the tensors, which otherwise syncs the whole tensors.
      */
     OpTensorSyncLocal(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
                    std::shared_ptr<vk::Device> device,
                    std::shared_ptr<vk::CommandBuffer> commandBuffer,
-                   std::vector<std::shared_ptr<Tensor>> tensors);
+                   std::vector<std::shared_ptr<Tensor>> tensors,
+                   std::vector<Tensor::Range> ranges = {});
 
     /**
      * Default destructor. This class manages the memory of the staging tensors it owns but these are released in the postSubmit, before it arrives to the destructor.
@@ -40,7 +42,7 @@ class OpTensorSyncLocal : public OpBase
     void init() override;
 
     /**
-     * For device tensors, it records the copy command into the staging tensor from the device tensor.
+     * For device tensors, it records the copy command into the staging tensor from the device tensor, with one copy region per coalesced range.
      */
     void record() override;
 
@@ -58,6 +60,10 @@ class OpTensorSyncLocal : public OpBase
   private:
     // Never owned resources
     std::vector<std::shared_ptr<Tensor>> mStagingTensors;
+
+    // Always owned resources
+    std::vector<Tensor::Range> mRanges;
+    std::vector<std::vector<Tensor::Range>> mTensorRanges;
 };
 
 } // End namespace kp
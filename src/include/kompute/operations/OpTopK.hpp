@@ -0,0 +1,60 @@
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpSort.hpp"
+
+namespace kp {
+
+/**
+ * Operation that finds the k largest elements of the first tensor, writing
+ * them in descending order into the second tensor and their indices in the
+ * first tensor into the third tensor, where k is the size of the second and
+ * third tensors.
+ *
+ * The elements are sorted together with their indices by kp::OpSort, and only
+ * the first k sorted elements are stored into the outputs. Ties are returned
+ * in the order of their indices as the sort is stable.
+ */
+class OpTopK : public OpSort
+{
+  public:
+    /**
+     *  Base constructor, should not be used unless explicitly intended.
+     */
+    OpTopK();
+
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param physicalDevice Vulkan physical device used to find device queues
+     * @param device Vulkan logical device for passing to Algorithm
+     * @param commandBuffer Vulkan Command Buffer to record commands into
+     * @param tensors Tensors that are to be used in this operation, with the input tensor followed by the values and indices output tensors
+     * @param sortOrder Whether the largest elements are returned in descending order, or the smallest in ascending order
+     */
+    OpTopK(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           std::shared_ptr<vk::CommandBuffer> commandBuffer,
+           std::vector<std::shared_ptr<Tensor>>& tensors,
+           SortOrders sortOrder = SortOrders::eDescending);
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithms
+     * and the intermediate tensors but does not destroy the underlying tensors
+     */
+    virtual ~OpTopK() override;
+
+    /**
+     * Validates the sizes of the tensors and creates the passes of the sort
+     * of the input tensor with its indices.
+     */
+    virtual void init() override;
+};
+
+} // End namespace kp
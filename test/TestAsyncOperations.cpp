@@ -1,7 +1,9 @@
 
 #include "gtest/gtest.h"
 
+#include <atomic>
 #include <chrono>
+#include <thread>
 
 #include "kompute/Kompute.hpp"
 
@@ -166,3 +168,287 @@ TEST(TestAsyncOperations, TestManagerAsyncExecution)
     EXPECT_EQ(tensorA->data(), resultAsync);
     EXPECT_EQ(tensorB->data(), resultAsync);
 }
+
+TEST(TestAsyncOperations, TestManagerAsyncFutures)
+{
+    uint32_t size = 10;
+
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer b { float pb[]; };
+
+        shared uint sharedTotal[1];
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+
+            sharedTotal[0] = 0;
+
+            for (int i = 0; i < 100000000; i++)
+            {
+                atomicAdd(sharedTotal[0], 1);
+            }
+
+            pb[index] = sharedTotal[0];
+        }
+    )");
+
+    std::vector<float> data(size, 0.0);
+    std::vector<float> resultAsync(size, 100000000);
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorA{ new kp::Tensor(data) };
+    std::shared_ptr<kp::Tensor> tensorB{ new kp::Tensor(data) };
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorA, tensorB });
+
+    // Both futures are tracked independently, so awaiting them doesn't
+    // depend on which default sequence was created last
+    kp::EvalFuture futureA = mgr.evalOpAsyncDefault<kp::OpAlgoBase>(
+      { tensorA }, std::vector<char>(shader.begin(), shader.end()));
+    kp::EvalFuture futureB = mgr.evalOpAsyncDefault<kp::OpAlgoBase>(
+      { tensorB }, std::vector<char>(shader.begin(), shader.end()));
+
+    EXPECT_TRUE(futureA.valid());
+    EXPECT_TRUE(futureB.valid());
+
+    std::atomic<uint32_t> numContinuations(0);
+    kp::EvalFuture chained =
+      futureA.then([&numContinuations](kp::EvalFuture future) {
+          EXPECT_TRUE(future.ready());
+          numContinuations++;
+      });
+
+    EXPECT_TRUE(chained.wait());
+    EXPECT_TRUE(chained.get());
+    EXPECT_TRUE(futureA.ready());
+    EXPECT_TRUE(futureA.get());
+    EXPECT_TRUE(futureB.get());
+    EXPECT_EQ(numContinuations, 1);
+
+    // Continuations chained on a finished future run in the calling thread
+    futureB.then([&numContinuations](kp::EvalFuture) {
+        numContinuations++;
+    });
+    EXPECT_EQ(numContinuations, 2);
+
+    EXPECT_THROW(futureB
+                   .then([](kp::EvalFuture) {
+                       throw std::runtime_error("Continuation failure");
+                   })
+                   .get(),
+                 std::runtime_error);
+
+    EXPECT_TRUE(
+      mgr.evalOpAsyncDefault<kp::OpTensorSyncLocal>({ tensorA, tensorB })
+        .get());
+
+    EXPECT_EQ(tensorA->data(), resultAsync);
+    EXPECT_EQ(tensorB->data(), resultAsync);
+}
+
+TEST(TestAsyncOperations, TestSequencePollingAfterAwaitTimeout)
+{
+    uint32_t size = 10;
+
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer b { float pb[]; };
+
+        shared uint sharedTotal[1];
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+
+            sharedTotal[0] = 0;
+
+            for (int i = 0; i < 100000000; i++)
+            {
+                atomicAdd(sharedTotal[0], 1);
+            }
+
+            pb[index] = sharedTotal[0];
+        }
+    )");
+
+    std::vector<float> data(size, 0.0);
+    std::vector<float> resultAsync(size, 100000000);
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorA{ new kp::Tensor(data) };
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorA });
+
+    std::shared_ptr<kp::Sequence> sq = mgr.createManagedSequence("polled");
+
+    sq->begin();
+    sq->record<kp::OpAlgoBase>(
+      { tensorA }, std::vector<char>(shader.begin(), shader.end()));
+    sq->record<kp::OpTensorSyncLocal>({ tensorA });
+    sq->end();
+
+    EXPECT_TRUE(sq->evalAsync());
+
+    // A timed out await keeps the sequence running so it can be awaited again
+    if (!sq->evalAwait(0)) {
+        EXPECT_TRUE(sq->isRunning());
+        while (!sq->isComplete()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_TRUE(sq->evalAwait(0));
+    }
+
+    EXPECT_FALSE(sq->isRunning());
+    EXPECT_TRUE(sq->isComplete());
+    EXPECT_EQ(tensorA->data(), resultAsync);
+}
+
+TEST(TestAsyncOperations, TestTransferEngineStreamingOverlap)
+{
+    uint32_t size = 1000;
+
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer a { float pa[]; };
+        layout(set = 0, binding = 1) buffer b { float pb[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            pb[index] = pa[index] * 2;
+        }
+    )");
+
+    // Second queue of the same family is used for the transfers
+    kp::Manager mgr(0, { 0, 0 });
+
+    // Small chunks so each tensor is streamed through multiple chunks
+    std::shared_ptr<kp::TransferEngine> transferEngine =
+      mgr.createTransferEngine(1, 256, 2);
+
+    std::vector<float> dataFirst(size);
+    std::vector<float> dataSecond(size);
+    for (uint32_t i = 0; i < size; i++) {
+        dataFirst[i] = i;
+        dataSecond[i] = size - i;
+    }
+
+    std::shared_ptr<kp::Tensor> tensorInFirst{ new kp::Tensor(
+      std::vector<float>(size, 0)) };
+    std::shared_ptr<kp::Tensor> tensorInSecond{ new kp::Tensor(
+      std::vector<float>(size, 0)) };
+    std::shared_ptr<kp::Tensor> tensorOutFirst{ new kp::Tensor(
+      std::vector<float>(size, 0)) };
+    std::shared_ptr<kp::Tensor> tensorOutSecond{ new kp::Tensor(
+      std::vector<float>(size, 0)) };
+
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorInFirst, tensorInSecond, tensorOutFirst, tensorOutSecond });
+
+    // Tensors are created with zeros so the values come from the uploads
+    tensorInFirst->setData(dataFirst);
+    tensorInSecond->setData(dataSecond);
+
+    transferEngine->upload({ tensorInFirst });
+
+    std::shared_ptr<kp::Sequence> sq = mgr.getOrCreateManagedSequence("run");
+
+    sq->begin();
+    sq->record<kp::OpAlgoBase>(
+      { tensorInFirst, tensorOutFirst },
+      std::vector<char>(shader.begin(), shader.end()));
+    sq->end();
+
+    // The upload of the next batch overlaps with the compute of the first
+    std::future<void> uploadSecond =
+      transferEngine->uploadAsync({ tensorInSecond });
+
+    sq->evalAsync();
+    sq->evalAwait();
+
+    uploadSecond.get();
+
+    std::shared_ptr<kp::Sequence> sqSecond =
+      mgr.getOrCreateManagedSequence("runSecond");
+
+    sqSecond->begin();
+    sqSecond->record<kp::OpAlgoBase>(
+      { tensorInSecond, tensorOutSecond },
+      std::vector<char>(shader.begin(), shader.end()));
+    sqSecond->end();
+    sqSecond->eval();
+
+    transferEngine->download({ tensorOutFirst, tensorOutSecond });
+
+    std::vector<float> expectedFirst(size);
+    std::vector<float> expectedSecond(size);
+    for (uint32_t i = 0; i < size; i++) {
+        expectedFirst[i] = dataFirst[i] * 2;
+        expectedSecond[i] = dataSecond[i] * 2;
+    }
+
+    EXPECT_EQ(tensorOutFirst->data(), expectedFirst);
+    EXPECT_EQ(tensorOutSecond->data(), expectedSecond);
+}
+
+TEST(TestAsyncOperations, TestTransferEngineCopyAcrossManagers)
+{
+    uint32_t size = 1000;
+
+    // Separate managers create separate logical devices, so the copy is
+    // bounced through the host in chunks
+    kp::Manager mgrSrc;
+    kp::Manager mgrDst;
+
+    std::shared_ptr<kp::TransferEngine> transferEngineSrc =
+      mgrSrc.createTransferEngine(0, 256, 2);
+    std::shared_ptr<kp::TransferEngine> transferEngineDst =
+      mgrDst.createTransferEngine(0, 256, 2);
+
+    std::vector<float> data(size);
+    for (uint32_t i = 0; i < size; i++) {
+        data[i] = i;
+    }
+
+    std::shared_ptr<kp::Tensor> tensorSrc{ new kp::Tensor(data) };
+    std::shared_ptr<kp::Tensor> tensorDst{ new kp::Tensor(
+      std::vector<float>(size, 0)) };
+    std::shared_ptr<kp::Tensor> tensorSrcCopy{ new kp::Tensor(
+      std::vector<float>(size, 0)) };
+
+    mgrSrc.evalOpDefault<kp::OpTensorCreate>({ tensorSrc, tensorSrcCopy });
+    mgrDst.evalOpDefault<kp::OpTensorCreate>({ tensorDst });
+
+    std::future<void> copyFuture =
+      transferEngineSrc->copyToAsync(tensorSrc, transferEngineDst, tensorDst);
+    copyFuture.get();
+
+    EXPECT_EQ(tensorDst->data(), data);
+
+    // The host data is cleared so the values come from the device memory
+    tensorDst->setData(std::vector<float>(size, 0));
+    mgrDst.evalOpDefault<kp::OpTensorSyncLocal>({ tensorDst });
+    EXPECT_EQ(tensorDst->data(), data);
+
+    // Copies within the same manager are recorded as a direct buffer copy
+    transferEngineSrc->copyTo(tensorSrc, transferEngineSrc, tensorSrcCopy);
+    tensorSrcCopy->setData(std::vector<float>(size, 0));
+    mgrSrc.evalOpDefault<kp::OpTensorSyncLocal>({ tensorSrcCopy });
+    EXPECT_EQ(tensorSrcCopy->data(), data);
+
+    std::shared_ptr<kp::Tensor> tensorSmall{ new kp::Tensor({ 0, 0 }) };
+    mgrDst.evalOpDefault<kp::OpTensorCreate>({ tensorSmall });
+    EXPECT_THROW(
+      transferEngineSrc->copyTo(tensorSrc, transferEngineDst, tensorSmall),
+      std::runtime_error);
+}
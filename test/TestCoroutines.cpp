@@ -0,0 +1,119 @@
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+
+#if KOMPUTE_ENABLE_COROUTINES
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+// Minimal eagerly started coroutine type, as the awaitables can be used from
+// the coroutine types of any framework
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+// Single threaded event loop used as the executor of the coroutines
+class EventLoop
+{
+  public:
+    void post(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mMutex);
+            this->mTasks.push_back(task);
+        }
+        this->mCondition.notify_one();
+    }
+
+    void runUntil(std::function<bool()> isDone)
+    {
+        while (!isDone()) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(this->mMutex);
+                this->mCondition.wait(
+                  lock, [this]() { return !this->mTasks.empty(); });
+                task = this->mTasks.front();
+                this->mTasks.pop_front();
+            }
+            task();
+        }
+    }
+
+  private:
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<std::function<void()>> mTasks;
+};
+
+DetachedTask
+multiplyAndSync(std::shared_ptr<kp::Sequence> sq,
+                kp::CoroExecutor executor,
+                uint32_t& numFinished)
+{
+    bool isSuccessful = co_await sq->evalCoro(executor);
+    EXPECT_TRUE(isSuccessful);
+    numFinished++;
+}
+
+TEST(TestCoroutines, ManyCoroutinesAwaitSequencesOnEventLoop)
+{
+    uint32_t numCoroutines = 64;
+
+    kp::Manager mgr;
+
+    std::vector<std::shared_ptr<kp::Tensor>> tensorsOut;
+    std::vector<std::shared_ptr<kp::Sequence>> sequences;
+    for (uint32_t i = 0; i < numCoroutines; i++) {
+        std::shared_ptr<kp::Tensor> tensorLHS{ new kp::Tensor({ 0, 1, 2 }) };
+        std::shared_ptr<kp::Tensor> tensorRHS{ new kp::Tensor(
+          { (float)i, (float)i, (float)i }) };
+        std::shared_ptr<kp::Tensor> tensorOutput{ new kp::Tensor(
+          { 0, 0, 0 }) };
+
+        mgr.evalOpDefault<kp::OpTensorCreate>(
+          { tensorLHS, tensorRHS, tensorOutput });
+
+        std::shared_ptr<kp::Sequence> sq = mgr.createManagedSequence();
+        sq->begin();
+        sq->record<kp::OpMult>({ tensorLHS, tensorRHS, tensorOutput });
+        sq->record<kp::OpTensorSyncLocal>({ tensorOutput });
+        sq->end();
+
+        tensorsOut.push_back(tensorOutput);
+        sequences.push_back(sq);
+    }
+
+    EventLoop loop;
+    kp::CoroExecutor executor = [&loop](std::function<void()> resume) {
+        loop.post(resume);
+    };
+
+    // All the coroutines are in flight at the same time and are resumed by
+    // the event loop once the completion thread awaits their sequence
+    uint32_t numFinished = 0;
+    for (uint32_t i = 0; i < numCoroutines; i++) {
+        multiplyAndSync(sequences[i], executor, numFinished);
+    }
+
+    loop.runUntil(
+      [&numFinished, numCoroutines]() { return numFinished == numCoroutines; });
+
+    for (uint32_t i = 0; i < numCoroutines; i++) {
+        EXPECT_EQ(tensorsOut[i]->data(),
+                  std::vector<float>({ 0, (float)i, 2 * (float)i }));
+    }
+}
+
+#endif // KOMPUTE_ENABLE_COROUTINES
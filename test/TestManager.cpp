@@ -1,6 +1,8 @@
 
 #include "gtest/gtest.h"
 
+#include <thread>
+
 #include "kompute/Kompute.hpp"
 
 TEST(TestManager, EndToEndOpMultFlow)
@@ -132,3 +134,206 @@ TEST(TestManager, TestCreateInitTensor)
 
     EXPECT_EQ(tensorC->data(), std::vector<float>({ 0, 1, 2 }));
 }
+
+TEST(TestManager, TestExternalDeviceCreatesComputeQueue)
+{
+    vk::ApplicationInfo applicationInfo;
+    applicationInfo.pApplicationName = "Kompute Test";
+    applicationInfo.apiVersion = KOMPUTE_VK_API_VERSION;
+    vk::InstanceCreateInfo instanceCreateInfo;
+    instanceCreateInfo.pApplicationInfo = &applicationInfo;
+    std::shared_ptr<vk::Instance> instance = std::make_shared<vk::Instance>();
+    vk::createInstance(&instanceCreateInfo, nullptr, instance.get());
+
+    std::vector<vk::PhysicalDevice> physicalDevices =
+      instance->enumeratePhysicalDevices();
+    ASSERT_FALSE(physicalDevices.empty());
+    std::shared_ptr<vk::PhysicalDevice> physicalDevice =
+      std::make_shared<vk::PhysicalDevice>(physicalDevices[0]);
+
+    uint32_t computeQueueFamilyIndex = 0;
+    std::vector<vk::QueueFamilyProperties> allQueueFamilyProperties =
+      physicalDevice->getQueueFamilyProperties();
+    while (!(allQueueFamilyProperties[computeQueueFamilyIndex].queueFlags &
+             vk::QueueFlagBits::eCompute)) {
+        computeQueueFamilyIndex++;
+    }
+
+    float queuePriority = 1.0f;
+    vk::DeviceQueueCreateInfo deviceQueueCreateInfo(
+      vk::DeviceQueueCreateFlags(), computeQueueFamilyIndex, 1, &queuePriority);
+    vk::DeviceCreateInfo deviceCreateInfo(
+      vk::DeviceCreateFlags(), 1, &deviceQueueCreateInfo);
+    std::shared_ptr<vk::Device> device = std::make_shared<vk::Device>();
+    physicalDevice->createDevice(&deviceCreateInfo, nullptr, device.get());
+
+    {
+        kp::Manager mgr(instance, physicalDevice, device, 0);
+
+        std::shared_ptr<kp::Tensor> tensorLHS{ new kp::Tensor({ 0, 1, 2 }) };
+        std::shared_ptr<kp::Tensor> tensorRHS{ new kp::Tensor({ 2, 4, 6 }) };
+        std::shared_ptr<kp::Tensor> tensorOutput{ new kp::Tensor(
+          { 0, 0, 0 }) };
+
+        mgr.evalOpDefault<kp::OpTensorCreate>(
+          { tensorLHS, tensorRHS, tensorOutput });
+        mgr.evalOpDefault<kp::OpMult>({ tensorLHS, tensorRHS, tensorOutput });
+        mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorOutput });
+
+        EXPECT_EQ(tensorOutput->data(), std::vector<float>({ 0, 4, 12 }));
+    }
+
+    device->destroy(
+      (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    instance->destroy(
+      (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+}
+
+TEST(TestManager, TestConcurrentGetOrCreateSequence)
+{
+    kp::Manager mgr;
+
+    uint32_t numThreads = 16;
+
+    std::vector<std::shared_ptr<kp::Sequence>> sequences(numThreads);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < numThreads; i++) {
+        threads.push_back(std::thread([&mgr, &sequences, i]() {
+            sequences[i] = mgr.getOrCreateManagedSequence("shared");
+        }));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (uint32_t i = 1; i < numThreads; i++) {
+        EXPECT_EQ(sequences[i], sequences[0]);
+    }
+}
+
+TEST(TestManager, TestStressEvalOpAsyncFromManyThreads)
+{
+    kp::Manager mgr;
+
+    uint32_t numThreads = 8;
+    uint32_t numIterations = 50;
+
+    std::vector<std::shared_ptr<kp::Tensor>> tensorsOut;
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < numThreads; i++) {
+        tensorsOut.push_back(
+          std::make_shared<kp::Tensor>(std::vector<float>{ 0, 0, 0 }));
+    }
+
+    for (uint32_t i = 0; i < numThreads; i++) {
+        threads.push_back(std::thread([&mgr, &tensorsOut, numIterations, i]() {
+            std::string sequenceName = "thread" + std::to_string(i);
+            std::shared_ptr<kp::Tensor> tensorLHS{ new kp::Tensor(
+              { 0, 1, 2 }) };
+            std::shared_ptr<kp::Tensor> tensorRHS{ new kp::Tensor(
+              { (float)i, (float)i, (float)i }) };
+            std::shared_ptr<kp::Tensor> tensorOutput = tensorsOut[i];
+
+            mgr.evalOpDefault<kp::OpTensorCreate>(
+              { tensorLHS, tensorRHS, tensorOutput });
+
+            for (uint32_t j = 0; j < numIterations; j++) {
+                // Named sequences are awaited by the thread that owns them
+                mgr.evalOpAsync<kp::OpMult>(
+                  { tensorLHS, tensorRHS, tensorOutput }, sequenceName);
+                mgr.evalOpAwait(sequenceName);
+
+                // Default sequences are created per call so they are never
+                // shared across threads
+                mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorOutput });
+                mgr.evalOpDefault<kp::OpTensorSyncDevice>({ tensorRHS });
+            }
+
+            mgr.evalOp<kp::OpTensorSyncLocal>({ tensorOutput }, sequenceName);
+        }));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (uint32_t i = 0; i < numThreads; i++) {
+        EXPECT_EQ(tensorsOut[i]->data(),
+                  std::vector<float>({ 0, (float)i, 2 * (float)i }));
+    }
+}
+
+TEST(TestManager, TestConcurrentEvalOpSameNamedSequence)
+{
+    kp::Manager mgr;
+
+    uint32_t numThreads = 8;
+
+    std::shared_ptr<kp::Tensor> tensorLHS{ new kp::Tensor({ 0, 1, 2 }) };
+    std::shared_ptr<kp::Tensor> tensorRHS{ new kp::Tensor({ 2, 4, 6 }) };
+    std::shared_ptr<kp::Tensor> tensorOutput{ new kp::Tensor({ 0, 0, 0 }) };
+
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorLHS, tensorRHS, tensorOutput });
+
+    // Evaluations of the same named sequence are serialised by the manager
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < numThreads; i++) {
+        threads.push_back(std::thread([&mgr, tensorLHS, tensorRHS, tensorOutput]() {
+            mgr.evalOp<kp::OpMult>({ tensorLHS, tensorRHS, tensorOutput },
+                                   "shared");
+        }));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorOutput });
+
+    EXPECT_EQ(tensorOutput->data(), std::vector<float>({ 0, 4, 12 }));
+}
+
+TEST(TestManager, TestListDevicesAndSelectByPolicy)
+{
+    std::vector<kp::DeviceInfo> deviceInfos = kp::Manager::listDevices();
+
+    ASSERT_GT(deviceInfos.size(), 0);
+    for (uint32_t i = 0; i < deviceInfos.size(); i++) {
+        EXPECT_EQ(deviceInfos[i].index, i);
+        EXPECT_GT(deviceInfos[i].maxComputeWorkGroupInvocations, 0);
+        EXPECT_GT(deviceInfos[i].maxComputeSharedMemorySize, 0);
+    }
+
+    // Selecting by name and by a custom filter resolves to the same device
+    kp::DevicePolicy devicePolicy;
+    devicePolicy.filter = [](const kp::DeviceInfo& deviceInfo) {
+        return deviceInfo.maxComputeWorkGroupInvocations >= 64;
+    };
+    uint32_t selectedIndex = devicePolicy.select(deviceInfos);
+
+    kp::DevicePolicy namePolicy;
+    namePolicy.nameRegex = ".";
+    namePolicy.filter = devicePolicy.filter;
+    EXPECT_EQ(namePolicy.select(deviceInfos), selectedIndex);
+
+    kp::Manager mgr(devicePolicy);
+    EXPECT_EQ(mgr.physicalDeviceIndex(), selectedIndex);
+
+    std::shared_ptr<kp::Tensor> tensorLHS{ new kp::Tensor({ 0, 1, 2 }) };
+    std::shared_ptr<kp::Tensor> tensorRHS{ new kp::Tensor({ 2, 4, 6 }) };
+    std::shared_ptr<kp::Tensor> tensorOutput{ new kp::Tensor({ 0, 0, 0 }) };
+
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorLHS, tensorRHS, tensorOutput });
+    mgr.evalOpDefault<kp::OpMult>({ tensorLHS, tensorRHS, tensorOutput });
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorOutput });
+
+    EXPECT_EQ(tensorOutput->data(), std::vector<float>({ 0, 4, 12 }));
+
+    kp::DevicePolicy unsatisfiablePolicy;
+    unsatisfiablePolicy.requiredExtensions = { "VK_KOMPUTE_missing_extension" };
+    EXPECT_THROW(unsatisfiablePolicy.select(deviceInfos), std::runtime_error);
+
+    kp::DevicePolicy unmatchedNamePolicy;
+    unmatchedNamePolicy.nameRegex = "^$";
+    EXPECT_THROW(unmatchedNamePolicy.select(deviceInfos), std::runtime_error);
+}
@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+
+TEST(TestMultiDeviceManager, ShardEvalAndGatherOnSameDeviceTwice)
+{
+    // The same device is used twice so the test runs with a single GPU
+    std::vector<uint32_t> physicalDeviceIndices{ 0, 0 };
+    kp::MultiDeviceManager multiMgr(physicalDeviceIndices);
+
+    EXPECT_EQ(multiMgr.size(), 2);
+
+    std::vector<float> lhs{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    std::vector<float> rhs{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+    // Rows of two elements are split into three and two rows
+    std::vector<std::shared_ptr<kp::Tensor>> lhsShards =
+      multiMgr.shard(lhs, 2);
+    std::vector<std::shared_ptr<kp::Tensor>> rhsShards =
+      multiMgr.shard(rhs, 2);
+    std::vector<std::shared_ptr<kp::Tensor>> outShards =
+      multiMgr.shard(std::vector<float>(lhs.size(), 0), 2);
+
+    EXPECT_EQ(lhsShards[0]->size(), 6);
+    EXPECT_EQ(lhsShards[1]->size(), 4);
+
+    multiMgr.evalOp<kp::OpMult>({ lhsShards, rhsShards, outShards });
+
+    std::vector<float> expected;
+    for (size_t i = 0; i < lhs.size(); i++) {
+        expected.push_back(lhs[i] * rhs[i]);
+    }
+    EXPECT_EQ(multiMgr.gather(outShards), expected);
+
+    EXPECT_THROW(multiMgr.shard({ 0, 1, 2 }, 2), std::runtime_error);
+    EXPECT_THROW(multiMgr.shard({ 0 }), std::runtime_error);
+}
+
+TEST(TestMultiDeviceManager, AllReduceGradients)
+{
+    std::vector<std::shared_ptr<kp::Manager>> managers;
+    for (uint32_t i = 0; i < 3; i++) {
+        managers.push_back(std::make_shared<kp::Manager>(0));
+    }
+    kp::MultiDeviceManager multiMgr(managers);
+
+    std::vector<std::shared_ptr<kp::Tensor>> gradients =
+      multiMgr.replicate({ 0, 0, 0 });
+    for (uint32_t i = 0; i < gradients.size(); i++) {
+        gradients[i]->setData({ (float)i, 1, 2 * (float)i });
+    }
+    multiMgr.evalOp<kp::OpTensorSyncDevice>({ gradients });
+
+    EXPECT_EQ(multiMgr.allReduce(gradients),
+              std::vector<float>({ 3, 3, 6 }));
+
+    // The reduced values are synced back into the memory of every device
+    for (const std::shared_ptr<kp::Tensor>& gradient : gradients) {
+        gradient->setData({ 0, 0, 0 });
+    }
+    EXPECT_EQ(multiMgr.gather(gradients),
+              std::vector<float>({ 3, 3, 6, 3, 3, 6, 3, 3, 6 }));
+
+    EXPECT_EQ(
+      multiMgr.allReduce(gradients, kp::MultiDeviceManager::ReduceOps::eMean),
+      std::vector<float>({ 3, 3, 6 }));
+
+    EXPECT_THROW(multiMgr.allReduce({ gradients[0] }), std::runtime_error);
+}
@@ -1,6 +1,8 @@
 
 #include "gtest/gtest.h"
 
+#include <thread>
+
 #include "kompute/Kompute.hpp"
 
 TEST(TestMultipleAlgoExecutions, SingleSequenceRecord)
@@ -304,3 +306,170 @@ TEST(TestMultipleAlgoExecutions, ManagerEvalMultSourceStrMgrCreate)
 
     EXPECT_EQ(tensorOut->data(), std::vector<float>({ 0.0, 4.0, 12.0 }));
 }
+
+TEST(TestMultipleAlgoExecutions, DescriptorSetsSharedThroughManagerArena)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorA{ new kp::Tensor({ 0, 0, 0 }) };
+    std::shared_ptr<kp::Tensor> tensorB{ new kp::Tensor({ 0, 0, 0 }) };
+
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + 1;
+      })");
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorA, tensorB });
+
+    std::shared_ptr<kp::Sequence> sq = mgr.createManagedSequence();
+
+    for (size_t i = 0; i < 3; i++) {
+        sq->begin();
+        sq->record<kp::OpAlgoBase>(
+          { tensorA }, std::vector<char>(shader.begin(), shader.end()));
+        sq->record<kp::OpAlgoBase>(
+          { tensorA }, std::vector<char>(shader.begin(), shader.end()));
+        sq->end();
+        sq->eval();
+    }
+
+    // With push descriptors the bindings are recorded in the command buffer
+    // and no descriptor sets are allocated from the arena
+    bool isPushDescriptorsEnabled =
+      mgr.descriptorPoolArena()->isPushDescriptorsEnabled();
+
+    EXPECT_EQ(mgr.descriptorPoolArena()->numDescriptorSets(),
+              isPushDescriptorsEnabled ? 0 : 1);
+
+    sq->begin();
+    sq->record<kp::OpAlgoBase>({ tensorB },
+                               std::vector<char>(shader.begin(), shader.end()));
+    sq->record<kp::OpTensorSyncLocal>({ tensorA, tensorB });
+    sq->end();
+    sq->eval();
+
+    EXPECT_EQ(mgr.descriptorPoolArena()->numDescriptorSets(),
+              isPushDescriptorsEnabled ? 0 : 2);
+    EXPECT_EQ(mgr.descriptorPoolArena()->numDescriptorPools(),
+              isPushDescriptorsEnabled ? 0 : 1);
+
+    EXPECT_EQ(tensorA->data(), std::vector<float>({ 6, 6, 6 }));
+    EXPECT_EQ(tensorB->data(), std::vector<float>({ 1, 1, 1 }));
+}
+
+// Creates the tensor and evaluates the shader on it in a sequence which is
+// then cleared, so the tensor is only held by the caller and its descriptor
+// set is retired once it is destroyed
+static void
+evalAndReleaseSequence(kp::Manager& mgr,
+                       std::shared_ptr<kp::Tensor> tensor,
+                       const std::string& shader)
+{
+    std::shared_ptr<kp::Sequence> sq = mgr.createManagedSequence();
+    sq->begin();
+    sq->record<kp::OpTensorCreate>({ tensor });
+    sq->end();
+    sq->eval();
+    sq->begin();
+    sq->record<kp::OpAlgoBase>(
+      { tensor }, std::vector<char>(shader.begin(), shader.end()));
+    sq->end();
+    sq->eval();
+    sq->begin();
+    sq->end();
+}
+
+TEST(TestMultipleAlgoExecutions, RetiredDescriptorSetsFreedAfterSubmission)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorA{ new kp::Tensor({ 0, 0, 0 }) };
+    std::shared_ptr<kp::Tensor> tensorB{ new kp::Tensor({ 0, 0, 0 }) };
+
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + 1;
+      })");
+
+    std::shared_ptr<kp::DescriptorPoolArena> arena = mgr.descriptorPoolArena();
+    bool isPushDescriptorsEnabled = arena->isPushDescriptorsEnabled();
+
+    evalAndReleaseSequence(mgr, tensorA, shader);
+    tensorA = nullptr;
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorB });
+
+    // A submission still in flight may reference the set of the destroyed
+    // tensor, so it is only retired when the next set is allocated
+    uint64_t submission = arena->beginSubmission();
+
+    mgr.evalOpDefault<kp::OpAlgoBase>(
+      { tensorB }, std::vector<char>(shader.begin(), shader.end()));
+
+    EXPECT_EQ(arena->numRetiredDescriptorSets(),
+              isPushDescriptorsEnabled ? 0 : 1);
+    EXPECT_EQ(arena->numDescriptorSets(), isPushDescriptorsEnabled ? 0 : 1);
+
+    arena->endSubmission(submission);
+
+    EXPECT_EQ(arena->numRetiredDescriptorSets(), 0);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorB });
+
+    EXPECT_EQ(tensorB->data(), std::vector<float>({ 1, 1, 1 }));
+}
+
+TEST(TestMultipleAlgoExecutions, RetiredDescriptorSetsFreedWithoutAwait)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorA{ new kp::Tensor({ 0, 0, 0 }) };
+    std::shared_ptr<kp::Tensor> tensorB{ new kp::Tensor({ 0, 0, 0 }) };
+    std::shared_ptr<kp::Tensor> tensorC{ new kp::Tensor({ 0, 0, 0 }) };
+
+    std::string shader(R"(
+      #version 450
+      layout (local_size_x = 1) in;
+      layout(set = 0, binding = 0) buffer a { float pa[]; };
+      void main() {
+          uint index = gl_GlobalInvocationID.x;
+          pa[index] = pa[index] + 1;
+      })");
+
+    std::shared_ptr<kp::DescriptorPoolArena> arena = mgr.descriptorPoolArena();
+
+    evalAndReleaseSequence(mgr, tensorA, shader);
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorB, tensorC });
+
+    // The sequence is submitted and never awaited while the set is retired
+    std::shared_ptr<kp::Sequence> sq = mgr.createManagedSequence();
+    sq->begin();
+    sq->record<kp::OpAlgoBase>(
+      { tensorB }, std::vector<char>(shader.begin(), shader.end()));
+    sq->end();
+    sq->evalAsync();
+
+    tensorA = nullptr;
+
+    while (!sq->isComplete()) {
+        std::this_thread::yield();
+    }
+
+    // Allocating a set retires the set of the destroyed tensor, which is
+    // freed as the fence of the submission has signalled
+    mgr.evalOpDefault<kp::OpAlgoBase>(
+      { tensorC }, std::vector<char>(shader.begin(), shader.end()));
+
+    EXPECT_EQ(arena->numRetiredDescriptorSets(), 0);
+
+    sq->evalAwait();
+}
@@ -76,3 +76,81 @@ TEST(TestProcessingIterations, IterateThroughMultipleSumAndCopies)
 
     EXPECT_EQ(tensorA->data(), testExpectedOutVec);
 }
+
+TEST(TestProcessingIterations, IterateThroughDoubleBufferWithoutCopies)
+{
+    kp::Manager mgr;
+
+    uint32_t TOTAL_ITER = 10;
+
+    std::shared_ptr<kp::TensorDoubleBuffer> doubleBuffer{
+        new kp::TensorDoubleBuffer({ 0, 0, 0 })
+    };
+
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer a { float pa[]; };
+        layout(set = 0, binding = 1) buffer b { float pb[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            pb[index] = pa[index] + 1;
+        }
+    )");
+
+    mgr.evalOpDefault<kp::OpTensorCreate>(doubleBuffer->tensors());
+
+    {
+        std::shared_ptr<kp::Sequence> sq =
+          mgr.getOrCreateManagedSequence("run");
+
+        sq->begin();
+
+        sq->record<kp::OpAlgoDoubleBuffer>(
+          { doubleBuffer->read(), doubleBuffer->write() },
+          doubleBuffer,
+          TOTAL_ITER,
+          std::vector<char>(shader.begin(), shader.end()));
+
+        sq->end();
+
+        // An even number of iterations leaves the roles unchanged so the
+        // same recording can be evaluated again
+        sq->eval();
+        sq->eval();
+    }
+
+    EXPECT_EQ(doubleBuffer->readIndex(), 0);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ doubleBuffer->read() });
+
+    EXPECT_EQ(doubleBuffer->read()->data(),
+              std::vector<float>({ 20, 20, 20 }));
+
+    {
+        std::shared_ptr<kp::Sequence> sq =
+          mgr.getOrCreateManagedSequence("runOdd");
+
+        sq->begin();
+
+        sq->record<kp::OpAlgoDoubleBuffer>(
+          { doubleBuffer->read(), doubleBuffer->write() },
+          doubleBuffer,
+          3,
+          std::vector<char>(shader.begin(), shader.end()));
+
+        sq->end();
+
+        sq->eval();
+    }
+
+    EXPECT_EQ(doubleBuffer->readIndex(), 1);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ doubleBuffer->read() });
+
+    EXPECT_EQ(doubleBuffer->read()->data(),
+              std::vector<float>({ 23, 23, 23 }));
+}
@@ -0,0 +1,208 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+#include "kompute/Kompute.hpp"
+
+#include "TestUtils.hpp"
+
+static std::vector<float>
+attentionReference(const std::vector<float>& queries,
+                   const std::vector<float>& keys,
+                   const std::vector<float>& values,
+                   uint32_t batches,
+                   uint32_t queryRows,
+                   uint32_t keyRows,
+                   uint32_t headDim,
+                   uint32_t valueDim,
+                   bool causal)
+{
+    std::vector<float> output(batches * queryRows * valueDim);
+    float scale = 1.0f / std::sqrt(float(headDim));
+    for (uint32_t b = 0; b < batches; b++) {
+        for (uint32_t q = 0; q < queryRows; q++) {
+            uint32_t numKeys = causal ? q + keyRows - queryRows + 1 : keyRows;
+            std::vector<float> scores(numKeys);
+            float maxScore = -INFINITY;
+            for (uint32_t k = 0; k < numKeys; k++) {
+                float score = 0;
+                for (uint32_t d = 0; d < headDim; d++) {
+                    score += queries[(b * queryRows + q) * headDim + d] *
+                             keys[(b * keyRows + k) * headDim + d];
+                }
+                scores[k] = score * scale;
+                maxScore = std::max(maxScore, scores[k]);
+            }
+            float sum = 0;
+            for (uint32_t k = 0; k < numKeys; k++) {
+                scores[k] = std::exp(scores[k] - maxScore);
+                sum += scores[k];
+            }
+            for (uint32_t d = 0; d < valueDim; d++) {
+                float value = 0;
+                for (uint32_t k = 0; k < numKeys; k++) {
+                    value += scores[k] * values[(b * keyRows + k) * valueDim + d];
+                }
+                output[(b * queryRows + q) * valueDim + d] = value / sum;
+            }
+        }
+    }
+    return output;
+}
+
+TEST(TestOpAttention, SoftmaxOfLargeValues)
+{
+    kp::Manager mgr;
+
+    // The values would overflow the exponentials without subtracting the
+    // maximum of each row
+    uint32_t rowSize = 300;
+    std::vector<float> data(2 * rowSize);
+    std::vector<float> expected(2 * rowSize);
+    for (uint32_t row = 0; row < 2; row++) {
+        float sum = 0;
+        for (uint32_t i = 0; i < rowSize; i++) {
+            data[row * rowSize + i] = 1000.0f * row + (i % 7);
+            sum += std::exp(float(i % 7) - 6.0f);
+        }
+        for (uint32_t i = 0; i < rowSize; i++) {
+            expected[row * rowSize + i] = std::exp(float(i % 7) - 6.0f) / sum;
+        }
+    }
+
+    std::shared_ptr<kp::Tensor> tensor{ new kp::Tensor(data) };
+    tensor->reshape({ 2, rowSize });
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensor });
+
+    mgr.evalOpDefault<kp::OpSoftmax>({ tensor, tensor });
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensor });
+
+    expectNear(tensor->data(), expected);
+}
+
+TEST(TestOpAttention, LayerNormAndRmsNorm)
+{
+    kp::Manager mgr;
+
+    uint32_t rowSize = 5;
+    std::vector<float> data = { 1, 2, 3, 4, 5, 10, 10, 10, 10, 14 };
+    std::vector<float> scale = { 1, 2, 1, 0.5, 1 };
+    std::vector<float> shift = { 0, 1, 0, 0, -1 };
+
+    std::vector<float> expectedLayer(data.size());
+    std::vector<float> expectedRms(data.size());
+    for (uint32_t row = 0; row < 2; row++) {
+        float mean = 0;
+        float meanSquare = 0;
+        for (uint32_t i = 0; i < rowSize; i++) {
+            mean += data[row * rowSize + i] / rowSize;
+            meanSquare += data[row * rowSize + i] * data[row * rowSize + i] /
+                          rowSize;
+        }
+        float variance = meanSquare - mean * mean;
+        for (uint32_t i = 0; i < rowSize; i++) {
+            float value = data[row * rowSize + i];
+            expectedLayer[row * rowSize + i] =
+              (value - mean) / std::sqrt(variance + 1e-5f) * scale[i] +
+              shift[i];
+            expectedRms[row * rowSize + i] =
+              value / std::sqrt(meanSquare + 1e-5f) * scale[i];
+        }
+    }
+
+    std::shared_ptr<kp::Tensor> tensorIn{ new kp::Tensor(data) };
+    std::shared_ptr<kp::Tensor> tensorScale{ new kp::Tensor(scale) };
+    std::shared_ptr<kp::Tensor> tensorShift{ new kp::Tensor(shift) };
+    std::shared_ptr<kp::Tensor> tensorLayer{ new kp::Tensor(
+      std::vector<float>(data.size())) };
+    std::shared_ptr<kp::Tensor> tensorRms{ new kp::Tensor(
+      std::vector<float>(data.size())) };
+    tensorIn->reshape({ 2, rowSize });
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorIn, tensorScale, tensorShift, tensorLayer, tensorRms });
+
+    mgr.evalOpDefault<kp::OpLayerNorm>(
+      { tensorIn, tensorScale, tensorShift, tensorLayer });
+    mgr.evalOpDefault<kp::OpLayerNorm>({ tensorIn, tensorScale, tensorRms },
+                                       kp::OpLayerNorm::NormTypes::eRmsNorm);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorLayer, tensorRms });
+
+    expectNear(tensorLayer->data(), expectedLayer);
+    expectNear(tensorRms->data(), expectedRms);
+
+    EXPECT_THROW(
+      mgr.evalOpDefault<kp::OpLayerNorm>({ tensorIn, tensorIn, tensorRms }),
+      std::runtime_error);
+}
+
+TEST(TestOpAttention, AttentionAcrossTiles)
+{
+    kp::Manager mgr;
+
+    // Enough queries and keys for several tiles of each
+    uint32_t batches = 2;
+    uint32_t queryRows = 70;
+    uint32_t keyRows = 150;
+    uint32_t headDim = 16;
+    uint32_t valueDim = 8;
+    std::vector<float> queries =
+      sequenceData(batches * queryRows * headDim, 1, 23);
+    std::vector<float> keys =
+      sequenceData(batches * keyRows * headDim, 2, 23);
+    std::vector<float> values =
+      sequenceData(batches * keyRows * valueDim, 3, 23);
+
+    std::shared_ptr<kp::Tensor> tensorQueries{ new kp::Tensor(queries) };
+    std::shared_ptr<kp::Tensor> tensorKeys{ new kp::Tensor(keys) };
+    std::shared_ptr<kp::Tensor> tensorValues{ new kp::Tensor(values) };
+    std::shared_ptr<kp::Tensor> tensorOut{ new kp::Tensor(
+      std::vector<float>(batches * queryRows * valueDim)) };
+    std::shared_ptr<kp::Tensor> tensorCausal{ new kp::Tensor(
+      std::vector<float>(batches * queryRows * valueDim)) };
+    tensorQueries->reshape({ batches, queryRows, headDim });
+    tensorKeys->reshape({ batches, keyRows, headDim });
+    tensorValues->reshape({ batches, keyRows, valueDim });
+    tensorCausal->reshape({ batches, queryRows, valueDim });
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorQueries, tensorKeys, tensorValues, tensorOut, tensorCausal });
+
+    std::weak_ptr<kp::Sequence> sqWeakPtr =
+      mgr.getOrCreateManagedSequence("attention");
+    if (std::shared_ptr<kp::Sequence> sq = sqWeakPtr.lock()) {
+        sq->begin();
+        sq->record<kp::OpAttention>(
+          { tensorQueries, tensorKeys, tensorValues, tensorOut });
+        sq->record<kp::OpAttention>(
+          { tensorQueries, tensorKeys, tensorValues, tensorCausal }, true);
+        sq->record<kp::OpTensorSyncLocal>({ tensorOut, tensorCausal });
+        sq->end();
+        sq->eval();
+    }
+
+    expectNear(tensorOut->data(),
+               attentionReference(queries,
+                                  keys,
+                                  values,
+                                  batches,
+                                  queryRows,
+                                  keyRows,
+                                  headDim,
+                                  valueDim,
+                                  false));
+    expectNear(tensorCausal->data(),
+               attentionReference(queries,
+                                  keys,
+                                  values,
+                                  batches,
+                                  queryRows,
+                                  keyRows,
+                                  headDim,
+                                  valueDim,
+                                  true));
+
+    EXPECT_THROW(mgr.evalOpDefault<kp::OpAttention>(
+                   { tensorKeys, tensorQueries, tensorValues, tensorOut }),
+                 std::runtime_error);
+}
@@ -0,0 +1,280 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "kompute/Kompute.hpp"
+
+#include "TestUtils.hpp"
+
+static std::vector<float>
+conv2dReference(const std::vector<float>& input,
+                const std::vector<float>& weights,
+                const std::vector<float>& bias,
+                uint32_t batches,
+                uint32_t channels,
+                uint32_t height,
+                uint32_t width,
+                uint32_t filters,
+                uint32_t kernelHeight,
+                uint32_t kernelWidth,
+                uint32_t stride,
+                uint32_t padding)
+{
+    uint32_t outputHeight = (height + 2 * padding - kernelHeight) / stride + 1;
+    uint32_t outputWidth = (width + 2 * padding - kernelWidth) / stride + 1;
+    std::vector<float> output(batches * filters * outputHeight * outputWidth);
+    for (uint32_t n = 0; n < batches; n++) {
+        for (uint32_t k = 0; k < filters; k++) {
+            for (uint32_t oy = 0; oy < outputHeight; oy++) {
+                for (uint32_t ox = 0; ox < outputWidth; ox++) {
+                    float sum = bias.size() ? bias[k] : 0;
+                    for (uint32_t c = 0; c < channels; c++) {
+                        for (uint32_t ky = 0; ky < kernelHeight; ky++) {
+                            for (uint32_t kx = 0; kx < kernelWidth; kx++) {
+                                int y = int(oy * stride + ky) - int(padding);
+                                int x = int(ox * stride + kx) - int(padding);
+                                if (y < 0 || y >= int(height) || x < 0 ||
+                                    x >= int(width)) {
+                                    continue;
+                                }
+                                sum += input[((n * channels + c) * height + y) *
+                                               width +
+                                             x] *
+                                       weights[((k * channels + c) *
+                                                  kernelHeight +
+                                                ky) *
+                                                 kernelWidth +
+                                               kx];
+                            }
+                        }
+                    }
+                    output[((n * filters + k) * outputHeight + oy) *
+                             outputWidth +
+                           ox] = sum;
+                }
+            }
+        }
+    }
+    return output;
+}
+
+TEST(TestOpConvolution, Conv2DDirectAndIm2colMatchReference)
+{
+    kp::Manager mgr;
+
+    std::vector<float> input = sequenceData(2 * 3 * 9 * 7, 1);
+    std::vector<float> weights = sequenceData(4 * 3 * 3 * 3, 2);
+    std::vector<float> bias = { 0.5, -0.5, 1, 0 };
+    std::vector<float> expected =
+      conv2dReference(input, weights, bias, 2, 3, 9, 7, 4, 3, 3, 1, 1);
+
+    std::shared_ptr<kp::Tensor> tensorIn{ new kp::Tensor(input) };
+    std::shared_ptr<kp::Tensor> tensorWeights{ new kp::Tensor(weights) };
+    std::shared_ptr<kp::Tensor> tensorBias{ new kp::Tensor(bias) };
+    std::shared_ptr<kp::Tensor> tensorDirect{ new kp::Tensor(
+      std::vector<float>(expected.size())) };
+    std::shared_ptr<kp::Tensor> tensorIm2col{ new kp::Tensor(
+      std::vector<float>(expected.size())) };
+    tensorIn->reshape({ 2, 3, 9, 7 });
+    tensorWeights->reshape({ 4, 3, 3, 3 });
+    tensorDirect->reshape({ 2, 4, 9, 7 });
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorIn, tensorWeights, tensorBias, tensorDirect, tensorIm2col });
+
+    mgr.evalOpDefault<kp::OpConv2D>(
+      { tensorIn, tensorWeights, tensorBias, tensorDirect },
+      1,
+      1,
+      kp::OpConv2D::ConvAlgorithms::eDirect);
+    mgr.evalOpDefault<kp::OpConv2D>(
+      { tensorIn, tensorWeights, tensorBias, tensorIm2col },
+      1,
+      1,
+      kp::OpConv2D::ConvAlgorithms::eIm2col);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorDirect, tensorIm2col });
+
+    expectNear(tensorDirect->data(), expected);
+    expectNear(tensorIm2col->data(), expected);
+}
+
+TEST(TestOpConvolution, Conv2DLargeKernelWithStride)
+{
+    kp::Manager mgr;
+
+    std::vector<float> input = sequenceData(2 * 20 * 19, 3);
+    std::vector<float> weights = sequenceData(3 * 2 * 5 * 5, 4);
+    std::vector<float> expected =
+      conv2dReference(input, weights, {}, 1, 2, 20, 19, 3, 5, 5, 2, 0);
+
+    std::shared_ptr<kp::Tensor> tensorIn{ new kp::Tensor(input) };
+    std::shared_ptr<kp::Tensor> tensorWeights{ new kp::Tensor(weights) };
+    std::shared_ptr<kp::Tensor> tensorOut{ new kp::Tensor(
+      std::vector<float>(expected.size())) };
+    tensorIn->reshape({ 2, 20, 19 });
+    tensorWeights->reshape({ 3, 2, 5, 5 });
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorIn, tensorWeights, tensorOut });
+
+    mgr.evalOpDefault<kp::OpConv2D>({ tensorIn, tensorWeights, tensorOut }, 2);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorOut });
+
+    expectNear(tensorOut->data(), expected);
+
+    tensorOut->reshape({ 3, 4, 16 });
+    EXPECT_THROW(mgr.evalOpDefault<kp::OpConv2D>(
+                   { tensorIn, tensorWeights, tensorOut }, 2),
+                 std::runtime_error);
+}
+
+TEST(TestOpConvolution, Conv1DWithStrideAndPadding)
+{
+    kp::Manager mgr;
+
+    std::vector<float> input = sequenceData(2 * 3 * 50, 5);
+    std::vector<float> weights = sequenceData(4 * 3 * 5, 6);
+    std::vector<float> expected =
+      conv2dReference(input, weights, {}, 2, 3, 1, 50, 4, 1, 5, 1, 0);
+
+    // The reference only supports the same stride and padding in both
+    // dimensions, so the strided and padded case is checked on a few values
+    std::shared_ptr<kp::Tensor> tensorIn{ new kp::Tensor(input) };
+    std::shared_ptr<kp::Tensor> tensorWeights{ new kp::Tensor(weights) };
+    std::shared_ptr<kp::Tensor> tensorOut{ new kp::Tensor(
+      std::vector<float>(expected.size())) };
+    std::shared_ptr<kp::Tensor> tensorStrided{ new kp::Tensor(
+      std::vector<float>(2 * 4 * 25)) };
+    tensorIn->reshape({ 2, 3, 50 });
+    tensorWeights->reshape({ 4, 3, 5 });
+    tensorStrided->reshape({ 2, 4, 25 });
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorIn, tensorWeights, tensorOut, tensorStrided });
+
+    mgr.evalOpDefault<kp::OpConv1D>({ tensorIn, tensorWeights, tensorOut });
+    mgr.evalOpDefault<kp::OpConv1D>(
+      { tensorIn, tensorWeights, tensorStrided }, 2, 2);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorOut, tensorStrided });
+
+    expectNear(tensorOut->data(), expected);
+
+    // With a padding of two the strided output at position i is the output
+    // without padding at position 2 * i - 2 when the window is inside
+    for (uint32_t i = 1; i < 24; i++) {
+        for (uint32_t nk = 0; nk < 8; nk++) {
+            EXPECT_NEAR(tensorStrided->data()[nk * 25 + i],
+                        expected[nk * 46 + 2 * i - 2],
+                        1e-4);
+        }
+    }
+}
+
+TEST(TestOpConvolution, MaxAndAveragePooling)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorIn{ new kp::Tensor(
+      { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 }) };
+    std::shared_ptr<kp::Tensor> tensorMax{ new kp::Tensor(
+      std::vector<float>(4)) };
+    std::shared_ptr<kp::Tensor> tensorAverage{ new kp::Tensor(
+      std::vector<float>(4)) };
+    std::shared_ptr<kp::Tensor> tensorMax1D{ new kp::Tensor(
+      std::vector<float>(6)) };
+    tensorIn->reshape({ 1, 1, 4, 4 });
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorIn, tensorMax, tensorAverage, tensorMax1D });
+
+    mgr.evalOpDefault<kp::OpPool2D>(
+      { tensorIn, tensorMax }, kp::OpPool2D::PoolTypes::eMax, 2);
+    mgr.evalOpDefault<kp::OpPool2D>(
+      { tensorIn, tensorAverage }, kp::OpPool2D::PoolTypes::eAverage, 3, 1);
+
+    tensorIn->reshape({ 2, 8 });
+    mgr.evalOpDefault<kp::OpPool1D>(
+      { tensorIn, tensorMax1D }, kp::OpPool2D::PoolTypes::eMax, 3, 2);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>(
+      { tensorMax, tensorAverage, tensorMax1D });
+
+    EXPECT_EQ(tensorMax->data(), std::vector<float>({ 6, 8, 14, 16 }));
+    EXPECT_EQ(tensorAverage->data(), std::vector<float>({ 6, 7, 10, 11 }));
+    EXPECT_EQ(tensorMax1D->data(),
+              std::vector<float>({ 3, 5, 7, 11, 13, 15 }));
+}
+
+TEST(TestOpConvolution, SmallNetworkInSequence)
+{
+    kp::Manager mgr;
+
+    std::vector<float> input = sequenceData(2 * 8 * 8, 7);
+    std::vector<float> weights = sequenceData(3 * 2 * 3 * 3, 8);
+    std::vector<float> scale = { 1, 2, 0.5 };
+    std::vector<float> shift = { 0, -1, 1 };
+    std::vector<float> mean = { 0.1, -0.2, 0.3 };
+    std::vector<float> variance = { 1, 4, 0.25 };
+
+    // Convolution, batch normalisation, relu and max pooling on the host
+    std::vector<float> features =
+      conv2dReference(input, weights, {}, 1, 2, 8, 8, 3, 3, 3, 1, 1);
+    for (size_t i = 0; i < features.size(); i++) {
+        uint32_t c = i / 64;
+        float normalised =
+          (features[i] - mean[c]) / std::sqrt(variance[c] + 1e-5f);
+        features[i] = std::max(normalised * scale[c] + shift[c], 0.0f);
+    }
+    std::vector<float> expected(3 * 4 * 4);
+    for (size_t i = 0; i < expected.size(); i++) {
+        uint32_t c = i / 16;
+        uint32_t y = (i / 4) % 4 * 2;
+        uint32_t x = i % 4 * 2;
+        expected[i] = std::max({ features[(c * 8 + y) * 8 + x],
+                                 features[(c * 8 + y) * 8 + x + 1],
+                                 features[(c * 8 + y + 1) * 8 + x],
+                                 features[(c * 8 + y + 1) * 8 + x + 1] });
+    }
+
+    std::shared_ptr<kp::Tensor> tensorIn{ new kp::Tensor(input) };
+    std::shared_ptr<kp::Tensor> tensorWeights{ new kp::Tensor(weights) };
+    std::shared_ptr<kp::Tensor> tensorScale{ new kp::Tensor(scale) };
+    std::shared_ptr<kp::Tensor> tensorShift{ new kp::Tensor(shift) };
+    std::shared_ptr<kp::Tensor> tensorMean{ new kp::Tensor(mean) };
+    std::shared_ptr<kp::Tensor> tensorVariance{ new kp::Tensor(variance) };
+    std::shared_ptr<kp::Tensor> tensorFeatures{ new kp::Tensor(
+      std::vector<float>(3 * 8 * 8)) };
+    std::shared_ptr<kp::Tensor> tensorOut{ new kp::Tensor(
+      std::vector<float>(3 * 4 * 4)) };
+    tensorIn->reshape({ 1, 2, 8, 8 });
+    tensorWeights->reshape({ 3, 2, 3, 3 });
+    tensorFeatures->reshape({ 1, 3, 8, 8 });
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorIn,
+                                            tensorWeights,
+                                            tensorScale,
+                                            tensorShift,
+                                            tensorMean,
+                                            tensorVariance,
+                                            tensorFeatures,
+                                            tensorOut });
+
+    std::weak_ptr<kp::Sequence> sqWeakPtr = mgr.getOrCreateManagedSequence("cnn");
+    if (std::shared_ptr<kp::Sequence> sq = sqWeakPtr.lock()) {
+        sq->begin();
+        sq->record<kp::OpConv2D>({ tensorIn, tensorWeights, tensorFeatures }, 1, 1);
+        sq->record<kp::OpBatchNorm>({ tensorFeatures,
+                                      tensorScale,
+                                      tensorShift,
+                                      tensorMean,
+                                      tensorVariance,
+                                      tensorFeatures });
+        sq->record<kp::OpRelu>({ tensorFeatures, tensorFeatures });
+        sq->record<kp::OpPool2D>(
+          { tensorFeatures, tensorOut }, kp::OpPool2D::PoolTypes::eMax, 2);
+        sq->record<kp::OpTensorSyncLocal>({ tensorOut });
+        sq->end();
+        sq->eval();
+    }
+
+    expectNear(tensorOut->data(), expected);
+}
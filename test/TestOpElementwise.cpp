@@ -0,0 +1,295 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "kompute/Kompute.hpp"
+
+// The fixed operations embed their precompiled shaders in Release builds, and
+// otherwise read the GLSL of the shaders, which like the fused expressions
+// requires the shader compiler
+static bool
+isOperationShaderAvailable()
+{
+#if RELEASE
+    return true;
+#else
+    return kp::ShaderCompiler::isCompilationEnabled();
+#endif
+}
+
+TEST(TestOpElementwise, BinaryOperations)
+{
+    if (!isOperationShaderAvailable()) {
+        GTEST_SKIP() << "Operation shaders require the shader compiler";
+    }
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorLhs{ new kp::Tensor({ 2, 4, 6, 8, 10 }) };
+    std::shared_ptr<kp::Tensor> tensorRhs{ new kp::Tensor({ 1, 2, 3, 4, 5 }) };
+    std::shared_ptr<kp::Tensor> tensorAdd{ new kp::Tensor({ 0, 0, 0, 0, 0 }) };
+    std::shared_ptr<kp::Tensor> tensorSub{ new kp::Tensor({ 0, 0, 0, 0, 0 }) };
+    std::shared_ptr<kp::Tensor> tensorDiv{ new kp::Tensor({ 0, 0, 0, 0, 0 }) };
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorLhs, tensorRhs, tensorAdd, tensorSub, tensorDiv });
+
+    mgr.evalOpDefault<kp::OpAdd>({ tensorLhs, tensorRhs, tensorAdd });
+    mgr.evalOpDefault<kp::OpSub>({ tensorLhs, tensorRhs, tensorSub });
+    mgr.evalOpDefault<kp::OpDiv>({ tensorLhs, tensorRhs, tensorDiv });
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>(
+      { tensorAdd, tensorSub, tensorDiv });
+
+    EXPECT_EQ(tensorAdd->data(), std::vector<float>({ 3, 6, 9, 12, 15 }));
+    EXPECT_EQ(tensorSub->data(), std::vector<float>({ 1, 2, 3, 4, 5 }));
+    EXPECT_EQ(tensorDiv->data(), std::vector<float>({ 2, 2, 2, 2, 2 }));
+}
+
+TEST(TestOpElementwise, UnaryAndScalarOperations)
+{
+    if (!isOperationShaderAvailable()) {
+        GTEST_SKIP() << "Operation shaders require the shader compiler";
+    }
+
+    kp::Manager mgr;
+
+    std::vector<float> data{ -2, -1, 0, 1, 2, 3 };
+
+    std::shared_ptr<kp::Tensor> tensorIn{ new kp::Tensor(data) };
+    std::shared_ptr<kp::Tensor> tensorRelu{ new kp::Tensor(
+      std::vector<float>(data.size())) };
+    std::shared_ptr<kp::Tensor> tensorSigmoid{ new kp::Tensor(
+      std::vector<float>(data.size())) };
+    std::shared_ptr<kp::Tensor> tensorScale{ new kp::Tensor(
+      std::vector<float>(data.size())) };
+    std::shared_ptr<kp::Tensor> tensorAddScalar{ new kp::Tensor(
+      std::vector<float>(data.size())) };
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorIn, tensorRelu, tensorSigmoid, tensorScale, tensorAddScalar });
+
+    mgr.evalOpDefault<kp::OpRelu>({ tensorIn, tensorRelu });
+    mgr.evalOpDefault<kp::OpSigmoid>({ tensorIn, tensorSigmoid });
+    mgr.evalOpDefault<kp::OpScale>({ tensorIn, tensorScale }, 0.5f);
+    mgr.evalOpDefault<kp::OpAddScalar>({ tensorIn, tensorAddScalar }, 10.0f);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>(
+      { tensorRelu, tensorSigmoid, tensorScale, tensorAddScalar });
+
+    EXPECT_EQ(tensorRelu->data(), std::vector<float>({ 0, 0, 0, 1, 2, 3 }));
+    EXPECT_EQ(tensorScale->data(),
+              std::vector<float>({ -1, -0.5, 0, 0.5, 1, 1.5 }));
+    EXPECT_EQ(tensorAddScalar->data(),
+              std::vector<float>({ 8, 9, 10, 11, 12, 13 }));
+    for (size_t i = 0; i < data.size(); i++) {
+        EXPECT_NEAR(
+          tensorSigmoid->data()[i], 1.0f / (1.0f + std::exp(-data[i])), 1e-5);
+    }
+}
+
+TEST(TestOpElementwise, FusedExpressionAcrossWorkgroups)
+{
+    if (!kp::ShaderCompiler::isCompilationEnabled()) {
+        GTEST_SKIP() << "Fused expressions require the shader compiler";
+    }
+
+    kp::Manager mgr;
+
+    // Sizes which are not a multiple of four nor of the workgroup size
+    for (uint32_t size : { 7, 1031 }) {
+        std::vector<float> dataA(size), dataB(size), dataC(size);
+        std::vector<float> expected(size);
+        for (uint32_t i = 0; i < size; i++) {
+            dataA[i] = i % 13;
+            dataB[i] = (i % 5) - 2.0f;
+            dataC[i] = (i % 3) - 1.0f;
+            expected[i] = std::max(dataA[i] * dataB[i] + dataC[i], 0.0f);
+        }
+
+        std::shared_ptr<kp::Tensor> tensorA{ new kp::Tensor(dataA) };
+        std::shared_ptr<kp::Tensor> tensorB{ new kp::Tensor(dataB) };
+        std::shared_ptr<kp::Tensor> tensorC{ new kp::Tensor(dataC) };
+        std::shared_ptr<kp::Tensor> tensorOut{ new kp::Tensor(
+          std::vector<float>(size)) };
+        mgr.evalOpDefault<kp::OpTensorCreate>(
+          { tensorA, tensorB, tensorC, tensorOut });
+
+        kp::ElementwiseExpr a = kp::ElementwiseExpr::input(0);
+        kp::ElementwiseExpr b = kp::ElementwiseExpr::input(1);
+        kp::ElementwiseExpr c = kp::ElementwiseExpr::input(2);
+
+        mgr.evalOpDefault<kp::OpElementwise>(
+          { tensorA, tensorB, tensorC, tensorOut },
+          kp::ElementwiseExpr::relu(a * b + c));
+
+        mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorOut });
+
+        EXPECT_EQ(tensorOut->data(), expected);
+    }
+}
+
+TEST(TestOpElementwise, ChainedOperationsInSequence)
+{
+    if (!isOperationShaderAvailable()) {
+        GTEST_SKIP() << "Operation shaders require the shader compiler";
+    }
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorA{ new kp::Tensor({ 1, 2, 3, 4, 5 }) };
+    std::shared_ptr<kp::Tensor> tensorB{ new kp::Tensor({ 5, 4, 3, 2, 1 }) };
+    std::shared_ptr<kp::Tensor> tensorTmp{ new kp::Tensor({ 0, 0, 0, 0, 0 }) };
+    std::shared_ptr<kp::Tensor> tensorOut{ new kp::Tensor({ 0, 0, 0, 0, 0 }) };
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.getOrCreateManagedSequence("newSequence");
+
+    sq->begin();
+    sq->record<kp::OpTensorCreate>({ tensorA, tensorB, tensorTmp, tensorOut });
+    sq->record<kp::OpSub>({ tensorA, tensorB, tensorTmp });
+    sq->record<kp::OpScale>({ tensorTmp, tensorTmp }, 2.0f);
+    sq->record<kp::OpRelu>({ tensorTmp, tensorOut });
+    sq->record<kp::OpTensorSyncLocal>({ tensorOut });
+    sq->end();
+    sq->eval();
+
+    EXPECT_EQ(tensorOut->data(), std::vector<float>({ 0, 0, 0, 4, 8 }));
+}
+
+TEST(TestOpElementwise, ExpressionValidation)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorA{ new kp::Tensor({ 1, 2, 3 }) };
+    std::shared_ptr<kp::Tensor> tensorOut{ new kp::Tensor({ 0, 0 }) };
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorA, tensorOut });
+
+    EXPECT_THROW(mgr.evalOpDefault<kp::OpRelu>({ tensorA, tensorOut }),
+                 std::runtime_error);
+    EXPECT_THROW(mgr.evalOpDefault<kp::OpAdd>({ tensorA, tensorA }),
+                 std::runtime_error);
+
+    EXPECT_EQ(
+      (kp::ElementwiseExpr::input(2) * 2.0f - kp::ElementwiseExpr::input(0))
+        .numInputs(),
+      3);
+}
+
+TEST(TestOpElementwise, BroadcastBinaryOperations)
+{
+    if (!isOperationShaderAvailable()) {
+        GTEST_SKIP() << "Operation shaders require the shader compiler";
+    }
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorMatrix{ new kp::Tensor(
+      { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 }) };
+    std::shared_ptr<kp::Tensor> tensorBias{ new kp::Tensor({ 1, 2, 3, 4 }) };
+    std::shared_ptr<kp::Tensor> tensorColumn{ new kp::Tensor({ 1, 10, 100 }) };
+    std::shared_ptr<kp::Tensor> tensorScalar{ new kp::Tensor({ 2 }) };
+    std::shared_ptr<kp::Tensor> tensorAdd{ new kp::Tensor(
+      std::vector<float>(12)) };
+    std::shared_ptr<kp::Tensor> tensorSub{ new kp::Tensor(
+      std::vector<float>(12)) };
+    std::shared_ptr<kp::Tensor> tensorDiv{ new kp::Tensor(
+      std::vector<float>(12)) };
+    std::shared_ptr<kp::Tensor> tensorOuter{ new kp::Tensor(
+      std::vector<float>(12)) };
+
+    tensorMatrix->reshape({ 3, 4 });
+    tensorColumn->reshape({ 3, 1 });
+    tensorOuter->reshape({ 3, 4 });
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorMatrix,
+                                            tensorBias,
+                                            tensorColumn,
+                                            tensorScalar,
+                                            tensorAdd,
+                                            tensorSub,
+                                            tensorDiv,
+                                            tensorOuter });
+
+    // Row broadcast which is read with vec4 loads
+    mgr.evalOpDefault<kp::OpAdd>({ tensorMatrix, tensorBias, tensorAdd });
+    // Column broadcast which is read element by element
+    mgr.evalOpDefault<kp::OpSub>({ tensorMatrix, tensorColumn, tensorSub });
+    // Scalar broadcast from a tensor of a single element
+    mgr.evalOpDefault<kp::OpDiv>({ tensorMatrix, tensorScalar, tensorDiv });
+    // Both inputs broadcast into the output
+    mgr.evalOpDefault<kp::OpAdd>({ tensorColumn, tensorBias, tensorOuter });
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>(
+      { tensorAdd, tensorSub, tensorDiv, tensorOuter });
+
+    EXPECT_EQ(tensorAdd->data(),
+              std::vector<float>(
+                { 1, 3, 5, 7, 5, 7, 9, 11, 9, 11, 13, 15 }));
+    EXPECT_EQ(tensorSub->data(),
+              std::vector<float>(
+                { -1, 0, 1, 2, -6, -5, -4, -3, -92, -91, -90, -89 }));
+    EXPECT_EQ(tensorDiv->data(),
+              std::vector<float>(
+                { 0, 0.5, 1, 1.5, 2, 2.5, 3, 3.5, 4, 4.5, 5, 5.5 }));
+    EXPECT_EQ(tensorOuter->data(),
+              std::vector<float>(
+                { 2, 3, 4, 5, 11, 12, 13, 14, 101, 102, 103, 104 }));
+}
+
+TEST(TestOpElementwise, FusedBroadcastExpression)
+{
+    if (!kp::ShaderCompiler::isCompilationEnabled()) {
+        GTEST_SKIP() << "Fused expressions require the shader compiler";
+    }
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorMatrix{ new kp::Tensor(
+      { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 }) };
+    std::shared_ptr<kp::Tensor> tensorColumn{ new kp::Tensor({ 1, 10, 100 }) };
+    std::shared_ptr<kp::Tensor> tensorMult{ new kp::Tensor(
+      std::vector<float>(12)) };
+
+    tensorMatrix->reshape({ 3, 4 });
+    tensorColumn->reshape({ 3, 1 });
+
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorMatrix, tensorColumn, tensorMult });
+
+    // Column broadcast of a generated shader which is read element by element
+    mgr.evalOpDefault<kp::OpElementwise>(
+      { tensorMatrix, tensorColumn, tensorMult },
+      kp::ElementwiseExpr::input(0) * kp::ElementwiseExpr::input(1));
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorMult });
+
+    EXPECT_EQ(tensorMult->data(),
+              std::vector<float>(
+                { 0, 1, 2, 3, 40, 50, 60, 70, 800, 900, 1000, 1100 }));
+}
+
+TEST(TestOpElementwise, BroadcastIncompatibleShapes)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorMatrix{ new kp::Tensor(
+      std::vector<float>(12)) };
+    std::shared_ptr<kp::Tensor> tensorRow{ new kp::Tensor({ 1, 2, 3 }) };
+    std::shared_ptr<kp::Tensor> tensorOut{ new kp::Tensor(
+      std::vector<float>(12)) };
+    std::shared_ptr<kp::Tensor> tensorOutTransposed{ new kp::Tensor(
+      std::vector<float>(12)) };
+
+    tensorMatrix->reshape({ 3, 4 });
+    tensorOutTransposed->reshape({ 4, 3 });
+
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorMatrix, tensorRow, tensorOut, tensorOutTransposed });
+
+    EXPECT_THROW(
+      mgr.evalOpDefault<kp::OpAdd>({ tensorMatrix, tensorRow, tensorOut }),
+      std::runtime_error);
+    EXPECT_THROW(mgr.evalOpDefault<kp::OpRelu>(
+                   { tensorMatrix, tensorOutTransposed }),
+                 std::runtime_error);
+}
@@ -0,0 +1,146 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+#include "kompute/Kompute.hpp"
+
+TEST(TestOpRandom, UniformMatchesPhiloxKnownAnswer)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensor{ new kp::Tensor({ 0, 0, 0, 0 }) };
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensor });
+
+    // Philox4x32-10 of a zero counter and key from the known answer tests of
+    // the reference implementation
+    mgr.evalOpDefault<kp::OpRandom>({ tensor });
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensor });
+
+    std::vector<uint32_t> expected = {
+        0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8
+    };
+    for (uint32_t i = 0; i < expected.size(); i++) {
+        EXPECT_FLOAT_EQ(tensor->data()[i],
+                        float(expected[i] >> 8) / 16777216.0f);
+    }
+}
+
+TEST(TestOpRandom, OffsetContinuesStream)
+{
+    kp::Manager mgr;
+
+    uint32_t size = 1001;
+    std::shared_ptr<kp::Tensor> tensorFull{ new kp::Tensor(
+      std::vector<float>(size)) };
+    std::shared_ptr<kp::Tensor> tensorFirst{ new kp::Tensor(
+      std::vector<float>(301)) };
+    std::shared_ptr<kp::Tensor> tensorSecond{ new kp::Tensor(
+      std::vector<float>(size - 301)) };
+    std::shared_ptr<kp::Tensor> tensorOffset{ new kp::Tensor(
+      std::vector<float>(7)) };
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorFull, tensorFirst, tensorSecond, tensorOffset });
+
+    kp::OpRandom::RandomDistributions normal =
+      kp::OpRandom::RandomDistributions::eNormal;
+
+    std::weak_ptr<kp::Sequence> sqWeakPtr =
+      mgr.getOrCreateManagedSequence("random");
+    if (std::shared_ptr<kp::Sequence> sq = sqWeakPtr.lock()) {
+        sq->begin();
+        sq->record<kp::OpRandom>({ tensorFull }, normal, 1234);
+        sq->record<kp::OpRandom>({ tensorFirst, tensorSecond }, normal, 1234);
+        sq->record<kp::OpRandom>({ tensorOffset }, normal, 1234, 513);
+        sq->record<kp::OpTensorSyncLocal>(
+          { tensorFull, tensorFirst, tensorSecond, tensorOffset });
+        sq->end();
+        sq->eval();
+    }
+
+    for (uint32_t i = 0; i < size; i++) {
+        float value =
+          i < 301 ? tensorFirst->data()[i] : tensorSecond->data()[i - 301];
+        EXPECT_FLOAT_EQ(tensorFull->data()[i], value);
+    }
+    for (uint32_t i = 0; i < 7; i++) {
+        EXPECT_FLOAT_EQ(tensorFull->data()[513 + i], tensorOffset->data()[i]);
+    }
+
+    // A different seed gives a different stream
+    mgr.evalOpDefault<kp::OpRandom>({ tensorFirst }, normal, 4321);
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorFirst });
+    EXPECT_NE(tensorFull->data()[0], tensorFirst->data()[0]);
+}
+
+TEST(TestOpRandom, DistributionStatistics)
+{
+    kp::Manager mgr;
+
+    uint32_t size = 1 << 16;
+    std::shared_ptr<kp::Tensor> tensorUniform{ new kp::Tensor(
+      std::vector<float>(size)) };
+    std::shared_ptr<kp::Tensor> tensorNormal{ new kp::Tensor(
+      std::vector<float>(size)) };
+    std::shared_ptr<kp::Tensor> tensorBernoulli{ new kp::Tensor(
+      std::vector<float>(size)) };
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorUniform, tensorNormal, tensorBernoulli });
+
+    mgr.evalOpDefault<kp::OpRandom>(
+      { tensorUniform },
+      kp::OpRandom::RandomDistributions::eUniform,
+      7,
+      0,
+      -2.0f,
+      6.0f);
+    mgr.evalOpDefault<kp::OpRandom>({ tensorNormal },
+                                    kp::OpRandom::RandomDistributions::eNormal,
+                                    7,
+                                    0,
+                                    3.0f,
+                                    0.5f);
+    mgr.evalOpDefault<kp::OpRandom>(
+      { tensorBernoulli },
+      kp::OpRandom::RandomDistributions::eBernoulli,
+      7,
+      0,
+      0.25f);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>(
+      { tensorUniform, tensorNormal, tensorBernoulli });
+
+    double uniformSum = 0;
+    double normalSum = 0;
+    double normalSquares = 0;
+    double bernoulliSum = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        float uniform = tensorUniform->data()[i];
+        EXPECT_GE(uniform, -2.0f);
+        EXPECT_LT(uniform, 6.0f);
+        uniformSum += uniform;
+
+        normalSum += tensorNormal->data()[i];
+        normalSquares += tensorNormal->data()[i] * tensorNormal->data()[i];
+
+        float bernoulli = tensorBernoulli->data()[i];
+        EXPECT_TRUE(bernoulli == 0.0f || bernoulli == 1.0f);
+        bernoulliSum += bernoulli;
+    }
+
+    double normalMean = normalSum / size;
+    EXPECT_NEAR(uniformSum / size, 2.0, 0.05);
+    EXPECT_NEAR(normalMean, 3.0, 0.01);
+    EXPECT_NEAR(std::sqrt(normalSquares / size - normalMean * normalMean),
+                0.5,
+                0.01);
+    EXPECT_NEAR(bernoulliSum / size, 0.25, 0.01);
+
+    EXPECT_THROW(mgr.evalOpDefault<kp::OpRandom>(
+                   { tensorBernoulli },
+                   kp::OpRandom::RandomDistributions::eBernoulli,
+                   7,
+                   0,
+                   1.5f),
+                 std::runtime_error);
+}
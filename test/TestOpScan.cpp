@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+
+TEST(TestOpScan, InclusiveAndExclusiveScan)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorIn{ new kp::Tensor({ 1, 2, 3, 4, 5, 6, 7 }) };
+    std::shared_ptr<kp::Tensor> tensorInclusive{ new kp::Tensor(
+      std::vector<float>(7)) };
+    std::shared_ptr<kp::Tensor> tensorExclusive{ new kp::Tensor(
+      std::vector<float>(7)) };
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorIn, tensorInclusive, tensorExclusive });
+
+    mgr.evalOpDefault<kp::OpScan>({ tensorIn, tensorInclusive });
+    mgr.evalOpDefault<kp::OpScan>({ tensorIn, tensorExclusive },
+                                  kp::OpScan::ScanTypes::eExclusive);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>(
+      { tensorInclusive, tensorExclusive });
+
+    EXPECT_EQ(tensorInclusive->data(),
+              std::vector<float>({ 1, 3, 6, 10, 15, 21, 28 }));
+    EXPECT_EQ(tensorExclusive->data(),
+              std::vector<float>({ 0, 1, 3, 6, 10, 15, 21 }));
+}
+
+TEST(TestOpScan, MultiLevelScanInPlace)
+{
+    kp::Manager mgr;
+
+    // Large enough to need three levels of block sums with the default
+    // workgroup size, with values that keep the sums exact as floats
+    uint32_t size = 1100003;
+    std::vector<float> data(size);
+    std::vector<float> expected(size);
+    float sum = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        data[i] = i % 3;
+        sum += data[i];
+        expected[i] = sum;
+    }
+
+    std::shared_ptr<kp::Tensor> tensor{ new kp::Tensor(data) };
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensor });
+
+    mgr.evalOpDefault<kp::OpScan>({ tensor, tensor });
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensor });
+
+    EXPECT_EQ(tensor->data(), expected);
+}
+
+TEST(TestOpScan, CompactWithPredicate)
+{
+    if (!kp::ShaderCompiler::isCompilationEnabled()) {
+        GTEST_SKIP() << "Predicate expressions require the shader compiler";
+    }
+
+    kp::Manager mgr;
+
+    uint32_t size = 5000;
+    std::vector<float> data(size);
+    std::vector<float> expected;
+    for (uint32_t i = 0; i < size; i++) {
+        data[i] = (i % 7) - 3.0f + i * 0.001f;
+        if (data[i] > 0) {
+            expected.push_back(data[i]);
+        }
+    }
+
+    std::shared_ptr<kp::Tensor> tensorIn{ new kp::Tensor(data) };
+    std::shared_ptr<kp::Tensor> tensorOut{ new kp::Tensor(
+      std::vector<float>(size)) };
+    std::shared_ptr<kp::Tensor> tensorCount{ new kp::Tensor({ 0 }) };
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorIn, tensorOut, tensorCount });
+
+    mgr.evalOpDefault<kp::OpCompact>(
+      { tensorIn, tensorOut, tensorCount },
+      kp::ElementwiseExpr::greater(kp::ElementwiseExpr::input(0),
+                                   kp::ElementwiseExpr::constant(0)));
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorOut, tensorCount });
+
+    EXPECT_EQ(tensorCount->data()[0], expected.size());
+    EXPECT_EQ(std::vector<float>(tensorOut->data().begin(),
+                                 tensorOut->data().begin() + expected.size()),
+              expected);
+}
+
+TEST(TestOpScan, CompactWithFlagsTensor)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorIn{ new kp::Tensor({ 1, 2, 3, 4, 5, 6 }) };
+    std::shared_ptr<kp::Tensor> tensorFlags{ new kp::Tensor(
+      { 0, 1, 1, 0, 0, 1 }) };
+    std::shared_ptr<kp::Tensor> tensorOut{ new kp::Tensor(
+      std::vector<float>(6)) };
+    std::shared_ptr<kp::Tensor> tensorCount{ new kp::Tensor({ 0 }) };
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorIn, tensorFlags, tensorOut, tensorCount });
+
+    mgr.evalOpDefault<kp::OpCompact>(
+      { tensorIn, tensorFlags, tensorOut, tensorCount },
+      kp::ElementwiseExpr::input(1));
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorOut, tensorCount });
+
+    EXPECT_EQ(tensorCount->data(), std::vector<float>({ 3 }));
+    EXPECT_EQ(tensorOut->data(), std::vector<float>({ 2, 3, 6, 0, 0, 0 }));
+
+    EXPECT_THROW(mgr.evalOpDefault<kp::OpCompact>(
+                   { tensorIn, tensorOut, tensorFlags },
+                   kp::ElementwiseExpr::input(0)),
+                 std::runtime_error);
+}
@@ -1,6 +1,12 @@
 
 #include "gtest/gtest.h"
 
+#include <cstdio>
+#include <fstream>
+
+#include <sys/stat.h>
+#include <utime.h>
+
 #include "kompute/Kompute.hpp"
 
 #include "kompute_test/shaders/shadertest_op_custom_shader.hpp"
@@ -37,6 +43,40 @@ TEST(TestOpAlgoBase, ShaderRawDataFromConstructor)
     EXPECT_EQ(tensorB->data(), std::vector<float>({ 3, 4, 5 }));
 }
 
+TEST(TestOpAlgoBase, ShaderSourceCompiledToSpirv)
+{
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer a { float pa[]; };
+
+        void main() {
+            pa[gl_GlobalInvocationID.x] = 1.0;
+        }
+    )");
+
+    EXPECT_FALSE(kp::ShaderCompiler::isSpirv(shader.data(), shader.size()));
+    EXPECT_TRUE(kp::ShaderCompiler::isSpirv(
+      (const char*)
+        kp::shader_data::test_shaders_glsl_test_op_custom_shader_comp_spv,
+      kp::shader_data::test_shaders_glsl_test_op_custom_shader_comp_spv_len));
+
+    if (!kp::ShaderCompiler::isCompilationEnabled()) {
+        EXPECT_THROW(kp::ShaderCompiler::compileSource(shader),
+                     std::runtime_error);
+        return;
+    }
+
+    std::vector<char> spirv = kp::ShaderCompiler::compileSource(shader);
+    EXPECT_TRUE(kp::ShaderCompiler::isSpirv(spirv.data(), spirv.size()));
+
+    EXPECT_THROW(kp::ShaderCompiler::compileSource(
+                   "#version 450\nvoid main() { undefinedFunction(); }\n"),
+                 std::runtime_error);
+}
+
 TEST(TestOpAlgoBase, ShaderCompiledDataFromConstructor)
 {
     kp::Manager mgr;
@@ -92,3 +132,68 @@ TEST(TestOpAlgoBase, ShaderCompiledDataFromFile)
     EXPECT_EQ(tensorA->data(), std::vector<float>({ 0, 1, 2 }));
     EXPECT_EQ(tensorB->data(), std::vector<float>({ 3, 4, 5 }));
 }
+
+TEST(TestOpAlgoBase, ShaderModulesSharedThroughManagerCache)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorA{ new kp::Tensor({ 3, 4, 5 }) };
+    std::shared_ptr<kp::Tensor> tensorB{ new kp::Tensor({ 0, 0, 0 }) };
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorA, tensorB });
+
+    std::vector<char> shaderData(
+      kp::shader_data::test_shaders_glsl_test_op_custom_shader_comp_spv,
+      kp::shader_data::test_shaders_glsl_test_op_custom_shader_comp_spv +
+        kp::shader_data::test_shaders_glsl_test_op_custom_shader_comp_spv_len);
+
+    for (size_t i = 0; i < 3; i++) {
+        mgr.evalOpDefault<kp::OpAlgoBase>(
+          { tensorA, tensorB }, "test/shaders/glsl/test_op_custom_shader.comp");
+        mgr.evalOpDefault<kp::OpAlgoBase>({ tensorA, tensorB }, shaderData);
+    }
+
+    EXPECT_EQ(mgr.shaderCache()->size(), 2);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorA, tensorB });
+
+    EXPECT_EQ(tensorA->data(), std::vector<float>({ 0, 1, 2 }));
+    EXPECT_EQ(tensorB->data(), std::vector<float>({ 0, 1, 2 }));
+}
+
+TEST(TestOpAlgoBase, ShaderCacheReplacesModifiedShaderFile)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorA{ new kp::Tensor({ 3, 4, 5 }) };
+    std::shared_ptr<kp::Tensor> tensorB{ new kp::Tensor({ 0, 0, 0 }) };
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorA, tensorB });
+
+    std::string shaderFilePath = "test_shader_cache_modified.comp.spv";
+    {
+        std::ofstream shaderFile(shaderFilePath, std::ios::binary);
+        shaderFile.write(
+          reinterpret_cast<const char*>(
+            kp::shader_data::test_shaders_glsl_test_op_custom_shader_comp_spv),
+          kp::shader_data::test_shaders_glsl_test_op_custom_shader_comp_spv_len);
+    }
+
+    mgr.evalOpDefault<kp::OpAlgoBase>({ tensorA, tensorB }, shaderFilePath);
+    EXPECT_EQ(mgr.shaderCache()->size(), 1);
+
+    struct stat fileStat;
+    ASSERT_EQ(stat(shaderFilePath.c_str(), &fileStat), 0);
+    struct utimbuf modifiedTimes;
+    modifiedTimes.actime = fileStat.st_atime;
+    modifiedTimes.modtime = fileStat.st_mtime + 10;
+    ASSERT_EQ(utime(shaderFilePath.c_str(), &modifiedTimes), 0);
+
+    mgr.evalOpDefault<kp::OpAlgoBase>({ tensorA, tensorB }, shaderFilePath);
+    EXPECT_EQ(mgr.shaderCache()->size(), 1);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorA, tensorB });
+
+    EXPECT_EQ(tensorA->data(), std::vector<float>({ 0, 1, 2 }));
+    EXPECT_EQ(tensorB->data(), std::vector<float>({ 0, 1, 2 }));
+
+    std::remove(shaderFilePath.c_str());
+}
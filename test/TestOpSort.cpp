@@ -0,0 +1,175 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <numeric>
+
+#include "kompute/Kompute.hpp"
+
+TEST(TestOpSort, SortFloatKeysAscendingAndDescending)
+{
+    kp::Manager mgr;
+
+    uint32_t size = 5003;
+    std::vector<float> data(size);
+    for (uint32_t i = 0; i < size; i++) {
+        data[i] = ((i * 7919) % 1000) * 0.5f - 250.0f;
+    }
+    std::vector<float> ascending = data;
+    std::sort(ascending.begin(), ascending.end());
+    std::vector<float> descending(ascending.rbegin(), ascending.rend());
+
+    std::shared_ptr<kp::Tensor> tensorA{ new kp::Tensor(data) };
+    std::shared_ptr<kp::Tensor> tensorB{ new kp::Tensor(data) };
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorA, tensorB });
+
+    mgr.evalOpDefault<kp::OpSort>({ tensorA });
+    mgr.evalOpDefault<kp::OpSort>({ tensorB },
+                                  kp::OpSort::KeyTypes::eFloat,
+                                  kp::OpSort::SortOrders::eDescending);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorA, tensorB });
+
+    EXPECT_EQ(tensorA->data(), ascending);
+    EXPECT_EQ(tensorB->data(), descending);
+}
+
+TEST(TestOpSort, SortKeysWithValuesIsStable)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorKeys{ new kp::Tensor(
+      { 3, -1, 2, -1, 3, 0, 2 }) };
+    std::shared_ptr<kp::Tensor> tensorValues{ new kp::Tensor(
+      { 0, 1, 2, 3, 4, 5, 6 }) };
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorKeys, tensorValues });
+
+    mgr.evalOpDefault<kp::OpSort>({ tensorKeys, tensorValues });
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorKeys, tensorValues });
+
+    EXPECT_EQ(tensorKeys->data(),
+              std::vector<float>({ -1, -1, 0, 2, 2, 3, 3 }));
+    EXPECT_EQ(tensorValues->data(),
+              std::vector<float>({ 1, 3, 5, 2, 6, 0, 4 }));
+
+    std::shared_ptr<kp::Tensor> tensorShort{ new kp::Tensor({ 0, 1 }) };
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorShort });
+    EXPECT_THROW(mgr.evalOpDefault<kp::OpSort>({ tensorKeys, tensorShort }),
+                 std::runtime_error);
+}
+
+TEST(TestOpSort, SortUintKeys)
+{
+    kp::Manager mgr;
+
+    // The keys are stored as the bits of the tensor data, avoiding the bit
+    // patterns of NaN floats so they are copied unchanged on the host
+    uint32_t size = 3001;
+    std::vector<uint32_t> keys(size);
+    for (uint32_t i = 0; i < size; i++) {
+        keys[i] = (i * 2654435761u) % 0x7F000000u;
+        if (i % 3 == 0) {
+            keys[i] |= 0x80000000u;
+        }
+    }
+    std::vector<float> data(size);
+    std::memcpy(data.data(), keys.data(), size * sizeof(uint32_t));
+    std::sort(keys.begin(), keys.end());
+
+    std::shared_ptr<kp::Tensor> tensor{ new kp::Tensor(data) };
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensor });
+
+    mgr.evalOpDefault<kp::OpSort>({ tensor }, kp::OpSort::KeyTypes::eUint);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensor });
+
+    std::vector<uint32_t> sorted(size);
+    std::memcpy(sorted.data(), tensor->data().data(), size * sizeof(uint32_t));
+    EXPECT_EQ(sorted, keys);
+}
+
+TEST(TestOpSort, TopKInSequence)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorIn{ new kp::Tensor(
+      { 0.5, 4, -2, 7, 4, 1, 9, -3 }) };
+    std::shared_ptr<kp::Tensor> tensorValues{ new kp::Tensor(
+      std::vector<float>(3)) };
+    std::shared_ptr<kp::Tensor> tensorIndices{ new kp::Tensor(
+      std::vector<float>(3)) };
+    std::shared_ptr<kp::Tensor> tensorSmallest{ new kp::Tensor(
+      std::vector<float>(2)) };
+    std::shared_ptr<kp::Tensor> tensorSmallestIndices{ new kp::Tensor(
+      std::vector<float>(2)) };
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorIn,
+                                            tensorValues,
+                                            tensorIndices,
+                                            tensorSmallest,
+                                            tensorSmallestIndices });
+
+    std::weak_ptr<kp::Sequence> sqWeakPtr = mgr.getOrCreateManagedSequence("topk");
+    if (std::shared_ptr<kp::Sequence> sq = sqWeakPtr.lock()) {
+        sq->begin();
+        sq->record<kp::OpTopK>({ tensorIn, tensorValues, tensorIndices });
+        sq->record<kp::OpTopK>({ tensorIn, tensorSmallest, tensorSmallestIndices },
+                               kp::OpSort::SortOrders::eAscending);
+        sq->record<kp::OpTensorSyncLocal>({ tensorValues,
+                                            tensorIndices,
+                                            tensorSmallest,
+                                            tensorSmallestIndices });
+        sq->end();
+        sq->eval();
+    }
+
+    EXPECT_EQ(tensorValues->data(), std::vector<float>({ 9, 7, 4 }));
+    EXPECT_EQ(tensorIndices->data(), std::vector<float>({ 6, 3, 1 }));
+    EXPECT_EQ(tensorSmallest->data(), std::vector<float>({ -3, -2 }));
+    EXPECT_EQ(tensorSmallestIndices->data(), std::vector<float>({ 7, 2 }));
+}
+
+TEST(TestOpSort, CompareWithStdSort)
+{
+    kp::Manager mgr;
+
+    uint32_t size = 1 << 20;
+    std::vector<float> data(size);
+    for (uint32_t i = 0; i < size; i++) {
+        data[i] = float((i * 2654435761u) % 1000003u) - 500000.0f;
+    }
+
+    std::shared_ptr<kp::Tensor> tensor{ new kp::Tensor(data) };
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensor });
+
+    std::weak_ptr<kp::Sequence> sqWeakPtr = mgr.getOrCreateManagedSequence("sort");
+    if (std::shared_ptr<kp::Sequence> sq = sqWeakPtr.lock()) {
+        sq->begin();
+        sq->record<kp::OpSort>({ tensor });
+        sq->end();
+
+        auto startDevice = std::chrono::high_resolution_clock::now();
+        sq->eval();
+        auto endDevice = std::chrono::high_resolution_clock::now();
+
+        RecordProperty("deviceSortMicroseconds",
+                       std::chrono::duration_cast<std::chrono::microseconds>(
+                         endDevice - startDevice)
+                         .count());
+    }
+
+    std::vector<float> expected = data;
+    auto startHost = std::chrono::high_resolution_clock::now();
+    std::sort(expected.begin(), expected.end());
+    auto endHost = std::chrono::high_resolution_clock::now();
+
+    RecordProperty(
+      "stdSortMicroseconds",
+      std::chrono::duration_cast<std::chrono::microseconds>(endHost - startHost)
+        .count());
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensor });
+
+    EXPECT_EQ(tensor->data(), expected);
+}
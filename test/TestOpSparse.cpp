@@ -0,0 +1,153 @@
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+
+#include "TestUtils.hpp"
+
+static std::vector<float>
+sparseData(uint32_t rows, uint32_t columns)
+{
+    // Around one percent of the elements are non zero, with a few longer
+    // rows so the rows do not all have the same size
+    std::vector<float> dense(rows * columns, 0);
+    for (uint32_t row = 0; row < rows; row++) {
+        uint32_t rowSize = row % 17 == 0 ? 40 : row % 5;
+        for (uint32_t i = 0; i < rowSize; i++) {
+            uint32_t column = (row * 31 + i * 97) % columns;
+            dense[row * columns + column] = float((row + i) % 9) - 4.0f + 0.5f;
+        }
+    }
+    return dense;
+}
+
+static std::vector<float>
+multiplyReference(const std::vector<float>& matrix,
+                  const std::vector<float>& dense,
+                  uint32_t rows,
+                  uint32_t columns,
+                  uint32_t denseColumns)
+{
+    std::vector<float> output(rows * denseColumns, 0);
+    for (uint32_t row = 0; row < rows; row++) {
+        for (uint32_t k = 0; k < columns; k++) {
+            for (uint32_t j = 0; j < denseColumns; j++) {
+                output[row * denseColumns + j] +=
+                  matrix[row * columns + k] * dense[k * denseColumns + j];
+            }
+        }
+    }
+    return output;
+}
+
+TEST(TestOpSparse, SparseTensorFormats)
+{
+    std::vector<float> dense = { 1, 0, 0, 2, 0, 0, 0, 0, 0, 3, 4, 5 };
+
+    kp::SparseTensor csr(dense, 3, 4);
+    EXPECT_EQ(csr.nonZeros(), 5);
+    EXPECT_EQ(csr.ellWidth(), 0);
+    EXPECT_EQ(csr.tensors().size(), 3);
+    EXPECT_EQ(csr.dense(), dense);
+
+    kp::SparseTensor ell(3,
+                         4,
+                         { 0, 2, 2, 5 },
+                         { 0, 3, 1, 2, 3 },
+                         { 1, 2, 3, 4, 5 },
+                         kp::SparseTensor::SparseFormats::eELL);
+    EXPECT_EQ(ell.nonZeros(), 5);
+    EXPECT_EQ(ell.ellWidth(), KP_SPARSE_ELL_VECTOR_SIZE);
+    EXPECT_EQ(ell.rowOffsets(), nullptr);
+    EXPECT_EQ(ell.tensors().size(), 2);
+    EXPECT_EQ(ell.dense(), dense);
+
+    EXPECT_THROW(kp::SparseTensor(3, 4, { 0, 2, 5 }, { 0, 1 }, { 1, 2 }),
+                 std::runtime_error);
+    EXPECT_THROW(kp::SparseTensor(1, 2, { 0, 1 }, { 2 }, { 1 }),
+                 std::runtime_error);
+}
+
+TEST(TestOpSparse, MultiplyVectorCsrAndEll)
+{
+    kp::Manager mgr;
+
+    uint32_t rows = 1000;
+    uint32_t columns = 500;
+    std::vector<float> dense = sparseData(rows, columns);
+    std::vector<float> vector(columns);
+    for (uint32_t i = 0; i < columns; i++) {
+        vector[i] = float(i % 13) / 13.0f - 0.5f;
+    }
+    std::vector<float> expected =
+      multiplyReference(dense, vector, rows, columns, 1);
+
+    std::shared_ptr<kp::SparseTensor> csr{ new kp::SparseTensor(
+      dense, rows, columns) };
+    std::shared_ptr<kp::SparseTensor> ell{ new kp::SparseTensor(
+      dense, rows, columns, kp::SparseTensor::SparseFormats::eELL) };
+    std::shared_ptr<kp::Tensor> tensorIn{ new kp::Tensor(vector) };
+    std::shared_ptr<kp::Tensor> tensorCsr{ new kp::Tensor(
+      std::vector<float>(rows)) };
+    std::shared_ptr<kp::Tensor> tensorEll{ new kp::Tensor(
+      std::vector<float>(rows)) };
+
+    mgr.evalOpDefault<kp::OpTensorCreate>(csr->tensors());
+    mgr.evalOpDefault<kp::OpTensorCreate>(ell->tensors());
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorIn, tensorCsr, tensorEll });
+
+    std::weak_ptr<kp::Sequence> sqWeakPtr =
+      mgr.getOrCreateManagedSequence("spmv");
+    if (std::shared_ptr<kp::Sequence> sq = sqWeakPtr.lock()) {
+        sq->begin();
+        sq->record<kp::OpSpMV>({ tensorIn, tensorCsr }, csr);
+        sq->record<kp::OpSpMV>({ tensorIn, tensorEll }, ell);
+        sq->record<kp::OpTensorSyncLocal>({ tensorCsr, tensorEll });
+        sq->end();
+        sq->eval();
+    }
+
+    expectNear(tensorCsr->data(), expected, 1e-3);
+    expectNear(tensorEll->data(), expected, 1e-3);
+
+    EXPECT_THROW(mgr.evalOpDefault<kp::OpSpMV>({ tensorCsr, tensorIn }, csr),
+                 std::runtime_error);
+}
+
+TEST(TestOpSparse, MultiplyMatrixCsrAndEll)
+{
+    kp::Manager mgr;
+
+    uint32_t rows = 300;
+    uint32_t columns = 200;
+    uint32_t denseColumns = 7;
+    std::vector<float> dense = sparseData(rows, columns);
+    std::vector<float> matrix(columns * denseColumns);
+    for (uint32_t i = 0; i < matrix.size(); i++) {
+        matrix[i] = float(i % 11) / 11.0f - 0.5f;
+    }
+    std::vector<float> expected =
+      multiplyReference(dense, matrix, rows, columns, denseColumns);
+
+    std::shared_ptr<kp::SparseTensor> csr{ new kp::SparseTensor(
+      dense, rows, columns) };
+    std::shared_ptr<kp::SparseTensor> ell{ new kp::SparseTensor(
+      dense, rows, columns, kp::SparseTensor::SparseFormats::eELL) };
+    std::shared_ptr<kp::Tensor> tensorIn{ new kp::Tensor(matrix) };
+    std::shared_ptr<kp::Tensor> tensorCsr{ new kp::Tensor(
+      std::vector<float>(rows * denseColumns)) };
+    std::shared_ptr<kp::Tensor> tensorEll{ new kp::Tensor(
+      std::vector<float>(rows * denseColumns)) };
+    tensorIn->reshape({ columns, denseColumns });
+
+    mgr.evalOpDefault<kp::OpTensorCreate>(csr->tensors());
+    mgr.evalOpDefault<kp::OpTensorCreate>(ell->tensors());
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorIn, tensorCsr, tensorEll });
+
+    mgr.evalOpDefault<kp::OpSpMM>({ tensorIn, tensorCsr }, csr);
+    mgr.evalOpDefault<kp::OpSpMM>({ tensorIn, tensorEll }, ell);
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorCsr, tensorEll });
+
+    expectNear(tensorCsr->data(), expected, 1e-3);
+    expectNear(tensorEll->data(), expected, 1e-3);
+}
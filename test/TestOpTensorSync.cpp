@@ -55,3 +55,163 @@ TEST(TestOpTensorSync, SyncToDeviceMemoryMultiTensor)
     EXPECT_EQ(tensorB->data(), testVec);
     EXPECT_EQ(tensorC->data(), testVec);
 }
+
+TEST(TestOpTensorSync, SyncToDeviceMemoryExplicitRanges)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorA{ new kp::Tensor({ 0, 0, 0, 0, 0, 0 }) };
+    std::shared_ptr<kp::Tensor> tensorB{ new kp::Tensor(
+      { 0, 0, 0, 0, 0, 0 }, kp::Tensor::TensorTypes::eStaging) };
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorA, tensorB });
+
+    tensorA->setData({ 1, 2, 3, 4, 5, 6 });
+    tensorB->setData({ 1, 2, 3, 4, 5, 6 });
+
+    mgr.evalOpDefault<kp::OpTensorSyncDevice>(
+      { tensorA, tensorB },
+      std::vector<kp::Tensor::Range>({ { 4, 2 }, { 0, 1 } }));
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorA, tensorB });
+
+    EXPECT_EQ(tensorA->data(), std::vector<float>({ 1, 0, 0, 0, 5, 6 }));
+    EXPECT_EQ(tensorB->data(), std::vector<float>({ 1, 0, 0, 0, 5, 6 }));
+}
+
+TEST(TestOpTensorSync, SyncToDeviceMemoryDirtyRanges)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorA{ new kp::Tensor({ 0, 0, 0, 0, 0, 0 }) };
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorA });
+
+    tensorA->data()[1] = 1;
+    tensorA->data()[2] = 2;
+    tensorA->data()[5] = 5;
+    tensorA->markDirty(1, 1);
+    tensorA->markDirty(2, 1);
+    tensorA->markDirty(5, 1);
+
+    // Adjacent dirty ranges are coalesced into a single copy region
+    std::vector<kp::Tensor::Range> dirtyRanges = tensorA->dirtyRanges();
+    EXPECT_EQ(dirtyRanges.size(), 2);
+    EXPECT_EQ(dirtyRanges[0].offset, 1);
+    EXPECT_EQ(dirtyRanges[0].size, 2);
+    EXPECT_EQ(dirtyRanges[1].offset, 5);
+    EXPECT_EQ(dirtyRanges[1].size, 1);
+
+    // Changes outside of the dirty ranges are not transferred
+    tensorA->data()[3] = 3;
+
+    mgr.evalOpDefault<kp::OpTensorSyncDevice>({ tensorA });
+
+    EXPECT_TRUE(tensorA->dirtyRanges().empty());
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorA });
+
+    EXPECT_EQ(tensorA->data(), std::vector<float>({ 0, 1, 2, 0, 0, 5 }));
+}
+
+TEST(TestOpTensorSync, SyncToDeviceMemoryDirtyRangesMarkedAfterRecord)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorA{ new kp::Tensor({ 0, 0, 0, 0, 0, 0 }) };
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorA });
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.getOrCreateManagedSequence("syncDevice");
+
+    sq->begin();
+    sq->record<kp::OpTensorSyncDevice>({ tensorA });
+    sq->end();
+
+    // Dirty ranges marked after recording are consumed by the evaluation
+    tensorA->data()[1] = 1;
+    tensorA->markDirty(1, 1);
+
+    EXPECT_TRUE(sq->eval());
+    EXPECT_TRUE(tensorA->dirtyRanges().empty());
+
+    tensorA->data()[4] = 4;
+    tensorA->markDirty(4, 1);
+
+    EXPECT_TRUE(sq->eval());
+    EXPECT_TRUE(tensorA->dirtyRanges().empty());
+
+    tensorA->setData({ 0, 0, 0, 0, 0, 0 });
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorA });
+
+    EXPECT_EQ(tensorA->data(), std::vector<float>({ 0, 1, 0, 0, 4, 0 }));
+
+    // Device tensors only transfer the copy regions recorded
+    tensorA->markDirty(0, 2);
+
+    sq->begin();
+    sq->record<kp::OpTensorSyncDevice>({ tensorA });
+    sq->end();
+
+    tensorA->markDirty(4, 1);
+
+    if (tensorA->isUnifiedMemory()) {
+        EXPECT_TRUE(sq->eval());
+    } else {
+        EXPECT_THROW(sq->eval(), std::runtime_error);
+    }
+}
+
+TEST(TestOpTensorSync, SyncToLocalMemoryExplicitRanges)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorA{ new kp::Tensor({ 1, 2, 3, 4 }) };
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorA });
+
+    tensorA->setData({ 0, 0, 0, 0 });
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>(
+      { tensorA }, std::vector<kp::Tensor::Range>({ { 2, 2 } }));
+
+    EXPECT_EQ(tensorA->data(), std::vector<float>({ 0, 0, 3, 4 }));
+
+    EXPECT_THROW(mgr.evalOpDefault<kp::OpTensorSyncLocal>(
+                   { tensorA }, std::vector<kp::Tensor::Range>({ { 3, 2 } })),
+                 std::runtime_error);
+}
+
+TEST(TestOpTensorSync, SyncDeviceTensorsInUnifiedMemory)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorLHS{ new kp::Tensor({ 0, 1, 2 }) };
+    std::shared_ptr<kp::Tensor> tensorRHS{ new kp::Tensor({ 2, 4, 6 }) };
+    std::shared_ptr<kp::Tensor> tensorOutput{ new kp::Tensor({ 0, 0, 0 }) };
+
+    mgr.evalOpDefault<kp::OpTensorCreate>(
+      { tensorLHS, tensorRHS, tensorOutput });
+
+    // The results are the same whether or not the device exposes unified
+    // memory, which only changes how the tensors are synced
+    tensorRHS->setData({ 1, 2, 3 });
+    mgr.evalOpDefault<kp::OpTensorSyncDevice>({ tensorRHS });
+
+    mgr.evalOpDefault<kp::OpMult>({ tensorLHS, tensorRHS, tensorOutput });
+
+    tensorOutput->setData({ 0, 0, 0 });
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorOutput });
+
+    EXPECT_EQ(tensorOutput->data(), std::vector<float>({ 0, 2, 6 }));
+
+    if (tensorOutput->isUnifiedMemory()) {
+        std::shared_ptr<kp::Tensor> view = tensorOutput->view(1, 2);
+        EXPECT_TRUE(view->isUnifiedMemory());
+
+        tensorOutput->setData({ 0, 0, 0 });
+        tensorOutput->mapDataFromHostMemory();
+        EXPECT_EQ(tensorOutput->data(), std::vector<float>({ 0, 2, 6 }));
+    }
+}
@@ -38,3 +38,269 @@ TEST(TestTensor, CopyFromHostData)
 
     EXPECT_EQ(tensorA->data(), tensorB->data());
 }
+
+TEST(TestTensor, ViewsSyncOnlyTheirRange)
+{
+    std::shared_ptr<kp::Tensor> tensor{ new kp::Tensor({ 0, 1, 2, 3, 4, 5 }) };
+    std::shared_ptr<kp::Tensor> viewA = tensor->view(0, 3);
+    std::shared_ptr<kp::Tensor> viewB = tensor->view(3, 3);
+
+    EXPECT_TRUE(viewA->isView());
+    EXPECT_EQ(viewA->parent(), tensor);
+    EXPECT_EQ(viewB->memoryOffset(), 3 * sizeof(float));
+    EXPECT_EQ(viewB->data(), std::vector<float>({ 3, 4, 5 }));
+
+    kp::Manager mgr;
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensor });
+
+    EXPECT_TRUE(viewA->isInit());
+    EXPECT_TRUE(viewB->isInit());
+
+    viewB->setData({ 6, 7, 8 });
+    EXPECT_EQ(tensor->data(), std::vector<float>({ 0, 1, 2, 6, 7, 8 }));
+
+    mgr.evalOpDefault<kp::OpTensorSyncDevice>({ viewB });
+
+    tensor->setData({ 0, 0, 0, 0, 0, 0 });
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensor });
+    EXPECT_EQ(tensor->data(), std::vector<float>({ 0, 1, 2, 6, 7, 8 }));
+
+    // Only the range of the view is synced back into the parent data
+    tensor->setData({ 9, 9, 9, 9, 9, 9 });
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ viewA });
+    EXPECT_EQ(viewA->data(), std::vector<float>({ 0, 1, 2 }));
+    EXPECT_EQ(tensor->data(), std::vector<float>({ 0, 1, 2, 9, 9, 9 }));
+}
+
+TEST(TestTensor, ViewsShareTheParentData)
+{
+    std::shared_ptr<kp::Tensor> tensor{ new kp::Tensor({ 0, 1, 2, 3, 4, 5 }) };
+    std::shared_ptr<kp::Tensor> view = tensor->view(2, 2);
+
+    kp::Manager mgr;
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensor });
+
+    // The data of the parent set after the view is created is synced by it
+    tensor->setData({ 6, 7, 8, 9, 10, 11 });
+    EXPECT_EQ(view->data(), std::vector<float>({ 8, 9 }));
+
+    mgr.evalOpDefault<kp::OpTensorSyncDevice>({ view });
+
+    tensor->setData({ 0, 0, 0, 0, 0, 0 });
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensor });
+    EXPECT_EQ(tensor->data(), std::vector<float>({ 0, 1, 8, 9, 4, 5 }));
+
+    // Writes through the view are written into the data of the parent
+    (*view)[1] = 12;
+    EXPECT_EQ(tensor->data()[3], 12);
+    EXPECT_EQ(view->hostData(), tensor->hostData() + 2);
+}
+
+TEST(TestTensor, ViewsAsCopySourceAndDestination)
+{
+    std::shared_ptr<kp::Tensor> tensor{ new kp::Tensor({ 0, 1, 2, 3, 4, 5 }) };
+    std::shared_ptr<kp::Tensor> viewA = tensor->view(0, 2);
+    std::shared_ptr<kp::Tensor> viewB = tensor->view(4, 2);
+    std::shared_ptr<kp::Tensor> tensorOut{ new kp::Tensor({ 0, 0 }) };
+
+    kp::Manager mgr;
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensor, tensorOut });
+
+    mgr.evalOpDefault<kp::OpTensorCopy>({ viewA, viewB, tensorOut });
+
+    EXPECT_EQ(tensorOut->data(), std::vector<float>({ 0, 1 }));
+
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensor, tensorOut });
+    EXPECT_EQ(tensor->data(), std::vector<float>({ 0, 1, 2, 3, 0, 1 }));
+    EXPECT_EQ(tensorOut->data(), std::vector<float>({ 0, 1 }));
+}
+
+TEST(TestTensor, NestedViewsAndInvalidRanges)
+{
+    std::shared_ptr<kp::Tensor> tensor{ new kp::Tensor({ 0, 1, 2, 3, 4, 5 }) };
+    std::shared_ptr<kp::Tensor> view = tensor->view(2, 4);
+    std::shared_ptr<kp::Tensor> nestedView = view->view(1, 2);
+
+    EXPECT_EQ(nestedView->parent(), tensor);
+    EXPECT_EQ(nestedView->memoryOffset(), 3 * sizeof(float));
+    EXPECT_EQ(nestedView->data(), std::vector<float>({ 3, 4 }));
+
+    EXPECT_THROW(tensor->view(4, 3), std::runtime_error);
+    EXPECT_THROW(tensor->view(0, 0), std::runtime_error);
+
+    kp::Tensor tensorNotShared({ 0, 1, 2 });
+    EXPECT_THROW(tensorNotShared.view(0, 1), std::runtime_error);
+
+    kp::Manager mgr;
+
+    EXPECT_THROW(mgr.evalOpDefault<kp::OpTensorCreate>({ view }),
+                 std::runtime_error);
+}
+
+TEST(TestTensor, ViewsBoundToShader)
+{
+    // Views are placed 256 bytes apart, which is the largest minimum storage
+    // buffer offset alignment allowed by the Vulkan specification
+    std::vector<float> data(192, 0);
+    for (uint32_t i = 0; i < 3; i++) {
+        data[i] = 2;
+        data[64 + i] = i;
+    }
+    std::shared_ptr<kp::Tensor> tensor{ new kp::Tensor(data) };
+    std::shared_ptr<kp::Tensor> viewLHS = tensor->view(0, 3);
+    std::shared_ptr<kp::Tensor> viewRHS = tensor->view(64, 3);
+    std::shared_ptr<kp::Tensor> viewOutput = tensor->view(128, 3);
+
+    kp::Manager mgr;
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensor });
+
+    mgr.evalOpDefault<kp::OpMult>({ viewLHS, viewRHS, viewOutput });
+
+    EXPECT_EQ(viewOutput->data(), std::vector<float>({ 0, 2, 4 }));
+    EXPECT_EQ(std::vector<float>(tensor->data().begin() + 128,
+                                 tensor->data().begin() + 131),
+              std::vector<float>({ 0, 2, 4 }));
+}
+
+TEST(TestTensor, CoalesceRanges)
+{
+    std::vector<kp::Tensor::Range> ranges = kp::Tensor::coalesceRanges(
+      { { 8, 2 }, { 0, 2 }, { 2, 1 }, { 9, 4 }, { 5, 0 }, { 20, 1 } });
+
+    EXPECT_EQ(ranges.size(), 3);
+    EXPECT_EQ(ranges[0].offset, 0);
+    EXPECT_EQ(ranges[0].size, 3);
+    EXPECT_EQ(ranges[1].offset, 8);
+    EXPECT_EQ(ranges[1].size, 5);
+    EXPECT_EQ(ranges[2].offset, 20);
+    EXPECT_EQ(ranges[2].size, 1);
+}
+
+// Returns a pointer into the storage aligned to the page size, which is the
+// usual minimum alignment of imported host pointers
+float*
+alignToPage(std::vector<float>& storage)
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(storage.data());
+    return reinterpret_cast<float*>((address + 4095) & ~uintptr_t(4095));
+}
+
+TEST(TestTensor, HostPointerTransfersWithoutDataVector)
+{
+    uint32_t size = 1024;
+    std::vector<float> storage(size + 1024, 0);
+    float* hostPointer = alignToPage(storage);
+    for (uint32_t i = 0; i < size; i++) {
+        hostPointer[i] = i;
+    }
+
+    std::shared_ptr<kp::Tensor> tensorHost{ new kp::Tensor(
+      hostPointer, size, kp::Tensor::TensorTypes::eStaging) };
+    std::shared_ptr<kp::Tensor> tensorDevice{ new kp::Tensor(
+      std::vector<float>(size, 0)) };
+
+    EXPECT_EQ(tensorHost->hostPointer(), hostPointer);
+    EXPECT_EQ(tensorHost->size(), size);
+    EXPECT_TRUE(tensorHost->data().empty());
+
+    kp::Manager mgr;
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorHost, tensorDevice });
+
+    mgr.evalOpDefault<kp::OpTensorCopy>({ tensorHost, tensorDevice });
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorDevice });
+
+    EXPECT_EQ(tensorDevice->data(),
+              std::vector<float>(hostPointer, hostPointer + size));
+
+    // Data copied into the tensor is written into the host memory
+    tensorDevice->setData(std::vector<float>(size, 2));
+    mgr.evalOpDefault<kp::OpTensorSyncDevice>({ tensorDevice });
+    mgr.evalOpDefault<kp::OpTensorCopy>({ tensorDevice, tensorHost });
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorHost });
+
+    EXPECT_EQ(std::vector<float>(hostPointer, hostPointer + size),
+              std::vector<float>(size, 2));
+}
+
+TEST(TestTensor, HostPointerUnalignedFallsBackToCopy)
+{
+    uint32_t size = 16;
+    std::vector<float> storage(size + 1025, 0);
+    float* hostPointer = alignToPage(storage) + 1;
+    for (uint32_t i = 0; i < size; i++) {
+        hostPointer[i] = i;
+    }
+
+    std::shared_ptr<kp::Tensor> tensorHost{ new kp::Tensor(
+      hostPointer, size, kp::Tensor::TensorTypes::eStaging) };
+    std::shared_ptr<kp::Tensor> tensorDevice{ new kp::Tensor(
+      std::vector<float>(size, 0)) };
+
+    kp::Manager mgr;
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorHost, tensorDevice });
+
+    EXPECT_FALSE(tensorHost->isHostMemoryImported());
+
+    mgr.evalOpDefault<kp::OpTensorCopy>({ tensorHost, tensorDevice });
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorDevice });
+
+    EXPECT_EQ(tensorDevice->data(),
+              std::vector<float>(hostPointer, hostPointer + size));
+
+    EXPECT_THROW(kp::Tensor(hostPointer, size, kp::Tensor::TensorTypes::eDevice),
+                 std::runtime_error);
+}
+
+TEST(TestTensor, HostPointerUnalignedSizeFallsBackToCopy)
+{
+    // The size in bytes is not a multiple of the page size, so the memory
+    // after the end of the tensor is not imported and stays untouched
+    uint32_t size = 1023;
+    std::vector<float> storage(size + 2048, 0);
+    float* hostPointer = alignToPage(storage);
+    for (uint32_t i = 0; i < size + 1; i++) {
+        hostPointer[i] = i;
+    }
+
+    std::shared_ptr<kp::Tensor> tensorHost{ new kp::Tensor(
+      hostPointer, size, kp::Tensor::TensorTypes::eStaging) };
+    std::shared_ptr<kp::Tensor> tensorDevice{ new kp::Tensor(
+      std::vector<float>(size, 2)) };
+
+    kp::Manager mgr;
+
+    mgr.evalOpDefault<kp::OpTensorCreate>({ tensorHost, tensorDevice });
+
+    EXPECT_FALSE(tensorHost->isHostMemoryImported());
+
+    mgr.evalOpDefault<kp::OpTensorCopy>({ tensorDevice, tensorHost });
+    mgr.evalOpDefault<kp::OpTensorSyncLocal>({ tensorHost });
+
+    EXPECT_EQ(std::vector<float>(hostPointer, hostPointer + size),
+              std::vector<float>(size, 2));
+    EXPECT_EQ(hostPointer[size], size);
+}
+
+TEST(TestTensor, ReshapeKeepsSize)
+{
+    std::shared_ptr<kp::Tensor> tensor{ new kp::Tensor(
+      std::vector<float>(24, 0)) };
+
+    EXPECT_EQ(tensor->shape(), (std::array<uint32_t, KP_MAX_DIM_SIZE>{ 24 }));
+
+    tensor->reshape({ 2, 3, 4 });
+    EXPECT_EQ(tensor->size(), 24);
+    EXPECT_EQ(tensor->shape(),
+              (std::array<uint32_t, KP_MAX_DIM_SIZE>{ 2, 3, 4 }));
+
+    EXPECT_THROW(tensor->reshape({ 5, 5 }), std::runtime_error);
+    EXPECT_THROW(tensor->reshape({ 24, 0 }), std::runtime_error);
+    EXPECT_THROW(tensor->reshape({ 1, 2, 3, 2, 2 }), std::runtime_error);
+    EXPECT_EQ(tensor->size(), 24);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+// Deterministic data in the range [-1, 1) that repeats every period
+// elements, where different seeds shift the sequence
+inline std::vector<float>
+sequenceData(uint32_t size, uint32_t seed, uint32_t period = 17)
+{
+    std::vector<float> data(size);
+    for (uint32_t i = 0; i < size; i++) {
+        data[i] = float((i * 37 + seed * 11) % period) / float(period / 2) -
+                  1.0f;
+    }
+    return data;
+}
+
+inline void
+expectNear(const std::vector<float>& actual,
+           const std::vector<float>& expected,
+           double tolerance = 1e-4)
+{
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); i++) {
+        EXPECT_NEAR(actual[i], expected[i], tolerance) << "at index " << i;
+    }
+}